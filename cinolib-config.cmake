@@ -30,6 +30,8 @@ option(CINOLIB_USES_INDIRECT_PREDICATES "Use Indirect Predicates"    OFF)
 option(CINOLIB_USES_GRAPH_CUT           "Use Graph Cut"              OFF)
 option(CINOLIB_USES_BOOST               "Use Boost"                  OFF)
 option(CINOLIB_USES_VTK                 "Use VTK"                    OFF)
+option(CINOLIB_USES_ZLIB                "Use ZLIB"                   OFF)
+option(CINOLIB_USES_AVX                 "Use AVX instructions"       OFF)
 
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -138,3 +140,28 @@ if(CINOLIB_USES_VTK)
 endif()
 
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+if(CINOLIB_USES_ZLIB)
+    message("CINOLIB OPTIONAL MODULE: ZLIB")
+    find_package(ZLIB)
+    if(ZLIB_FOUND)
+        target_link_libraries(cinolib INTERFACE ZLIB::ZLIB)
+        target_compile_definitions(cinolib INTERFACE CINOLIB_USES_ZLIB)
+    else()
+        message("Could not find ZLIB!")
+        set(CINOLIB_USES_ZLIB OFF)
+    endif()
+endif()
+
+#::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+if(CINOLIB_USES_AVX)
+    message("CINOLIB OPTIONAL MODULE: AVX")
+    if(MSVC)
+        target_compile_options(cinolib INTERFACE /arch:AVX)
+    else()
+        target_compile_options(cinolib INTERFACE -mavx)
+    endif()
+endif()
+
+#::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -47,6 +47,10 @@ int main(int argc, char **argv)
     {
         read_MESH(argv[1], verts, polys);
     }
+    else if(ext.compare("MSH")==0 || ext.compare("msh")==0)
+    {
+        read_MSH(argv[1], verts, polys);
+    }
     else if(ext.compare("TET")==0 || ext.compare("tet")==0)
     {
         read_TET(argv[1], verts, polys);
@@ -95,6 +99,10 @@ int main(int argc, char **argv)
     {
         write_MESH(argv[2], verts, polys);
     }
+    else if(ext.compare("MSH")==0 || ext.compare("msh")==0)
+    {
+        write_MSH(argv[2], verts, polys);
+    }
     else if(ext.compare("TET")==0 || ext.compare("tet")==0)
     {
         write_TET(argv[2], verts, polys);
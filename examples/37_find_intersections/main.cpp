@@ -13,7 +13,7 @@ int main(int argc, char **argv)
 
     Profiler p;
     p.push("Find intersections");
-    std::set<ipair> inters;
+    std::vector<ipair> inters;
     find_intersections(m, inters);
     p.pop();
 
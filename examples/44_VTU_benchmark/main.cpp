@@ -0,0 +1,74 @@
+#include <cinolib/io/read_write.h>
+#include <cinolib/how_many_seconds.h>
+#include <cinolib/string_utilities.h>
+#include <cstdio>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+long file_size(const char * filename)
+{
+    FILE *fp = fopen(filename, "rb");
+    if(!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    std::string s = (argc==2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/rockerarm.mesh";
+
+    std::vector<vec3d>             verts;
+    std::vector<std::vector<uint>> polys;
+    read_MESH(s.c_str(), verts, polys);
+
+    std::string out = get_file_path(s,true) + "_benchmark.vtu";
+    const char *formats[] = { "ascii", "binary", "appended raw", "appended base64" };
+
+    std::cout << "\nNative VTU IO (" << verts.size() << " verts, " << polys.size() << " polys)\n" << std::endl;
+    for(int compress=0; compress<2; ++compress)
+    for(int format=VTU_ASCII; format<=VTU_APPENDED_BASE64; ++format)
+    {
+        if(compress && format==VTU_ASCII) continue;
+#ifndef CINOLIB_USES_ZLIB
+        if(compress) continue;
+#endif
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        write_VTU(out.c_str(), verts, polys, {}, {}, {}, format, compress);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        std::vector<vec3d>             v;
+        std::vector<std::vector<uint>> p;
+        read_VTU(out.c_str(), v, p);
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+        printf("%-16s %-12s write %8.4fs   read %8.4fs   size %10ld bytes   %s\n",
+               formats[format], compress ? "(zlib)" : "",
+               how_many_seconds(t0,t1), how_many_seconds(t1,t2), file_size(out.c_str()),
+               (v.size()==verts.size() && p==polys) ? "OK" : "MISMATCH");
+    }
+
+#ifdef CINOLIB_USES_VTK
+    std::cout << "\nVTK based IO\n" << std::endl;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    write_VTU_with_VTK(out.c_str(), verts, polys);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    std::vector<vec3d>             v;
+    std::vector<std::vector<uint>> p;
+    read_VTU_with_VTK(out.c_str(), v, p);
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    printf("%-29s write %8.4fs   read %8.4fs   size %10ld bytes\n", "VTK defaults",
+           how_many_seconds(t0,t1), how_many_seconds(t1,t2), file_size(out.c_str()));
+
+    // cross check: the native reader must parse what VTK writes
+    read_VTU(out.c_str(), v, p);
+    std::cout << "native reader on VTK output: " << ((v.size()==verts.size() && p==polys) ? "OK" : "MISMATCH") << std::endl;
+#endif
+
+    remove(out.c_str());
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <cinolib/batch_mesh_conversion.h>
+#include <cinolib/string_utilities.h>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    if(argc<3)
+    {
+        std::cout << "usage: " << argv[0] << " <output extension> <mesh> [<mesh> ...]" << std::endl;
+        std::cout << "e.g.:  " << argv[0] << " vtu " << DATA_PATH << "/rockerarm.mesh " << DATA_PATH << "/sphere.mesh" << std::endl;
+        return -1;
+    }
+
+    std::string ext(argv[1]);
+    std::vector<BatchConversionJob> jobs;
+    for(int i=2; i<argc; ++i)
+    {
+        BatchConversionJob job;
+        job.input  = argv[i];
+        job.output = get_file_path(job.input,true) + "_converted." + ext;
+        jobs.push_back(job);
+    }
+
+    BatchConversionStats stats = batch_mesh_conversion(jobs);
+    stats.print();
+
+    return 0;
+}
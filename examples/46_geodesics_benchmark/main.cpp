@@ -0,0 +1,85 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/geodesics.h>
+#include <cinolib/fast_marching.h>
+#include <cinolib/dijkstra.h>
+#include <cinolib/how_many_seconds.h>
+#include <algorithm>
+#include <cstdio>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void report(const char * method, const double seconds, const std::vector<double> & d, const std::vector<double> & ref)
+{
+    double max_ref = 0, mean_err = 0, max_err = 0;
+    for(uint vid=0; vid<ref.size(); ++vid)
+    {
+        double err = std::fabs(d.at(vid) - ref.at(vid));
+        max_ref   = std::max(max_ref, ref.at(vid));
+        max_err   = std::max(max_err, err);
+        mean_err += err;
+    }
+    mean_err /= ref.size();
+    printf("%-24s %8.4fs   mean error %8.4f%%   max error %8.4f%%\n", method, seconds, 100*mean_err/max_ref, 100*max_err/max_ref);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    // on a sphere the exact geodesic distance is known (great circle distance).
+    // On any other mesh, errors are measured w.r.t. fast marching
+    bool sphere = (argc<2);
+    std::string s = sphere ? std::string(DATA_PATH) + "/sphere.obj" : std::string(argv[1]);
+    Trimesh<> m(s.c_str());
+    uint source = 0;
+
+    std::vector<double> fmm, ref(m.num_verts());
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    fast_marching(m, {source}, fmm);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    double fmm_time = how_many_seconds(t0,t1);
+
+    if(sphere)
+    {
+        vec3d  c = m.bbox().center();
+        double r = 0;
+        for(uint vid=0; vid<m.num_verts(); ++vid) r += m.vert(vid).dist(c);
+        r /= m.num_verts();
+        for(uint vid=0; vid<m.num_verts(); ++vid) ref.at(vid) = r * (m.vert(source)-c).angle_rad(m.vert(vid)-c);
+    }
+    else ref = fmm;
+
+    std::cout << "\nGeodesic distances from vertex " << source << " (" << m.num_verts() << " verts)" << std::endl;
+    std::cout << "errors are relative to the max distance, measured w.r.t. " << (sphere ? "the exact distance" : "fast marching") << "\n" << std::endl;
+
+    std::vector<double> d;
+    t0 = std::chrono::steady_clock::now();
+    dijkstra_exhaustive(m, source, d);
+    t1 = std::chrono::steady_clock::now();
+    report("Dijkstra (edges)", how_many_seconds(t0,t1), d, ref);
+
+    report("fast marching", fmm_time, fmm, ref);
+
+    // compute_geodesics normalizes its output in [0,1] (and, depending on the
+    // laplacian sign convention, it may be 1 at the source): map it back to compare
+    double max_ref = *std::max_element(ref.begin(), ref.end());
+    Trimesh<> tmp = m;
+    t0 = std::chrono::steady_clock::now();
+    ScalarField f = compute_geodesics(tmp, {source});
+    t1 = std::chrono::steady_clock::now();
+    if(f[source] > 0.5) f = (1.0 - f.array()).matrix();
+    f *= max_ref;
+    report("compute_geodesics (heat)", how_many_seconds(t0,t1), std::vector<double>(f.data(), f.data()+f.size()), ref);
+
+    t0 = std::chrono::steady_clock::now();
+    HeatGeodesics<Trimesh<>> hg(m);
+    t1 = std::chrono::steady_clock::now();
+    ScalarField h = hg.distances({source});
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    report("HeatGeodesics (setup)", how_many_seconds(t0,t1), std::vector<double>(h.data(), h.data()+h.size()), ref);
+    report("HeatGeodesics (query)", how_many_seconds(t1,t2), std::vector<double>(h.data(), h.data()+h.size()), ref);
+
+    return 0;
+}
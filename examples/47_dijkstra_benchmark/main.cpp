@@ -0,0 +1,113 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/grid_mesh.h>
+#include <cinolib/dijkstra.h>
+#include <cinolib/delta_stepping.h>
+#include <cinolib/indexed_heap.h>
+#include <cinolib/how_many_seconds.h>
+#include <cstdio>
+#include <set>
+#include <thread>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the previous implementation of dijkstra_exhaustive, based on std::set
+//
+void dijkstra_std_set(const Quadmesh<> & m, const uint source, std::vector<double> & dist)
+{
+    dist = std::vector<double>(m.num_verts(), inf_double);
+    dist.at(source) = 0.0;
+
+    std::set<std::pair<double,uint>> q;
+    q.insert(std::make_pair(0.0,source));
+
+    while(!q.empty())
+    {
+        uint vid = q.begin()->second;
+        q.erase(q.begin());
+
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
+            if(dist.at(nbr) > new_dist)
+            {
+                if(dist.at(nbr) < inf_double) q.erase(std::make_pair(dist.at(nbr),nbr));
+                dist.at(nbr) = new_dist;
+                q.insert(std::make_pair(new_dist,nbr));
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same, with an indexed heap of arity D
+//
+template<uint D>
+void dijkstra_heap(const Quadmesh<> & m, const uint source, std::vector<double> & dist)
+{
+    dist = std::vector<double>(m.num_verts(), inf_double);
+    dist.at(source) = 0.0;
+
+    IndexedHeap<D> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
+
+    while(!q.empty())
+    {
+        uint vid = q.pop();
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
+            if(dist.at(nbr) > new_dist)
+            {
+                dist.at(nbr) = new_dist;
+                q.push_or_decrease(nbr, new_dist);
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Func>
+double time_it(const Func & f, std::vector<double> & dist)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    f(dist);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return how_many_seconds(t0,t1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    // regular grids from 10K vertices up to max_verts (default 1M; 10M
+    // vertices need a few GB of memory for the mesh connectivity)
+    uint max_verts = (argc>1) ? atoi(argv[1]) : 1000000;
+
+    std::cout << "\nSingle source Dijkstra on regular grids (seconds)\n" << std::endl;
+    std::cout << "(delta-stepping runs on " << std::thread::hardware_concurrency() << " threads)\n" << std::endl;
+    printf("%12s %12s %12s %12s %12s %12s %12s\n", "verts", "std::set", "2-ary heap", "4-ary heap", "delta-step", "set/4-ary", "set/delta");
+
+    for(uint n=10000; n<=max_verts; n*=10)
+    {
+        uint side = std::sqrt(double(n));
+        Quadmesh<> m;
+        grid_mesh(side-1, side-1, m);
+        uint source = m.num_verts()/2 + side/2;
+
+        std::vector<double> d_set, d_bin, d_4ary, d_delta;
+        double t_set  = time_it([&](std::vector<double> & d){ dijkstra_std_set(m, source, d); }, d_set);
+        double t_bin  = time_it([&](std::vector<double> & d){ dijkstra_heap<2>(m, source, d); }, d_bin);
+        double t_4ary = time_it([&](std::vector<double> & d){ dijkstra_heap<4>(m, source, d); }, d_4ary);
+        double t_dlt  = time_it([&](std::vector<double> & d){ delta_stepping_exhaustive(m, {source}, d); }, d_delta);
+
+        // the heap speedup is measured against the serial baseline only; the
+        // parallel delta-stepping is reported separately
+        printf("%12d %12.4f %12.4f %12.4f %12.4f %11.2fx %11.2fx %s\n", m.num_verts(), t_set, t_bin, t_4ary, t_dlt,
+               t_set/t_4ary, t_set/t_dlt, (d_set==d_bin && d_set==d_4ary && d_set==d_delta) ? "" : "MISMATCH");
+    }
+    return 0;
+}
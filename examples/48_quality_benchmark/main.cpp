@@ -0,0 +1,114 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/quality.h>
+#include <cinolib/quality_batch.h>
+#include <cinolib/simd.h>
+#include <cinolib/how_many_seconds.h>
+#include <cstdio>
+#include <thread>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// per element evaluation (i.e. the previous implementation of update_quality)
+//
+void quality_per_element(const Polyhedralmesh<> & m, std::vector<double> & q)
+{
+    q.resize(m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(m.poly_is_tetrahedron(pid))
+        {
+            q[pid] = tet_scaled_jacobian(m.poly_vert(pid,0), m.poly_vert(pid,1),
+                                         m.poly_vert(pid,2), m.poly_vert(pid,3));
+        }
+        else
+        {
+            q[pid] = hex_scaled_jacobian(m.poly_vert(pid,0), m.poly_vert(pid,1),
+                                         m.poly_vert(pid,2), m.poly_vert(pid,3),
+                                         m.poly_vert(pid,4), m.poly_vert(pid,5),
+                                         m.poly_vert(pid,6), m.poly_vert(pid,7));
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// batched evaluation, on flat lists of corners
+//
+void quality_batched(const Polyhedralmesh<> & m, const std::vector<uint> & corners, const bool tets, std::vector<double> & q)
+{
+    q.resize(m.num_polys());
+    if(tets) tet_scaled_jacobian_batch(m.vector_verts().data(), corners.data(), m.num_polys(), q.data());
+    else     hex_scaled_jacobian_batch(m.vector_verts().data(), corners.data(), m.num_polys(), q.data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Func>
+double time_it(const Func & f, const uint reps)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for(uint i=0; i<reps; ++i) f();
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return how_many_seconds(t0,t1)/reps;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    // usage: ./quality_benchmark [mesh1 mesh2 ...] (tet or hex meshes)
+    std::vector<std::string> files;
+    for(int i=1; i<argc; ++i) files.push_back(argv[i]);
+    if(files.empty())
+    {
+        files.push_back(std::string(DATA_PATH) + "/rockerarm.mesh");
+        files.push_back(std::string(DATA_PATH) + "/ellipsoid.mesh");
+        files.push_back(std::string(DATA_PATH) + "/sphere.mesh");
+    }
+
+    std::cout << "\nScaled Jacobian of all mesh elements (milliseconds per evaluation)\n" << std::endl;
+    std::cout << "(" << dvec::W << " elements per SIMD instruction, update_quality runs on "
+              << std::thread::hardware_concurrency() << " threads)\n" << std::endl;
+    printf("%20s %10s %14s %14s %14s %10s %12s\n", "mesh", "elements", "per element", "batched", "update_quality", "speedup", "max diff");
+
+    for(const std::string & f : files)
+    {
+        Polyhedralmesh<> m(f.c_str());
+        if(m.num_polys()==0) continue;
+        bool tets = m.poly_is_tetrahedron(0);
+        std::vector<uint> corners;
+        for(uint pid=0; pid<m.num_polys(); ++pid)
+        {
+            if(tets != m.poly_is_tetrahedron(pid) || (!tets && !m.poly_is_hexahedron(pid)))
+            {
+                std::cerr << "WARNING : " << f << " is not a pure tet or hex mesh, skipped" << std::endl;
+                corners.clear();
+                break;
+            }
+            corners.insert(corners.end(), m.adj_p2v(pid).begin(), m.adj_p2v(pid).end());
+        }
+        if(corners.empty()) continue;
+
+        // repeat each evaluation so that it takes a measurable time
+        uint reps = std::max(1u, 10000000u/m.num_polys());
+
+        std::vector<double> q_elem, q_batch;
+        double t_elem  = time_it([&](){ quality_per_element(m, q_elem); }, reps);
+        double t_batch = time_it([&](){ quality_batched(m, corners, tets, q_batch); }, reps);
+        double t_mesh  = time_it([&](){ m.update_quality(); }, reps);
+
+        double diff = 0;
+        for(uint pid=0; pid<m.num_polys(); ++pid)
+        {
+            diff = std::max(diff, std::fabs(q_elem[pid]-q_batch[pid]));
+            diff = std::max(diff, std::fabs(double(float(q_elem[pid]))-m.poly_data(pid).quality));
+        }
+
+        std::string name = f.substr(f.find_last_of("/\\")+1);
+        printf("%20s %10d %14.3f %14.3f %14.3f %9.2fx %12g\n", name.c_str(), m.num_polys(),
+               1000*t_elem, 1000*t_batch, 1000*t_mesh, t_elem/t_batch, diff);
+    }
+    return 0;
+}
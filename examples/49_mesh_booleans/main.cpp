@@ -0,0 +1,64 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/mesh_boolean.h>
+#include <cinolib/vector_serialization.h>
+#include <cinolib/how_many_seconds.h>
+#include <cstdio>
+#include <cstring>
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char *argv[])
+{
+    // with no arguments, computes the union of a bunny and a sphere placed on its back
+    std::string op_name = (argc>1) ? argv[1] : "union";
+    std::string out     = (argc>2) ? argv[2] : "./boolean.obj";
+    std::vector<std::string> inputs;
+    for(int i=3; i<argc; ++i) inputs.push_back(argv[i]);
+
+    BooleanOperation op;
+    if(op_name=="union")        op = BOOLEAN_UNION;        else
+    if(op_name=="intersection") op = BOOLEAN_INTERSECTION; else
+    if(op_name=="difference")   op = BOOLEAN_DIFFERENCE;   else
+    {
+        std::cout << "usage: " << argv[0] << " <union|intersection|difference> <output mesh> <mesh> <mesh> [<mesh> ...]" << std::endl;
+        std::cout << "(difference subtracts all the other meshes from the first one)" << std::endl;
+        return -1;
+    }
+
+    // all the parts go in the same soup, labeled with their index
+    std::vector<vec3d> verts;
+    std::vector<uint>  tris, labels;
+    auto add_part = [&](const Trimesh<> & m)
+    {
+        std::vector<uint> t = serialized_vids_from_polys(m.vector_polys());
+        for(uint & vid : t) vid += verts.size();
+        verts.insert(verts.end(), m.vector_verts().begin(), m.vector_verts().end());
+        tris.insert(tris.end(), t.begin(), t.end());
+        labels.resize(tris.size()/3, labels.empty() ? 0 : labels.back()+1);
+    };
+    if(inputs.empty())
+    {
+        Trimesh<> bunny(std::string(std::string(DATA_PATH) + "/bunny.obj").c_str());
+        Trimesh<> sphere(std::string(std::string(DATA_PATH) + "/sphere.obj").c_str());
+        sphere.scale(0.3*bunny.bbox().diag()/sphere.bbox().diag());
+        sphere.translate(bunny.bbox().center() + vec3d(0, 0.3*bunny.bbox().delta_y(), 0) - sphere.bbox().center());
+        add_part(bunny);
+        add_part(sphere);
+    }
+    for(const std::string & s : inputs) add_part(Trimesh<>(s.c_str()));
+
+    std::vector<vec3d> res_verts;
+    std::vector<uint>  res_tris;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    mesh_boolean(verts, tris, labels, op, res_verts, res_tris);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    printf("%s of %d meshes (%d triangles): %d triangles in %.4fs\n", op_name.c_str(), (int)labels.back()+1,
+           (int)tris.size()/3, (int)res_tris.size()/3, how_many_seconds(t0,t1));
+
+    Trimesh<> res(res_verts, res_tris);
+    res.save(out.c_str());
+    return 0;
+}
@@ -36,9 +36,8 @@
 #ifndef CINO_DRAWABLE_SLICED_OBJ
 #define CINO_DRAWABLE_SLICED_OBJ
 
-// Boost polygons and Triangle are used to create and tessellate slices...
+// Boost polygons are used to create slices...
 #ifdef CINOLIB_USES_BOOST
-#ifdef CINOLIB_USES_TRIANGLE
 
 #include <cinolib/meshes/meshes.h>
 #include <cinolib/3d_printing/sliced_object.h>
@@ -92,7 +91,6 @@ class DrawableSlicedObj : public AbstractDrawablePolygonMesh<SlicedObj<M,V,E,P>>
 
 }
 
-#endif // CINO_USES_TRIANGLE
 #endif // CINO_USES_BOOST
 
 #endif // CINO_DRAWABLE_SLICED_OBJ
@@ -37,7 +37,7 @@
 #include <cinolib/parallel_for.h>
 #include <cinolib/octree.h>
 #include <cinolib/find_intersections.h>
-#include <mutex>
+#include <cinolib/concurrent_collector.h>
 
 namespace cinolib
 {
@@ -49,16 +49,13 @@ void overhangs(const Trimesh<M,V,E,P>  & m,
                const vec3d             & build_dir,
                      std::vector<uint> & polys_hanging)
 {
-    std::mutex mutex;
+    ConcurrentCollector<uint> pids;
     PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
     {
         float ang = build_dir.angle_deg(m.poly_data(pid).normal);
-        if(ang-90.f > thresh)
-        {
-            std::lock_guard<std::mutex> guard(mutex);
-            polys_hanging.push_back(pid);
-        }
+        if(ang-90.f > thresh) pids.push_back(pid);
     });
+    pids.merge_unique(polys_hanging);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -76,7 +73,7 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
     overhangs(m, thresh, build_dir, tmp);
 
     // cast a ray from each overhang to find the first triangle below it
-    std::mutex mutex;
+    ConcurrentCollector<std::pair<uint,uint>> pairs;
     PARALLEL_FOR(0, tmp.size(), 1000, [&](const uint i)
     {
         uint pid  = tmp[i];
@@ -91,12 +88,9 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
                 pair.second = hit->second;
             }
         }
-        // critical section
-        {
-            std::lock_guard<std::mutex> guard(mutex);
-            polys_hanging.push_back(pair);
-        }
+        pairs.push_back(pair);
     });
+    pairs.merge_unique(polys_hanging);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -35,9 +35,10 @@
 *********************************************************************************/
 #include <cinolib/3d_printing/sliced_object.h>
 #include <cinolib/io/read_CLI.h>
-#include <cinolib/triangle_wrap.h>
+#include <cinolib/constrained_delaunay.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/ANSI_color_codes.h>
+#include <climits>
 
 namespace cinolib
 {
@@ -129,28 +130,30 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void SlicedObj<M,V,E,P>::triangulate_slices()
 {
+    // slices are independent from each other, and are triangulated in parallel
+    std::vector<std::vector<vec2d>> verts(slices.size());
+    std::vector<std::vector<uint>>  segs (slices.size());
+    std::vector<std::vector<uint>>  tris;
+    for(uint sid=0; sid<slices.size(); ++sid) polygon_get_edges(slices.at(sid), verts.at(sid), segs.at(sid));
+    constrained_delaunay_triangulation(verts, segs, true, tris);
+
     for(uint sid=0; sid<slices.size(); ++sid)
     {
-        const BoostMultiPolygon & mp = slices.at(sid);
-
-        std::vector<vec3d> verts;
-        std::vector<uint>  tris;
-        triangulate_polygon(mp, "Q", z.at(sid), verts, tris);
-
-        uint base_addr = this->num_verts();
-        uint n_tris = tris.size()/3;
-
-        for(auto p : verts)
+        // coincident vertices are merged by the triangulation, and are not referenced
+        std::vector<uint> vmap(verts.at(sid).size(), UINT_MAX);
+        for(uint vid : tris.at(sid))
         {
-            uint vid = this->vert_add(p);
-            this->vert_data(vid).uvw[0] = static_cast<double>(sid)/static_cast<double>(num_slices());
-            this->vert_data(vid).label  = sid;
+            if(vmap.at(vid)!=UINT_MAX) continue;
+            const vec2d & p = verts.at(sid).at(vid);
+            vmap.at(vid) = this->vert_add(vec3d(p.x(), p.y(), z.at(sid)));
+            this->vert_data(vmap.at(vid)).uvw[0] = static_cast<double>(sid)/static_cast<double>(num_slices());
+            this->vert_data(vmap.at(vid)).label  = sid;
         }
-        for(uint i=0; i<n_tris; ++i)
+        for(uint i=0; i<tris.at(sid).size(); i+=3)
         {
-            uint pid = this->poly_add(base_addr + tris.at(3*i+0),
-                                      base_addr + tris.at(3*i+1),
-                                      base_addr + tris.at(3*i+2));
+            uint pid = this->poly_add(vmap.at(tris.at(sid).at(i+0)),
+                                      vmap.at(tris.at(sid).at(i+1)),
+                                      vmap.at(tris.at(sid).at(i+2)));
             this->poly_data(pid).label = sid;
             for(uint eid : this->adj_p2e(pid)) this->edge_data(eid).label = sid;
         }
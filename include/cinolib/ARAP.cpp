@@ -35,6 +35,9 @@
 *********************************************************************************/
 #include <cinolib/ARAP.h>
 #include <cinolib/parallel_for.h>
+#include <cinolib/geometry/point_utils.h>
+#include <algorithm>
+#include <iterator>
 
 namespace cinolib
 {
@@ -115,8 +118,49 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         }
         data.A = Eigen::SparseMatrix<double>(size, (data.use_soft_constraints) ? m.num_verts() : size);
         data.A.setFromTriplets(entries.begin(), entries.end());
-        if(data.use_soft_constraints) data.cache.derived().compute(data.A.transpose()*data.W.asDiagonal()*data.A);
-        else data.cache.derived().compute(data.A);
+        if(data.use_soft_constraints)
+        {
+            // each soft constraint adds w_constr * e_v * e_v^T to the normal equations,
+            // hence if the rest of the operator did not change, the previous factorization
+            // can be updated for the handles that were added or removed
+            FactorizationKey key;
+            key.op             = "ARAP";
+            key.laplacian_mode = data.w_type;
+            key.params         = { data.w_laplace, data.w_constr };
+            key.topology       = mesh_topology_fingerprint(m);
+            key.geometry       = (data.w_type==UNIFORM) ? 0 : mesh_geometry_fingerprint(m);
+
+            std::set<uint> bcs;
+            for(const auto & bc : data.bcs) bcs.insert(bc.first);
+            std::vector<uint> added, removed;
+            std::set_difference(bcs.begin(), bcs.end(), data.cache_bcs.begin(), data.cache_bcs.end(), std::back_inserter(added));
+            std::set_difference(data.cache_bcs.begin(), data.cache_bcs.end(), bcs.begin(), bcs.end(), std::back_inserter(removed));
+
+            bool updated = data.cache                                             &&
+                           data.cache_key.op             == key.op                &&
+                           data.cache_key.laplacian_mode == key.laplacian_mode    &&
+                           data.cache_key.params         == key.params            &&
+                           data.cache_key.topology       == key.topology          &&
+                           data.cache_key.geometry       == key.geometry          &&
+                           added.size()+removed.size()   <= data.max_rank_updates;
+            if(updated)
+            {
+                auto factor = std::make_shared<FactorizationCache::Solver>(*data.cache);
+                Eigen::SparseVector<double> e(m.num_verts());
+                for(uint k=0; updated && k<added.size()+removed.size(); ++k)
+                {
+                    bool add = k<added.size();
+                    e.setZero();
+                    e.insert(add ? added.at(k) : removed.at(k-added.size())) = std::sqrt(data.w_constr);
+                    updated = factor->rank_update(e, add ? 1.0 : -1.0);
+                }
+                if(updated) data.cache = factor;
+            }
+            if(!updated) data.cache = data.factorizations.factorization(data.A.transpose()*data.W.asDiagonal()*data.A);
+            data.cache_key = key;
+            data.cache_bcs = bcs;
+        }
+        else data.cache = data.factorizations.factorization(data.A);
 
         if(data.warm_start_with_laplacian)
         {
@@ -145,9 +189,9 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
             }
             if(data.use_soft_constraints)
             {
-                auto x = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_x).eval();
-                auto y = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_y).eval();
-                auto z = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_z).eval();
+                auto x = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_x).eval();
+                auto y = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_y).eval();
+                auto z = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_z).eval();
                 data.xyz_out.resize(m.num_verts());
                 for(uint vid=0; vid<m.num_verts(); ++vid)
                 {
@@ -156,9 +200,9 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
             }
             else
             {
-                auto x = data.cache.solve(rhs_x).eval();
-                auto y = data.cache.solve(rhs_y).eval();
-                auto z = data.cache.solve(rhs_z).eval();
+                auto x = data.cache->solve(rhs_x).eval();
+                auto y = data.cache->solve(rhs_y).eval();
+                auto z = data.cache->solve(rhs_z).eval();
                 data.xyz_out.resize(m.num_verts());
                 for(uint vid=0; vid<m.num_verts(); ++vid)
                 {
@@ -173,7 +217,7 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         }
         else
         {
-            data.xyz_out = m.vector_verts();
+            data.xyz_out = points_as_vec3d(m.vector_verts());
             for(const auto & bc : data.bcs) data.xyz_out.at(bc.first) = bc.second;
         }
     };
@@ -247,9 +291,9 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
                 rhs_z[new_row] = bc.second.z();
                 ++new_row;
             }
-            auto x = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_x).eval();
-            auto y = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_y).eval();
-            auto z = data.cache.solve(data.A.transpose()*data.W.asDiagonal()*rhs_z).eval();
+            auto x = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_x).eval();
+            auto y = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_y).eval();
+            auto z = data.cache->solve(data.A.transpose()*data.W.asDiagonal()*rhs_z).eval();
             for(uint vid=0; vid<m.num_verts(); ++vid)
             {
                 data.xyz_out[vid] = vec3d(x[vid],y[vid],z[vid]);
@@ -257,9 +301,9 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         }
         else
         {
-            auto x = data.cache.solve(rhs_x).eval();
-            auto y = data.cache.solve(rhs_y).eval();
-            auto z = data.cache.solve(rhs_z).eval();
+            auto x = data.cache->solve(rhs_x).eval();
+            auto y = data.cache->solve(rhs_y).eval();
+            auto z = data.cache->solve(rhs_z).eval();
             for(uint vid=0; vid<m.num_verts(); ++vid)
             {
                 int col = data.col_map[vid];
@@ -282,7 +326,7 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         global_step();
     }
 
-    m.vector_verts() = data.xyz_out;
+    m.vector_verts().assign(data.xyz_out.begin(), data.xyz_out.end());
     m.update_normals();
 }
 
@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/trimesh.h>
 #include <cinolib/linear_solvers.h>
+#include <set>
 
 namespace cinolib
 {
@@ -64,7 +65,15 @@ struct ARAP_data
     std::vector<double> w;       // edge weights { UNIFORM, COTANGENT }
     int w_type = UNIFORM;        // WARNING: cot weights seem rather unstable on volume meshes in interactive deformations
 
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> cache; // factorized matrix
+    // factorized matrix. Re-initializing with the same mesh and constrained vertices
+    // (e.g. when only the positions of the handles change) does not refactorize it.
+    // With soft constraints, adding or removing a few handles updates the current
+    // factorization with rank one updates (see updatable_ldlt.h)
+    FactorizationCache  factorizations;
+    FactorizationHandle cache;            // usable as a solver (cache.solve(b)) or as a pointer to it
+    FactorizationKey    cache_key;        // mesh and weights the factorization refers to
+    std::set<uint>      cache_bcs;        // soft constraints the factorization refers to
+    uint                max_rank_updates = 64;
 
     // In my experience replacing hard with soft constraints works
     // much better for interactive shape deformation (no artifacts
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/IRLS.h>
 #include <cinolib/p_norm.h>
+#include <cinolib/updatable_ldlt.h>
 
 namespace cinolib
 {
@@ -62,8 +63,56 @@ void solve_IRLS(const Eigen::SparseMatrix<double> & A,
                 const double conv_thresh,
                 const int    solver)
 {
-    Eigen::VectorXd w(A.rows());
-    for(int i=0; i<A.rows(); ++i) w[i] = 1.0;
+    Eigen::VectorXd w = Eigen::VectorXd::Ones(A.rows());
+
+    // direct solvers: factors of the normal equations, updated across iterations
+    bool direct = (solver==SIMPLICIAL_LLT || solver==SIMPLICIAL_LDLT);
+    Eigen::SparseMatrix<double> At = A.transpose();
+    Eigen::VectorXd             w_factor; // weights the factors currently refer to
+    UpdatableLDLT               factor;
+
+    // weighted least squares, for the current weights
+    auto minimize_L2 = [&]()
+    {
+        if(!direct)
+        {
+            solve_weighted_least_squares(A, w, b, x, solver, true);
+            return;
+        }
+
+        Eigen::SparseMatrix<double> AtWA = At * w.asDiagonal() * A;
+        Eigen::VectorXd             AtWb = At * w.asDiagonal() * b;
+
+        // rows whose weight changed by more than 10% are updated in the factors,
+        // the others are accounted for by the CG iterations
+        std::vector<int> changed;
+        if(w_factor.size()>0)
+        {
+            for(int i=0; i<A.rows(); ++i)
+            {
+                if(std::fabs(w[i]-w_factor[i]) > 0.1*w_factor[i]) changed.push_back(i);
+            }
+        }
+
+        bool refactorize = (w_factor.size()==0 || (Eigen::Index)changed.size() > std::max(A.cols()/20, Eigen::Index(1)));
+        for(uint k=0; !refactorize && k<changed.size(); ++k)
+        {
+            int    i     = changed[k];
+            double delta = w[i] - w_factor[i];
+            Eigen::SparseVector<double> a = At.col(i) * std::sqrt(std::fabs(delta));
+            refactorize = !factor.rank_update(a, (delta>0) ? 1.0 : -1.0);
+            w_factor[i] = w[i];
+        }
+
+        if(refactorize)
+        {
+            if(w_factor.size()==0) factor.analyzePattern(AtWA);
+            factor.factorize(AtWA);
+            w_factor = w;
+            x = factor.solve(AtWb);
+        }
+        else solve_PCG(AtWA, factor, AtWb, x, {}, 1e-10);
+    };
 
     double res      = 0;
     double prev_res = 0;
@@ -73,19 +122,20 @@ void solve_IRLS(const Eigen::SparseMatrix<double> & A,
         prev_res = res;
 
         // minimize L2
-        solve_weighted_least_squares(A, w, b, x, solver);
+        minimize_L2();
 
-        // update weights
+        // update weights. They are not normalized: the minimizer does not depend
+        // on their scale, and rows whose residual did not change keep their weight
+        Eigen::VectorXd r = b - A*x;
         for(int i=0; i<A.rows(); ++i)
         {
-            double e = std::fabs(b[i] - A.row(i)*x);
+            double e = std::fabs(r[i]);
             w[i] = std::min(std::pow(e, p-2.0), 1000.0);
         }
-        w.normalize();
 
         if(max_iter>0 && ++iter>max_iter) return;
 
-        res = p_norm(b - A*x, A.rows(), p);
+        res = p_norm(r, A.rows(), p);
         //std::cout << "res: " << res << "\tdelta: " << std::fabs(res-prev_res) << std::endl;
     }
     while(std::fabs(res-prev_res)>conv_thresh);
@@ -54,6 +54,15 @@ namespace cinolib
  * C. Sidney Burrus
  * and
  * https://en.wikipedia.org/wiki/Iteratively_reweighted_least_squares
+ *
+ * Subsequent iterations solve similar systems. With direct solvers
+ * (SIMPLICIAL_LLT, SIMPLICIAL_LDLT) the Cholesky factors of the normal
+ * equations are computed once, and then updated with rank one updates for
+ * the rows whose weight changed significantly (see updatable_ldlt.h). The
+ * factors are used to precondition a CG, warm started with the solution of
+ * the previous iteration, which converges in a few steps. If too many
+ * weights change, the matrix is factorized again, reusing the symbolic
+ * analysis. Iterative solvers are warm started as well.
 */
 
 CINO_INLINE
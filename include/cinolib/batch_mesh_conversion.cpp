@@ -0,0 +1,315 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/batch_mesh_conversion.h>
+#include <cinolib/io/read_write_IOData.h>
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/geometry/point_utils.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <mutex>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void BatchConversionStats::print() const
+{
+    auto print_stage = [](const char * name, const Stage & s)
+    {
+        double mb = double(s.bytes)/(1024.0*1024.0);
+        std::cout << "  " << name << "\t" << s.files << " files\t" << mb << " MB\t" << s.seconds << "s";
+        if(s.seconds>0) std::cout << "\t(" << s.files/s.seconds << " files/s, " << mb/s.seconds << " MB/s per thread)";
+        std::cout << std::endl;
+    };
+    std::cout << "batch conversion: " << write.files << " converted, " << failed << " failed [" << wall_seconds << "s]" << std::endl;
+    print_stage("read ", read);
+    print_stage("build", build);
+    print_stage("write", write);
+    std::cout << "  peak memory (estimated) " << double(peak_memory)/(1024.0*1024.0) << " MB" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+CINO_INLINE
+size_t batch_file_size(const std::string & filename)
+{
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if(!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return (size>0) ? size_t(size) : 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool batch_is_surface_format(const std::string & filename)
+{
+    std::string ext = get_file_extension(filename);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext=="off" || ext=="obj" || ext=="stl" || ext=="ply";
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// records which attributes are in data (before data is moved into a mesh)
+//
+struct BatchAttributes
+{
+    bool vert_colors, vert_labels, poly_colors, poly_labels, vert_uvw;
+
+    explicit BatchAttributes(const IOData & data)
+    : vert_colors(!data.vert_colors.empty())
+    , vert_labels(!data.vert_labels.empty())
+    , poly_colors(!data.poly_colors.empty())
+    , poly_labels(!data.poly_labels.empty())
+    , vert_uvw   (!data.vert_uvw.empty())
+    {}
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exports the attributes that were originally in data
+//
+template<class Mesh>
+CINO_INLINE
+void batch_export_attributes(const Mesh & m, const BatchAttributes & attr, IOData & out)
+{
+    if(attr.vert_colors) out.vert_colors = m.vector_vert_colors();
+    if(attr.vert_labels) out.vert_labels = m.vector_vert_labels();
+    if(attr.poly_colors) out.poly_colors = m.vector_poly_colors();
+    if(attr.poly_labels) out.poly_labels = m.vector_poly_labels();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if all the cells have n_faces faces with verts_per_face vertices each.
+// Cells can be either vertex-based (n_verts vertices), or face-based (e.g. .vtu)
+//
+CINO_INLINE
+bool batch_cells_are(const IOData & data, const uint n_verts, const uint n_faces, const uint verts_per_face)
+{
+    if(data.num_polys()==0) return false;
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        if(data.num_faces()==0)
+        {
+            if(data.verts_per_poly(pid)!=n_verts) return false;
+            continue;
+        }
+        if(data.verts_per_poly(pid)!=n_faces) return false;
+        for(uint i=0; i<n_faces; ++i)
+        {
+            if(data.verts_per_face(data.poly(pid)[i])!=verts_per_face) return false;
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// moves data into a mesh (which builds the connectivity), and exports it back
+//
+CINO_INLINE
+void batch_build_connectivity(IOData & data, const bool surface)
+{
+    BatchAttributes attr(data);
+    IOData out;
+
+    if(surface)
+    {
+        Polygonmesh<> m(std::move(data));
+        batch_export_attributes(m, attr, out);
+        out.verts = points_as_vec3d(m.vector_verts());
+        out.set_polys(m.vector_polys());
+        out.vert_normals = m.vector_vert_normals();
+        if(attr.vert_uvw)
+        {
+            out.vert_uvw.resize(m.num_verts());
+            for(uint vid=0; vid<m.num_verts(); ++vid) out.vert_uvw.at(vid) = m.vert_data(vid).uvw;
+        }
+        data = std::move(out);
+        return;
+    }
+
+    if(batch_cells_are(data, 4, 4, 3))
+    {
+        Tetmesh<> m(std::move(data));
+        batch_export_attributes(m, attr, out);
+        out.verts = points_as_vec3d(m.vector_verts());
+        for(uint pid=0; pid<m.num_polys(); ++pid) out.poly_add(m.adj_p2v(pid));
+    }
+    else if(batch_cells_are(data, 8, 6, 4))
+    {
+        Hexmesh<> m(std::move(data));
+        batch_export_attributes(m, attr, out);
+        out.verts = points_as_vec3d(m.vector_verts());
+        for(uint pid=0; pid<m.num_polys(); ++pid) out.poly_add(m.adj_p2v(pid));
+    }
+    else
+    {
+        Polyhedralmesh<> m(std::move(data));
+        batch_export_attributes(m, attr, out);
+        out.verts = points_as_vec3d(m.vector_verts());
+        out.set_faces(m.vector_faces());
+        for(uint pid=0; pid<m.num_polys(); ++pid) out.poly_add(m.adj_p2f(pid), m.poly_faces_winding(pid));
+    }
+    data = std::move(out);
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BatchConversionStats batch_mesh_conversion(const std::vector<BatchConversionJob> & jobs,
+                                           const BatchConversionOptions          & opt)
+{
+    typedef std::chrono::steady_clock clock;
+    auto seconds = [](const clock::time_point & t0, const clock::time_point & t1)
+    {
+        return std::chrono::duration<double>(t1-t0).count();
+    };
+
+    BatchConversionStats    stats;
+    std::mutex              mutex;     // guards stats and memory
+    std::condition_variable memory_cv; // signals released memory
+    size_t                  memory = 0;
+    std::atomic<size_t>     next_job(0);
+
+    auto worker = [&]()
+    {
+        for(size_t i=next_job++; i<jobs.size(); i=next_job++)
+        {
+            const BatchConversionJob & job = jobs.at(i);
+
+            // backpressure: wait until the estimated footprint fits into the budget
+            size_t file_size = batch_file_size(job.input);
+            size_t footprint = size_t(opt.memory_factor*file_size);
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                memory_cv.wait(lock, [&]{ return memory==0 || memory+footprint<=opt.max_memory; });
+                memory += footprint;
+                stats.peak_memory = std::max(stats.peak_memory, memory);
+            }
+            auto release = [&](const bool failed)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                memory -= footprint;
+                if(failed) ++stats.failed;
+                memory_cv.notify_all();
+            };
+
+            // missing and empty files are skipped without even trying to parse them
+            if(file_size==0)
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : batch_mesh_conversion() : couldn't open input file " << job.input << std::endl;
+                release(true);
+                continue;
+            }
+
+            IOData data;
+            clock::time_point t0 = clock::now();
+            bool ok = read_mesh(job.input.c_str(), data);
+            clock::time_point t1 = clock::now();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.read.files   += 1;
+                stats.read.bytes   += file_size;
+                stats.read.seconds += seconds(t0,t1);
+            }
+            if(!ok) { release(true); continue; }
+
+            if(opt.build_connectivity)
+            {
+                // an exception escaping a thread would terminate the whole batch. Meshes
+                // access their elements with at(), so invalid connectivity (e.g. duplicated
+                // faces) throws rather than crashing
+                t0 = clock::now();
+                try
+                {
+                    batch_build_connectivity(data, batch_is_surface_format(job.input));
+                }
+                catch(const std::exception & e)
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : batch_mesh_conversion() : couldn't build mesh " << job.input << " (" << e.what() << ")" << std::endl;
+                    release(true);
+                    continue;
+                }
+                t1 = clock::now();
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.build.files   += 1;
+                stats.build.seconds += seconds(t0,t1);
+            }
+
+            t0 = clock::now();
+            ok = write_mesh(job.output.c_str(), data);
+            t1 = clock::now();
+            if(ok)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.write.files   += 1;
+                stats.write.bytes   += batch_file_size(job.output);
+                stats.write.seconds += seconds(t0,t1);
+            }
+            release(!ok);
+        }
+    };
+
+    // the locale is global: make sure it is set before the threads start
+    use_dot_as_decimal_separator();
+
+    clock::time_point t0 = clock::now();
+    std::vector<std::thread> threads;
+    uint n_threads = std::max(1u, std::min(opt.n_threads, uint(jobs.size())));
+    for(uint t=0; t<n_threads; ++t) threads.emplace_back(worker);
+    for(auto & t : threads) t.join();
+    stats.wall_seconds = seconds(t0, clock::now());
+
+    return stats;
+}
+
+}
@@ -0,0 +1,118 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BATCH_MESH_CONVERSION_H
+#define CINO_BATCH_MESH_CONVERSION_H
+
+#include <sys/types.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Converts a list of mesh files with a pool of threads. Each thread picks the next
+ * job from the list and carries it out as a whole: read (read_mesh), connectivity
+ * building (the data is moved into a mesh of the proper type, and then exported
+ * back), and write (write_mesh). There are no separate queues for the stages: the
+ * overlap between reading, building and writing comes from different threads being
+ * at different points of their own jobs.
+ *
+ * Memory is kept under control by estimating the footprint of each mesh as a
+ * multiple of its file size: a thread does not start a new job until the
+ * estimated memory of all the meshes in flight fits into the budget (a job is
+ * always started if no other is in flight, even if it exceeds the budget).
+ *
+ * Jobs whose input file cannot be opened or parsed (readers reject truncated or
+ * malformed files, and elements referring to missing vertices), whose mesh cannot
+ * be built, or whose formats are not supported, are skipped and counted as failed.
+ * Other jobs are not affected. Per stage statistics (number of
+ * files, bytes and time accumulated over all the threads) are returned, to measure
+ * the throughput.
+*/
+
+struct BatchConversionJob
+{
+    std::string input;
+    std::string output;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct BatchConversionOptions
+{
+    uint   n_threads          = std::max(1u, std::thread::hardware_concurrency());
+    size_t max_memory         = size_t(1) << 31; // memory budget for the meshes in flight (bytes)
+    double memory_factor      = 10.0;            // estimated mesh footprint, as a multiple of its file size
+    bool   build_connectivity = true;            // if false, data goes straight from reader to writer
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct BatchConversionStats
+{
+    struct Stage
+    {
+        uint   files   = 0;
+        size_t bytes   = 0; // size of input files (read), or output files (write)
+        double seconds = 0; // accumulated over all threads
+    };
+
+    Stage  read;
+    Stage  build;
+    Stage  write;
+    uint   failed       = 0;
+    size_t peak_memory  = 0; // max estimated memory in flight
+    double wall_seconds = 0;
+
+    void print() const;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BatchConversionStats batch_mesh_conversion(const std::vector<BatchConversionJob> & jobs,
+                                           const BatchConversionOptions          & opt = BatchConversionOptions());
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "batch_mesh_conversion.cpp"
+#endif
+
+#endif // CINO_BATCH_MESH_CONVERSION_H
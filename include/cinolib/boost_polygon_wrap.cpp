@@ -38,6 +38,8 @@
 
 #ifdef CINOLIB_USES_TRIANGLE
 #include <cinolib/triangle_wrap.h>
+#else
+#include <cinolib/constrained_delaunay.h>
 #endif
 
 namespace cinolib
@@ -243,10 +245,18 @@ void triangulate_polygon(const std::vector<BoostPoint> & poly,
                                std::vector<vec2d>      & verts,
                                std::vector<uint>       & tris)
 {
+#ifndef CINOLIB_USES_TRIANGLE
+    (void)flags; // Triangle flags, no meaning for the builtin CDT
+    std::vector<uint> e;
+    verts.clear();
+    polygon_get_edges(poly, verts, e);
+    constrained_delaunay_triangulation(verts, e, true, tris);
+#else
     std::vector<vec2d> v, h;
     std::vector<uint>  e;
     polygon_get_edges(poly, v, e);
     triangle_wrap(v, e, h, flags, verts, tris);
+#endif
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -257,6 +267,13 @@ void triangulate_polygon(const BoostPolygon            & poly,
                                std::vector<vec2d>      & verts,
                                std::vector<uint>       & tris)
 {
+#ifndef CINOLIB_USES_TRIANGLE
+    (void)flags; // Triangle flags, no meaning for the builtin CDT
+    std::vector<uint> e;
+    verts.clear();
+    polygon_get_edges(poly, verts, e);
+    constrained_delaunay_triangulation(verts, e, true, tris);
+#else
     // find one seed per hole (to robustly clear holes from triangulation)
     std::vector<vec2d> h_seeds;
     for(uint hid=0; hid<poly.inners().size(); ++hid)
@@ -275,6 +292,7 @@ void triangulate_polygon(const BoostPolygon            & poly,
     std::vector<uint>  e;
     polygon_get_edges(poly, v, e);
     triangle_wrap(v, e, h_seeds, flags, verts, tris);
+#endif
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -285,6 +303,13 @@ void triangulate_polygon(const BoostMultiPolygon       & poly,
                                std::vector<vec2d>      & verts,
                                std::vector<uint>       & tris)
 {
+#ifndef CINOLIB_USES_TRIANGLE
+    (void)flags; // Triangle flags, no meaning for the builtin CDT
+    std::vector<uint> e;
+    verts.clear();
+    polygon_get_edges(poly, verts, e);
+    constrained_delaunay_triangulation(verts, e, true, tris);
+#else
     // find one seed per hole (to robustly clear holes from triangulation)
     std::vector<vec2d> h_seeds;
     for(const BoostPolygon & p : poly)
@@ -306,6 +331,7 @@ void triangulate_polygon(const BoostMultiPolygon       & poly,
     std::vector<uint>  e;
     polygon_get_edges(poly, v, e);
     triangle_wrap(v, e, h_seeds, flags, verts, tris);
+#endif
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -148,6 +148,9 @@ namespace cinolib
 
     //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+    // polygons are triangulated with Triangle (see triangle_wrap.h). If CINOLIB_USES_TRIANGLE
+    // is not defined, the built-in constrained Delaunay triangulation is used instead, and
+    // flags are ignored (see constrained_delaunay.h)
     CINO_INLINE
     void triangulate_polygon(const std::vector<BoostPoint> & poly,
                              const std::string               flags,
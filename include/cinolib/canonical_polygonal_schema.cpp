@@ -38,6 +38,7 @@
 #include <cinolib/geometry/n_sided_poygon.h>
 #include <cinolib/harmonic_map.h>
 #include <cinolib/sampling.h>
+#include <cinolib/geometry/point_utils.h>
 
 namespace cinolib
 {
@@ -131,7 +132,7 @@ void canonical_polygonal_schema(      Trimesh<M,V,E,P>  & m_in,
 
     // map the interior vertices
     m_out = m_in;
-    m_out.vector_verts() = harmonic_map_3d(m_in, dirichlet_bcs, 1, laplacian_mode);
+    points_assign(m_out.vector_verts(), harmonic_map_3d(m_in, dirichlet_bcs, 1, laplacian_mode));
     m_out.update_bbox();
     m_out.update_normals();    
 }
@@ -0,0 +1,139 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/concurrent_collector.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+template<typename T>
+CINO_INLINE
+void ConcurrentCollector<T>::push_back(const T & item)
+{
+    local_buffer().push_back(item);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+uint ConcurrentCollector<T>::size() const
+{
+    uint count = 0;
+    for(const auto & b : buffers) count += b.size();
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void ConcurrentCollector<T>::clear()
+{
+    // buffers are not released, as threads may still refer to them
+    for(auto & b : buffers) b.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void ConcurrentCollector<T>::merge(std::vector<T> & out) const
+{
+    out.reserve(out.size() + size());
+    for(const auto & b : buffers) out.insert(out.end(), b.begin(), b.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void ConcurrentCollector<T>::merge_unique(std::vector<T> & out) const
+{
+    out.clear();
+    merge(out);
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+std::vector<T> & ConcurrentCollector<T>::local_buffer()
+{
+    // each thread remembers the last few collectors it pushed into, and its buffer in
+    // each of them, so that loops feeding more than one collector do not take the mutex
+    // at each push. Collectors have unique ids, so a new collector allocated at the
+    // address of a dead one cannot be mistaken for it
+    static const uint CACHE_SIZE = 8;
+    thread_local uint64_t         cached_id [CACHE_SIZE] = {};
+    thread_local std::vector<T> * cached_buf[CACHE_SIZE] = {};
+    thread_local uint             next_slot = 0;
+    for(uint i=0; i<CACHE_SIZE; ++i)
+    {
+        if(cached_id[i]==id) return *cached_buf[i];
+    }
+
+    // cache miss: the thread may still own a buffer here (if its cache entry was evicted)
+    std::vector<T> * buf;
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto it = owners.find(std::this_thread::get_id());
+        if(it!=owners.end()) buf = it->second; else
+        {
+            buffers.emplace_back();
+            buf = &buffers.back();
+            owners[std::this_thread::get_id()] = buf;
+        }
+    }
+    cached_id [next_slot] = id;
+    cached_buf[next_slot] = buf;
+    next_slot = (next_slot+1) % CACHE_SIZE;
+    return *buf;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+uint64_t ConcurrentCollector<T>::next_id()
+{
+    static std::atomic<uint64_t> count(0);
+    return ++count;
+}
+
+}
@@ -0,0 +1,112 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_CONCURRENT_COLLECTOR_H
+#define CINO_CONCURRENT_COLLECTOR_H
+
+#include <cinolib/cino_inline.h>
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cinolib
+{
+
+/* Collects the output of a parallel loop (see parallel_for.h) without serializing
+ * the threads on a mutex. Each thread appends its items to a private buffer, and
+ * all the buffers are merged once the loop is over. Each thread caches its buffers in
+ * the last 8 collectors it used, and the mutex is only taken on a miss in that cache
+ * (e.g. when a thread pushes into a collector for the first time, to create its buffer).
+ *
+ * Example of usage: collect the ids of the polygons that satisfy some condition
+ *
+ * ConcurrentCollector<uint> c;
+ * PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+ * {
+ *     if(condition(pid)) c.push_back(pid);
+ * });
+ * std::vector<uint> pids;
+ * c.merge_unique(pids); // sorted, without duplicates
+ *
+ * Items are stored in per-thread order, hence merge() returns them in no particular
+ * order. Use merge_unique() (which requires T to provide operator<) to get a sorted
+ * and deterministic result, also for items that are detected by more than one thread.
+*/
+
+template<typename T>
+class ConcurrentCollector
+{
+    public:
+
+        explicit ConcurrentCollector() : id(next_id()) {}
+
+        ConcurrentCollector(const ConcurrentCollector &) = delete;
+        ConcurrentCollector & operator=(const ConcurrentCollector &) = delete;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push_back(const T & item); // thread safe
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // not thread safe: call these only once the parallel loop is over
+        uint size() const;
+        void clear();
+        void merge       (std::vector<T> & out) const; // appends all the items to out
+        void merge_unique(std::vector<T> & out) const; // out becomes the sorted set of all the items
+
+    protected:
+
+        std::vector<T> & local_buffer();
+        static uint64_t  next_id();
+
+        const uint64_t                                        id;      // tells collectors apart in the per-thread cache
+        std::mutex                                            mutex;   // guards buffers and owners
+        std::deque<std::vector<T>>                            buffers; // one per thread (deque: no reallocation on push)
+        std::unordered_map<std::thread::id,std::vector<T>*>   owners;  // the buffer of each thread
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "concurrent_collector.cpp"
+#endif
+
+#endif // CINO_CONCURRENT_COLLECTOR_H
@@ -0,0 +1,685 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/constrained_delaunay.h>
+#include <cinolib/predicates.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+
+namespace cinolib
+{
+
+namespace
+{
+
+/* Triangulation with adjacencies. The i-th edge of triangle t goes from tv[3t+i] to
+ * tv[3t+(i+1)%3], tn[3t+i] is the triangle on the other side of it (UINT_MAX along
+ * the convex hull), and tc[3t+i] tells whether the edge is constrained or not
+*/
+
+struct CDTMesh
+{
+    const std::vector<vec2d> & p;
+    std::vector<uint> tv;
+    std::vector<uint> tn;
+    std::vector<char> tc;
+    std::vector<uint> v2t;   // one triangle incident to each vertex
+    std::vector<uint> hnext; // next vertex along the hull, CCW (construction only)
+    std::vector<uint> hprev; // previous vertex along the hull, CCW (construction only)
+    std::vector<uint> htri;  // triangle incident to the hull edge leaving each vertex (construction only)
+    std::vector<char> mark;  // scratch flags for the triangles in a cavity
+    std::minstd_rand  rng;   // insertion order and point location (default seed)
+
+    struct FanEdge { uint x, y, n; char c; };
+
+    explicit CDTMesh(const std::vector<vec2d> & p) : p(p), v2t(p.size(), UINT_MAX) {}
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    uint num_tris() const { return tv.size()/3; }
+
+    uint vert(const uint t, const uint i) const { return tv[3*t+i%3]; }
+
+    uint edge(const uint t, const uint a, const uint b) const
+    {
+        for(uint i=0; i<3; ++i) if(tv[3*t+i]==a && tv[3*t+(i+1)%3]==b) return i;
+        return UINT_MAX;
+    }
+
+    uint index(const uint t, const uint v) const
+    {
+        for(uint i=0; i<3; ++i) if(tv[3*t+i]==v) return i;
+        return UINT_MAX;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    void set_tri(const uint t, const uint a, const uint b, const uint c)
+    {
+        tv[3*t  ] = a;
+        tv[3*t+1] = b;
+        tv[3*t+2] = c;
+        v2t[a] = v2t[b] = v2t[c] = t;
+    }
+
+    uint add_tri(const uint a, const uint b, const uint c)
+    {
+        uint t = num_tris();
+        tv.resize(tv.size()+3);
+        tn.resize(tn.size()+3, UINT_MAX);
+        tc.resize(tc.size()+3, 0);
+        set_tri(t, a, b, c);
+        return t;
+    }
+
+    // makes n the triangle across the i-th edge of t (and vice versa)
+    void link(const uint t, const uint i, const uint n, const char constr)
+    {
+        tn[3*t+i] = n;
+        tc[3*t+i] = constr;
+        if(n==UINT_MAX) return;
+        uint j = edge(n, vert(t,i+1), vert(t,i));
+        assert(j!=UINT_MAX);
+        tn[3*n+j] = t;
+        tc[3*n+j] = constr;
+    }
+
+    void set_constrained(const uint t, const uint i)
+    {
+        tc[3*t+i] = 1;
+        uint n = tn[3*t+i];
+        if(n!=UINT_MAX) tc[3*n+edge(n, vert(t,i+1), vert(t,i))] = 1;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // flips the i-th edge (a,b) of t=(a,b,c), where u=(b,a,d) is the triangle
+    // on the other side of it. Results in t=(a,d,c) and u=(d,b,c). Returns u
+    uint flip(const uint t, const uint i)
+    {
+        uint u = tn[3*t+i];
+        uint j = edge(u, vert(t,i+1), vert(t,i));
+        uint a = vert(t,i);
+        uint b = vert(t,i+1);
+        uint c = vert(t,i+2);
+        uint d = vert(u,j+2);
+        uint n_bc = tn[3*t+(i+1)%3], n_ca = tn[3*t+(i+2)%3];
+        uint n_ad = tn[3*u+(j+1)%3], n_db = tn[3*u+(j+2)%3];
+        char c_bc = tc[3*t+(i+1)%3], c_ca = tc[3*t+(i+2)%3];
+        char c_ad = tc[3*u+(j+1)%3], c_db = tc[3*u+(j+2)%3];
+        set_tri(t, a, d, c);
+        set_tri(u, d, b, c);
+        tn[3*t+1] = u; tc[3*t+1] = 0;
+        tn[3*u+2] = t; tc[3*u+2] = 0;
+        link(t, 0, n_ad, c_ad);
+        link(t, 2, n_ca, c_ca);
+        link(u, 0, n_db, c_db);
+        link(u, 1, n_bc, c_bc);
+        if(!htri.empty())
+        {
+            if(n_bc==UINT_MAX) htri[b] = u;
+            if(n_ad==UINT_MAX) htri[a] = t;
+        }
+        return u;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // Lawson flips, starting from the i-th edge of t. Flipped edges are
+    // always opposite to the last vertex of t, that is, the new point
+    void legalize(const uint t, const uint i)
+    {
+        std::vector<std::pair<uint,uint>> stack(1, std::make_pair(t,i));
+        while(!stack.empty())
+        {
+            uint tt = stack.back().first;
+            uint ii = stack.back().second;
+            stack.pop_back();
+            uint u = tn[3*tt+ii];
+            if(u==UINT_MAX || tc[3*tt+ii]) continue;
+            uint j = edge(u, vert(tt,ii+1), vert(tt,ii));
+            if(incircle(p[vert(tt,ii)], p[vert(tt,ii+1)], p[vert(tt,ii+2)], p[vert(u,j+2)])<=0) continue;
+            u = flip(tt,ii);
+            stack.push_back(std::make_pair(tt,0));
+            stack.push_back(std::make_pair(u,0));
+        }
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // replaces the triangles in old (whose ids are reused) with a fan of triangles (x,y,q),
+    // one for each edge in bnd. Edges are listed CCW around q, each one starting where the
+    // previous one ends. If the fan is open, q becomes a hull vertex, between the end of the
+    // last edge and the beginning of the first one. The new triangles are then legalized
+    void fan(const uint q, const std::vector<FanEdge> & bnd, const std::vector<uint> & old, const bool closed)
+    {
+        std::vector<uint> ft(bnd.size());
+        for(uint k=0; k<bnd.size(); ++k)
+        {
+            if(k<old.size())
+            {
+                ft[k] = old[k];
+                set_tri(ft[k], bnd[k].x, bnd[k].y, q);
+            }
+            else ft[k] = add_tri(bnd[k].x, bnd[k].y, q);
+        }
+        for(uint k=0; k<bnd.size(); ++k)
+        {
+            link(ft[k], 0, bnd[k].n, bnd[k].c);
+            if(bnd[k].n==UINT_MAX) htri[bnd[k].x] = ft[k];
+            if(k+1<bnd.size()) link(ft[k], 1, ft[k+1], 0); else
+            if(closed)         link(ft[k], 1, ft[0],   0);
+        }
+        if(!closed)
+        {
+            uint l = bnd.back().y;
+            uint r = bnd.front().x;
+            link(ft.back(),  1, UINT_MAX, 0);
+            link(ft.front(), 2, UINT_MAX, 0);
+            hnext[l] = q; hprev[q] = l; htri[l] = ft.back();
+            hnext[q] = r; hprev[r] = q; htri[q] = ft.front();
+        }
+        for(uint t : ft) legalize(t, 0);
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // remembering stochastic walk from triangle t towards q (Devillers et al., 2002).
+    // Returns true if q is inside t, where i is the edge of t that contains q, if any.
+    // Returns false if q is outside the hull, where i is a hull edge of t that q sees
+    bool walk(const uint q, uint & t, uint & i)
+    {
+        uint from  = UINT_MAX;
+        uint steps = 0;
+        while(true)
+        {
+            uint k0   = rng()%3;
+            uint next = UINT_MAX;
+            i = UINT_MAX;
+            for(uint k=0; k<3; ++k)
+            {
+                uint e = (k0+k)%3;
+                if(from!=UINT_MAX && tn[3*t+e]==from) continue; // q is on this side of it
+                double o = orient2d(p[vert(t,e)], p[vert(t,e+1)], p[q]);
+                if(o<0) { next = e; break; }
+                if(o==0) i = e;
+            }
+            if(next==UINT_MAX) return true;
+            if(tn[3*t+next]==UINT_MAX) { i = next; return false; }
+            from = t;
+            t    = tn[3*t+next];
+            if(++steps>num_tris()) return scan(q, t, i);
+        }
+    }
+
+    // linear time fallback of walk(), in case rounding errors make it cycle
+    // (that is, if CINOLIB_USES_SHEWCHUK_PREDICATES is not defined)
+    bool scan(const uint q, uint & t, uint & i) const
+    {
+        for(t=0; t<num_tris(); ++t)
+        {
+            bool inside = true;
+            i = UINT_MAX;
+            for(uint e=0; e<3 && inside; ++e)
+            {
+                double o = orient2d(p[vert(t,e)], p[vert(t,e+1)], p[q]);
+                if(o<0) inside = false; else if(o==0) i = e;
+            }
+            if(inside) return true;
+        }
+        for(t=0; t<num_tris(); ++t)
+        for(i=0; i<3; ++i)
+        {
+            if(tn[3*t+i]==UINT_MAX && orient2d(p[vert(t,i)], p[vert(t,i+1)], p[q])<0) return false;
+        }
+        assert(false);
+        t = i = 0;
+        return true;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // inserts vertex q in the Delaunay triangulation, searching for it from triangle t
+    void insert_vertex(const uint q, uint t)
+    {
+        uint i;
+        std::vector<FanEdge> bnd;
+        if(!walk(q, t, i))
+        {
+            // q is outside the hull: connect it to the chain of hull edges it sees
+            uint L = vert(t,i);
+            uint R = L;
+            while(orient2d(p[hprev[L]], p[L], p[q])<0) L = hprev[L];
+            while(orient2d(p[R], p[hnext[R]], p[q])<0) R = hnext[R];
+            assert(L!=R);
+            for(uint v=R; v!=L; v=hprev[v]) bnd.push_back({ v, hprev[v], htri[hprev[v]], 0 });
+            fan(q, bnd, {}, false);
+            return;
+        }
+        if(i==UINT_MAX) // strictly inside t: split it in three
+        {
+            for(uint e=0; e<3; ++e) bnd.push_back({ vert(t,e), vert(t,e+1), tn[3*t+e], tc[3*t+e] });
+            fan(q, bnd, {t}, true);
+            return;
+        }
+        // on edge (a,b) of t=(a,b,c): split t, and the triangle u=(b,a,d) across the edge
+        uint a = vert(t,i);
+        uint b = vert(t,i+1);
+        uint c = vert(t,i+2);
+        uint u = tn[3*t+i];
+        bnd.push_back({ b, c, tn[3*t+(i+1)%3], tc[3*t+(i+1)%3] });
+        bnd.push_back({ c, a, tn[3*t+(i+2)%3], tc[3*t+(i+2)%3] });
+        if(u==UINT_MAX) // hull edge
+        {
+            fan(q, bnd, {t}, false);
+            return;
+        }
+        uint j = edge(u, b, a);
+        uint d = vert(u,j+2);
+        bnd.push_back({ a, d, tn[3*u+(j+1)%3], tc[3*u+(j+1)%3] });
+        bnd.push_back({ d, b, tn[3*u+(j+2)%3], tc[3*u+(j+2)%3] });
+        fan(q, bnd, {t,u}, true);
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // Delaunay triangulation of the given (distinct) vertices. Vertices are inserted in a
+    // biased randomized insertion order (Amenta et al., 2003): rounds of doubling size,
+    // each one sorted along a Hilbert curve, so that the walk from the previous vertex is
+    // short. Random insertion keeps the expected number of flips linear for any input,
+    // including those (e.g. convex chains) for which an ordered insertion does O(n^2) flips
+    void delaunay(std::vector<uint> verts)
+    {
+        uint n = verts.size();
+        if(n<3) return;
+        brio_order(verts);
+
+        // first triangle, from the first vertex not aligned with the first two
+        uint k = 2;
+        while(k<n && orient2d(p[verts[0]], p[verts[1]], p[verts[k]])==0) ++k;
+        if(k==n) return;
+        std::swap(verts[2], verts[k]);
+
+        hnext.assign(p.size(), UINT_MAX);
+        hprev.assign(p.size(), UINT_MAX);
+        htri .assign(p.size(), UINT_MAX);
+
+        uint a = verts[0];
+        uint b = verts[1];
+        uint c = verts[2];
+        if(orient2d(p[a], p[b], p[c])<0) std::swap(a,b);
+        add_tri(a, b, c);
+        hnext[a] = b; hprev[b] = a; htri[a] = 0;
+        hnext[b] = c; hprev[c] = b; htri[b] = 0;
+        hnext[c] = a; hprev[a] = c; htri[c] = 0;
+
+        for(uint i=3; i<n; ++i) insert_vertex(verts[i], v2t[verts[i-1]]);
+
+        hnext.clear();
+        hprev.clear();
+        htri.clear();
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    void brio_order(std::vector<uint> & verts)
+    {
+        // fixed seed: the output must not change from run to run
+        std::shuffle(verts.begin(), verts.end(), rng);
+
+        vec2d bmin = p[verts.front()];
+        vec2d bmax = p[verts.front()];
+        for(uint v : verts)
+        {
+            bmin = bmin.min(p[v]);
+            bmax = bmax.max(p[v]);
+        }
+        vec2d delta = bmax - bmin;
+        double s = 65535.0 / std::max(std::max(delta[0], delta[1]), 1e-300);
+        std::vector<uint64_t> key(p.size());
+        for(uint v : verts)
+        {
+            key[v] = hilbert_index((uint)((p[v][0]-bmin[0])*s), (uint)((p[v][1]-bmin[1])*s));
+        }
+
+        std::vector<uint> rounds(1, verts.size());
+        while(rounds.back()>64) rounds.push_back(rounds.back()/2);
+        uint beg = 0;
+        for(auto it=rounds.rbegin(); it!=rounds.rend(); ++it)
+        {
+            std::sort(verts.begin()+beg, verts.begin()+*it, [&](const uint i, const uint j)
+            {
+                return key[i]<key[j];
+            });
+            beg = *it;
+        }
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // position of point (x,y) along a Hilbert curve filling a 2^16 x 2^16 grid
+    static uint64_t hilbert_index(uint x, uint y)
+    {
+        uint64_t d = 0;
+        for(uint s=1u<<15; s>0; s/=2)
+        {
+            uint rx = (x & s)>0;
+            uint ry = (y & s)>0;
+            d += (uint64_t)s * s * ((3*rx)^ry);
+            if(ry==0)
+            {
+                if(rx==1)
+                {
+                    x = 65535 - x;
+                    y = 65535 - y;
+                }
+                std::swap(x,y);
+            }
+        }
+        return d;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // looks around vertex a for the first step of segment (a,b). If there is an edge
+    // (a,v) along the segment, returns v and the edge (t,i). Otherwise, returns
+    // UINT_MAX and the triangle t=(a,x,y) whose edge (x,y) is crossed by the segment,
+    // where i is the position of a in t
+    uint locate(const uint a, const uint b, uint & t, uint & i) const
+    {
+        auto along = [&](const uint v)
+        {
+            return v==b || (orient2d(p[a], p[b], p[v])==0 && (p[v]-p[a]).dot(p[b]-p[a])>0);
+        };
+        for(int dir=0; dir<2; ++dir) // CCW first, then CW if the hull stops the rotation
+        {
+            uint t0 = v2t[a];
+            t = t0;
+            do
+            {
+                i = index(t,a);
+                uint x = vert(t,i+1);
+                uint y = vert(t,i+2);
+                if(along(x)) { return x; }
+                if(along(y)) { i = (i+2)%3; return y; }
+                if(orient2d(p[a], p[b], p[x])<0 && orient2d(p[a], p[b], p[y])>0) return UINT_MAX;
+                t = (dir==0) ? tn[3*t+(i+2)%3] : tn[3*t+i];
+            }
+            while(t!=UINT_MAX && t!=t0);
+            if(t==t0) break;
+        }
+        assert(false);
+        t = UINT_MAX;
+        return UINT_MAX;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // triangulates the pseudo polygon made of edge (x,y) and of the chain of vertices
+    // that goes from y back to x (CCW). Each step picks the vertex whose circle through
+    // x and y is empty, and splits the polygon in two (Anglada, 1997)
+    void fill_pseudo_polygon(const uint x, const uint y, const std::vector<uint> & chain, std::vector<uint> & tris) const
+    {
+        std::vector<std::array<uint,4>> stack(1, std::array<uint,4>{{ x, y, 0, (uint)chain.size() }});
+        while(!stack.empty())
+        {
+            std::array<uint,4> r = stack.back();
+            stack.pop_back();
+            if(r[2]==r[3]) continue;
+            uint c = r[2];
+            for(uint k=r[2]+1; k<r[3]; ++k)
+            {
+                if(incircle(p[r[0]], p[r[1]], p[chain[c]], p[chain[k]])>0) c = k;
+            }
+            tris.push_back(r[0]);
+            tris.push_back(r[1]);
+            tris.push_back(chain[c]);
+            stack.push_back(std::array<uint,4>{{ chain[c], r[1], r[2], c    }});
+            stack.push_back(std::array<uint,4>{{ r[0], chain[c], c+1,  r[3] }});
+        }
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // replaces the triangles crossed by segment (a,e) with a triangulation of the two
+    // sides of it. Right and left are the vertices on the two sides, ordered from a to e
+    void fill_cavity(const uint a, const uint e, const std::vector<uint> & cavity, const std::vector<uint> & right, std::vector<uint> & left)
+    {
+        mark.resize(num_tris(), 0);
+        for(uint t : cavity) mark[t] = 1;
+        std::map<std::pair<uint,uint>,std::pair<uint,char>> bnd;
+        for(uint t : cavity)
+        for(uint i=0; i<3; ++i)
+        {
+            uint n = tn[3*t+i];
+            if(n==UINT_MAX || !mark[n]) bnd[std::make_pair(vert(t,i),vert(t,i+1))] = std::make_pair(n,tc[3*t+i]);
+        }
+        for(uint t : cavity) mark[t] = 0;
+
+        std::vector<uint> tris;
+        fill_pseudo_polygon(e, a, right, tris);
+        std::reverse(left.begin(), left.end());
+        fill_pseudo_polygon(a, e, left, tris);
+        assert(tris.size()==3*cavity.size());
+
+        for(uint k=0; k<cavity.size(); ++k) set_tri(cavity[k], tris[3*k], tris[3*k+1], tris[3*k+2]);
+
+        std::map<std::pair<uint,uint>,std::pair<uint,uint>> open;
+        for(uint t : cavity)
+        for(uint i=0; i<3; ++i)
+        {
+            uint f = vert(t,i);
+            uint g = vert(t,i+1);
+            auto it = bnd.find(std::make_pair(f,g));
+            if(it!=bnd.end())
+            {
+                link(t, i, it->second.first, it->second.second);
+                continue;
+            }
+            auto jt = open.find(std::make_pair(g,f));
+            if(jt==open.end())
+            {
+                open[std::make_pair(f,g)] = std::make_pair(t,i);
+                continue;
+            }
+            uint n = jt->second.first;
+            uint j = jt->second.second;
+            char c = (f==a && g==e) || (f==e && g==a);
+            tn[3*t+i] = n; tc[3*t+i] = c;
+            tn[3*n+j] = t; tc[3*n+j] = c;
+            open.erase(jt);
+        }
+        assert(open.empty());
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // enforces segment (a,b). Returns false if it crosses another constraint
+    bool insert_segment(uint a, const uint b)
+    {
+        std::vector<uint> cavity, right, left;
+        while(a!=b)
+        {
+            uint t, i;
+            uint v = locate(a, b, t, i);
+            if(t==UINT_MAX) return false;
+            if(v!=UINT_MAX)
+            {
+                set_constrained(t, i);
+                a = v;
+                continue;
+            }
+
+            // walk along the segment, collecting the triangles it crosses
+            cavity.assign(1, t);
+            right.assign(1, vert(t,i+1));
+            left.assign (1, vert(t,i+2));
+            uint ci = (i+1)%3; // crossed edge, from right to left
+            uint e = b;
+            while(true)
+            {
+                if(tc[3*t+ci]) return false;
+                uint u = tn[3*t+ci];
+                uint j = edge(u, vert(t,ci+1), vert(t,ci));
+                uint w = vert(u,j+2);
+                cavity.push_back(u);
+                t = u;
+                double o = (w==b) ? 0 : orient2d(p[a], p[b], p[w]);
+                if(o==0) { e = w; break; }
+                if(o>0) { left.push_back(w);  ci = (j+1)%3; }
+                else    { right.push_back(w); ci = (j+2)%3; }
+            }
+            fill_cavity(a, e, cavity, right, left);
+            a = e;
+        }
+        return true;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // triangles inside the constraints according to the even-odd rule: each triangle
+    // gets the smallest number of constrained edges to cross to reach it from outside
+    void output(const bool remove_outside, std::vector<uint> & tris) const
+    {
+        uint nt = num_tris();
+        std::vector<uint> depth(nt, remove_outside ? UINT_MAX : 1);
+        if(remove_outside)
+        {
+            std::deque<uint> q;
+            for(uint t=0; t<nt; ++t)
+            for(uint i=0; i<3; ++i)
+            {
+                if(tn[3*t+i]!=UINT_MAX || (uint)tc[3*t+i]>=depth[t]) continue;
+                depth[t] = tc[3*t+i];
+                if(depth[t]==0) q.push_front(t); else q.push_back(t);
+            }
+            while(!q.empty())
+            {
+                uint t = q.front();
+                q.pop_front();
+                for(uint i=0; i<3; ++i)
+                {
+                    uint n = tn[3*t+i];
+                    if(n==UINT_MAX) continue;
+                    uint d = depth[t] + tc[3*t+i];
+                    if(d>=depth[n]) continue;
+                    depth[n] = d;
+                    if(tc[3*t+i]) q.push_back(n); else q.push_front(n);
+                }
+            }
+        }
+        for(uint t=0; t<nt; ++t)
+        {
+            if(depth[t]%2==0) continue;
+            tris.push_back(tv[3*t  ]);
+            tris.push_back(tv[3*t+1]);
+            tris.push_back(tv[3*t+2]);
+        }
+    }
+};
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void constrained_delaunay_triangulation(const std::vector<vec2d> & verts,
+                                        const std::vector<uint>  & segs,
+                                        const bool                 remove_outside,
+                                              std::vector<uint>  & tris)
+{
+    assert(segs.size()%2==0);
+    tris.clear();
+
+    // merge the coincident vertices (found by sorting them lexicographically)
+    std::vector<uint> order(verts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const uint i, const uint j)
+    {
+        return verts[i][0]<verts[j][0] || (verts[i][0]==verts[j][0] && verts[i][1]<verts[j][1]);
+    });
+    std::vector<uint> rep(verts.size());
+    std::vector<uint> unique_verts;
+    for(uint vid : order)
+    {
+        if(!unique_verts.empty() && verts[vid][0]==verts[unique_verts.back()][0] &&
+                                    verts[vid][1]==verts[unique_verts.back()][1])
+        {
+            rep[vid] = unique_verts.back();
+            continue;
+        }
+        rep[vid] = vid;
+        unique_verts.push_back(vid);
+    }
+
+    CDTMesh m(verts);
+    m.delaunay(unique_verts);
+    if(m.num_tris()==0) return;
+
+    for(uint i=0; i<segs.size(); i+=2)
+    {
+        if(!m.insert_segment(rep.at(segs[i]), rep.at(segs[i+1])))
+        {
+            std::cerr << "WARNING : constrained_delaunay_triangulation() : intersecting segments are not supported" << std::endl;
+        }
+    }
+    m.output(remove_outside, tris);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void constrained_delaunay_triangulation(const std::vector<std::vector<vec2d>> & verts,
+                                        const std::vector<std::vector<uint>>  & segs,
+                                        const bool                              remove_outside,
+                                              std::vector<std::vector<uint>>  & tris)
+{
+    assert(verts.size()==segs.size());
+    tris.resize(verts.size());
+    PARALLEL_FOR(0, verts.size(), 2, [&](uint i)
+    {
+        constrained_delaunay_triangulation(verts.at(i), segs.at(i), remove_outside, tris.at(i));
+    });
+}
+
+}
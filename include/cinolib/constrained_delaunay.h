@@ -0,0 +1,85 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_CONSTRAINED_DELAUNAY_H
+#define CINO_CONSTRAINED_DELAUNAY_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <vector>
+
+namespace cinolib
+{
+
+/* Constrained Delaunay triangulation of a planar straight line graph (PSLG), with no
+ * dependency on external libraries. Points are inserted one by one in a randomized order,
+ * each one located by walking from the previous one, and the Delaunay property is restored
+ * with edge flips (expected O(n log n) time for any input). Each segment is then inserted
+ * by removing the triangles it crosses, and by re-triangulating the two sides of the cavity
+ * it opens. Vertices that lie on a segment split it in two.
+ *
+ * If remove_outside is true, only the triangles inside the polygons described by the
+ * segments are returned, according to the even-odd rule (i.e. holes are carved without
+ * the need of seed points). Otherwise, the whole convex hull is triangulated.
+ *
+ * Output triangles are CCW and refer to the input vertices, no new vertex is ever created.
+ * Coincident input vertices are merged into the first of them, and the others will not be
+ * referenced. Segments crossing each other are not supported (the one inserted last is
+ * not enforced). All the decisions are taken with the orient2d and incircle predicates,
+ * and are therefore exact if the symbol CINOLIB_USES_SHEWCHUK_PREDICATES is defined (see
+ * predicates.h).
+*/
+
+CINO_INLINE
+void constrained_delaunay_triangulation(const std::vector<vec2d> & verts,
+                                        const std::vector<uint>  & segs, // serialized segments
+                                        const bool                 remove_outside,
+                                              std::vector<uint>  & tris);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// triangulates many independent PSLGs (e.g. the slices of a 3D printing job) in parallel
+CINO_INLINE
+void constrained_delaunay_triangulation(const std::vector<std::vector<vec2d>> & verts,
+                                        const std::vector<std::vector<uint>>  & segs,
+                                        const bool                              remove_outside,
+                                              std::vector<std::vector<uint>>  & tris);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "constrained_delaunay.cpp"
+#endif
+
+#endif // CINO_CONSTRAINED_DELAUNAY_H
@@ -0,0 +1,347 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/delta_stepping.h>
+#include <cinolib/dijkstra.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+namespace cinolib
+{
+
+namespace
+{
+
+// the three graphs visited by delta-stepping. for_each_nbr calls f(nbr,w)
+// for each outgoing arc of vid, where w is the arc weight
+
+template<class Mesh>
+struct DS_primal_graph
+{
+    const Mesh & m;
+
+    template<class Func>
+    void for_each_nbr(const uint vid, const Func & f) const
+    {
+        for(uint nbr : m.adj_v2v(vid)) f(nbr, m.vert(vid).dist(m.vert(nbr)));
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+struct DS_srf_graph
+{
+    const Mesh & m;
+
+    template<class Func>
+    void for_each_nbr(const uint vid, const Func & f) const
+    {
+        for(uint eid : m.adj_v2e(vid))
+        {
+            if(!m.edge_is_on_srf(eid)) continue;
+            uint nbr = m.vert_opposite_to(eid,vid);
+            f(nbr, m.vert(vid).dist(m.vert(nbr)));
+        }
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+struct DS_masked_graph
+{
+    const Mesh                & m;
+    const std::vector<double> & weights;
+    const std::vector<bool>   & mask;
+
+    template<class Func>
+    void for_each_nbr(const uint vid, const Func & f) const
+    {
+        for(uint eid : m.adj_v2e(vid))
+        {
+            if(mask.at(eid)) continue;
+            uint nbr = m.vert_opposite_to(eid,vid);
+            f(nbr, weights.at(nbr));
+        }
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits [0,n) into chunks processed in parallel, calling func(chunk,beg,end).
+// Returns the number of chunks (small ranges are processed serially, in one chunk)
+template<class Func>
+CINO_INLINE
+uint DS_parallel_chunks(const uint n, const uint max_chunks, const Func & func)
+{
+    uint n_chunks = (n<1024) ? 1 : std::min(max_chunks, n);
+    if(n_chunks==1)
+    {
+        func(0, 0, n);
+        return 1;
+    }
+    PARALLEL_FOR(0, n_chunks, 2, [&](uint c)
+    {
+        func(c, uint(size_t(n)*c/n_chunks), uint(size_t(n)*(c+1)/n_chunks));
+    });
+    return n_chunks;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Graph>
+CINO_INLINE
+void delta_stepping(const Graph               & g,
+                    const uint                  nv,
+                    const std::vector<uint>   & sources,
+                          std::vector<double> & dist,
+                          double                delta)
+{
+    const uint NONE       = uint(-1);
+    const uint max_chunks = 4 * std::max(1u, std::thread::hardware_concurrency());
+
+    // tentative distances, lowered concurrently with an atomic min
+    std::unique_ptr<std::atomic<double>[]> d(new std::atomic<double>[nv]);
+    PARALLEL_FOR(0, nv, 10000, [&](uint vid)
+    {
+        d[vid].store(inf_double, std::memory_order_relaxed);
+    });
+
+    if(delta<=0)
+    {
+        std::vector<double> sum(max_chunks, 0);
+        std::vector<size_t> count(max_chunks, 0);
+        DS_parallel_chunks(nv, max_chunks, [&](uint c, uint beg, uint end)
+        {
+            for(uint vid=beg; vid<end; ++vid)
+            {
+                g.for_each_nbr(vid, [&](uint, double w){ sum[c] += w; ++count[c]; });
+            }
+        });
+        double tot_sum   = std::accumulate(sum.begin(), sum.end(), 0.0);
+        size_t tot_count = std::accumulate(count.begin(), count.end(), size_t(0));
+        delta = (tot_count>0 && tot_sum>0) ? 2.0*tot_sum/tot_count : 1.0;
+    }
+
+    // buckets are lazy: a vertex may appear in more than one bucket, but
+    // only the entry in bucket in_bucket[v] is valid
+    std::vector<std::vector<uint>> buckets;
+    std::vector<uint> in_bucket(nv, NONE);
+    auto bucket_insert = [&](const uint vid)
+    {
+        uint b = uint(d[vid].load(std::memory_order_relaxed)/delta);
+        if(in_bucket.at(vid)==b) return;
+        in_bucket.at(vid) = b;
+        if(b>=buckets.size()) buckets.resize(b+1);
+        buckets.at(b).push_back(vid);
+    };
+
+    // relaxes the light (or heavy) arcs leaving the vertices in list, and
+    // moves the vertices whose distance improved to their new bucket
+    std::vector<std::vector<uint>> improved(max_chunks);
+    auto relax = [&](const std::vector<uint> & list, const bool light)
+    {
+        uint n_chunks = DS_parallel_chunks(list.size(), max_chunks, [&](uint c, uint beg, uint end)
+        {
+            improved.at(c).clear();
+            for(uint i=beg; i<end; ++i)
+            {
+                uint   vid = list[i];
+                double dv  = d[vid].load(std::memory_order_relaxed);
+                g.for_each_nbr(vid, [&](uint nbr, double w)
+                {
+                    if(light != (w<=delta)) return;
+                    double new_dist = dv + w;
+                    double old_dist = d[nbr].load(std::memory_order_relaxed);
+                    while(new_dist < old_dist)
+                    {
+                        if(d[nbr].compare_exchange_weak(old_dist, new_dist, std::memory_order_relaxed))
+                        {
+                            improved.at(c).push_back(nbr);
+                            break;
+                        }
+                    }
+                });
+            }
+        });
+        for(uint c=0; c<n_chunks; ++c)
+        {
+            for(uint vid : improved.at(c)) bucket_insert(vid);
+        }
+    };
+
+    for(uint vid : sources)
+    {
+        d[vid].store(0.0, std::memory_order_relaxed);
+        bucket_insert(vid);
+    }
+
+    std::vector<uint> settled_in(nv, NONE);
+    std::vector<uint> frontier, settled;
+    for(uint i=0; i<buckets.size(); ++i)
+    {
+        settled.clear();
+        while(!buckets.at(i).empty())
+        {
+            frontier.clear();
+            std::swap(frontier, buckets.at(i));
+
+            // drop stale entries and duplicates. Vertices can re-enter the
+            // bucket if relaxing light arcs lowers their distance again
+            uint k = 0;
+            for(uint vid : frontier)
+            {
+                if(in_bucket.at(vid)!=i) continue;
+                in_bucket.at(vid) = NONE;
+                frontier.at(k++) = vid;
+                if(settled_in.at(vid)!=i)
+                {
+                    settled_in.at(vid) = i;
+                    settled.push_back(vid);
+                }
+            }
+            frontier.resize(k);
+            relax(frontier, true);
+        }
+        relax(settled, false);
+    }
+
+    dist.resize(nv);
+    PARALLEL_FOR(0, nv, 10000, [&](uint vid)
+    {
+        dist[vid] = d[vid].load(std::memory_order_relaxed);
+    });
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void delta_stepping_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                               const std::vector<uint>     & sources,
+                                     std::vector<double>   & dist,
+                               const double                  delta)
+{
+    DS_primal_graph<AbstractMesh<M,V,E,P>> g = { m };
+    delta_stepping(g, m.num_verts(), sources, dist, delta);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void delta_stepping_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                        const std::vector<uint>                 & sources,
+                                              std::vector<double>               & dist,
+                                        const double                              delta)
+{
+    DS_srf_graph<AbstractPolyhedralMesh<M,V,E,F,P>> g = { m };
+    delta_stepping(g, m.num_verts(), sources, dist, delta);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void delta_stepping_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
+                                             const std::vector<uint>     & sources,
+                                             const std::vector<double>   & weights,
+                                             const std::vector<bool>     & mask,
+                                                   std::vector<double>   & dist,
+                                             const double                  delta)
+{
+    DS_masked_graph<AbstractMesh<M,V,E,P>> g = { m, weights, mask };
+    delta_stepping(g, m.num_verts(), sources, dist, delta);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_paths_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                               const std::vector<uint>     & sources,
+                                     std::vector<double>   & dist,
+                               const SSSPMethod              method)
+{
+    switch(method)
+    {
+        case SSSP_DIJKSTRA       : dijkstra_exhaustive(m, sources, dist);       break;
+        case SSSP_DELTA_STEPPING : delta_stepping_exhaustive(m, sources, dist); break;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void shortest_paths_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                        const std::vector<uint>                 & sources,
+                                              std::vector<double>               & dist,
+                                        const SSSPMethod                          method)
+{
+    switch(method)
+    {
+        case SSSP_DIJKSTRA       : dijkstra_exhaustive_srf_only(m, sources, dist);       break;
+        case SSSP_DELTA_STEPPING : delta_stepping_exhaustive_srf_only(m, sources, dist); break;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_paths_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
+                                             const std::vector<uint>     & sources,
+                                             const std::vector<double>   & weights,
+                                             const std::vector<bool>     & mask,
+                                                   std::vector<double>   & dist,
+                                             const SSSPMethod              method)
+{
+    switch(method)
+    {
+        case SSSP_DIJKSTRA       : dijkstra_exhaustive_mask_on_edges(m, sources, weights, mask, dist);       break;
+        case SSSP_DELTA_STEPPING : delta_stepping_exhaustive_mask_on_edges(m, sources, weights, mask, dist); break;
+    }
+}
+
+}
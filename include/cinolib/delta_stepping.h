@@ -0,0 +1,145 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_DELTA_STEPPING_H
+#define CINO_DELTA_STEPPING_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/meshes/abstract_polyhedralmesh.h>
+
+namespace cinolib
+{
+
+/* Parallel single source shortest paths on the vertex graph of a mesh, with
+ * the delta-stepping algorithm of Meyer and Sanders:
+ *
+ *     U. Meyer, P. Sanders
+ *     Delta-stepping: a parallelizable shortest path algorithm
+ *     Journal of Algorithms, 2003
+ *
+ * Vertices are kept in buckets of width delta, according to their tentative
+ * distance. Buckets are processed in increasing order, and all the vertices in
+ * the current bucket are relaxed in parallel (light edges, not longer than
+ * delta, are relaxed until the bucket empties; heavy edges are relaxed once
+ * at the end). Small deltas do the same work of Dijkstra with little
+ * parallelism, large deltas expose more parallelism but relax vertices more
+ * than once. If delta is zero, it is set to twice the average edge weight.
+ *
+ * Distances are the same computed by the corresponding dijkstra_exhaustive
+ * functions (see dijkstra.h), and unreached vertices have inf_double distance.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void delta_stepping_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                               const std::vector<uint>     & sources,
+                                     std::vector<double>   & dist,
+                               const double                  delta = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void delta_stepping_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                        const std::vector<uint>                 & sources,
+                                              std::vector<double>               & dist,
+                                        const double                              delta = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void delta_stepping_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
+                                             const std::vector<uint>     & sources,
+                                             const std::vector<double>   & weights, // per vert weights (used as metric instead of edge lengths)
+                                             const std::vector<bool>     & mask,    // if mask[e] = true, path cannot pass through edge e
+                                                   std::vector<double>   & dist,
+                                             const double                  delta = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::: ALGORITHM SELECTION ::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exhaustive shortest paths with either the serial Dijkstra (default, best for
+// small meshes, or when other threads are busy) or the parallel delta-stepping.
+// Algorithms built on top of them (e.g. shortest_path_tree, homotopy_basis)
+// take a SSSPMethod too, with the same default, so that the choice can be made
+// at their call sites
+
+enum SSSPMethod
+{
+    SSSP_DIJKSTRA,
+    SSSP_DELTA_STEPPING,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_paths_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                               const std::vector<uint>     & sources,
+                                     std::vector<double>   & dist,
+                               const SSSPMethod              method = SSSP_DIJKSTRA);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void shortest_paths_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                        const std::vector<uint>                 & sources,
+                                              std::vector<double>               & dist,
+                                        const SSSPMethod                          method = SSSP_DIJKSTRA);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_paths_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
+                                             const std::vector<uint>     & sources,
+                                             const std::vector<double>   & weights, // per vert weights (used as metric instead of edge lengths)
+                                             const std::vector<bool>     & mask,    // if mask[e] = true, path cannot pass through edge e
+                                                   std::vector<double>   & dist,
+                                             const SSSPMethod              method = SSSP_DIJKSTRA);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "delta_stepping.cpp"
+#endif
+
+#endif // CINO_DELTA_STEPPING_H
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/dijkstra.h>
+#include <cinolib/indexed_heap.h>
 #include <cinolib/min_max_inf.h>
 #include <cinolib/stl_container_utilities.h>
 
@@ -42,22 +43,16 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why std::set and not
-// std::unordered_set or std::priority_queue?
+// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why not std::priority_queue?
 //
-// The reason why I am using std::set is that Dijkstra requires priority
-// update, which is supported by none of the STL containers. Options are:
-//
-//  1) remove an element and re-add it with updated priority. In this
-//     case std::set has the best remove performances
-//
-//  2) leave "dead" copies of an element in the container, and just add a
-//     new copy each time its priority needs an update. Regardless the waste
-//     of memory, which is an issue by itself, in this case at each iteration
-//     you need a mechanism that allows you to discard the current element
-//     if it is not the one with the most recent priority...
-//
-// I therefore decided to go for (1).
+// Dijkstra requires priority update, which is supported by none of the STL
+// containers. These implementations used to remove and re-insert elements
+// from a std::set, which is O(log n) but pays a node allocation and a tree
+// rebalance at each update. They now use an IndexedHeap (see indexed_heap.h),
+// preallocated to the mesh size, which tracks the position of each element and
+// supports decrease key in place. Note that, like the dist and prev arrays, the
+// heap costs O(n) to set up at each call, also for point to point queries that
+// terminate after visiting a few vertices.
 // See also:
 // https://stackoverflow.com/questions/649640/how-to-do-an-efficient-priority-update-in-stl-priority-queue
 
@@ -72,13 +67,12 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_v2v(vid))
         {
@@ -86,14 +80,8 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -110,13 +98,12 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_v2v(vid))
         {
@@ -124,14 +111,8 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -148,13 +129,12 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint eid : m.adj_v2e(vid))
         {
@@ -165,14 +145,8 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
 
                 if(dist.at(nbr) > new_dist)
                 {
-                    if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                    {
-                        auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                        assert(it!=q.end());
-                        q.erase(it);
-                    }
                     dist.at(nbr) = new_dist;
-                    q.insert(std::make_pair(new_dist,nbr));
+                    q.push_or_decrease(nbr, new_dist);
                 }
             }
         }
@@ -192,13 +166,12 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint eid : m.adj_v2e(vid))
         {
@@ -209,14 +182,8 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -238,13 +205,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -260,15 +226,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -293,13 +253,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -315,15 +274,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -349,13 +302,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -373,15 +325,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -409,13 +355,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -436,15 +381,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -475,13 +414,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -499,15 +437,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -538,13 +470,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -565,15 +496,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -605,13 +530,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -629,15 +553,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -658,13 +576,12 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_p2p(vid))
         {
@@ -672,14 +589,8 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -695,18 +606,17 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 {
     dist = std::vector<double>(m.num_polys(), inf_double);
 
-    std::set<std::pair<double,uint>> q;
+    IndexedHeap<> q(m.num_polys());
 
     for(uint s : sources)
     {
         dist.at(s) = 0.0;
-        q.insert(std::make_pair(0.0,s));
+        q.push_or_decrease(s, 0.0);
     }
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_p2p(vid))
         {
@@ -714,14 +624,8 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -743,13 +647,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -765,15 +668,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -798,13 +695,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -822,15 +718,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -857,13 +747,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -881,15 +770,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -915,13 +798,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push_or_decrease(source, 0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -937,15 +819,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr, new_dist);
             }
         }
     }
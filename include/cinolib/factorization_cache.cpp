@@ -0,0 +1,386 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/factorization_cache.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+
+namespace cinolib
+{
+
+namespace
+{
+
+template<typename T>
+CINO_INLINE
+void fingerprint_combine(size_t & h, const T & v)
+{
+    h ^= std::hash<T>()(v) + 0x9e3779b97f4a7c15ull + (h<<6) + (h>>2);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool same_symbolic(const FactorizationKey & a, const FactorizationKey & b)
+{
+    return a.op==b.op && a.topology==b.topology;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool same_numeric(const FactorizationKey & a, const FactorizationKey & b)
+{
+    return same_symbolic(a,b)                &&
+           a.laplacian_mode==b.laplacian_mode &&
+           a.params==b.params                &&
+           a.geometry==b.geometry;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// for matrix keyed operators: topology is the sparsity pattern, geometry the values
+CINO_INLINE
+FactorizationKey matrix_key(const Eigen::SparseMatrix<double> & A)
+{
+    assert(A.isCompressed());
+    FactorizationKey key;
+    key.op = "matrix";
+    fingerprint_combine(key.topology, A.rows());
+    fingerprint_combine(key.topology, A.cols());
+    for(int i=0; i<=A.outerSize();  ++i) fingerprint_combine(key.topology, A.outerIndexPtr()[i]);
+    for(int i=0; i<A.nonZeros();    ++i) fingerprint_combine(key.topology, A.innerIndexPtr()[i]);
+    for(int i=0; i<A.nonZeros();    ++i) fingerprint_combine(key.geometry, A.valuePtr()[i]);
+    return key;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+std::vector<uint> constrained_dofs(const std::map<uint,T> & bc)
+{
+    std::vector<uint> dofs;
+    dofs.reserve(bc.size());
+    for(const auto & obj : bc) dofs.push_back(obj.first);
+    return dofs; // sorted, as map keys are
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+size_t mesh_topology_fingerprint(const AbstractMesh<M,V,E,P> & m)
+{
+    size_t h = 0;
+    fingerprint_combine(h, m.num_verts());
+    fingerprint_combine(h, m.num_edges());
+    fingerprint_combine(h, m.num_polys());
+    for(uint eid=0; eid<m.num_edges(); ++eid)
+    {
+        fingerprint_combine(h, m.edge_vert_id(eid,0));
+        fingerprint_combine(h, m.edge_vert_id(eid,1));
+    }
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        for(uint vid : m.adj_p2v(pid)) fingerprint_combine(h, vid);
+    }
+    return h;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+size_t mesh_geometry_fingerprint(const AbstractMesh<M,V,E,P> & m)
+{
+    size_t h = 0;
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        const auto & p = m.vert(vid);
+        fingerprint_combine(h, p.x());
+        fingerprint_combine(h, p.y());
+        fingerprint_combine(h, p.z());
+    }
+    return h;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Assemble>
+CINO_INLINE
+FactorizationCache::Entry & FactorizationCache::fetch(const FactorizationKey  & key,
+                                                      const Assemble          & assemble,
+                                                      const std::vector<uint> & constrained)
+{
+    ++clock;
+
+    // same operator: nothing to do
+    for(Entry & e : entries)
+    {
+        if(same_numeric(e.key,key) && e.constrained==constrained)
+        {
+            e.last_use = clock;
+            ++n_hits;
+            return e;
+        }
+    }
+
+    // same pattern: the new entry starts from a copy of the cached factorization, so
+    // that its symbolic analysis is reused (the cached one is never changed, as handles
+    // to it may still be around)
+    std::shared_ptr<const Solver> analysis;
+    std::vector<int>              col_map;
+    size_t                        pattern = 0;
+    for(const Entry & e : entries)
+    {
+        if(same_symbolic(e.key,key) && e.constrained==constrained)
+        {
+            analysis = e.solver;
+            col_map  = e.col_map;
+            pattern  = e.pattern;
+            break;
+        }
+    }
+
+    // new operator: evict the least recently used entry, if needed
+    if(entries.size()>=std::max(1u,max_entries))
+    {
+        auto lru = std::min_element(entries.begin(), entries.end(),
+                                    [](const Entry & a, const Entry & b){ return a.last_use < b.last_use; });
+        entries.erase(lru);
+    }
+    entries.emplace_back();
+    Entry & e      = entries.back();
+    e.key          = key;
+    e.constrained  = constrained;
+    e.last_use     = clock;
+    if(analysis)
+    {
+        e.solver  = std::make_shared<Solver>(*analysis);
+        e.col_map = col_map;
+        e.pattern = pattern;
+        factorize(e, assemble(), false);
+    }
+    else
+    {
+        e.solver = std::make_shared<Solver>();
+        factorize(e, assemble(), true);
+    }
+    return e;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FactorizationCache::factorize(Entry & e, const Eigen::SparseMatrix<double> & A, bool symbolic)
+{
+    assert(A.rows()==A.cols());
+
+    // split A into the free/free block (to be factorized) and the free/constrained
+    // block, which moves the contribution of boundary conditions to the rhs
+    if(symbolic)
+    {
+        e.col_map.assign(A.cols(), 0);
+        for(uint dof : e.constrained) e.col_map.at(dof) = -1;
+        int fresh = 0;
+        for(int & c : e.col_map) if(c>=0) c = fresh++;
+    }
+    int n_free = int(A.cols()) - int(e.constrained.size());
+
+    std::vector<Eigen::Triplet<double>> ff, fc;
+    ff.reserve(A.nonZeros());
+    for(int col=0; col<A.outerSize(); ++col)
+    for(Eigen::SparseMatrix<double>::InnerIterator it(A,col); it; ++it)
+    {
+        int r = e.col_map.at(it.row());
+        int c = e.col_map.at(it.col());
+        if(r<0) continue;
+        if(c>=0) ff.push_back(Eigen::Triplet<double>(r, c, it.value()));
+        else     fc.push_back(Eigen::Triplet<double>(r, it.col(), it.value()));
+    }
+    Eigen::SparseMatrix<double> A_ff(n_free, n_free);
+    A_ff.setFromTriplets(ff.begin(), ff.end());
+    e.A_fc.resize(n_free, A.cols());
+    e.A_fc.setFromTriplets(fc.begin(), fc.end());
+
+    // safety net: if the pattern changed anyway, the symbolic analysis must be redone
+    size_t pattern = 0;
+    A_ff.makeCompressed();
+    for(int i=0; i<=A_ff.outerSize(); ++i) fingerprint_combine(pattern, A_ff.outerIndexPtr()[i]);
+    for(int i=0; i<A_ff.nonZeros();   ++i) fingerprint_combine(pattern, A_ff.innerIndexPtr()[i]);
+    if(pattern!=e.pattern) symbolic = true;
+    e.pattern = pattern;
+
+    if(symbolic)
+    {
+        e.solver->analyzePattern(A_ff);
+        ++n_symbolic;
+    }
+    else ++n_numeric;
+    e.solver->factorize(A_ff);
+
+    if(e.solver->info()!=Eigen::Success)
+    {
+        std::cerr << "WARNING : FactorizationCache : matrix factorization failed" << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FactorizationCache::solve(const Entry                             & e,
+                               const Eigen::MatrixXd                   & B,
+                                     Eigen::MatrixXd                   & X,
+                               const std::map<uint,Eigen::RowVectorXd> & bc) const
+{
+    assert(B.rows()==int(e.col_map.size()));
+
+    Eigen::MatrixXd X_c = Eigen::MatrixXd::Zero(B.rows(), B.cols());
+    for(const auto & obj : bc) X_c.row(obj.first) = obj.second;
+    Eigen::MatrixXd rhs(e.A_fc.rows(), B.cols());
+    for(uint i=0; i<e.col_map.size(); ++i) if(e.col_map[i]>=0) rhs.row(e.col_map[i]) = B.row(i);
+    if(!bc.empty()) rhs -= e.A_fc * X_c;
+
+    // back-substitution is const, hence columns can be solved in parallel
+    Eigen::MatrixXd X_f(rhs.rows(), rhs.cols());
+    PARALLEL_FOR(0, rhs.cols(), 2, [&](uint col)
+    {
+        Eigen::VectorXd b = rhs.col(col);
+        X_f.col(col) = e.solver->solve(b);
+    });
+
+    X.resize(B.rows(), B.cols());
+    for(uint i=0; i<e.col_map.size(); ++i)
+    {
+        if(e.col_map[i]>=0) X.row(i) = X_f.row(e.col_map[i]);
+        else                X.row(i) = X_c.row(i);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Assemble>
+CINO_INLINE
+void FactorizationCache::solve(const FactorizationKey      & key,
+                               const Assemble              & assemble,
+                               const Eigen::VectorXd       & b,
+                                     Eigen::VectorXd       & x,
+                               const std::map<uint,double> & bc)
+{
+    std::map<uint,Eigen::RowVectorXd> bc_rows;
+    for(const auto & obj : bc) bc_rows[obj.first] = Eigen::RowVectorXd::Constant(1, obj.second);
+
+    Eigen::MatrixXd X;
+    solve(key, assemble, Eigen::MatrixXd(b), X, bc_rows);
+    x = X.col(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Assemble>
+CINO_INLINE
+void FactorizationCache::solve(const FactorizationKey                  & key,
+                               const Assemble                          & assemble,
+                               const Eigen::MatrixXd                   & B,
+                                     Eigen::MatrixXd                   & X,
+                               const std::map<uint,Eigen::RowVectorXd> & bc)
+{
+    solve(fetch(key, assemble, constrained_dofs(bc)), B, X, bc);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FactorizationCache::solve(const Eigen::SparseMatrix<double> & A,
+                               const Eigen::VectorXd             & b,
+                                     Eigen::VectorXd             & x,
+                               const std::map<uint,double>       & bc)
+{
+    std::map<uint,Eigen::RowVectorXd> bc_rows;
+    for(const auto & obj : bc) bc_rows[obj.first] = Eigen::RowVectorXd::Constant(1, obj.second);
+
+    Eigen::MatrixXd X;
+    solve(A, Eigen::MatrixXd(b), X, bc_rows);
+    x = X.col(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FactorizationCache::solve(const Eigen::SparseMatrix<double>       & A,
+                               const Eigen::MatrixXd                   & B,
+                                     Eigen::MatrixXd                   & X,
+                               const std::map<uint,Eigen::RowVectorXd> & bc)
+{
+    if(A.isCompressed())
+    {
+        solve(fetch(matrix_key(A), [&](){ return A; }, constrained_dofs(bc)), B, X, bc);
+    }
+    else
+    {
+        Eigen::SparseMatrix<double> tmp = A;
+        tmp.makeCompressed();
+        solve(tmp, B, X, bc);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Assemble>
+CINO_INLINE
+std::shared_ptr<const FactorizationCache::Solver> FactorizationCache::factorization(const FactorizationKey & key,
+                                                                                    const Assemble         & assemble)
+{
+    return fetch(key, assemble, {}).solver;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::shared_ptr<const FactorizationCache::Solver> FactorizationCache::factorization(const Eigen::SparseMatrix<double> & A)
+{
+    if(A.isCompressed()) return fetch(matrix_key(A), [&](){ return A; }, {}).solver;
+    Eigen::SparseMatrix<double> tmp = A;
+    tmp.makeCompressed();
+    return factorization(tmp);
+}
+
+}
@@ -0,0 +1,215 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FACTORIZATION_CACHE_H
+#define CINO_FACTORIZATION_CACHE_H
+
+#include <sys/types.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/updatable_ldlt.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Identifies a linear operator built on top of a mesh. Two operators with same
+ * op, topology and set of constrained DOFs (Dirichlet boundary conditions) have
+ * the same sparsity pattern, hence they share the symbolic analysis of their
+ * factorization. If laplacian mode, numeric parameters and geometry also match,
+ * the operators coincide, and so does their numeric factorization.
+ *
+ * Topology and geometry are fingerprints (hashes) of the mesh connectivity and
+ * vertex positions, computed with the functions below. Operators that do not
+ * depend on the vertex positions (e.g. the uniform Laplacian) can leave the
+ * geometry fingerprint to zero, so that moving vertices does not invalidate
+ * their factorization.
+*/
+
+struct FactorizationKey
+{
+    std::string         op;                  // operator name (e.g. "harmonic_map"), including anything that affects its pattern
+    int                 laplacian_mode = -1;
+    std::vector<double> params;              // any other numeric parameter (e.g. time step)
+    size_t              topology = 0;        // mesh_topology_fingerprint(m)
+    size_t              geometry = 0;        // mesh_geometry_fingerprint(m)
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+size_t mesh_topology_fingerprint(const AbstractMesh<M,V,E,P> & m);
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+size_t mesh_geometry_fingerprint(const AbstractMesh<M,V,E,P> & m);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Keeps the (sparse Cholesky) factorizations of the operators used by a program,
+ * so that solving again with a different right hand side, or with different
+ * values for the same set of Dirichlet boundary conditions, costs only a
+ * back-substitution. When the operator changes but keeps its sparsity pattern
+ * (e.g. the mesh vertices moved, or a parameter changed), the symbolic analysis
+ * is reused and only the numeric factorization is recomputed.
+ *
+ * Operators can be identified either by a FactorizationKey, in which case they
+ * are assembled (calling assemble()) only on a cache miss, or directly by their
+ * matrix, in which case the key is a fingerprint of its pattern and values.
+ * Matrices are expected to be symmetric positive (semi) definite. The cache holds
+ * at most max_entries factorizations, and evicts the least recently used one.
+ * Cached factorizations are never modified: an operator that only shares the
+ * pattern of a cached one gets a new entry, which copies the symbolic analysis.
+*/
+
+class FactorizationCache
+{
+    public:
+
+        typedef UpdatableLDLT Solver; // (a copy of a cached factorization can be updated, see updatable_ldlt.h)
+
+        explicit FactorizationCache(const uint max_entries = 8) : max_entries(max_entries) {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // solves A*x = b, subject to Dirichlet boundary conditions
+        template<class Assemble> // Eigen::SparseMatrix<double> assemble()
+        void solve(const FactorizationKey        & key,
+                   const Assemble                & assemble,
+                   const Eigen::VectorXd         & b,
+                         Eigen::VectorXd         & x,
+                   const std::map<uint,double>   & bc = {});
+
+        void solve(const Eigen::SparseMatrix<double> & A,
+                   const Eigen::VectorXd             & b,
+                         Eigen::VectorXd             & x,
+                   const std::map<uint,double>       & bc = {});
+
+        // batched versions: the columns of B are solved in parallel, and bc
+        // holds one value per column for each constrained DOF
+        template<class Assemble>
+        void solve(const FactorizationKey                  & key,
+                   const Assemble                          & assemble,
+                   const Eigen::MatrixXd                   & B,
+                         Eigen::MatrixXd                   & X,
+                   const std::map<uint,Eigen::RowVectorXd> & bc = {});
+
+        void solve(const Eigen::SparseMatrix<double>       & A,
+                   const Eigen::MatrixXd                   & B,
+                         Eigen::MatrixXd                   & X,
+                   const std::map<uint,Eigen::RowVectorXd> & bc = {});
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // factorization of A (without boundary conditions)
+        template<class Assemble>
+        std::shared_ptr<const Solver> factorization(const FactorizationKey & key, const Assemble & assemble);
+        std::shared_ptr<const Solver> factorization(const Eigen::SparseMatrix<double> & A);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void clear() { entries.clear(); }
+        uint size()  const { return entries.size(); }
+
+        uint num_hits()     const { return n_hits;     } // solves that reused a factorization
+        uint num_numeric()  const { return n_numeric;  } // numeric factorizations (reusing the symbolic one)
+        uint num_symbolic() const { return n_symbolic; } // full factorizations (symbolic + numeric)
+
+    protected:
+
+        struct Entry
+        {
+            FactorizationKey            key;
+            std::vector<uint>           constrained;
+            std::vector<int>            col_map;  // maps matrix columns to free DOFs (-1 for constrained DOFs)
+            Eigen::SparseMatrix<double> A_fc;     // free rows, constrained columns (to move BCs to the rhs)
+            std::shared_ptr<Solver>     solver;
+            size_t                      pattern = 0; // fingerprint of the pattern of the factorized block
+            uint                        last_use = 0;
+        };
+
+        template<class Assemble>
+        Entry & fetch(const FactorizationKey & key, const Assemble & assemble, const std::vector<uint> & constrained);
+
+        void    factorize(Entry & e, const Eigen::SparseMatrix<double> & A, bool symbolic);
+        void    solve    (const Entry & e, const Eigen::MatrixXd & B, Eigen::MatrixXd & X, const std::map<uint,Eigen::RowVectorXd> & bc) const;
+
+        uint               max_entries;
+        std::vector<Entry> entries;
+        uint               clock      = 0;
+        uint               n_hits     = 0;
+        uint               n_numeric  = 0;
+        uint               n_symbolic = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Shared handle to a (read only) cached factorization. Besides being a smart pointer,
+ * it exposes solve() and info() directly, so that code written for a solver held by
+ * value (e.g. data.cache.solve(b)) keeps working when the solver comes from the cache.
+*/
+
+class FactorizationHandle : public std::shared_ptr<const FactorizationCache::Solver>
+{
+    public:
+
+        using std::shared_ptr<const FactorizationCache::Solver>::shared_ptr;
+
+        FactorizationHandle() {}
+        FactorizationHandle(const std::shared_ptr<const FactorizationCache::Solver> & p)
+            : std::shared_ptr<const FactorizationCache::Solver>(p) {}
+
+        template<typename Rhs>
+        auto solve(const Eigen::MatrixBase<Rhs> & b) const -> decltype(std::declval<const FactorizationCache::Solver&>().solve(b))
+        {
+            return (*this)->solve(b);
+        }
+
+        Eigen::ComputationInfo info() const { return (*this)->info(); }
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "factorization_cache.cpp"
+#endif
+
+#endif // CINO_FACTORIZATION_CACHE_H
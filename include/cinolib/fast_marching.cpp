@@ -0,0 +1,211 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/fast_marching.h>
+#include <cinolib/indexed_heap.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace cinolib
+{
+
+namespace
+{
+
+// min of d(p) + |x-p|, with p on the segment p0-p1, and d linear
+//
+CINO_INLINE
+double fmm_update(const vec3d & x,
+                  const vec3d & p0, const double d0,
+                  const vec3d & p1, const double d1)
+{
+    vec3d  e  = p1 - p0;
+    vec3d  a  = x  - p0;
+    double ee = e.dot(e);
+    double dd = d1 - d0;
+    if(ee > 0 && dd*dd < ee)
+    {
+        double s  = a.dot(e)/ee;                     // projection of x on the line
+        double h2 = std::max(0.0, a.dot(a) - s*s*ee); // squared distance from the line
+        double u  = dd * std::sqrt(h2/(ee - dd*dd));
+        double t  = s - u/std::sqrt(ee);
+        if(t >= 0 && t <= 1) return d0 + t*dd + std::sqrt(h2 + u*u);
+    }
+    return std::min(d0 + a.norm(), d1 + x.dist(p1));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// min of d(p) + |x-p|, with p on the triangle p0-p1-p2, and d linear
+//
+CINO_INLINE
+double fmm_update(const vec3d & x,
+                  const vec3d & p0, const double d0,
+                  const vec3d & p1, const double d1,
+                  const vec3d & p2, const double d2)
+{
+    vec3d  e1  = p1 - p0;
+    vec3d  e2  = p2 - p0;
+    vec3d  a   = x  - p0;
+    double g00 = e1.dot(e1);
+    double g01 = e1.dot(e2);
+    double g11 = e2.dot(e2);
+    double det = g00*g11 - g01*g01;
+    if(det > 1e-12*g00*g11)
+    {
+        // projection of x on the plane (s), and inverse metric times the value gradient (z)
+        double b0  = a.dot(e1), b1 = a.dot(e2);
+        double s0  = ( g11*b0 - g01*b1)/det;
+        double s1  = (-g01*b0 + g00*b1)/det;
+        double h2  = std::max(0.0, (a - e1*s0 - e2*s1).norm_sqrd());
+        double dd0 = d1 - d0, dd1 = d2 - d0;
+        double z0  = ( g11*dd0 - g01*dd1)/det;
+        double z1  = (-g01*dd0 + g00*dd1)/det;
+        double q   = dd0*z0 + dd1*z1;
+        if(q < 1)
+        {
+            double r  = std::sqrt(h2/(1-q));
+            double t0 = s0 - r*z0;
+            double t1 = s1 - r*z1;
+            if(t0 >= 0 && t1 >= 0 && t0+t1 <= 1) return d0 + t0*dd0 + t1*dd1 + r;
+        }
+    }
+    return std::min({fmm_update(x, p0, d0, p1, d1),
+                     fmm_update(x, p1, d1, p2, d2),
+                     fmm_update(x, p2, d2, p0, d0)});
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best update of vid from the accepted vertices of element pid
+//
+template<class M, class V, class E, class P>
+CINO_INLINE
+double fmm_update(const AbstractMesh<M,V,E,P> & m,
+                  const uint                    pid,
+                  const uint                    vid,
+                  const std::vector<double>   & dist,
+                  const std::vector<bool>     & accepted)
+{
+    uint n = 0;
+    uint known[3];
+    for(uint v : m.adj_p2v(pid))
+    {
+        if(v!=vid && accepted[v] && n<3) known[n++] = v;
+    }
+    const vec3d & x = m.vert(vid);
+    switch(n)
+    {
+        case 1 : return dist[known[0]] + x.dist(m.vert(known[0]));
+        case 2 : return fmm_update(x, m.vert(known[0]), dist[known[0]],
+                                      m.vert(known[1]), dist[known[1]]);
+        case 3 : return fmm_update(x, m.vert(known[0]), dist[known[0]],
+                                      m.vert(known[1]), dist[known[1]],
+                                      m.vert(known[2]), dist[known[2]]);
+    }
+    return inf_double;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void fast_marching(const AbstractMesh<M,V,E,P> & m,
+                   const std::vector<uint>     & sources,
+                         std::vector<double>   & dist,
+                   const double                  max_dist)
+{
+    dist.assign(m.num_verts(), inf_double);
+
+    // the updates are for triangles (surfaces) and tetrahedra (volumes) only
+    uint simplex_size = (m.mesh_type()<TETMESH) ? 3 : 4;
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(m.verts_per_poly(pid)!=simplex_size)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : fast_marching() : only triangle and tetrahedral meshes are supported" << std::endl;
+            return;
+        }
+    }
+
+    std::vector<bool> accepted(m.num_verts(), false);
+
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources)
+    {
+        dist.at(vid) = 0.0;
+        q.push_or_decrease(vid, 0.0);
+    }
+
+    while(!q.empty())
+    {
+        if(q.top_priority() > max_dist) break;
+        uint vid = q.pop();
+        accepted[vid] = true;
+
+        // only the elements incident to vid can improve the neighbors
+        for(uint eid : m.adj_v2e(vid))
+        {
+            uint nbr = m.vert_opposite_to(eid, vid);
+            if(accepted[nbr]) continue;
+
+            double d = dist[nbr];
+            for(uint pid : m.adj_e2p(eid))
+            {
+                d = std::min(d, fmm_update(m, pid, nbr, dist, accepted));
+            }
+            if(m.adj_e2p(eid).empty()) // dangling edge
+            {
+                d = std::min(d, dist[vid] + m.edge_length(eid));
+            }
+            if(d < dist[nbr])
+            {
+                dist[nbr] = d;
+                q.push_or_decrease(nbr, d);
+            }
+        }
+    }
+
+    // vertices left in the queue are beyond max_dist
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        if(!accepted[vid]) dist[vid] = inf_double;
+    }
+}
+
+}
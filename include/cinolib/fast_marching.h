@@ -0,0 +1,82 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FAST_MARCHING_H
+#define CINO_FAST_MARCHING_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/meshes/abstract_mesh.h>
+
+namespace cinolib
+{
+
+/* Geodesic distances with the Fast Marching Method, on triangle and tetrahedral
+ * meshes. The front is propagated from the sources in increasing distance
+ * order (using an IndexedHeap), as in Dijkstra. Differently from Dijkstra,
+ * distances do not travel along the mesh edges only. Each vertex is updated by
+ * solving the eikonal equation within its incident elements, from the vertices
+ * already accepted. That is, it takes the minimum of d(p) + |v-p| over the
+ * opposite edge (face, for tets), with d linearly interpolated. If the minimum is
+ * not inside the element (e.g. obtuse angles), the update falls back to the
+ * element edges. Memory is linear in the number of vertices. Meshes with elements
+ * other than triangles (or tetrahedra) are rejected, leaving all distances to inf_double.
+ *
+ * Reference:
+ *
+ *   Computing Geodesic Paths on Manifolds
+ *   R. Kimmel, J.A. Sethian
+ *   PNAS (1998)
+ *
+ * Propagation stops at max_dist. Vertices beyond it (or not reachable from the
+ * sources) have inf_double distance.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void fast_marching(const AbstractMesh<M,V,E,P> & m,
+                   const std::vector<uint>     & sources,
+                         std::vector<double>   & dist,
+                   const double                  max_dist = inf_double);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "fast_marching.cpp"
+#endif
+
+#endif // CINO_FAST_MARCHING_H
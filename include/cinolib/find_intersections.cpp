@@ -36,7 +36,8 @@
 #include <cinolib/find_intersections.h>
 #include <cinolib/parallel_for.h>
 #include <cinolib/octree.h>
-#include <mutex>
+#include <cinolib/geometry/point_utils.h>
+#include <cinolib/concurrent_collector.h>
 
 namespace cinolib
 {
@@ -44,10 +45,10 @@ namespace cinolib
 template<class M, class V, class E, class P>
 CINO_INLINE
 void find_intersections(const Trimesh<M,V,E,P> & m,
-                              std::set<ipair>  & intersections)
+                              std::vector<ipair> & intersections)
 {
     auto tris = serialized_vids_from_polys(m.vector_polys());
-    find_intersections(m.vector_verts(), tris, intersections);
+    find_intersections(points_as_vec3d(m.vector_verts()), tris, intersections);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -55,12 +56,12 @@ void find_intersections(const Trimesh<M,V,E,P> & m,
 CINO_INLINE
 void find_intersections(const std::vector<vec3d> & verts,
                         const std::vector<uint>  & tris,
-                              std::set<ipair>    & intersections)
+                              std::vector<ipair> & intersections)
 {
     Octree o(8,1000); // max 1000 elements per leaf, depth permitting
     o.build_from_vectors(verts, tris);
 
-    std::mutex mutex;
+    ConcurrentCollector<ipair> pairs;
     PARALLEL_FOR(0, o.leaves.size(), 1, [&](uint i)
     {        
         auto & leaf = o.leaves.at(i);
@@ -78,12 +79,13 @@ void find_intersections(const std::vector<vec3d> & verts,
                 const Triangle *t1 = dynamic_cast<Triangle*>(T1);
                 if(t0->intersects_triangle(t1->v,true)) // precise check (exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined)
                 {
-                    std::lock_guard<std::mutex> guard(mutex);
-                    intersections.insert(unique_pair(tid0,tid1));
+                    pairs.push_back(unique_pair(tid0,tid1));
                 }
             }
         }
     });
+
+    pairs.merge_unique(intersections);
 }
 
 }
@@ -39,18 +39,19 @@
 #include <cinolib/geometry/vec_mat.h>
 #include <cinolib/meshes/trimesh.h>
 #include <cinolib/ipair.h>
-#include <set>
+#include <vector>
 
 namespace cinolib
 {
 
 /* This method puts all the input polygons into an octree, then
- * performs pairwise intersection tests within each leaf, retunrning
- * a set of pairs of intersecting triangles.
+ * performs pairwise intersection tests within each leaf, returning
+ * the sorted list of pairs of intersecting triangles.
  *
- * The output must be a set and not a vector because triangles will
- * appear in all the leaves that have non empty overlap with it. Therefore,
- * the same intersection can be detected multiple times.
+ * Triangles appear in all the leaves that have non empty overlap with
+ * them, therefore the same intersection can be detected multiple times.
+ * Leaves are processed in parallel, each thread collects its own pairs
+ * (see concurrent_collector.h), and duplicates are removed at the end.
  *
  * IMPORTANT: intersections tests are based on the orient predicates contained
  * in cinolib/predicates.h. These predicates are exact if the symbol
@@ -60,14 +61,14 @@ namespace cinolib
 template<class M, class V, class E, class P>
 CINO_INLINE
 void find_intersections(const Trimesh<M,V,E,P> & m,
-                        std::set<ipair>        & intersections);
+                        std::vector<ipair>     & intersections);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
 void find_intersections(const std::vector<vec3d> & verts,
                         const std::vector<uint>  & tris,
-                              std::set<ipair>    & intersections);
+                              std::vector<ipair> & intersections);
 
 }
 
@@ -39,6 +39,10 @@
 #include <cinolib/laplacian.h>
 #include <cinolib/vertex_mass.h>
 #include <cinolib/linear_solvers.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/geometry/point_utils.h>
+#include <algorithm>
+#include <iostream>
 
 namespace cinolib
 {
@@ -108,62 +112,190 @@ ScalarField compute_geodesics_amortized(      Mesh              & m,
                                         const int                 laplacian_mode,
                                         const float               time_scalar)
 {
-    // first call, heavy solve (matrix factorization + gradient matrix)
-    if (cache.heat_flow_cache == NULL)
+    FactorizationKey heat_key;
+    heat_key.op             = "geodesics_heat_flow";
+    heat_key.laplacian_mode = laplacian_mode;
+    heat_key.params         = { time_scalar };
+    heat_key.topology       = mesh_topology_fingerprint(m);
+    heat_key.geometry       = mesh_geometry_fingerprint(m);
+
+    FactorizationKey integration_key = heat_key;
+    integration_key.op = "geodesics_integration";
+    integration_key.params.clear();
+
+    // operators are assembled (only on a cache miss) on a normalized copy of the
+    // mesh position and scale, to get better numerical precision
+    double             d = 1.0;
+    vec3d              c(0,0,0);
+    std::vector<vec3d> xyz;
+    bool               normalized = false;
+    auto normalize = [&]()
     {
-        // optimize position and scale to get better numerical precision
-        double d = m.bbox().diag();
-        vec3d  c = m.bbox().center();
+        if(normalized) return;
+        xyz = points_as_vec3d(m.vector_verts());
+        d = m.bbox().diag();
+        c = m.bbox().center();
         m.translate(-c);
         m.scale(1.0/d);
+        normalized = true;
+    };
 
+    auto heat_flow_matrix = [&]()
+    {
+        normalize();
         // use the squared avg edge length as time step, as suggested in the original paper
         double time = m.edge_avg_length();
         time *= time;
         time *= time_scalar;
+        Eigen::SparseMatrix<double> A = mass_matrix(m) - time * laplacian(m, laplacian_mode);
+        return A;
+    };
 
-        Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
-        Eigen::SparseMatrix<double> MM  = mass_matrix(m);
-        Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
-
-        for(uint vid : heat_charges) rhs[vid] = 1.0;
-
-        ScalarField heat(m.num_verts());
-        cache.heat_flow_cache = new Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>(MM - time * L);
-        assert(cache.heat_flow_cache->info() == Eigen::Success);
-        heat = cache.heat_flow_cache->solve(rhs).eval();
+    auto integration_matrix = [&]()
+    {
+        normalize();
+        Eigen::SparseMatrix<double> A = -laplacian(m, laplacian_mode);
+        return A;
+    };
 
+    if(cache.gradient_matrix.rows()==0 || cache.topology!=heat_key.topology || cache.geometry!=heat_key.geometry)
+    {
+        normalize();
         cache.gradient_matrix = gradient_matrix(m);
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
+        cache.topology        = heat_key.topology;
+        cache.geometry        = heat_key.geometry;
+    }
 
-        ScalarField geodesics(m.num_verts());
-        cache.integration_cache = new Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>(-L);
-        assert(cache.integration_cache->info() == Eigen::Success);
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
+    auto heat_flow   = cache.factorizations.factorization(heat_key, heat_flow_matrix);
+    auto integration = cache.factorizations.factorization(integration_key, integration_matrix);
 
-        // restore original scale and position
+    // restore original scale and position (exactly, so that the mesh fingerprint does not change)
+    if(normalized)
+    {
         m.scale(d);
         m.translate(c);
-        return geodesics;
+        m.vector_verts().assign(xyz.begin(), xyz.end());
     }
-    else // solve by back-substitution using pre-factored matrices
+
+    // solve by back-substitution using pre-factored matrices
+    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
+    for(uint vid : heat_charges) rhs[vid] = 1.0;
+    ScalarField heat = heat_flow->solve(rhs).eval();
+
+    VectorField grad = cache.gradient_matrix * heat;
+    grad.normalize();
+
+    ScalarField geodesics(m.num_verts());
+    geodesics = integration->solve(cache.gradient_matrix.transpose() * grad).eval();
+    geodesics.normalize_in_01();
+
+    return geodesics;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+HeatGeodesics<Mesh>::HeatGeodesics(const Mesh  & m,
+                                   const int     laplacian_mode,
+                                   const float   time_scalar)
+    : nv(m.num_verts())
+{
+    // use the squared avg edge length as time step, as suggested in the original paper.
+    // Both operators scale uniformly with the mesh, hence there is no need to normalize it
+    double time = m.edge_avg_length();
+    time *= time;
+    time *= time_scalar;
+
+    Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+
+    heat_flow.compute(MM - time * L);
+    if(heat_flow.info()!=Eigen::Success) std::cerr << "WARNING : HeatGeodesics : heat flow factorization failed" << std::endl;
+
+    // -L is only semi definite (constants are in its kernel). The tiny mass
+    // term makes it definite, without any practical effect on the distances
+    poisson.compute(-L + 1e-10 * MM);
+    if(poisson.info()!=Eigen::Success) std::cerr << "WARNING : HeatGeodesics : Poisson factorization failed" << std::endl;
+
+    G = gradient_matrix(m);
+    Eigen::VectorXd w(3*m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
     {
-        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
-        for(uint vid : heat_charges) rhs[vid] = 1.0;
-        ScalarField heat = cache.heat_flow_cache->solve(rhs).eval();
+        w[3*pid+0] = w[3*pid+1] = w[3*pid+2] = m.poly_mass(pid);
+    }
+    div = G.transpose() * w.asDiagonal();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
+template<class Mesh>
+CINO_INLINE
+void HeatGeodesics<Mesh>::solve(const std::vector<uint> & sources, Eigen::VectorXd & dist) const
+{
+    assert(!sources.empty());
 
-        ScalarField geodesics(m.num_verts());
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
+    Eigen::VectorXd u0 = Eigen::VectorXd::Zero(nv);
+    for(uint vid : sources) u0[vid] = 1.0;
+    Eigen::VectorXd u = heat_flow.solve(u0);
 
-        return geodesics;
+    // unit vector field pointing away from the sources
+    Eigen::VectorXd X = G * u;
+    for(int i=0; i<X.size(); i+=3)
+    {
+        double n = X.segment<3>(i).norm();
+        if(n>0) X.segment<3>(i) /= -n;
     }
 
+    dist = poisson.solve(div * X);
+
+    // remove the additive constant, so that distance is zero at the sources
+    double offset = dist[sources.front()];
+    for(uint vid : sources) offset = std::min(offset, dist[vid]);
+    dist.array() -= offset;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+ScalarField HeatGeodesics<Mesh>::distances(const std::vector<uint> & sources) const
+{
+    Eigen::VectorXd dist;
+    solve(sources, dist);
+    return ScalarField(dist);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+Eigen::MatrixXd HeatGeodesics<Mesh>::batch_distances(const std::vector<std::vector<uint>> & source_sets) const
+{
+    Eigen::MatrixXd res(nv, source_sets.size());
+    PARALLEL_FOR(0, source_sets.size(), 2, [&](uint i)
+    {
+        Eigen::VectorXd dist;
+        solve(source_sets.at(i), dist);
+        res.col(i) = dist;
+    });
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+DistanceMatrix HeatGeodesics<Mesh>::landmark_distances(const std::vector<uint> & landmarks) const
+{
+    DistanceMatrix res(landmarks.size(), nv);
+    PARALLEL_FOR(0, landmarks.size(), 2, [&](uint i)
+    {
+        Eigen::VectorXd dist;
+        solve({landmarks.at(i)}, dist);
+        res.row(i) = dist.transpose().cast<float>();
+    });
+    return res;
 }
 
 }
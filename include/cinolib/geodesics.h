@@ -41,6 +41,7 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/scalar_field.h>
 #include <cinolib/symbols.h>
+#include <cinolib/factorization_cache.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -79,11 +80,18 @@ ScalarField compute_geodesics(      Mesh              & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* Factorizations and gradient matrix used by compute_geodesics_amortized. They
+ * are computed at the first call, and reused by subsequent calls as long as the
+ * mesh (connectivity and vertex positions), laplacian mode and time scalar do not
+ * change. Otherwise, they are updated automatically.
+*/
+
 struct GeodesicsCache
 {
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>  *heat_flow_cache   = NULL;
-    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> *integration_cache = NULL;
-    Eigen::SparseMatrix<double>                         gradient_matrix;
+    FactorizationCache          factorizations;
+    Eigen::SparseMatrix<double> gradient_matrix;
+    size_t                      topology = 0; // fingerprints of the mesh gradient_matrix refers to
+    size_t                      geometry = 0;
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -95,6 +103,53 @@ ScalarField compute_geodesics_amortized(      Mesh              & m,
                                         const std::vector<uint> & heat_charges,
                                         const int                 laplacian_mode = COTANGENT,
                                         const float               time_scalar = 1.0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Many-source geodesic distances with the heat method. Both the heat flow and
+ * the Poisson operators are factorized once, at construction. Queries only
+ * cost two back-substitutions each. Independent queries (e.g. one per landmark)
+ * are solved in parallel.
+ *
+ * Unlike compute_geodesics, distances are NOT normalized. The divergence is
+ * area (volume) weighted and the additive constant of the Poisson problem is
+ * removed, so the output approximates the true geodesic distance in mesh units,
+ * and it is zero at the sources. The mesh is only read at construction: later
+ * changes of the mesh are not seen by the engine.
+*/
+
+typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> DistanceMatrix;
+
+template<class Mesh>
+class HeatGeodesics
+{
+    public:
+
+        explicit HeatGeodesics(const Mesh  & m,
+                               const int     laplacian_mode = COTANGENT,
+                               const float   time_scalar = 1.0);
+
+        // distance from the closest source
+        ScalarField distances(const std::vector<uint> & sources) const;
+
+        // one column per set of sources (solved in parallel)
+        Eigen::MatrixXd batch_distances(const std::vector<std::vector<uint>> & source_sets) const;
+
+        // landmark-to-all distance matrix, in single precision: row i holds the
+        // distances of all the mesh vertices from the i-th landmark
+        DistanceMatrix landmark_distances(const std::vector<uint> & landmarks) const;
+
+    protected:
+
+        void solve(const std::vector<uint> & sources, Eigen::VectorXd & dist) const;
+
+        uint                                               nv;
+        Eigen::SparseMatrix<double>                        G;       // gradient matrix (3 rows per element)
+        Eigen::SparseMatrix<double>                        div;     // G^T * diag(element mass), i.e. integrated divergence
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> heat_flow;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> poisson;
+};
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/geometry/aabb.h>
+#include <cinolib/geometry/point_utils.h>
 #include <algorithm>
 #include <cmath>
 
@@ -117,7 +118,11 @@ void AABB::push(const AABB & aabb)
 CINO_INLINE
 void AABB::push(const std::vector<vec3d> & list)
 {
-    for(auto p : list) push(p);
+    if(list.empty()) return;
+    vec3d lo, hi;
+    points_bbox(list, lo, hi);
+    push(lo);
+    push(hi);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
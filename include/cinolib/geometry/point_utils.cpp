@@ -34,8 +34,282 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/geometry/point_utils.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
 
 namespace cinolib
 {
 
+static_assert(sizeof(vec3d)==3*sizeof(double), "vec3d is expected to be a plain array of 3 doubles");
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_bbox(const std::vector<vec3d> & p, vec3d & min, vec3d & max)
+{
+    min = vec3d( inf_double,  inf_double,  inf_double);
+    max = vec3d(-inf_double, -inf_double, -inf_double);
+
+    uint i = 0;
+#ifdef CINO_SIMD_SSE2
+    uint n_blocks = p.size()/4;
+    // a block of four points is 12 doubles, hence each lane of the
+    // registers below always sees the same coordinate: lane j of
+    // register k holds coordinate (k*W+j)%3, where W is the width
+    const double * ptr = p.empty() ? nullptr : p.front().ptr();
+#ifdef CINO_SIMD_AVX
+    const uint W = 4;
+    __m256d lo[3], hi[3];
+    for(uint k=0; k<3; ++k) { lo[k] = _mm256_set1_pd(inf_double); hi[k] = _mm256_set1_pd(-inf_double); }
+    for(uint b=0; b<n_blocks; ++b, ptr+=12)
+    for(uint k=0; k<3; ++k)
+    {
+        __m256d x = _mm256_loadu_pd(ptr+k*W);
+        lo[k] = _mm256_min_pd(x, lo[k]);
+        hi[k] = _mm256_max_pd(x, hi[k]);
+    }
+    double l[3][W], h[3][W];
+    for(uint k=0; k<3; ++k) { _mm256_storeu_pd(l[k], lo[k]); _mm256_storeu_pd(h[k], hi[k]); }
+    const uint n_regs = 3;
+#else
+    const uint W = 2;
+    __m128d lo[6], hi[6];
+    for(uint k=0; k<6; ++k) { lo[k] = _mm_set1_pd(inf_double); hi[k] = _mm_set1_pd(-inf_double); }
+    for(uint b=0; b<n_blocks; ++b, ptr+=12)
+    for(uint k=0; k<6; ++k)
+    {
+        __m128d x = _mm_loadu_pd(ptr+k*W);
+        lo[k] = _mm_min_pd(x, lo[k]);
+        hi[k] = _mm_max_pd(x, hi[k]);
+    }
+    double l[6][W], h[6][W];
+    for(uint k=0; k<6; ++k) { _mm_storeu_pd(l[k], lo[k]); _mm_storeu_pd(h[k], hi[k]); }
+    const uint n_regs = 6;
+#endif
+    for(uint k=0; k<n_regs; ++k)
+    for(uint j=0; j<W;      ++j)
+    {
+        uint coord = (k*W+j)%3;
+        min[coord] = std::min(min[coord], l[k][j]);
+        max[coord] = std::max(max[coord], h[k][j]);
+    }
+    i = n_blocks*4;
+#endif
+    for(; i<p.size(); ++i)
+    {
+        min = min.min(p[i]);
+        max = max.max(p[i]);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+// applies x = op(x,pattern) to all the coordinates of a list of points,
+// where the pattern has period 3 (one value per coordinate)
+template<class OpSIMD, class Op>
+CINO_INLINE
+void points_apply_periodic(std::vector<vec3d> & p, const vec3d & pattern, const OpSIMD & op_simd, const Op & op)
+{
+    uint i = 0;
+#ifdef CINO_SIMD_SSE2
+    uint n_blocks = p.size()/4;
+    double * ptr = p.empty() ? nullptr : p.front().ptr();
+    double   pt[12];
+    for(uint j=0; j<12; ++j) pt[j] = pattern[j%3];
+    __m128d t[6];
+    for(uint k=0; k<6; ++k) t[k] = _mm_loadu_pd(pt+2*k);
+    for(uint b=0; b<n_blocks; ++b, ptr+=12)
+    for(uint k=0; k<6; ++k)
+    {
+        _mm_storeu_pd(ptr+2*k, op_simd(_mm_loadu_pd(ptr+2*k), t[k]));
+    }
+    i = n_blocks*4;
+#endif
+    for(; i<p.size(); ++i)
+    for(uint j=0; j<3; ++j)
+    {
+        p[i][j] = op(p[i][j], pattern[j]);
+    }
+}
+
+#ifdef CINO_SIMD_SSE2
+struct SIMD_add { __m128d operator()(const __m128d & a, const __m128d & b) const { return _mm_add_pd(a,b); } };
+struct SIMD_mul { __m128d operator()(const __m128d & a, const __m128d & b) const { return _mm_mul_pd(a,b); } };
+#else
+struct SIMD_add {};
+struct SIMD_mul {};
+#endif
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_translate(std::vector<vec3d> & p, const vec3d & delta)
+{
+    points_apply_periodic(p, delta, SIMD_add(), [](const double a, const double b){ return a+b; });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_scale(std::vector<vec3d> & p, const double scale_factor)
+{
+    points_apply_periodic(p, vec3d(scale_factor), SIMD_mul(), [](const double a, const double b){ return a*b; });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_transform(std::vector<vec3d> & p, const mat3d & M)
+{
+    uint n_blocks = (p.size()+3)/4;
+    PARALLEL_FOR(0, n_blocks, 25000, [&](uint b)
+    {
+        uint end = std::min((uint)p.size(), 4*b+4);
+        for(uint i=4*b; i<end; ++i) p[i] = M*p[i];
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_transform(std::vector<vec3d> & p, const mat4d & T)
+{
+    uint n_blocks = (p.size()+3)/4;
+    PARALLEL_FOR(0, n_blocks, 25000, [&](uint b)
+    {
+        uint end = std::min((uint)p.size(), 4*b+4);
+        for(uint i=4*b; i<end; ++i)
+        {
+            vec4d h = T*vec4d({p[i][0], p[i][1], p[i][2], 1.0});
+            p[i] = vec3d(h[0], h[1], h[2]);
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_normalize(std::vector<vec3d> & v)
+{
+    uint n_blocks = (v.size()+3)/4;
+    PARALLEL_FOR(0, n_blocks, 25000, [&](uint b)
+    {
+        uint end = std::min((uint)v.size(), 4*b+4);
+        for(uint i=4*b; i<end; ++i) v[i].normalize();
+    });
+}
+
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const std::vector<vec3d> & points_as_vec3d(const std::vector<vec3d> & p)
+{
+    return p;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void points_assign(std::vector<vec3d> & dst, std::vector<vec3d> && src)
+{
+    dst = std::move(src);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+std::vector<vec3d> points_as_vec3d(const std::vector<mat<3,1,S>> & p)
+{
+    return std::vector<vec3d>(p.begin(), p.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_assign(std::vector<mat<3,1,S>> & dst, std::vector<vec3d> && src)
+{
+    dst.assign(src.begin(), src.end());
+    std::vector<vec3d>().swap(src);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_bbox(const std::vector<mat<3,1,S>> & p, vec3d & min, vec3d & max)
+{
+    min = vec3d( inf_double,  inf_double,  inf_double);
+    max = vec3d(-inf_double, -inf_double, -inf_double);
+    for(const auto & q : p)
+    {
+        min = min.min(q);
+        max = max.max(q);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_translate(std::vector<mat<3,1,S>> & p, const vec3d & delta)
+{
+    for(auto & q : p) q = vec3d(q) + delta;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_scale(std::vector<mat<3,1,S>> & p, const double scale_factor)
+{
+    for(auto & q : p) q = vec3d(q) * scale_factor;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_transform(std::vector<mat<3,1,S>> & p, const mat3d & M)
+{
+    PARALLEL_FOR(0, p.size(), 100000, [&](uint i)
+    {
+        p[i] = M*vec3d(p[i]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_transform(std::vector<mat<3,1,S>> & p, const mat4d & T)
+{
+    PARALLEL_FOR(0, p.size(), 100000, [&](uint i)
+    {
+        vec4d h = T*vec4d({(double)p[i][0], (double)p[i][1], (double)p[i][2], 1.0});
+        p[i] = vec3d(h[0], h[1], h[2]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class S>
+CINO_INLINE
+void points_normalize(std::vector<mat<3,1,S>> & v)
+{
+    PARALLEL_FOR(0, v.size(), 100000, [&](uint i)
+    {
+        vec3d n = v[i];
+        if(n.normalize()>0) v[i] = n;
+    });
+}
+
 }
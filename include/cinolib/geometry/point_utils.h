@@ -36,9 +36,85 @@
 #ifndef CINO_POINT_UTILS_H
 #define CINO_POINT_UTILS_H
 
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <vector>
+
 namespace cinolib
 {
 
+/* Array-level operations on lists of points (or vectors), such as the vertices
+ * or the normals of a mesh. The lists are processed in blocks of four elements
+ * (i.e. 12 consecutive doubles), using SSE2/AVX registers where available (see
+ * vec_mat_utils.h). Per-point transformations are executed in parallel on
+ * large lists.
+*/
+
+CINO_INLINE
+void points_bbox(const std::vector<vec3d> & p, vec3d & min, vec3d & max);
+
+CINO_INLINE
+void points_translate(std::vector<vec3d> & p, const vec3d & delta);
+
+CINO_INLINE
+void points_scale(std::vector<vec3d> & p, const double scale_factor);
+
+// p = M * p
+CINO_INLINE
+void points_transform(std::vector<vec3d> & p, const mat3d & M);
+
+// p = T * p, with p in homogeneous coordinates (affine transformations only)
+CINO_INLINE
+void points_transform(std::vector<vec3d> & p, const mat4d & T);
+
+// scales each vector to unit length (degenerate vectors are left unchanged)
+CINO_INLINE
+void points_normalize(std::vector<vec3d> & v);
+
+// the same list in double precision (a copy is made only if the input is not vec3d)
+CINO_INLINE
+const std::vector<vec3d> & points_as_vec3d(const std::vector<vec3d> & p);
+
+// moves a list of points into another (the list is converted if the point types differ)
+CINO_INLINE
+void points_assign(std::vector<vec3d> & dst, std::vector<vec3d> && src);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// generic (scalar) versions, for lists of points of any other type (e.g. vec3f)
+
+template<class S>
+CINO_INLINE
+std::vector<vec3d> points_as_vec3d(const std::vector<mat<3,1,S>> & p);
+
+template<class S>
+CINO_INLINE
+void points_assign(std::vector<mat<3,1,S>> & dst, std::vector<vec3d> && src);
+
+template<class S>
+CINO_INLINE
+void points_bbox(const std::vector<mat<3,1,S>> & p, vec3d & min, vec3d & max);
+
+template<class S>
+CINO_INLINE
+void points_translate(std::vector<mat<3,1,S>> & p, const vec3d & delta);
+
+template<class S>
+CINO_INLINE
+void points_scale(std::vector<mat<3,1,S>> & p, const double scale_factor);
+
+template<class S>
+CINO_INLINE
+void points_transform(std::vector<mat<3,1,S>> & p, const mat3d & M);
+
+template<class S>
+CINO_INLINE
+void points_transform(std::vector<mat<3,1,S>> & p, const mat4d & T);
+
+template<class S>
+CINO_INLINE
+void points_normalize(std::vector<mat<3,1,S>> & v);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -111,6 +111,16 @@ mat<r,c,T>::mat(const T * values)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<uint r, uint c, class T>
+template<class U>
+CINO_INLINE
+mat<r,c,T>::mat(const mat<r,c,U> & m)
+{
+    for(uint i=0; i<r*c; ++i) _vec[i] = static_cast<T>(m._vec[i]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<uint r, uint c, class T>
 CINO_INLINE
 mat<r,c,T>::mat(const T v0, const T v1)
@@ -63,6 +63,10 @@ class mat
         explicit mat(const T v0, const T v1);
         explicit mat(const T v0, const T v1, const T v2);
         explicit mat() {}
+
+        // conversion between scalar types (e.g. vec3f <=> vec3d), so that
+        // single precision data can be promoted to double (and vice versa)
+        template<class U> mat(const mat<r,c,U> & m);
         ~mat() {}
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1011,6 +1011,341 @@ void mat_times(const T m0[][c0], const T m1[][c1], T m2[][c1])
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//:::::::::::::::::::::::::: SIMD SPECIALIZATIONS ::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINO_SIMD_SSE2
+
+namespace
+{
+
+// adds up the lanes of a register from first to last, that is,
+// in the same order of the generic (scalar) loops
+CINO_INLINE
+double hsum_in_order(const __m128d p01)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(p01, _mm_unpackhi_pd(p01,p01)));
+}
+
+CINO_INLINE
+float hsum_in_order(const __m128 p)
+{
+    __m128 s = _mm_add_ss(p, _mm_shuffle_ps(p,p,_MM_SHUFFLE(1,1,1,1)));
+    s = _mm_add_ss(s, _mm_movehl_ps(p,p));
+    s = _mm_add_ss(s, _mm_shuffle_ps(p,p,_MM_SHUFFLE(3,3,3,3)));
+    return _mm_cvtss_f32(s);
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dot<3,double>(const double * v_0, const double * v_1)
+{
+    __m128d p01 = _mm_mul_pd(_mm_loadu_pd(v_0), _mm_loadu_pd(v_1));
+    return hsum_in_order(p01) + v_0[2]*v_1[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dot<4,double>(const double * v_0, const double * v_1)
+{
+    __m128d p01 = _mm_mul_pd(_mm_loadu_pd(v_0),   _mm_loadu_pd(v_1));
+    __m128d p23 = _mm_mul_pd(_mm_loadu_pd(v_0+2), _mm_loadu_pd(v_1+2));
+    __m128d s   = _mm_add_sd(p01, _mm_unpackhi_pd(p01,p01));
+    s = _mm_add_sd(s, p23);
+    s = _mm_add_sd(s, _mm_unpackhi_pd(p23,p23));
+    return _mm_cvtsd_f64(s);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+float vec_dot<3,float>(const float * v_0, const float * v_1)
+{
+    __m128 p = _mm_mul_ps(_mm_setr_ps(v_0[0], v_0[1], v_0[2], 0.f),
+                          _mm_setr_ps(v_1[0], v_1[1], v_1[2], 0.f));
+    __m128 s = _mm_add_ss(p, _mm_shuffle_ps(p,p,_MM_SHUFFLE(1,1,1,1)));
+    s = _mm_add_ss(s, _mm_movehl_ps(p,p));
+    return _mm_cvtss_f32(s);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+float vec_dot<4,float>(const float * v_0, const float * v_1)
+{
+    return hsum_in_order(_mm_mul_ps(_mm_loadu_ps(v_0), _mm_loadu_ps(v_1)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void vec_cross<double>(const double * v_0, const double * v_1, double * v_2)
+{
+    // x and y components in one register, z in scalar
+    __m128d a = _mm_loadu_pd(v_0+1);                     // (v0_1, v0_2)
+    __m128d b = _mm_setr_pd(v_1[2], v_1[0]);             // (v1_2, v1_0)
+    __m128d c = _mm_setr_pd(v_0[2], v_0[0]);             // (v0_2, v0_0)
+    __m128d d = _mm_loadu_pd(v_1+1);                     // (v1_1, v1_2)
+    double  z = v_0[0] * v_1[1] - v_0[1] * v_1[0];
+    _mm_storeu_pd(v_2, _mm_sub_pd(_mm_mul_pd(a,b), _mm_mul_pd(c,d)));
+    v_2[2] = z;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dist_sqrd<3,double>(const double * v_0, const double * v_1)
+{
+    __m128d d01 = _mm_sub_pd(_mm_loadu_pd(v_0), _mm_loadu_pd(v_1));
+    double  d2  = v_0[2] - v_1[2];
+    return hsum_in_order(_mm_mul_pd(d01,d01)) + d2*d2;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_norm_sqrd<3,double>(const double * v)
+{
+    return vec_dot<3,double>(v,v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_normalize<3,double>(double * v)
+{
+    double n = sqrt(vec_norm_sqrd<3,double>(v));
+    if(vec_is_deg<3,double>(v)) return -1;
+    __m128d nn = _mm_set1_pd(n);
+    _mm_storeu_pd(v, _mm_div_pd(_mm_loadu_pd(v), nn));
+    v[2] /= n;
+    return n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void vec_cross<float>(const float * v_0, const float * v_1, float * v_2)
+{
+    // all the three components in one register (the fourth lane is unused)
+    __m128 a = _mm_setr_ps(v_0[1], v_0[2], v_0[0], 0.f);
+    __m128 b = _mm_setr_ps(v_1[2], v_1[0], v_1[1], 0.f);
+    __m128 c = _mm_setr_ps(v_0[2], v_0[0], v_0[1], 0.f);
+    __m128 d = _mm_setr_ps(v_1[1], v_1[2], v_1[0], 0.f);
+    float tmp[4];
+    _mm_storeu_ps(tmp, _mm_sub_ps(_mm_mul_ps(a,b), _mm_mul_ps(c,d)));
+    v_2[0] = tmp[0];
+    v_2[1] = tmp[1];
+    v_2[2] = tmp[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+// adds up the first three lanes in double precision, from first to last
+// (as the generic code does for float vectors with a double accumulator)
+CINO_INLINE
+double hsum3_to_double(const __m128 p)
+{
+    return hsum_in_order(_mm_cvtps_pd(p)) + (double)_mm_cvtss_f32(_mm_movehl_ps(p,p));
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dist_sqrd<3,float>(const float * v_0, const float * v_1)
+{
+    __m128 d = _mm_sub_ps(_mm_setr_ps(v_0[0], v_0[1], v_0[2], 0.f),
+                          _mm_setr_ps(v_1[0], v_1[1], v_1[2], 0.f));
+    return hsum3_to_double(_mm_mul_ps(d,d));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_norm_sqrd<3,float>(const float * v)
+{
+    __m128 p = _mm_setr_ps(v[0], v[1], v[2], 0.f);
+    return hsum3_to_double(_mm_mul_ps(p,p));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_normalize<3,float>(float * v)
+{
+    double n = sqrt(vec_norm_sqrd<3,float>(v));
+    if(vec_is_deg<3,float>(v)) return -1;
+    float tmp[4];
+    _mm_storeu_ps(tmp, _mm_div_ps(_mm_setr_ps(v[0], v[1], v[2], 0.f), _mm_set1_ps((float)n)));
+    v[0] = tmp[0];
+    v[1] = tmp[1];
+    v[2] = tmp[2];
+    return n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<3,3,1,double>(const double m0[][3], const double m1[][1], double m2[][1])
+{
+    for(uint i=0; i<3; ++i) m2[i][0] = vec_dot<3,double>(m0[i], m1[0]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<3,3,3,double>(const double m0[][3], const double m1[][3], double m2[][3])
+{
+    // rows of the result as linear combinations of the rows of m1
+    // (first two columns in SSE registers, third one in scalar)
+    __m128d b0 = _mm_loadu_pd(m1[0]);
+    __m128d b1 = _mm_loadu_pd(m1[1]);
+    __m128d b2 = _mm_loadu_pd(m1[2]);
+    for(uint i=0; i<3; ++i)
+    {
+        __m128d r = _mm_mul_pd(_mm_set1_pd(m0[i][0]), b0);
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_set1_pd(m0[i][1]), b1));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_set1_pd(m0[i][2]), b2));
+        m2[i][2] = m0[i][0]*m1[0][2] + m0[i][1]*m1[1][2] + m0[i][2]*m1[2][2];
+        _mm_storeu_pd(m2[i], r);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<4,4,1,double>(const double m0[][4], const double m1[][1], double m2[][1])
+{
+    for(uint i=0; i<4; ++i) m2[i][0] = vec_dot<4,double>(m0[i], m1[0]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<4,4,4,double>(const double m0[][4], const double m1[][4], double m2[][4])
+{
+#ifdef CINO_SIMD_AVX
+    __m256d b0 = _mm256_loadu_pd(m1[0]);
+    __m256d b1 = _mm256_loadu_pd(m1[1]);
+    __m256d b2 = _mm256_loadu_pd(m1[2]);
+    __m256d b3 = _mm256_loadu_pd(m1[3]);
+    for(uint i=0; i<4; ++i)
+    {
+        __m256d r = _mm256_mul_pd(_mm256_set1_pd(m0[i][0]), b0);
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(m0[i][1]), b1));
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(m0[i][2]), b2));
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(m0[i][3]), b3));
+        _mm256_storeu_pd(m2[i], r);
+    }
+#else
+    for(uint h=0; h<4; h+=2) // left and right halves of the rows of m1
+    {
+        __m128d b0 = _mm_loadu_pd(m1[0]+h);
+        __m128d b1 = _mm_loadu_pd(m1[1]+h);
+        __m128d b2 = _mm_loadu_pd(m1[2]+h);
+        __m128d b3 = _mm_loadu_pd(m1[3]+h);
+        for(uint i=0; i<4; ++i)
+        {
+            __m128d r = _mm_mul_pd(_mm_set1_pd(m0[i][0]), b0);
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_set1_pd(m0[i][1]), b1));
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_set1_pd(m0[i][2]), b2));
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_set1_pd(m0[i][3]), b3));
+            _mm_storeu_pd(m2[i]+h, r);
+        }
+    }
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<3,3,1,float>(const float m0[][3], const float m1[][1], float m2[][1])
+{
+    for(uint i=0; i<3; ++i) m2[i][0] = vec_dot<3,float>(m0[i], m1[0]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<3,3,3,float>(const float m0[][3], const float m1[][3], float m2[][3])
+{
+    // rows of the result as linear combinations of the rows of m1
+    // (the fourth lane is unused)
+    __m128 b0 = _mm_setr_ps(m1[0][0], m1[0][1], m1[0][2], 0.f);
+    __m128 b1 = _mm_setr_ps(m1[1][0], m1[1][1], m1[1][2], 0.f);
+    __m128 b2 = _mm_setr_ps(m1[2][0], m1[2][1], m1[2][2], 0.f);
+    for(uint i=0; i<3; ++i)
+    {
+        __m128 r = _mm_mul_ps(_mm_set1_ps(m0[i][0]), b0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m0[i][1]), b1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m0[i][2]), b2));
+        float tmp[4];
+        _mm_storeu_ps(tmp, r);
+        m2[i][0] = tmp[0];
+        m2[i][1] = tmp[1];
+        m2[i][2] = tmp[2];
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<4,4,1,float>(const float m0[][4], const float m1[][1], float m2[][1])
+{
+    for(uint i=0; i<4; ++i) m2[i][0] = vec_dot<4,float>(m0[i], m1[0]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<4,4,4,float>(const float m0[][4], const float m1[][4], float m2[][4])
+{
+    __m128 b0 = _mm_loadu_ps(m1[0]);
+    __m128 b1 = _mm_loadu_ps(m1[1]);
+    __m128 b2 = _mm_loadu_ps(m1[2]);
+    __m128 b3 = _mm_loadu_ps(m1[3]);
+    for(uint i=0; i<4; ++i)
+    {
+        __m128 r = _mm_mul_ps(_mm_set1_ps(m0[i][0]), b0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m0[i][1]), b1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m0[i][2]), b2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m0[i][3]), b3));
+        _mm_storeu_ps(m2[i], r);
+    }
+}
+
+#endif // CINO_SIMD_SSE2
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 }
@@ -37,6 +37,7 @@
 #define CINO_VEC_MAT_UTILS_H
 
 #include <cinolib/cino_inline.h>
+#include <cinolib/simd.h>
 #include <initializer_list>
 #include <sys/types.h>
 
@@ -130,6 +131,45 @@ void mat_times(const T m0[][c0], const T m1[][c1], T m2[][c1]);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* SIMD specializations of the hottest kernels on 3D/4D vectors and 3x3/4x4
+ * matrices (dot products, norms, distances, cross products, matrix products),
+ * both in double and in single precision. They use SSE2, which is part of any
+ * x86-64 target, and AVX for the 4x4 double products if the compiler targets
+ * it (e.g. -mavx, see the option CINOLIB_USES_AVX in cinolib-config.cmake). On
+ * any other target, or if the symbol CINOLIB_NO_SIMD is defined, the generic
+ * code above is used (see simd.h).
+ *
+ * The kernels perform the same floating point operations in the same order
+ * of the generic code, hence they return the same results.
+*/
+
+#ifdef CINO_SIMD_SSE2
+
+template<> CINO_INLINE double vec_dot      <3,double>(const double * v_0, const double * v_1);
+template<> CINO_INLINE double vec_dot      <4,double>(const double * v_0, const double * v_1);
+template<> CINO_INLINE float  vec_dot      <3,float> (const float  * v_0, const float  * v_1);
+template<> CINO_INLINE float  vec_dot      <4,float> (const float  * v_0, const float  * v_1);
+template<> CINO_INLINE void   vec_cross    <double>  (const double * v_0, const double * v_1, double * v_2);
+template<> CINO_INLINE double vec_dist_sqrd<3,double>(const double * v_0, const double * v_1);
+template<> CINO_INLINE double vec_norm_sqrd<3,double>(const double * vec);
+template<> CINO_INLINE double vec_normalize<3,double>(      double * vec);
+template<> CINO_INLINE void   vec_cross    <float>   (const float  * v_0, const float  * v_1, float  * v_2);
+template<> CINO_INLINE double vec_dist_sqrd<3,float> (const float  * v_0, const float  * v_1);
+template<> CINO_INLINE double vec_norm_sqrd<3,float> (const float  * vec);
+template<> CINO_INLINE double vec_normalize<3,float> (      float  * vec);
+
+template<> CINO_INLINE void mat_times<3,3,1,double>(const double m0[][3], const double m1[][1], double m2[][1]);
+template<> CINO_INLINE void mat_times<3,3,3,double>(const double m0[][3], const double m1[][3], double m2[][3]);
+template<> CINO_INLINE void mat_times<4,4,1,double>(const double m0[][4], const double m1[][1], double m2[][1]);
+template<> CINO_INLINE void mat_times<4,4,4,double>(const double m0[][4], const double m1[][4], double m2[][4]);
+template<> CINO_INLINE void mat_times<3,3,1,float> (const float  m0[][3], const float  m1[][1], float  m2[][1]);
+template<> CINO_INLINE void mat_times<3,3,3,float> (const float  m0[][3], const float  m1[][3], float  m2[][3]);
+template<> CINO_INLINE void mat_times<4,4,1,float> (const float  m0[][4], const float  m1[][1], float  m2[][1]);
+template<> CINO_INLINE void mat_times<4,4,4,float> (const float  m0[][4], const float  m1[][4], float  m2[][4]);
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 }
 
 #ifndef  CINO_STATIC_LIB
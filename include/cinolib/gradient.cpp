@@ -42,6 +42,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/gradient.h>
+#include <cinolib/sparse_matrix_assembly.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -50,83 +52,103 @@ typedef Eigen::Triplet<double> Entry;
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class P>
+/* All matrices are assembled directly in compressed (column major) form, filling
+ * each column in parallel: column vid of the per poly gradient contains three
+ * entries (x,y,z) for each element incident to vid. Per vertex gradients are
+ * obtained by averaging the per poly gradients of the elements incident to each
+ * vertex, weighted by their area (or volume).
+*/
+
+namespace
+{
+
+// 3N x 3M matrix that maps per element vectors to per vertex vectors, averaging
+// the elements incident to each vertex with weights w (typically area or volume)
+//
+template<class Mesh>
 CINO_INLINE
-Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, const bool per_poly)
+Eigen::SparseMatrix<double> gradient_vert_average(const Mesh & m, const std::vector<double> & w)
 {
-    if(per_poly)
+    std::vector<double> sum(m.num_verts(), 0.0);
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
+        for(uint pid : m.adj_v2p(vid)) sum[vid] += w[pid];
+    });
 
-        for(uint pid=0; pid<m.num_polys(); ++pid)
-        {
-            double area = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
-            vec3d n     = m.poly_data(pid).normal;
+    Eigen::SparseMatrix<double> A;
+    sparse_alloc(A, m.num_verts()*3, m.num_polys()*3, [&](uint col)
+    {
+        return m.adj_p2v(col/3).size();
+    });
 
-            for(uint off=0; off<m.verts_per_poly(pid); ++off)
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
+    {
+        for(uint i=0; i<3; ++i)
+        {
+            int    *idx = A.innerIndexPtr() + A.outerIndexPtr()[3*pid+i];
+            double *val = A.valuePtr()      + A.outerIndexPtr()[3*pid+i];
+            for(uint vid : m.adj_p2v(pid))
             {
-                uint  prev = m.poly_vert_id(pid,off);
-                uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
-                uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
-                vec3d u    = m.vert(next) - m.vert(curr);
-                vec3d v    = m.vert(curr) - m.vert(prev);
-                vec3d u_90 = u.cross(n); u_90.normalize();
-                vec3d v_90 = v.cross(n); v_90.normalize();
-
-                vec3d per_vert_sum_over_edge_normals = u_90 * u.norm() + v_90 * v.norm();
-                per_vert_sum_over_edge_normals /= area;
-
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.x())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.y())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.z()));
+                *idx++ = 3*vid+i;
+                *val++ = w[pid]/sum[vid];
             }
         }
+    });
+    sparse_sort_inner(A);
+
+    return A;
+}
 
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
-    else // per vertex
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, const bool per_poly)
+{
+    std::vector<double> area(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
     {
-        Eigen::SparseMatrix<double> G(m.num_verts()*3, m.num_verts());
-        std::vector<Entry> entries;
+        area[pid] = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
+    });
 
-        for(uint vid=0; vid<m.num_verts(); ++vid)
-        {
-            std::vector<std::pair<uint,vec3d>> vert_contr;
-            double area=0.f;
-            for(uint pid : m.adj_v2p(vid))
-            {
-                area   += std::max(m.poly_area(pid), 1e-5) * 2.0;
-                vec3d n = m.poly_data(pid).normal;
+    Eigen::SparseMatrix<double> G;
+    sparse_alloc(G, m.num_polys()*3, m.num_verts(), [&](uint vid)
+    {
+        return m.adj_v2p(vid).size()*3;
+    });
 
-                for(uint off=0; off<m.verts_per_poly(pid); ++off)
-                {
-                    uint  prev = m.poly_vert_id(pid,off);
-                    uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
-                    uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
-                    vec3d u    = m.vert(next) - m.vert(curr);
-                    vec3d v    = m.vert(curr) - m.vert(prev);
-                    vec3d u_90 = u.cross(n); u_90.normalize();
-                    vec3d v_90 = v.cross(n); v_90.normalize();
-
-                    // note: Eigen::setFromTriplets will take care of summing contributs w.r.t. multiple polys
-                    vert_contr.push_back(std::make_pair(curr, u_90*u.norm()+v_90*v.norm()));
-                }
-            }
-            uint row = vid * 3;
-            for(auto c : vert_contr)
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+    {
+        int    *idx = G.innerIndexPtr() + G.outerIndexPtr()[vid];
+        double *val = G.valuePtr()      + G.outerIndexPtr()[vid];
+        for(uint pid : m.adj_v2p(vid))
+        {
+            uint  nv   = m.verts_per_poly(pid);
+            uint  off  = m.poly_vert_offset(pid,vid);
+            uint  prev = m.poly_vert_id(pid,(off+nv-1)%nv);
+            uint  next = m.poly_vert_id(pid,(off+1)%nv);
+            vec3d n    = m.poly_data(pid).normal;
+            vec3d u    = m.vert(next) - m.vert(vid);
+            vec3d v    = m.vert(vid)  - m.vert(prev);
+            vec3d u_90 = u.cross(n); u_90.normalize();
+            vec3d v_90 = v.cross(n); v_90.normalize();
+
+            vec3d per_vert_sum_over_edge_normals = u_90 * u.norm() + v_90 * v.norm();
+            per_vert_sum_over_edge_normals /= area[pid];
+
+            for(uint i=0; i<3; ++i)
             {
-                entries.push_back(Entry(row  , c.first, c.second.x()/area));
-                entries.push_back(Entry(row+1, c.first, c.second.y()/area));
-                entries.push_back(Entry(row+2, c.first, c.second.z()/area));
+                *idx++ = 3*pid+i;
+                *val++ = per_vert_sum_over_edge_normals[i];
             }
         }
+    });
+    sparse_sort_inner(G);
 
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
+    if(per_poly) return G;
+    return gradient_vert_average(m, area) * G;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -135,92 +157,48 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, const bool per_poly)
 {
-    if(per_poly)
+    std::vector<double> vol(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
-
-        for(uint pid=0; pid<m.num_polys(); ++pid)
-        {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
+        vol[pid] = m.poly_volume(pid);
+    });
 
-            for(uint vid : m.adj_p2v(pid))
-            {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
-                {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
-                }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
-            }
-        }
-
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
-    else // per vert
+    Eigen::SparseMatrix<double> G;
+    sparse_alloc(G, m.num_polys()*3, m.num_verts(), [&](uint vid)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
+        return m.adj_v2p(vid).size()*3;
+    });
 
-        for(uint pid=0; pid<m.num_polys(); ++pid)
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+    {
+        int    *idx = G.innerIndexPtr() + G.outerIndexPtr()[vid];
+        double *val = G.valuePtr()      + G.outerIndexPtr()[vid];
+        for(uint pid : m.adj_v2p(vid))
         {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
-
-            for(uint vid : m.adj_p2v(pid))
+            vec3d per_vert_sum_over_f_normals(0,0,0);
+            for(uint fid : m.adj_p2f(pid))
             {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
+                if (m.face_contains_vert(fid,vid))
                 {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
+                    vec3d  n   = m.poly_face_normal(pid,fid);
+                    double a   = m.face_area(fid);
+                    double avg = static_cast<double>(m.verts_per_face(fid));
+                    per_vert_sum_over_f_normals += (n*a)/avg;
                 }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
             }
-        }
-        G.setFromTriplets(entries.begin(), entries.end());
+            per_vert_sum_over_f_normals /= std::max(vol[pid], 1e-5);
 
-        Eigen::SparseMatrix<double> A(m.num_verts()*3, m.num_polys()*3);
-        entries.clear();
-
-        for(uint vid=0;vid<m.num_verts();++vid)
-        {
-            double total_volume=0;
-            for(uint pid : m.adj_v2p(vid))
+            for(uint i=0; i<3; ++i)
             {
-                total_volume += m.poly_volume(pid);
-            }
-            uint row = 3*vid;
-            for(uint pid : m.adj_v2p(vid))
-            {
-                uint col=3*pid;
-                entries.push_back(Entry(row,  col,   m.poly_volume(pid)/total_volume));
-                entries.push_back(Entry(row+1,col+1, m.poly_volume(pid)/total_volume));
-                entries.push_back(Entry(row+2,col+2, m.poly_volume(pid)/total_volume));
+                *idx++ = 3*pid+i;
+                *val++ = per_vert_sum_over_f_normals[i];
             }
         }
-        A.setFromTriplets(entries.begin(), entries.end());
-        return A*G;
-    }
+    });
+    sparse_sort_inner(G);
+
+    if(per_poly) return G;
+    return gradient_vert_average(m, vol) * G;
 }
 
 }
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/grid_projector.h>
 #include <cinolib/octree.h>
+#include <cinolib/geometry/point_utils.h>
 
 namespace cinolib
 {
@@ -111,7 +112,7 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
     auto update_targets = [&](const uint smooth_iters, const bool sort_by_dist)
     {
         // pre smooth the surface
-        std::vector<vec3d> verts = m.vector_verts();
+        std::vector<vec3d> verts = points_as_vec3d(m.vector_verts());
         for(uint i=0; i<smooth_iters; ++i)
         {
             PARALLEL_FOR(0, m.num_verts(), 1000,[&](const uint vid)
@@ -35,11 +35,31 @@
 *********************************************************************************/
 #include <cinolib/harmonic_map.h>
 #include <cinolib/laplacian.h>
+#include <cinolib/laplacian_operator.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
 {
 
+namespace
+{
+
+// one row (x,y,z) per constrained vertex
+CINO_INLINE
+std::map<uint,Eigen::RowVectorXd> harmonic_map_3d_bc(const std::map<uint,vec3d> & bc)
+{
+    std::map<uint,Eigen::RowVectorXd> bc_rows;
+    for(const auto & obj : bc)
+    {
+        bc_rows[obj.first] = Eigen::RowVector3d(obj.second.x(), obj.second.y(), obj.second.z());
+    }
+    return bc_rows;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
@@ -51,10 +71,19 @@ ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB ||
+           solver == CG_JACOBI      || solver == CG_INCOMPLETE_CHOLESKY || solver == CG_MATRIX_FREE ||
+           solver == CG_MULTIGRID   || solver == MULTIGRID);
 
     ScalarField f(m.num_verts());
 
+    if(solver == CG_MATRIX_FREE && n == 1) // (powers of L must be assembled)
+    {
+        LaplacianOperator<M,V,E,P> Ln(m, laplacian_mode, -1.0); // keep it PSD
+        solve_PCG(Ln, JacobiPreconditioner(Ln), Eigen::VectorXd::Zero(m.num_verts()), f, bc);
+        return f;
+    }
+
     Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
     Eigen::SparseMatrix<double> Ln = -L;
     Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
@@ -80,36 +109,126 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB ||
+           solver == CG_JACOBI      || solver == CG_INCOMPLETE_CHOLESKY || solver == CG_MATRIX_FREE ||
+           solver == CG_MULTIGRID   || solver == MULTIGRID);
 
-    ScalarField f(3*m.num_verts());
+    if(solver == CG_MATRIX_FREE && n == 1) // (powers of L must be assembled)
+    {
+        // the three coordinates are independent: solve three scalar problems with the same operator
+        LaplacianOperator<M,V,E,P> Ln(m, laplacian_mode, -1.0); // keep it PSD
+        JacobiPreconditioner       Pc(Ln);
+        std::vector<vec3d>         res(m.num_verts());
+        for(int i=0; i<3; ++i)
+        {
+            std::map<uint,double> bc_1d;
+            for(auto obj : bc) bc_1d[obj.first] = obj.second[i];
+            Eigen::VectorXd f;
+            solve_PCG(Ln, Pc, Eigen::VectorXd::Zero(m.num_verts()), f, bc_1d);
+            for(uint vid=0; vid<m.num_verts(); ++vid) res.at(vid)[i] = f[vid];
+        }
+        return res;
+    }
 
-    Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode, 3);
-    Eigen::SparseMatrix<double> Ln = -L;
-    Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(3*m.num_verts());
+    // the three coordinates are independent: factorize Ln once, and solve for x,y,z together
+    Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
+    Eigen::SparseMatrix<double> Ln  = -L;
+    Eigen::MatrixXd             rhs = Eigen::MatrixXd::Zero(m.num_verts(), 3);
 
     for(uint i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
 
-    uint y_off = m.num_verts();
-    uint z_off = m.num_verts() + y_off;
-    std::map<uint,double> bc_1d;
-    for(auto obj : bc)
+    Eigen::MatrixXd f;
+    solve_square_system_with_bc(Ln, rhs, f, harmonic_map_3d_bc(bc), solver);
+
+    std::vector<vec3d> res(m.num_verts());
+    for(uint vid=0; vid<m.num_verts(); ++vid)
     {
-        uint  vid = obj.first;
-        vec3d pos = obj.second;
-        bc_1d[      vid] = pos.x();
-        bc_1d[y_off+vid] = pos.y();
-        bc_1d[z_off+vid] = pos.z();
+        res.at(vid) = vec3d(f(vid,0), f(vid,1), f(vid,2));
     }
 
-    solve_square_system_with_bc(Ln, rhs, f, bc_1d, solver);
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+FactorizationKey harmonic_map_key(const AbstractMesh<M,V,E,P> & m,
+                                  const char                  * op,
+                                  const uint                    n,
+                                  const int                     laplacian_mode)
+{
+    FactorizationKey key;
+    key.op             = std::string(op) + "_" + std::to_string(n); // (n changes the sparsity pattern)
+    key.laplacian_mode = laplacian_mode;
+    key.topology       = mesh_topology_fingerprint(m);
+    key.geometry       = (laplacian_mode==UNIFORM) ? 0 : mesh_geometry_fingerprint(m);
+    return key;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
+                         const std::map<uint,double> & bc,
+                         FactorizationCache          & cache,
+                         const uint                    n,
+                         const int                     laplacian_mode)
+{
+    assert(n > 0);
+    assert(bc.size() > 0);
+    assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
+
+    auto assemble = [&]()
+    {
+        Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+        Eigen::SparseMatrix<double> Ln = -L;
+        for(uint i=1; i<n; ++i) Ln = Ln * (-L); // keep it PSD
+        return Ln;
+    };
+
+    ScalarField f(m.num_verts());
+    cache.solve(harmonic_map_key(m, "harmonic_map", n, laplacian_mode), assemble, Eigen::VectorXd::Zero(m.num_verts()), f, bc);
+    return f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
+                                   const std::map<uint,vec3d>  & bc,
+                                   FactorizationCache          & cache,
+                                   const uint                    n,
+                                   const int                     laplacian_mode)
+{
+    assert(n > 0);
+    assert(bc.size() > 0);
+    assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
+
+    auto assemble = [&]()
+    {
+        Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+        Eigen::SparseMatrix<double> Ln = -L;
+        for(uint i=1; i<n; ++i) Ln = Ln * (-L); // keep it PSD
+        return Ln;
+    };
+
+    // same operator of the scalar map: x,y,z are solved together, with a single factorization
+    Eigen::MatrixXd f;
+    cache.solve(harmonic_map_key(m, "harmonic_map", n, laplacian_mode), assemble, Eigen::MatrixXd::Zero(m.num_verts(),3), f, harmonic_map_3d_bc(bc));
 
     std::vector<vec3d> res(m.num_verts());
     for(uint vid=0; vid<m.num_verts(); ++vid)
     {
-        res.at(vid) = vec3d(f[vid], f[y_off+vid], f[z_off+vid]);
+        res.at(vid) = vec3d(f(vid,0), f(vid,1), f(vid,2));
     }
-
     return res;
 }
 
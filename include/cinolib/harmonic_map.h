@@ -76,6 +76,28 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
                                    const uint                    n = 1,
                                    const int                     laplacian_mode = COTANGENT,
                                    const int                     solver = SIMPLICIAL_LLT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, but the factorization of the (n)-Laplacian is kept in the cache,
+// and reused as long as mesh, n, laplacian mode and constrained vertices do not change
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
+                         const std::map<uint,double> & bc,
+                         FactorizationCache          & cache,
+                         const uint                    n = 1,
+                         const int                     laplacian_mode = COTANGENT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
+                                   const std::map<uint,vec3d>  & bc,
+                                   FactorizationCache          & cache,
+                                   const uint                    n = 1,
+                                   const int                     laplacian_mode = COTANGENT);
 }
 
 #ifndef  CINO_STATIC_LIB
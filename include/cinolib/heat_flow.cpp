@@ -36,6 +36,8 @@
 #include <cinolib/heat_flow.h>
 #include <cinolib/laplacian.h>
 #include <cinolib/vertex_mass.h>
+#include <cinolib/laplacian_operator.h>
+#include <cinolib/parallel_for.h>
 #include <cinolib/linear_solvers.h>
 #include <Eigen/Sparse>
 
@@ -48,12 +50,31 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
                       const std::vector<uint>     & heat_charges,
                       const double                  time,
                       const int                     laplacian_mode,
-                      const bool                    hard_contraint_bcs)
+                      const bool                    hard_contraint_bcs,
+                      const int                     solver)
 {
     assert(heat_charges.size() > 0);
 
     ScalarField heat(m.num_verts());
 
+    if(solver == CG_MATRIX_FREE)
+    {
+        std::vector<double> mass(m.num_verts());
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+        {
+            mass[vid] = m.vert_mass(vid);
+        });
+        LaplacianOperator<M,V,E,P> A(m, laplacian_mode, -time, mass);
+        Eigen::VectorXd            rhs = Eigen::VectorXd::Zero(m.num_verts());
+        std::map<uint,double>      bcs;
+        for(uint vid : heat_charges)
+        {
+            if(hard_contraint_bcs) bcs[vid] = 1.0; else rhs[vid] = 1.0;
+        }
+        solve_PCG(A, JacobiPreconditioner(A), rhs, heat, bcs);
+        return heat;
+    }
+
     Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
     Eigen::SparseMatrix<double> MM  = mass_matrix(m);
     Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
@@ -62,16 +83,53 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
     {
         std::map<uint,double> bcs;
         for(uint vid: heat_charges) bcs[vid] = 1.0;
-        solve_square_system_with_bc(MM - time * L, rhs, heat, bcs);
+        solve_square_system_with_bc(MM - time * L, rhs, heat, bcs, solver);
     }
     else // heat flow as a diffusion problem (charges lose heat)
     {
         for(uint vid : heat_charges) rhs[vid] = 1.0;
-        solve_square_system(MM - time * L, rhs, heat);
+        solve_square_system(MM - time * L, rhs, heat, solver);
     }
 
 
     return heat;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
+                      const std::vector<uint>     & heat_charges,
+                      FactorizationCache          & cache,
+                      const double                  time,
+                      const int                     laplacian_mode,
+                      const bool                    hard_contraint_bcs)
+{
+    assert(heat_charges.size() > 0);
+
+    FactorizationKey key;
+    key.op             = "heat_flow";
+    key.laplacian_mode = laplacian_mode;
+    key.params         = { time };
+    key.topology       = mesh_topology_fingerprint(m);
+    key.geometry       = mesh_geometry_fingerprint(m); // (mass depends on geometry, regardless of the laplacian mode)
+
+    auto assemble = [&]()
+    {
+        Eigen::SparseMatrix<double> A = mass_matrix(m) - time * laplacian(m, laplacian_mode);
+        return A;
+    };
+
+    ScalarField           heat(m.num_verts());
+    Eigen::VectorXd       rhs = Eigen::VectorXd::Zero(m.num_verts());
+    std::map<uint,double> bcs;
+    for(uint vid : heat_charges)
+    {
+        if(hard_contraint_bcs) bcs[vid] = 1.0; else rhs[vid] = 1.0;
+    }
+    cache.solve(key, assemble, rhs, heat, bcs);
+    return heat;
+}
+
 }
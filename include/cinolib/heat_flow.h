@@ -42,12 +42,14 @@
 #include <cinolib/scalar_field.h>
 #include <cinolib/meshes/abstract_mesh.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 
 namespace cinolib
 {
 
 /* Solve the heat flow problem  (M - t * L) u = u0,
- * subject to certain Dirichlet boundary conditions
+ * subject to certain Dirichlet boundary conditions.
+ * With solver CG_MATRIX_FREE, neither L nor M are assembled
 */
 
 template<class M, class V, class E, class P>
@@ -56,6 +58,21 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
                       const std::vector<uint>     & heat_charges,
                       const double                  time = 1.0,
                       const int                     laplacian_mode = COTANGENT,
+                      const bool                    hard_contraint_bcs = false,
+                      const int                     solver = SIMPLICIAL_LLT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, but the factorization of (M - t * L) is kept in the cache, and
+// reused as long as mesh, time and laplacian mode do not change (with hard
+// constraints, heat charges must not change either)
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
+                      const std::vector<uint>     & heat_charges,
+                      FactorizationCache          & cache,
+                      const double                  time = 1.0,
+                      const int                     laplacian_mode = COTANGENT,
                       const bool                    hard_contraint_bcs = false);
 }
 
@@ -86,11 +86,12 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
                       const uint                       root,
                       std::vector<std::vector<uint>> & basis,
                       std::vector<bool>              & tree,
-                      std::vector<bool>              & cotree)
+                      std::vector<bool>              & cotree,
+                      const SSSPMethod                 sssp_method)
 {
     assert(root<m.num_verts());
 
-    shortest_path_tree(m, root, tree);
+    shortest_path_tree(m, root, tree, sssp_method);
 
     // Compute the cotree as the Maximum Spanning Tree of the dual of M,
     // without considering dual edges that cross edges of primal tree.
@@ -154,7 +155,7 @@ void homotopy_basis(AbstractPolygonMesh<M,V,E,P> & m,
 
         for(uint vid=0; vid<m.num_verts(); ++vid)
         {
-            double length = homotopy_basis(m, vid, data.loops, data.tree, data.cotree);
+            double length = homotopy_basis(m, vid, data.loops, data.tree, data.cotree, data.sssp_method);
 
             if(length < best_length)
             {
@@ -173,7 +174,7 @@ void homotopy_basis(AbstractPolygonMesh<M,V,E,P> & m,
     }
     else
     {
-        data.length = homotopy_basis(m, data.root, data.loops, data.tree, data.cotree);
+        data.length = homotopy_basis(m, data.root, data.loops, data.tree, data.cotree, data.sssp_method);
     }
 
     if(data.detach_loops) detach_loops(dynamic_cast<Trimesh<M,V,E,P>&>(m), data);
@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
 #include <cinolib/meshes/trimesh.h>
+#include <cinolib/delta_stepping.h>
 
 namespace cinolib
 {
@@ -116,6 +117,7 @@ struct HomotopyBasisData
     // INPUT: SETTINGS
     bool  globally_shortest  = false; // cost for globally shortest is O(n^2 log n). When this is set to true, root will contain the root of the globally shortest basis
     uint  root               = 0;     // cost for a base centered at root is O(n log n)
+    SSSPMethod sssp_method   = SSSP_DIJKSTRA; // algorithm used to compute the shortest path tree (see delta_stepping.h)
 
     // INPUT: REFINEMENT OPTIONS AND STATISTICS
     bool  detach_loops       = false;                 // refine mesh topology to detach loops traversing the same edges
@@ -151,7 +153,8 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
                       const uint                       root,
                       std::vector<std::vector<uint>> & basis,
                       std::vector<bool>              & tree,
-                      std::vector<bool>              & cotree);
+                      std::vector<bool>              & cotree,
+                      const SSSPMethod                 sssp_method = SSSP_DIJKSTRA);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
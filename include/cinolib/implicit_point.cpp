@@ -0,0 +1,626 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/implicit_point.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace cinolib
+{
+
+namespace
+{
+
+// floating point number, with a bound of its absolute rounding error.
+// Operations propagate the bound, according to the standard model of
+// floating point arithmetic (i.e. |fl(a op b) - (a op b)| <= u|fl(a op b)|)
+struct fval
+{
+    double v, e;
+    fval(const double v = 0.0, const double e = 0.0) : v(v), e(e) {}
+};
+
+const double U   = std::numeric_limits<double>::epsilon()*0.5;
+const double ETA = std::numeric_limits<double>::denorm_min();
+
+CINO_INLINE
+fval operator+(const fval & a, const fval & b)
+{
+    double s = a.v + b.v;
+    return fval(s, a.e + b.e + U*std::fabs(s));
+}
+
+CINO_INLINE
+fval operator-(const fval & a, const fval & b)
+{
+    double s = a.v - b.v;
+    return fval(s, a.e + b.e + U*std::fabs(s));
+}
+
+CINO_INLINE
+fval operator*(const fval & a, const fval & b)
+{
+    double p = a.v * b.v;
+    double e = std::fabs(a.v)*b.e + std::fabs(b.v)*a.e + a.e*b.e + U*std::fabs(p);
+    if(std::fabs(p) < std::numeric_limits<double>::min() && (a.v!=0 && b.v!=0)) e += ETA; // underflow
+    return fval(p, e);
+}
+
+// sign of a, or UNCERTAIN if the error bound does not allow to tell. The bound
+// is slightly enlarged to account for the rounding errors in its own computation
+const int UNCERTAIN = 2;
+
+CINO_INLINE
+int sign(const fval & a)
+{
+    double e = a.e * (1.0 + 1e-10);
+    if(a.v >  e) return  1;
+    if(a.v < -e) return -1;
+    if(a.v==0.0 && a.e==0.0) return 0;
+    return UNCERTAIN;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact number, represented as a floating point expansion (i.e. an unevaluated
+// sum of non overlapping doubles, sorted by increasing magnitude). Operations
+// are the linear time algorithms described in:
+//
+//     Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates
+//     Jonathan Richard Shewchuk
+//     Discrete & Computational Geometry, 1997
+//
+struct xval
+{
+    std::vector<double> c;
+    xval() {}
+    xval(const double d) { if(d!=0.0) c.push_back(d); }
+};
+
+// x+y = a+b exactly
+CINO_INLINE
+void two_sum(const double a, const double b, double & x, double & y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    double br = b - bv;
+    double ar = a - av;
+    y = ar + br;
+}
+
+// x+y = a+b exactly, provided that |a| >= |b|
+CINO_INLINE
+void fast_two_sum(const double a, const double b, double & x, double & y)
+{
+    x = a + b;
+    double bv = x - a;
+    y = b - bv;
+}
+
+// x+y = a*b exactly
+CINO_INLINE
+void two_prod(const double a, const double b, double & x, double & y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// h = e+f (Shewchuk's FAST-EXPANSION-SUM, with zero elimination)
+CINO_INLINE
+void expansion_sum(const std::vector<double> & e, const std::vector<double> & f, std::vector<double> & h)
+{
+    h.clear();
+    if(e.empty()) { h = f; return; }
+    if(f.empty()) { h = e; return; }
+    h.reserve(e.size()+f.size());
+
+    size_t ei = 0, fi = 0;
+    double Q, Qnew, hh;
+    // merge the components of e and f by increasing magnitude
+    auto e_first = [&]() { return fi==f.size() || (ei<e.size() && ((f[fi]>e[ei])==(f[fi]>-e[ei]))); };
+    if(e_first()) Q = e[ei++]; else Q = f[fi++];
+    if(ei<e.size() && fi<f.size())
+    {
+        if(e_first()) fast_two_sum(e[ei++], Q, Qnew, hh);
+        else          fast_two_sum(f[fi++], Q, Qnew, hh);
+        Q = Qnew;
+        if(hh!=0.0) h.push_back(hh);
+    }
+    while(ei<e.size() || fi<f.size())
+    {
+        if(e_first()) two_sum(Q, e[ei++], Qnew, hh);
+        else          two_sum(Q, f[fi++], Qnew, hh);
+        Q = Qnew;
+        if(hh!=0.0) h.push_back(hh);
+    }
+    if(Q!=0.0) h.push_back(Q);
+}
+
+// h = e*b (Shewchuk's SCALE-EXPANSION, with zero elimination)
+CINO_INLINE
+void expansion_scale(const std::vector<double> & e, const double b, std::vector<double> & h)
+{
+    h.clear();
+    if(e.empty() || b==0.0) return;
+    h.reserve(2*e.size());
+
+    double Q, hh, p1, p0, sum;
+    two_prod(e[0], b, Q, hh);
+    if(hh!=0.0) h.push_back(hh);
+    for(size_t i=1; i<e.size(); ++i)
+    {
+        two_prod(e[i], b, p1, p0);
+        two_sum(Q, p0, sum, hh);
+        if(hh!=0.0) h.push_back(hh);
+        fast_two_sum(p1, sum, Q, hh);
+        if(hh!=0.0) h.push_back(hh);
+    }
+    if(Q!=0.0) h.push_back(Q);
+}
+
+CINO_INLINE
+xval operator+(const xval & a, const xval & b)
+{
+    xval res;
+    expansion_sum(a.c, b.c, res.c);
+    return res;
+}
+
+CINO_INLINE
+xval operator-(const xval & a, const xval & b)
+{
+    xval nb = b;
+    for(double & d : nb.c) d = -d;
+    return a + nb;
+}
+
+CINO_INLINE
+xval operator*(const xval & a, const xval & b)
+{
+    const xval & l = (a.c.size()>=b.c.size()) ? a : b; // scale the longest
+    const xval & s = (a.c.size()>=b.c.size()) ? b : a; // expansion by each
+    xval res;                                           // component of the other
+    std::vector<double> tmp, sum;
+    for(double d : s.c)
+    {
+        expansion_scale(l.c, d, tmp);
+        expansion_sum(res.c, tmp, sum);
+        std::swap(res.c, sum);
+    }
+    return res;
+}
+
+CINO_INLINE
+int sign(const xval & a)
+{
+    if(a.c.empty()) return 0;
+    return (a.c.back()>0) ? 1 : -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class N>
+CINO_INLINE
+N det2(const N & a, const N & b, const N & c, const N & d)
+{
+    return a*d - b*c;
+}
+
+template<class N>
+CINO_INLINE
+N det3(const N a[3], const N b[3], const N c[3])
+{
+    return a[0]*det2(b[1],b[2],c[1],c[2]) - a[1]*det2(b[0],b[2],c[0],c[2]) + a[2]*det2(b[0],b[1],c[0],c[1]);
+}
+
+template<class N>
+CINO_INLINE
+N det4(const N a[4], const N b[4], const N c[4], const N d[4])
+{
+    N s0 = det2(a[0],a[1],b[0],b[1]);
+    N s1 = det2(a[0],a[2],b[0],b[2]);
+    N s2 = det2(a[0],a[3],b[0],b[3]);
+    N s3 = det2(a[1],a[2],b[1],b[2]);
+    N s4 = det2(a[1],a[3],b[1],b[3]);
+    N s5 = det2(a[2],a[3],b[2],b[3]);
+    N c5 = det2(c[2],c[3],d[2],d[3]);
+    N c4 = det2(c[1],c[3],d[1],d[3]);
+    N c3 = det2(c[1],c[2],d[1],d[2]);
+    N c2 = det2(c[0],c[3],d[0],d[3]);
+    N c1 = det2(c[0],c[2],d[0],d[2]);
+    N c0 = det2(c[0],c[1],d[0],d[1]);
+    return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+}
+
+template<class N>
+CINO_INLINE
+void cross(const N a[3], const N b[3], N res[3])
+{
+    res[0] = a[1]*b[2] - a[2]*b[1];
+    res[1] = a[2]*b[0] - a[0]*b[2];
+    res[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+template<class N>
+CINO_INLINE
+N dot(const N a[3], const N b[3])
+{
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// homogeneous coordinates (X,Y,Z,W) of an implicit point,
+// as polynomials in the coordinates of its explicit points
+template<class N>
+CINO_INLINE
+void homogeneous_coords(const ImplicitPointType t, const vec3d v[], N h[4])
+{
+    switch(t)
+    {
+        case EXPLICIT:
+        {
+            for(int i=0; i<3; ++i) h[i] = N(v[0][i]);
+            h[3] = N(1.0);
+            break;
+        }
+        case LPI:
+        {
+            // P = p + (q-p) * n.dot(r-p) / n.dot(q-p), with n the plane normal
+            N p[3], qp[3], rp[3], sr[3], tr[3], n[3];
+            for(int i=0; i<3; ++i)
+            {
+                p [i] = N(v[0][i]);
+                qp[i] = N(v[1][i]) - p[i];
+                rp[i] = N(v[2][i]) - p[i];
+                sr[i] = N(v[3][i]) - N(v[2][i]);
+                tr[i] = N(v[4][i]) - N(v[2][i]);
+            }
+            cross(sr, tr, n);
+            N w   = dot(n, qp);
+            N num = dot(n, rp);
+            for(int i=0; i<3; ++i) h[i] = p[i]*w + qp[i]*num;
+            h[3] = w;
+            break;
+        }
+        case TPI:
+        {
+            // Cramer's rule on the system n_i.dot(P) = n_i.dot(p_i)
+            N n[3][3], d[3];
+            for(int j=0; j<3; ++j)
+            {
+                N p[3], qp[3], rp[3];
+                for(int i=0; i<3; ++i)
+                {
+                    p [i] = N(v[3*j  ][i]);
+                    qp[i] = N(v[3*j+1][i]) - p[i];
+                    rp[i] = N(v[3*j+2][i]) - p[i];
+                }
+                cross(qp, rp, n[j]);
+                d[j] = dot(n[j], p);
+            }
+            for(int i=0; i<3; ++i)
+            {
+                N m[3][3];
+                for(int j=0; j<3; ++j)
+                for(int k=0; k<3; ++k)
+                {
+                    m[j][k] = (k==i) ? d[j] : n[j][k];
+                }
+                h[i] = det3(m[0], m[1], m[2]);
+            }
+            h[3] = det3(n[0], n[1], n[2]);
+            break;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void homogeneous_coords(const ImplicitPoint & p, fval h[4])
+{
+    for(int i=0; i<4; ++i) h[i] = fval(p.h[i], p.h_err[i]);
+}
+
+CINO_INLINE
+void homogeneous_coords(const ImplicitPoint & p, xval h[4])
+{
+    homogeneous_coords(p.type(), &p.vert(0), h);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int sign_W(const ImplicitPoint & p)
+{
+    if(p.type()==EXPLICIT) return 1;
+    int s = sign(fval(p.h[3], p.h_err[3]));
+    if(s!=UNCERTAIN) return s;
+    xval h[4];
+    homogeneous_coords(p, h);
+    return sign(h[3]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// coordinates of p relative to the explicit point o, scaled by the W of p
+// (i.e. the first three coordinates of (X,Y,Z,W) - W*(o,1))
+template<class N>
+CINO_INLINE
+void relative_coords(const ImplicitPoint & p, const vec3d & o, N r[3])
+{
+    if(p.type()==EXPLICIT)
+    {
+        for(int i=0; i<3; ++i) r[i] = N(p.vert(0)[i]) - N(o[i]);
+        return;
+    }
+    N h[4];
+    homogeneous_coords(p, h);
+    for(int i=0; i<3; ++i) r[i] = h[i] - h[3]*N(o[i]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// determinant of the 3x3 matrix with rows (X,Y,W) of a,b,c (x,y being
+// the two coordinates of the projection), which has the same sign of
+// orient2d(a,b,c) times the signs of the W of a,b and c
+template<class N>
+CINO_INLINE
+N orient2d_hom(const ImplicitPoint & a, const ImplicitPoint & b, const ImplicitPoint & c, const uint x, const uint y)
+{
+    // the determinant is invariant to cyclic permutations of
+    // the rows: bring an explicit point (if any) in first position
+    const ImplicitPoint *p[3] = { &a, &b, &c };
+    if     (b.type()==EXPLICIT) { p[0] = &b; p[1] = &c; p[2] = &a; }
+    else if(c.type()==EXPLICIT) { p[0] = &c; p[1] = &a; p[2] = &b; }
+
+    if(p[0]->type()==EXPLICIT)
+    {
+        // subtract W times the row of p0 from the other rows, and expand along the last column
+        N r1[3], r2[3];
+        relative_coords(*p[1], p[0]->vert(0), r1);
+        relative_coords(*p[2], p[0]->vert(0), r2);
+        return det2(r1[x], r1[y], r2[x], r2[y]);
+    }
+
+    N ha[4], hb[4], hc[4];
+    homogeneous_coords(a, ha);
+    homogeneous_coords(b, hb);
+    homogeneous_coords(c, hc);
+    N ra[3] = { ha[x], ha[y], ha[3] };
+    N rb[3] = { hb[x], hb[y], hb[3] };
+    N rc[3] = { hc[x], hc[y], hc[3] };
+    return det3(ra, rb, rc);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// determinant of the 4x4 matrix with rows (X,Y,Z,W) of a,b,c,d, which has the
+// same sign of orient3d(a,b,c,d) times the signs of the W of a,b,c and d
+template<class N>
+CINO_INLINE
+N orient3d_hom(const ImplicitPoint & a, const ImplicitPoint & b, const ImplicitPoint & c, const ImplicitPoint & d)
+{
+    // the determinant is invariant to even permutations of
+    // the rows: bring an explicit point (if any) in first position
+    const ImplicitPoint *p[4] = { &a, &b, &c, &d };
+    if     (b.type()==EXPLICIT) { p[0] = &b; p[1] = &a; p[2] = &d; p[3] = &c; }
+    else if(c.type()==EXPLICIT) { p[0] = &c; p[1] = &d; p[2] = &a; p[3] = &b; }
+    else if(d.type()==EXPLICIT) { p[0] = &d; p[1] = &c; p[2] = &b; p[3] = &a; }
+
+    if(p[0]->type()==EXPLICIT)
+    {
+        // subtract W times the row of p0 from the other rows, and expand along the last column
+        N r1[3], r2[3], r3[3];
+        relative_coords(*p[1], p[0]->vert(0), r1);
+        relative_coords(*p[2], p[0]->vert(0), r2);
+        relative_coords(*p[3], p[0]->vert(0), r3);
+        return det3(r1, r3, r2);
+    }
+
+    N ha[4], hb[4], hc[4], hd[4];
+    homogeneous_coords(a, ha);
+    homogeneous_coords(b, hb);
+    homogeneous_coords(c, hc);
+    homogeneous_coords(d, hd);
+    return det4(ha, hb, hc, hd);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a[axis]*W_b - b[axis]*W_a, which has the same sign of a[axis]-b[axis]
+// times the signs of the W of a and b
+template<class N>
+CINO_INLINE
+N compare_hom(const ImplicitPoint & a, const ImplicitPoint & b, const uint axis)
+{
+    if(b.type()==EXPLICIT)
+    {
+        N r[3];
+        relative_coords(a, b.vert(0), r);
+        return r[axis];
+    }
+    if(a.type()==EXPLICIT)
+    {
+        N r[3];
+        relative_coords(b, a.vert(0), r);
+        return N(0.0) - r[axis];
+    }
+    N ha[4], hb[4];
+    homogeneous_coords(a, ha);
+    homogeneous_coords(b, hb);
+    return ha[axis]*hb[3] - hb[axis]*ha[3];
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ImplicitPoint::ImplicitPoint(const vec3d & p)
+{
+    t    = EXPLICIT;
+    v[0] = p;
+    init_filter();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ImplicitPoint ImplicitPoint::line_plane(const vec3d & p, const vec3d & q,
+                                        const vec3d & r, const vec3d & s, const vec3d & t)
+{
+    ImplicitPoint res;
+    res.t    = LPI;
+    res.v[0] = p;
+    res.v[1] = q;
+    res.v[2] = r;
+    res.v[3] = s;
+    res.v[4] = t;
+    res.init_filter();
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ImplicitPoint ImplicitPoint::three_planes(const vec3d & p0, const vec3d & q0, const vec3d & r0,
+                                          const vec3d & p1, const vec3d & q1, const vec3d & r1,
+                                          const vec3d & p2, const vec3d & q2, const vec3d & r2)
+{
+    ImplicitPoint res;
+    res.t    = TPI;
+    res.v[0] = p0;
+    res.v[1] = q0;
+    res.v[2] = r0;
+    res.v[3] = p1;
+    res.v[4] = q1;
+    res.v[5] = r1;
+    res.v[6] = p2;
+    res.v[7] = q2;
+    res.v[8] = r2;
+    res.init_filter();
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ImplicitPoint::init_filter()
+{
+    fval hf[4];
+    homogeneous_coords(t, v, hf);
+    for(int i=0; i<4; ++i)
+    {
+        h[i]     = hf[i].v;
+        h_err[i] = hf[i].e;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d ImplicitPoint::approx() const
+{
+    if(t==EXPLICIT) return v[0];
+    return vec3d(h[0]/h[3], h[1]/h[3], h[2]/h[3]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ImplicitPoint::is_degenerate() const
+{
+    return sign_W(*this)==0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double orient2d(const ImplicitPoint & a,
+                const ImplicitPoint & b,
+                const ImplicitPoint & c,
+                const uint            drop_axis)
+{
+    uint x = (drop_axis+1)%3;
+    uint y = (drop_axis+2)%3;
+    int  s = sign(orient2d_hom<fval>(a,b,c,x,y));
+    if(s==UNCERTAIN) s = sign(orient2d_hom<xval>(a,b,c,x,y));
+    if(s==0) return 0;
+    return s * sign_W(a) * sign_W(b) * sign_W(c);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double orient3d(const ImplicitPoint & a,
+                const ImplicitPoint & b,
+                const ImplicitPoint & c,
+                const ImplicitPoint & d)
+{
+    int s = sign(orient3d_hom<fval>(a,b,c,d));
+    if(s==UNCERTAIN) s = sign(orient3d_hom<xval>(a,b,c,d));
+    if(s==0) return 0;
+    return s * sign_W(a) * sign_W(b) * sign_W(c) * sign_W(d);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int compare_coord(const ImplicitPoint & a,
+                  const ImplicitPoint & b,
+                  const uint            axis)
+{
+    int s = sign(compare_hom<fval>(a,b,axis));
+    if(s==UNCERTAIN) s = sign(compare_hom<xval>(a,b,axis));
+    if(s==0) return 0;
+    return s * sign_W(a) * sign_W(b);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool points_are_coincident(const ImplicitPoint & a,
+                           const ImplicitPoint & b)
+{
+    return compare_coord(a,b,0)==0 &&
+           compare_coord(a,b,1)==0 &&
+           compare_coord(a,b,2)==0;
+}
+
+}
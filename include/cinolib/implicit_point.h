@@ -0,0 +1,185 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_IMPLICIT_POINT_H
+#define CINO_IMPLICIT_POINT_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+/* Implicit points are points in R^3 that are not defined by their coordinates, but
+ * by the geometric construction that generates them, starting from input (explicit)
+ * points with floating point coordinates. They allow to perform geometric constructions
+ * (e.g. the intersection between a segment and a triangle, or the vertices of a mesh
+ * arrangement) without rounding their results to vec3d, which would break the exactness
+ * of all the downstream predicates. Supported constructions are:
+ *
+ *     EXPLICIT : an input point
+ *     LPI      : the intersection between the line passing through p,q and the plane
+ *                passing through r,s,t
+ *     TPI      : the intersection of three planes, each passing through three points
+ *
+ * Each implicit point is described by homogeneous coordinates (X,Y,Z,W), where X, Y, Z
+ * and W are polynomials in the coordinates of the explicit points that define it. All
+ * the predicates below are exact, and evaluated lazily: they are first computed with
+ * floating point arithmetic and a dynamic bound of the rounding error (which is cached
+ * at construction time, for the homogeneous coordinates), and only if the bound says
+ * that the sign may be wrong they are re-evaluated in exact arithmetic, representing
+ * each intermediate number as a floating point expansion (i.e. an unevaluated sum of
+ * non overlapping doubles, as in Shewchuk's adaptive predicates). Exact evaluations
+ * therefore happen only for (almost) degenerate configurations. Predicates do not depend
+ * on the symbol CINOLIB_USES_SHEWCHUK_PREDICATES.
+ *
+ * Each implicit point stores a copy of the coordinates of the explicit points that define
+ * it. A rounded approximation of its position can be obtained with approx(), e.g. to
+ * store it in a mesh or export it. LPI points defined by a line parallel to the plane,
+ * and TPI points defined by planes that do not meet at a single point, are degenerate
+ * (i.e. W=0) and should not be used in predicates.
+ *
+ * For more details refer to:
+ *
+ *     Indirect Predicates for Geometric Constructions
+ *     Marco Attene
+ *     Computer-Aided Design, 2020
+ *
+ *     Fast and Robust Mesh Arrangements using Floating-point Arithmetic
+ *     Gianmarco Cherchi, Marco Livesu, Riccardo Scateni, Marco Attene
+ *     ACM Transactions on Graphics, 2020
+*/
+
+typedef enum
+{
+    EXPLICIT,
+    LPI,
+    TPI,
+}
+ImplicitPointType;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class ImplicitPoint
+{
+    public:
+
+        ImplicitPoint() : ImplicitPoint(vec3d(0,0,0)) {}
+
+        // explicit point
+        ImplicitPoint(const vec3d & p);
+
+        // intersection between the line through p,q and the plane through r,s,t
+        static ImplicitPoint line_plane(const vec3d & p, const vec3d & q,
+                                        const vec3d & r, const vec3d & s, const vec3d & t);
+
+        // intersection of the planes through (p0,q0,r0), (p1,q1,r1) and (p2,q2,r2)
+        static ImplicitPoint three_planes(const vec3d & p0, const vec3d & q0, const vec3d & r0,
+                                          const vec3d & p1, const vec3d & q1, const vec3d & r1,
+                                          const vec3d & p2, const vec3d & q2, const vec3d & r2);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        ImplicitPointType type() const { return t; }
+
+        // coordinates of the explicit points that define this point
+        // (1 for EXPLICIT, 5 for LPI, 9 for TPI, in the order above)
+        const vec3d & vert(const uint i) const { return v[i]; }
+
+        // floating point approximation of the point
+        vec3d approx() const;
+
+        // true if W is exactly zero (i.e. the construction does not define a point)
+        bool is_degenerate() const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // homogeneous coordinates (X,Y,Z,W) evaluated in floating point, and
+        // a bound of their absolute rounding error (zero for explicit points)
+        double h[4];
+        double h_err[4];
+
+    protected:
+
+        void init_filter();
+
+        ImplicitPointType t;
+        vec3d v[9];
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact orientation of the points a,b,c projected on the coordinate plane
+// orthogonal to drop_axis (i.e. on XY for drop_axis=2, on YZ for drop_axis=0,
+// on ZX for drop_axis=1). Returns +1 if they are counterclockwise, -1 if they
+// are clockwise, 0 if they are colinear (see orient2d in predicates.h)
+CINO_INLINE
+double orient2d(const ImplicitPoint & a,
+                const ImplicitPoint & b,
+                const ImplicitPoint & c,
+                const uint            drop_axis = 2);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact orientation of the points a,b,c,d. Same sign convention of orient3d
+// in predicates.h (returns +1, -1 or 0 if they are coplanar)
+CINO_INLINE
+double orient3d(const ImplicitPoint & a,
+                const ImplicitPoint & b,
+                const ImplicitPoint & c,
+                const ImplicitPoint & d);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact comparison of one coordinate of a and b (axis = 0,1,2 for x,y,z).
+// Returns +1 if a[axis] > b[axis], -1 if a[axis] < b[axis], 0 otherwise
+CINO_INLINE
+int compare_coord(const ImplicitPoint & a,
+                  const ImplicitPoint & b,
+                  const uint            axis);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if a and b are exactly the same point, regardless of their construction
+CINO_INLINE
+bool points_are_coincident(const ImplicitPoint & a,
+                           const ImplicitPoint & b);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "implicit_point.cpp"
+#endif
+
+#endif // CINO_IMPLICIT_POINT_H
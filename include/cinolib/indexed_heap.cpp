@@ -0,0 +1,152 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/indexed_heap.h>
+#include <algorithm>
+#include <cassert>
+
+namespace cinolib
+{
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::resize(const uint n)
+{
+    heap.clear();
+    heap.reserve(n);
+    pos.assign(n, -1);
+    prio.assign(n, 0.0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::clear()
+{
+    for(uint key : heap) pos[key] = -1;
+    heap.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+bool IndexedHeap<D>::push_or_decrease(const uint key, const double priority)
+{
+    assert(key < pos.size());
+    if(pos[key] < 0)
+    {
+        pos[key]  = heap.size();
+        prio[key] = priority;
+        heap.push_back(key);
+    }
+    else if(priority < prio[key])
+    {
+        prio[key] = priority;
+    }
+    else return false;
+
+    sift_up(pos[key]);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+uint IndexedHeap<D>::pop()
+{
+    assert(!empty());
+    uint key = heap.front();
+    pos[key] = -1;
+    if(heap.size() > 1)
+    {
+        heap.front() = heap.back();
+        pos[heap.front()] = 0;
+        heap.pop_back();
+        sift_down(0);
+    }
+    else heap.pop_back();
+    return key;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::sift_up(uint i)
+{
+    uint key = heap[i];
+    while(i > 0)
+    {
+        uint parent = (i-1)/D;
+        if(prio[heap[parent]] <= prio[key]) break;
+        heap[i] = heap[parent];
+        pos[heap[i]] = i;
+        i = parent;
+    }
+    heap[i]  = key;
+    pos[key] = i;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::sift_down(uint i)
+{
+    uint key = heap[i];
+    uint n   = heap.size();
+    while(true)
+    {
+        uint first = D*i+1;
+        if(first >= n) break;
+        uint last  = std::min(first+D, n);
+        uint child = first;
+        for(uint c=first+1; c<last; ++c)
+        {
+            if(prio[heap[c]] < prio[heap[child]]) child = c;
+        }
+        if(prio[key] <= prio[heap[child]]) break;
+        heap[i] = heap[child];
+        pos[heap[i]] = i;
+        i = child;
+    }
+    heap[i]  = key;
+    pos[key] = i;
+}
+
+}
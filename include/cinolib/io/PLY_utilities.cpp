@@ -0,0 +1,94 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/PLY_utilities.h>
+#include <cstring>
+
+namespace cinolib
+{
+
+CINO_INLINE
+PLY_type PLY_type_from_string(const std::string & str)
+{
+    if(str=="char"   || str=="int8"   ) return PLY_INT8;
+    if(str=="uchar"  || str=="uint8"  ) return PLY_UINT8;
+    if(str=="short"  || str=="int16"  ) return PLY_INT16;
+    if(str=="ushort" || str=="uint16" ) return PLY_UINT16;
+    if(str=="int"    || str=="int32"  ) return PLY_INT32;
+    if(str=="uint"   || str=="uint32" ) return PLY_UINT32;
+    if(str=="float"  || str=="float32") return PLY_FLOAT32;
+    if(str=="double" || str=="float64") return PLY_FLOAT64;
+    return PLY_UNKNOWN;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint PLY_type_size(const PLY_type type)
+{
+    switch(type)
+    {
+        case PLY_INT8    :
+        case PLY_UINT8   : return 1;
+        case PLY_INT16   :
+        case PLY_UINT16  : return 2;
+        case PLY_INT32   :
+        case PLY_UINT32  :
+        case PLY_FLOAT32 : return 4;
+        case PLY_FLOAT64 : return 8;
+        default          : return 0;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PLY_type_is_integer(const PLY_type type)
+{
+    return type!=PLY_FLOAT32 && type!=PLY_FLOAT64 && type!=PLY_UNKNOWN;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PLY_host_is_little_endian()
+{
+    uint32_t one = 1;
+    unsigned char c;
+    memcpy(&c, &one, 1);
+    return c==1;
+}
+
+}
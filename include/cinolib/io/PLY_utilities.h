@@ -0,0 +1,112 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_PLY_UTILITIES_H
+#define CINO_PLY_UTILITIES_H
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Facilities shared by the PLY reader and writer. A PLY file is made of a
+ * textual header listing the elements (e.g. vertex, face) and their typed
+ * properties, followed by the element records stored either as ASCII text or
+ * as packed binary data, in little or big endian byte order.
+ *
+ * Properties that have a counterpart in the standard mesh attributes (see
+ * meshes/mesh_attributes.h) are mapped to them. The flags below tell which
+ * ones are present in a file:
+ *
+ *     PLY_NORMAL  : nx, ny, nz
+ *     PLY_COLOR   : red, green, blue, alpha (also with diffuse_ prefix)
+ *     PLY_UVW     : u, v, w (also s, t and texture_u, texture_v). w is written only if non zero
+ *     PLY_LABEL   : label
+ *     PLY_QUALITY : quality
+ *
+ * Reference: http://paulbourke.net/dataformats/ply/
+*/
+
+enum
+{
+    PLY_NORMAL  = 0x01,
+    PLY_COLOR   = 0x02,
+    PLY_UVW     = 0x04,
+    PLY_LABEL   = 0x08,
+    PLY_QUALITY = 0x10,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+enum PLY_type
+{
+    PLY_INT8,
+    PLY_UINT8,
+    PLY_INT16,
+    PLY_UINT16,
+    PLY_INT32,
+    PLY_UINT32,
+    PLY_FLOAT32,
+    PLY_FLOAT64,
+    PLY_UNKNOWN,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// accepts both the old (char, uchar, short, ...) and the new (int8, uint8, ...) type names
+CINO_INLINE
+PLY_type PLY_type_from_string(const std::string & str);
+
+CINO_INLINE
+uint PLY_type_size(const PLY_type type);
+
+CINO_INLINE
+bool PLY_type_is_integer(const PLY_type type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PLY_host_is_little_endian();
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "PLY_utilities.cpp"
+#endif
+
+#endif // CINO_PLY_UTILITIES_H
@@ -0,0 +1,213 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/VTU_utilities.h>
+#include <iostream>
+#include <cassert>
+
+#ifdef CINOLIB_USES_ZLIB
+#include <zlib.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+void base64_encode(const unsigned char * data,
+                   const size_t          size,
+                         std::string   & out)
+{
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    size_t off = out.size();
+    out.resize(off + 4*((size+2)/3));
+    char *ptr = &out[off];
+
+    size_t i=0;
+    for(; i+2<size; i+=3)
+    {
+        uint32_t n = (uint32_t(data[i])<<16) | (uint32_t(data[i+1])<<8) | uint32_t(data[i+2]);
+        *ptr++ = table[(n>>18) & 63];
+        *ptr++ = table[(n>>12) & 63];
+        *ptr++ = table[(n>> 6) & 63];
+        *ptr++ = table[ n      & 63];
+    }
+    if(i<size)
+    {
+        uint32_t n = uint32_t(data[i])<<16;
+        if(i+1<size) n |= uint32_t(data[i+1])<<8;
+        *ptr++ = table[(n>>18) & 63];
+        *ptr++ = table[(n>>12) & 63];
+        *ptr++ = (i+1<size) ? table[(n>>6) & 63] : '=';
+        *ptr++ = '=';
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void base64_decode(const char                       * beg,
+                   const char                       * end,
+                         std::vector<unsigned char> & out)
+{
+    struct Table
+    {
+        int v[256];
+        Table()
+        {
+            const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for(int i=0; i<256; ++i) v[i] = -1;
+            for(int i=0; i<64;  ++i) v[uint(alphabet[i])] = i;
+        }
+    };
+    static const Table table; // thread safe initialization (C++11)
+
+    out.clear();
+    out.reserve(3*(end-beg)/4);
+
+    // each quadruplet is decoded independently, hence padding
+    // characters in the middle of the string are handled as well
+    int quad[4], n=0, pad=0;
+    for(const char *c=beg; c<end; ++c)
+    {
+        if(*c=='=')
+        {
+            quad[n++] = 0;
+            ++pad;
+        }
+        else
+        {
+            int v = table.v[uint((unsigned char)*c)];
+            if(v<0) continue; // white spaces, new lines,...
+            quad[n++] = v;
+        }
+        if(n==4)
+        {
+            uint32_t bits = (uint32_t(quad[0])<<18) | (uint32_t(quad[1])<<12) | (uint32_t(quad[2])<<6) | uint32_t(quad[3]);
+                       out.push_back((bits>>16) & 0xFF);
+            if(pad<2)  out.push_back((bits>> 8) & 0xFF);
+            if(pad<1)  out.push_back( bits      & 0xFF);
+            n   = 0;
+            pad = 0;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_ZLIB
+
+CINO_INLINE
+bool zlib_compress_blocks(const unsigned char              * data,
+                          const size_t                       size,
+                                std::vector<uint64_t>      & block_table,
+                                std::vector<unsigned char> & compressed,
+                          const size_t                       block_size)
+{
+    size_t nb   = (size + block_size - 1)/block_size;
+    size_t last = size - (nb>0 ? (nb-1)*block_size : 0);
+
+    block_table.clear();
+    block_table.push_back(nb);
+    block_table.push_back(block_size);
+    block_table.push_back(last==block_size ? 0 : last); // VTK convention: zero if the last block is full
+
+    compressed.clear();
+    compressed.reserve(size/2);
+
+    std::vector<unsigned char> buf(compressBound(block_size));
+    for(size_t i=0; i<nb; ++i)
+    {
+        size_t bs  = (i+1<nb) ? block_size : last;
+        uLongf len = buf.size();
+        if(compress2(buf.data(), &len, data + i*block_size, bs, Z_DEFAULT_COMPRESSION)!=Z_OK) return false;
+        compressed.insert(compressed.end(), buf.begin(), buf.begin()+len);
+        block_table.push_back(len);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool zlib_uncompress_blocks(const std::vector<uint64_t>      & block_table,
+                            const unsigned char              * compressed,
+                                  std::vector<unsigned char> & data)
+{
+    assert(block_table.size()>=3);
+    size_t nb   = block_table.at(0);
+    size_t bs   = block_table.at(1);
+    size_t last = (block_table.at(2)==0) ? bs : block_table.at(2);
+    assert(block_table.size()==3+nb);
+
+    data.resize(nb>0 ? (nb-1)*bs + last : 0);
+
+    size_t off = 0;
+    for(size_t i=0; i<nb; ++i)
+    {
+        uLongf len = (i+1<nb) ? bs : last;
+        if(uncompress(data.data() + i*bs, &len, compressed + off, block_table.at(3+i))!=Z_OK) return false;
+        off += block_table.at(3+i);
+    }
+    return true;
+}
+
+#else
+
+CINO_INLINE
+bool zlib_compress_blocks(const unsigned char              *,
+                          const size_t                       ,
+                                std::vector<uint64_t>      &,
+                                std::vector<unsigned char> &,
+                          const size_t                       )
+{
+    std::cerr << "ERROR : ZLIB missing. Install ZLIB and recompile defining symbol CINOLIB_USES_ZLIB" << std::endl;
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool zlib_uncompress_blocks(const std::vector<uint64_t>      &,
+                            const unsigned char              *,
+                                  std::vector<unsigned char> &)
+{
+    std::cerr << "ERROR : ZLIB missing. Install ZLIB and recompile defining symbol CINOLIB_USES_ZLIB" << std::endl;
+    return false;
+}
+
+#endif
+
+}
@@ -0,0 +1,126 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_VTU_UTILITIES_H
+#define CINO_VTU_UTILITIES_H
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Facilities shared by the native VTU reader and writer. The VTK XML format
+ * for unstructured grids can store its arrays in four different ways:
+ *
+ *     VTU_ASCII           : human readable, but huge and slow to parse
+ *     VTU_BINARY          : base64 encoded binary data, inlined in each <DataArray>
+ *     VTU_APPENDED_RAW    : raw binary data, appended at the end of the file
+ *     VTU_APPENDED_BASE64 : base64 encoded binary data, appended at the end of the file
+ *
+ * Binary blocks are always preceded by a header that tells their size in bytes.
+ * If the file is compressed (vtkZLibDataCompressor) the header is replaced by a
+ * block table [#blocks, block size, last block size, compressed size of each block].
+ * Compression is available only if CINOLIB_USES_ZLIB is defined.
+ *
+ * Reference: https://vtk.org/Wiki/VTK_XML_Formats
+*/
+
+enum
+{
+    VTU_ASCII,
+    VTU_BINARY,
+    VTU_APPENDED_RAW, // default
+    VTU_APPENDED_BASE64,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Per point or per cell data, stored in the <PointData> and <CellData> sections.
+// Values are serialized (n_components entries for each point/cell)
+//
+struct VTU_data_array
+{
+    std::string         name;
+    uint                n_components = 1;
+    std::vector<double> values;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void base64_encode(const unsigned char * data,
+                   const size_t          size,
+                         std::string   & out);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// decodes the string [beg,end), skipping white spaces. Concatenated
+// streams (each one with its own padding) are decoded as a unique stream
+//
+CINO_INLINE
+void base64_decode(const char                       * beg,
+                   const char                       * end,
+                         std::vector<unsigned char> & out);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits data into blocks of block_size bytes and compresses each of them
+// independently, filling the VTK block table and the compressed stream
+//
+CINO_INLINE
+bool zlib_compress_blocks(const unsigned char              * data,
+                          const size_t                       size,
+                                std::vector<uint64_t>      & block_table,
+                                std::vector<unsigned char> & compressed,
+                          const size_t                       block_size = 32768);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool zlib_uncompress_blocks(const std::vector<uint64_t>      & block_table,
+                            const unsigned char              * compressed,
+                                  std::vector<unsigned char> & data);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "VTU_utilities.cpp"
+#endif
+
+#endif // CINO_VTU_UTILITIES_H
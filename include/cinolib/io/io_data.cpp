@@ -0,0 +1,171 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/io_data.h>
+#include <cassert>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void IOData::clear()
+{
+    verts.clear();
+    vert_uvw.clear();
+    vert_normals.clear();
+    vert_colors.clear();
+    vert_labels.clear();
+    faces.clear();
+    face_offsets.clear();
+    polys.clear();
+    poly_offsets = {0};
+    poly_winding.clear();
+    poly_colors.clear();
+    poly_labels.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint IOData::face_add(const std::vector<uint> & f)
+{
+    if(face_offsets.empty()) face_offsets.push_back(0);
+    faces.insert(faces.end(), f.begin(), f.end());
+    face_offsets.push_back(faces.size());
+    return num_faces()-1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint IOData::poly_add(const std::vector<uint> & p)
+{
+    polys.insert(polys.end(), p.begin(), p.end());
+    poly_offsets.push_back(polys.size());
+    return num_polys()-1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint IOData::poly_add(const std::vector<uint> & p, const std::vector<bool> & winding)
+{
+    assert(p.size()==winding.size());
+    poly_winding.insert(poly_winding.end(), winding.begin(), winding.end());
+    return poly_add(p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IOData::set_faces(const std::vector<std::vector<uint>> & f)
+{
+    size_t size = 0;
+    for(const auto & face : f) size += face.size();
+    faces.clear();
+    faces.reserve(size);
+    face_offsets.clear();
+    face_offsets.reserve(f.size()+1);
+    for(const auto & face : f) face_add(face);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IOData::set_polys(const std::vector<std::vector<uint>> & p)
+{
+    size_t size = 0;
+    for(const auto & poly : p) size += poly.size();
+    polys.clear();
+    polys.reserve(size);
+    poly_offsets = {0};
+    poly_offsets.reserve(p.size()+1);
+    poly_winding.clear();
+    for(const auto & poly : p) poly_add(poly);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IOData::set_polys(const std::vector<std::vector<uint>> & p, const std::vector<std::vector<bool>> & winding)
+{
+    assert(p.size()==winding.size());
+    set_polys(p);
+    poly_winding.reserve(polys.size());
+    for(const auto & w : winding) poly_winding.insert(poly_winding.end(), w.begin(), w.end());
+    assert(poly_winding.size()==polys.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<uint>> IOData::vector_faces() const
+{
+    std::vector<std::vector<uint>> res(num_faces());
+    for(uint fid=0; fid<num_faces(); ++fid)
+    {
+        res[fid].assign(face(fid), face(fid) + verts_per_face(fid));
+    }
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<uint>> IOData::vector_polys() const
+{
+    std::vector<std::vector<uint>> res(num_polys());
+    for(uint pid=0; pid<num_polys(); ++pid)
+    {
+        res[pid].assign(poly(pid), poly(pid) + verts_per_poly(pid));
+    }
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<bool>> IOData::vector_poly_winding() const
+{
+    std::vector<std::vector<bool>> res(num_polys());
+    if(poly_winding.empty()) return res;
+    for(uint pid=0; pid<num_polys(); ++pid)
+    {
+        res[pid].assign(poly_winding.begin() + poly_offsets[pid], poly_winding.begin() + poly_offsets[pid+1]);
+    }
+    return res;
+}
+
+}
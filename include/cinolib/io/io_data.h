@@ -0,0 +1,123 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_IO_DATA_H
+#define CINO_IO_DATA_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/color.h>
+
+namespace cinolib
+{
+
+/* Container for all the data a mesh file can hold, filled by read_mesh and
+ * consumed by write_mesh. Elements are serialized: the vertices of the i-th
+ * poly are polys[poly_offsets[i]] ... polys[poly_offsets[i+1]-1]. If faces is
+ * not empty (general polyhedra), polys refer to faces rather than vertices, and
+ * poly_winding tells, for each entry of polys, whether the face is CCW when
+ * seen from outside the poly. Per element attributes (uvw, normals, colors,
+ * labels) are optional: they are either empty or as long as their elements.
+ *
+ * The OFF, OBJ, STL, MESH and VTU parsers append elements straight to these
+ * buffers, and the matching writers read from them. The other formats still
+ * go through a vector of vectors. Mesh classes can be constructed from an
+ * IOData rvalue, in which case the vertex positions are moved into the mesh
+ * rather than copied. Elements are copied once, as the mesh builds its own
+ * connectivity.
+*/
+
+class IOData
+{
+    public:
+
+        std::vector<vec3d> verts;
+        std::vector<vec3d> vert_uvw;
+        std::vector<vec3d> vert_normals;
+        std::vector<Color> vert_colors;
+        std::vector<int>   vert_labels;
+
+        std::vector<uint>  faces;          // (general polyhedra only)
+        std::vector<uint>  face_offsets;   // (general polyhedra only)
+
+        std::vector<uint>  polys;
+        std::vector<uint>  poly_offsets = {0};
+        std::vector<bool>  poly_winding;   // (general polyhedra only)
+        std::vector<Color> poly_colors;
+        std::vector<int>   poly_labels;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint num_verts() const { return verts.size(); }
+        uint num_faces() const { return face_offsets.empty() ? 0 : face_offsets.size()-1; }
+        uint num_polys() const { return poly_offsets.size()-1; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint         verts_per_face(const uint fid) const { return face_offsets[fid+1] - face_offsets[fid]; }
+        uint         verts_per_poly(const uint pid) const { return poly_offsets[pid+1] - poly_offsets[pid]; }
+        const uint * face          (const uint fid) const { return faces.data() + face_offsets[fid]; }
+        const uint * poly          (const uint pid) const { return polys.data() + poly_offsets[pid]; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint face_add(const std::vector<uint> & f);
+        uint poly_add(const std::vector<uint> & p);
+        uint poly_add(const std::vector<uint> & p, const std::vector<bool> & winding);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // conversion from/to the vector of vectors representation used by the file parsers
+        void set_faces(const std::vector<std::vector<uint>> & f);
+        void set_polys(const std::vector<std::vector<uint>> & p);
+        void set_polys(const std::vector<std::vector<uint>> & p, const std::vector<std::vector<bool>> & winding);
+        std::vector<std::vector<uint>> vector_faces() const;
+        std::vector<std::vector<uint>> vector_polys() const;
+        std::vector<std::vector<bool>> vector_poly_winding() const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "io_data.cpp"
+#endif
+
+#endif // CINO_IO_DATA_H
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_CLI.h>
+#include <cinolib/string_utilities.h>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -91,7 +92,7 @@ void read_CLI(const char                                   * filename,
               std::vector<std::vector<std::vector<vec3d>>> & open_polylines,     // support structures
               std::vector<std::vector<std::vector<vec3d>>> & hatches)            // supports/infills
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     internal_polylines.clear();
     external_polylines.clear();
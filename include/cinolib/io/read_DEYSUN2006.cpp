@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_DEYSUN2006.h>
+#include <cinolib/string_utilities.h>
 
 
 
@@ -46,7 +47,7 @@ void read_DeyandSun2006(const char          * filename,
                         std::vector<int>    & arcs,
                         std::vector<double> & radius)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     coords.clear();
     arcs.clear();
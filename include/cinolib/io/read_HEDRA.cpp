@@ -34,19 +34,20 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_HEDRA.h>
+#include <cinolib/string_utilities.h>
 #include <iostream>
 
 namespace cinolib
 {
 
 CINO_INLINE
-void read_HEDRA(const char                     * filename,
+bool read_HEDRA(const char                     * filename,
                 std::vector<vec3d>             & verts,
                 std::vector<std::vector<uint>> & faces,
                 std::vector<std::vector<uint>> & polys,
                 std::vector<std::vector<bool>> & polys_winding)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     verts.clear();
     faces.clear();
@@ -58,45 +59,45 @@ void read_HEDRA(const char                     * filename,
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_HEDRA() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     uint nv, nf, np;
-    fscanf(fp, "%d %d %d", &nv, &nf, &np);
+    bool ok = (fscanf(fp, "%d %d %d", &nv, &nf, &np)==3);
 
-    for(uint i=0; i<nv; ++i)
+    for(uint i=0; i<nv && ok; ++i)
     {
         double x, y, z;
-        fscanf(fp, "%lf %lf %lf", &x, &y, &z);
+        ok = (fscanf(fp, "%lf %lf %lf", &x, &y, &z)==3);
         verts.push_back(vec3d(x,y,z));
     }
 
-    for(uint i=0; i<nf; ++i)
+    for(uint i=0; i<nf && ok; ++i)
     {
-        uint n_verts;
-        fscanf(fp, "%d", &n_verts);
+        uint n_verts = 0;
+        ok = (fscanf(fp, "%d", &n_verts)==1);
 
         std::vector<uint> f;
-        for(uint j=0; j<n_verts; ++j)
+        for(uint j=0; j<n_verts && ok; ++j)
         {
             uint vid;
-            fscanf(fp, "%d", &vid);
+            ok = (fscanf(fp, "%d", &vid)==1);
             f.push_back(vid-1);
         }
         faces.push_back(f);
     }
 
-    for(uint i=0; i<np; ++i)
+    for(uint i=0; i<np && ok; ++i)
     {
-        uint nf;
-        fscanf(fp, "%d", &nf);
+        uint nf = 0;
+        ok = (fscanf(fp, "%d", &nf)==1);
 
         std::vector<uint> p;
         std::vector<bool> p_winding;
-        for(uint j=0; j<nf; ++j)
+        for(uint j=0; j<nf && ok; ++j)
         {
             int fid;
-            fscanf(fp, "%d", &fid);
+            ok = (fscanf(fp, "%d", &fid)==1);
 
             if (fid > 0)
             {
@@ -114,6 +115,13 @@ void read_HEDRA(const char                     * filename,
     }
 
     fclose(fp);
+
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_HEDRA() : failed reading " << filename << std::endl;
+        return false;
+    }
+    return true;
 }
 
 }
@@ -45,7 +45,7 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_HEDRA(const char                     * filename,
+bool read_HEDRA(const char                     * filename,
                 std::vector<vec3d>             & verts,
                 std::vector<std::vector<uint>> & faces,
                 std::vector<std::vector<uint>> & polys,
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_HEXEX.h>
+#include <cinolib/string_utilities.h>
 #include <sstream>
 #include <iostream>
 #include <assert.h>
@@ -47,7 +48,7 @@ void read_HEXEX(const char         * filename,
                 std::vector<uint>  & tets,        // serialized tets (4 vids per tet)
                 std::vector<vec3d> & tets_param) // tets param (4 points per tet)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     verts.clear();
     tets.clear();
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_HYBRID.h>
+#include <cinolib/string_utilities.h>
 #include <iostream>
 
 namespace cinolib
@@ -46,7 +47,7 @@ void read_HYBDRID(const char                     * filename,
                   std::vector<std::vector<uint>> & polys,
                   std::vector<std::vector<bool>> & polys_face_winding)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     verts.clear();
     faces.clear();
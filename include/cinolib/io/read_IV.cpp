@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_IV.h>
+#include <cinolib/string_utilities.h>
 #include <cinolib/io/io_utilities.h>
 
 namespace cinolib
@@ -45,7 +46,7 @@ void read_IV(const char          * filename,
              std::vector<uint>   & tri,
              std::vector<int>    & patch)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "r");
 
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_LIVESU2012.h>
+#include <cinolib/string_utilities.h>
 
 #include <map>
 #include <set>
@@ -58,7 +59,7 @@ void read_Livesu2012(const char          * filename,
                      std::vector<int>    & arcs,
                      std::vector<double> & radius)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     coords.clear();
     arcs.clear();
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_MESH.h>
+#include <cinolib/string_utilities.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/io/io_utilities.h>
 #include <iostream>
@@ -43,24 +44,17 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_MESH(const char                     * filename,
-               std::vector<vec3d>             & verts,
-               std::vector<std::vector<uint>> & polys,
-               std::vector<int>               & vert_labels,
-               std::vector<int>               & poly_labels)
+bool read_MESH(const char * filename, IOData & data)
 {
-    verts.clear();
-    polys.clear();
-    vert_labels.clear();
-    poly_labels.clear();
+    data.clear();
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *f = fopen(filename, "r");
     if(!f)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     std::unordered_set<int> v_unique_labels;
@@ -68,14 +62,16 @@ void read_MESH(const char                     * filename,
 
     // read header
     int ver, dim, nv, nc;
-    if(!seek_keyword(f, "MeshVersionFormatted")) assert(false && "could not find keyword MESHVERSIONFORMATTED");
-    eat_int(f, ver);
-    if(!seek_keyword(f, "Dimension")) assert(false && "could not find keyword DIMENSION");
-    eat_int(f, dim);
+    if(!seek_keyword(f, "MeshVersionFormatted") || !eat_int(f, ver) ||
+       !seek_keyword(f, "Dimension")            || !eat_int(f, dim) ||
+       !seek_keyword(f, "Vertices")             || !eat_int(f, nv))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : missing header in " << filename << std::endl;
+        fclose(f);
+        return false;
+    }
 
     // read verts
-    if(!seek_keyword(f, "Vertices")) assert(false && "could not find keyword VERTICES");
-    eat_int(f, nv);
     for(int i=0; i<nv; ++i)
     {
         double x=0,y=0,z=0;
@@ -83,9 +79,14 @@ void read_MESH(const char                     * filename,
         if(!eat_double(f, x) ||
            !eat_double(f, y) ||
            !eat_double(f, z) ||
-           !eat_int(f, l)) assert(false && "failed reading vert");
-        verts.push_back(vec3d(x,y,z));
-        vert_labels.push_back(l);
+           !eat_int(f, l))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading vert" << std::endl;
+            fclose(f);
+            return false;
+        }
+        data.verts.push_back(vec3d(x,y,z));
+        data.vert_labels.push_back(l);
         v_unique_labels.insert(l);
     }
 
@@ -96,9 +97,9 @@ void read_MESH(const char                     * filename,
         if(strcmp(cell_type, "End")==0)
         {
             fclose(f);
-            if(v_unique_labels.size()<2) vert_labels.clear();
-            if(p_unique_labels.size()<2) poly_labels.clear();
-            return;
+            if(v_unique_labels.size()<2) data.vert_labels.clear();
+            if(p_unique_labels.size()<2) data.poly_labels.clear();
+            return true;
         }
         else if(strcmp(cell_type, "#")==0)
         {
@@ -108,30 +109,45 @@ void read_MESH(const char                     * filename,
         }
         else if(strcmp(cell_type, "Tetrahedra")==0)
         {
-            if(!eat_int(f, nc)) assert(false && "failed reading num tets");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading num tets" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 int l;
-                std::vector<uint> tet(4);
+                uint tet[4];
                 if(!eat_uint(f, tet[0]) ||
                    !eat_uint(f, tet[1]) ||
                    !eat_uint(f, tet[2]) ||
                    !eat_uint(f, tet[3]) ||
-                   !eat_int(f, l)) assert(false && "failed reading tet");
+                   !eat_int(f, l))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading tet" << std::endl;
+                    fclose(f);
+                    return false;
+                }
 
-                for(uint & vid : tet) vid -= 1;
-                polys.push_back(tet);
-                poly_labels.push_back(l);
+                for(uint vid : tet) data.polys.push_back(vid-1);
+                data.poly_offsets.push_back(data.polys.size());
+                data.poly_labels.push_back(l);
                 p_unique_labels.insert(l);
             }
         }
         else if(strcmp(cell_type, "Hexahedra")==0)
         {
-            if(!eat_int(f, nc)) assert(false && "failed reading num hexa");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading num hexa" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 int l;
-                std::vector<uint> hex(8);                
+                uint hex[8];
                 if(!eat_uint(f, hex[0]) ||
                    !eat_uint(f, hex[1]) ||
                    !eat_uint(f, hex[2]) ||
@@ -140,17 +156,27 @@ void read_MESH(const char                     * filename,
                    !eat_uint(f, hex[5]) ||
                    !eat_uint(f, hex[6]) ||
                    !eat_uint(f, hex[7]) ||
-                   !eat_int(f, l)) assert(false && "failed reading hexa");
+                   !eat_int(f, l))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading hexa" << std::endl;
+                    fclose(f);
+                    return false;
+                }
 
-                for(uint & vid : hex) vid -= 1;
-                polys.push_back(hex);
-                poly_labels.push_back(l);
+                for(uint vid : hex) data.polys.push_back(vid-1);
+                data.poly_offsets.push_back(data.polys.size());
+                data.poly_labels.push_back(l);
                 p_unique_labels.insert(l);
             }
         }
         else if(strcmp(cell_type, "Triangles")==0)
         {
-            if(!eat_int(f, nc))  assert(false && "failed reading num tris");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading num tris" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 int l;
@@ -158,13 +184,23 @@ void read_MESH(const char                     * filename,
                 if(!eat_uint(f, tri[0]) ||
                    !eat_uint(f, tri[1]) ||
                    !eat_uint(f, tri[2]) ||
-                   !eat_int(f, l)) assert(false && "failed reading tri");
+                   !eat_int(f, l))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading tri" << std::endl;
+                    fclose(f);
+                    return false;
+                }
                 // discard these elements
             }
         }
         else if(strcmp(cell_type, "Quadrilaterals")==0)
         {
-            if(!eat_int(f, nc))  assert(false && "failed reading num quads");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading num quads" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 int l;
@@ -173,58 +209,107 @@ void read_MESH(const char                     * filename,
                    !eat_uint(f, quad[1]) ||
                    !eat_uint(f, quad[2]) ||
                    !eat_uint(f, quad[3]) ||
-                   !eat_int(f, l)) assert(false && "failed reading quad");
+                   !eat_int(f, l))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading quad" << std::endl;
+                    fclose(f);
+                    return false;
+                }
                 // discard these elements
             }
         }
         else if(strcmp(cell_type, "Edges")==0)
         {
-            if(!eat_int(f, nc)) assert(false && "failed reading num edges");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading num edges" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 int l;
                 std::vector<uint> edge(4);
                 if(!eat_uint(f, edge[0]) ||
                    !eat_uint(f, edge[1]) ||
-                   !eat_int(f, l)) assert(false && "failed reading edge");
+                   !eat_int(f, l))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading edge" << std::endl;
+                    fclose(f);
+                    return false;
+                }
                 // discard these elements
             }
         }
         else if(strcmp(cell_type, "Corners")==0)
         {
-            if(!eat_int(f, nc)) assert(false && "failed reading corners");
+            if(!eat_int(f, nc))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading corners" << std::endl;
+                fclose(f);
+                return false;
+            }
             for(int i=0; i<nc; ++i)
             {
                 std::vector<uint> corner(4);
-                if(!eat_uint(f, corner[0])) assert(false && "failed reading corner");
+                if(!eat_uint(f, corner[0]))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MESH() : failed reading corner" << std::endl;
+                    fclose(f);
+                    return false;
+                }
                 // discard these elements
             }
         }
     }
+    // no End keyword
+    fclose(f);
+    if(v_unique_labels.size()<2) data.vert_labels.clear();
+    if(p_unique_labels.size()<2) data.poly_labels.clear();
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_MESH(const char                     * filename,
+               std::vector<vec3d>             & verts,
+               std::vector<std::vector<uint>> & polys,
+               std::vector<int>               & vert_labels,
+               std::vector<int>               & poly_labels)
+{
+    IOData data;
+    bool ok = read_MESH(filename, data);
+    verts       = std::move(data.verts);
+    polys       = data.vector_polys();
+    vert_labels = std::move(data.vert_labels);
+    poly_labels = std::move(data.poly_labels);
+    return ok;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_MESH(const char                     * filename,
+bool read_MESH(const char                     * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & polys)
 {
     std::vector<int> vert_labels, poly_labels;
-    read_MESH(filename, verts, polys, vert_labels, poly_labels);
+    return read_MESH(filename, verts, polys, vert_labels, poly_labels);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_MESH(const char                     * filename,
+bool read_MESH(const char                     * filename,
                std::vector<double>            & coords,
                std::vector<std::vector<uint>> & polys)
 {
     std::vector<vec3d> verts;
     std::vector<int>   vert_labels, poly_labels;
-    read_MESH(filename, verts, polys, vert_labels, poly_labels);
+    if(!read_MESH(filename, verts, polys, vert_labels, poly_labels)) return false;
     coords = serialized_xyz_from_vec3d(verts);
+    return true;
 }
 
 }
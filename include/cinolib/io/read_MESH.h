@@ -40,13 +40,23 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/io_data.h>
 
 
 namespace cinolib
 {
 
+// tetrahedra and hexahedra are appended straight to the serialized polys of
+// data (lower dimensional elements are skipped). The other readers below are
+// built on top of this one
+//
 CINO_INLINE
-void read_MESH(const char                     * filename,
+bool read_MESH(const char * filename, IOData & data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_MESH(const char                     * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & polys,
                std::vector<int>               & vert_labels,
@@ -55,14 +65,14 @@ void read_MESH(const char                     * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_MESH(const char                     * filename,
+bool read_MESH(const char                     * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & polys);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_MESH(const char                     * filename,
+bool read_MESH(const char                     * filename,
                std::vector<double>            & coords,
                std::vector<std::vector<uint>> & polys);
 }
@@ -0,0 +1,547 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_MSH.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+
+namespace cinolib
+{
+
+namespace
+{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// number of nodes for each Gmsh element type (zero means unknown)
+static const uint MSH_NODES_PER_ELEMENT[32] =
+{
+    0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8, 20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56
+};
+
+CINO_INLINE uint msh_nodes_per_element(const int type) { return (type>0 && type<32) ? MSH_NODES_PER_ELEMENT[type] : 0; }
+CINO_INLINE bool msh_is_tet(const int type) { return type==4 || type==11 || type==29 || type==30 || type==31; }
+CINO_INLINE bool msh_is_hex(const int type) { return type==5 || type==12 || type==17; }
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct MSH_parser
+{
+    const char * c;
+    const char * end;
+    bool         binary     = false;
+    bool         swap_bytes = false;
+    uint         dsize      = 8;     // sizeof(size_t) in the file
+    bool         bad        = false; // set if data ends prematurely, or cannot be parsed
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    template<typename T>
+    T raw(const char * ptr) const
+    {
+        T val;
+        if(swap_bytes)
+        {
+            char tmp[sizeof(T)];
+            for(size_t b=0; b<sizeof(T); ++b) tmp[b] = ptr[sizeof(T)-1-b];
+            memcpy(&val, tmp, sizeof(T));
+        }
+        else memcpy(&val, ptr, sizeof(T));
+        return val;
+    }
+
+    size_t raw_size(const char * ptr) const
+    {
+        return (dsize==8) ? size_t(raw<uint64_t>(ptr)) : size_t(raw<uint32_t>(ptr));
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // in case of errors the functions below set bad, and return 0 from then on
+
+    bool can_read(const size_t n)
+    {
+        if(!bad && size_t(end-c)<n) bad = true;
+        return !bad;
+    }
+
+    bool advance(char * next)
+    {
+        if(next==c) bad = true; else c = next;
+        return !bad;
+    }
+
+    int get_int()
+    {
+        if(binary) { if(!can_read(4)) return 0; int val = raw<int32_t>(c); c+=4; return val; }
+        char *next;
+        int val = int(strtol(c, &next, 10));
+        return (!bad && advance(next)) ? val : 0;
+    }
+
+    size_t get_size()
+    {
+        if(binary) { if(!can_read(dsize)) return 0; size_t val = raw_size(c); c+=dsize; return val; }
+        char *next;
+        size_t val = size_t(strtoull(c, &next, 10));
+        return (!bad && advance(next)) ? val : 0;
+    }
+
+    // a number of items, each taking at least one byte in the file
+    size_t get_count()
+    {
+        size_t n = get_size();
+        if(n>size_t(end-c)) bad = true;
+        return bad ? 0 : n;
+    }
+
+    double get_double()
+    {
+        if(binary) { if(!can_read(8)) return 0; double val = raw<double>(c); c+=8; return val; }
+        char *next;
+        double val = strtod(c, &next);
+        return (!bad && advance(next)) ? val : 0;
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    void skip_line()
+    {
+        while(c<end && *c!='\n') ++c;
+        if(c<end) ++c;
+    }
+
+    // moves the cursor to the next section tag (e.g. $Nodes) and returns it
+    bool next_section(std::string & tag)
+    {
+        while(c<end && isspace(*c)) ++c;
+        if(c>=end) return false;
+        if(*c!='$') { skip_line(); return next_section(tag); }
+        const char *beg = c;
+        while(c<end && !isspace(*c)) ++c;
+        tag = std::string(beg, c);
+        skip_line();
+        return true;
+    }
+
+    // moves the cursor right after the closing tag of section
+    void close_section(const std::string & tag)
+    {
+        std::string end_tag = "$End" + tag.substr(1);
+        c = std::search(c, end, end_tag.begin(), end_tag.end());
+        skip_line();
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// reads the list of physical tags and returns the first one (or -1)
+CINO_INLINE
+int msh_physical_tag(MSH_parser & p)
+{
+    int    phys = -1;
+    size_t n    = p.get_count();
+    for(size_t i=0; i<n; ++i)
+    {
+        int tag = p.get_int();
+        if(i==0) phys = tag;
+    }
+    return phys;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void msh_skip_bounding_entities(MSH_parser & p)
+{
+    size_t n = p.get_count();
+    for(size_t i=0; i<n; ++i) p.get_int();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & poly_labels)
+{
+    verts.clear();
+    polys.clear();
+    poly_labels.clear();
+
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "rb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : couldn't open input file " << filename << std::endl;
+        return false;
+    }
+
+    // the whole file is loaded in memory and parsed from there
+    std::string buf;
+    fseek(fp, 0, SEEK_END);
+    buf.resize(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    size_t n_read = fread(&buf[0], 1, buf.size(), fp);
+    fclose(fp);
+    if(n_read!=buf.size())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : error reading input file " << filename << std::endl;
+        return false;
+    }
+
+    MSH_parser p;
+    p.c   = buf.c_str();
+    p.end = buf.c_str() + buf.size();
+
+    std::map<int,int>   vol_labels; // volume entity => physical tag
+    std::vector<vec3d>  nodes;
+    std::vector<uint>   tag2node;   // node tag => position in nodes
+    std::vector<size_t> p2tags;     // serialized node tags of all polys
+    std::vector<uint>   p_offset;   // position of each poly in p2tags
+    std::vector<int>    p_entity;
+
+    std::string tag;
+    while(p.next_section(tag))
+    {
+        if(tag=="$MeshFormat")
+        {
+            // the format line is always ASCII
+            double version = p.get_double();
+            int    type    = p.get_int();
+            p.dsize        = p.get_int();
+            if(p.dsize!=4 && p.dsize!=8)
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : invalid data size " << p.dsize << std::endl;
+                return false;
+            }
+            if(version<4.1 || version>=5)
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : unsupported version " << version << " (only 4.1 is supported)" << std::endl;
+                return false;
+            }
+            p.skip_line();
+            if(type==1)
+            {
+                if(p.end-p.c<4)
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : truncated file " << filename << std::endl;
+                    return false;
+                }
+                int one;
+                memcpy(&one, p.c, 4);
+                p.swap_bytes = (one!=1);
+                p.binary     = true;
+                p.c += 4;
+            }
+        }
+        else if(tag=="$Entities")
+        {
+            size_t n_points   = p.get_count();
+            size_t n_curves   = p.get_count();
+            size_t n_surfaces = p.get_count();
+            size_t n_volumes  = p.get_count();
+            for(size_t i=0; i<n_points; ++i)
+            {
+                p.get_int();
+                for(int j=0; j<3; ++j) p.get_double();
+                msh_physical_tag(p);
+            }
+            for(size_t i=0; i<n_curves+n_surfaces+n_volumes; ++i)
+            {
+                int etag = p.get_int();
+                for(int j=0; j<6; ++j) p.get_double();
+                int phys = msh_physical_tag(p);
+                msh_skip_bounding_entities(p);
+                if(i>=n_curves+n_surfaces) vol_labels[etag] = phys;
+            }
+        }
+        else if(tag=="$PartitionedEntities")
+        {
+            // element blocks refer to partitioned entities, which
+            // inherit the physical tag of their parent if they don't have one
+            p.get_size(); // number of partitions
+            size_t n_ghosts = p.get_count();
+            for(size_t i=0; i<2*n_ghosts; ++i) p.get_int();
+
+            size_t n_points   = p.get_count();
+            size_t n_curves   = p.get_count();
+            size_t n_surfaces = p.get_count();
+            size_t n_volumes  = p.get_count();
+            for(size_t i=0; i<n_points+n_curves+n_surfaces+n_volumes; ++i)
+            {
+                int etag       = p.get_int();
+                int parent_dim = p.get_int();
+                int parent_tag = p.get_int();
+                size_t n_parts = p.get_count();
+                for(size_t j=0; j<n_parts; ++j) p.get_int();
+                if(i<n_points)
+                {
+                    for(int j=0; j<3; ++j) p.get_double();
+                    msh_physical_tag(p);
+                    continue;
+                }
+                for(int j=0; j<6; ++j) p.get_double();
+                int phys = msh_physical_tag(p);
+                msh_skip_bounding_entities(p);
+                if(i>=n_points+n_curves+n_surfaces)
+                {
+                    if(phys<0 && parent_dim==3 && vol_labels.count(parent_tag)>0) phys = vol_labels.at(parent_tag);
+                    vol_labels[etag] = phys;
+                }
+            }
+        }
+        else if(tag=="$Nodes")
+        {
+            size_t n_blocks = p.get_count();
+            size_t n_nodes  = p.get_count();
+            p.get_size(); // min node tag
+            size_t max_tag  = p.get_size();
+            if(n_nodes>buf.size())
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : invalid number of nodes " << n_nodes << std::endl;
+                return false;
+            }
+            if(max_tag>buf.size()) // (node tags are mapped with a dense table)
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : node tags too sparse (max tag " << max_tag << ")" << std::endl;
+                return false;
+            }
+            nodes.resize(n_nodes);
+            tag2node.assign(max_tag+1, std::numeric_limits<uint>::max());
+
+            size_t base = 0;
+            for(size_t b=0; b<n_blocks; ++b)
+            {
+                int    dim    = p.get_int();
+                p.get_int(); // entity tag
+                int    param  = p.get_int();
+                size_t n      = p.get_count();
+                size_t stride = 3 + ((param && dim>0 && dim<=3) ? dim : 0);
+                if(n>n_nodes-base || (p.binary && n*(p.dsize+stride*8)>size_t(p.end-p.c)))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : invalid node block " << b << std::endl;
+                    return false;
+                }
+
+                std::atomic<bool> bad_tag(false);
+                if(p.binary)
+                {
+                    const char *tags = p.c;
+                    const char *xyz  = p.c + n*p.dsize;
+                    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+                    {
+                        size_t t = p.raw_size(tags + i*p.dsize);
+                        const char *ptr = xyz + i*stride*8;
+                        if(t<tag2node.size()) tag2node[t] = base+i; else bad_tag = true;
+                        nodes.at(base+i) = vec3d(p.raw<double>(ptr), p.raw<double>(ptr+8), p.raw<double>(ptr+16));
+                    });
+                    p.c = xyz + n*stride*8;
+                }
+                else
+                {
+                    for(size_t i=0; i<n; ++i)
+                    {
+                        size_t t = p.get_size();
+                        if(t<tag2node.size()) tag2node[t] = base+i; else bad_tag = true;
+                    }
+                    for(size_t i=0; i<n; ++i)
+                    {
+                        vec3d & v = nodes.at(base+i);
+                        v.x() = p.get_double();
+                        v.y() = p.get_double();
+                        v.z() = p.get_double();
+                        for(size_t j=3; j<stride; ++j) p.get_double();
+                    }
+                }
+                if(bad_tag)
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : node tag greater than max tag " << max_tag << std::endl;
+                    return false;
+                }
+                base += n;
+            }
+        }
+        else if(tag=="$Elements")
+        {
+            size_t n_blocks = p.get_count();
+            size_t n_elems  = p.get_count();
+            p.get_size(); // min element tag
+            p.get_size(); // max element tag
+            p_offset.reserve(std::min(n_elems, buf.size()));
+            p_entity.reserve(std::min(n_elems, buf.size()));
+
+            for(size_t b=0; b<n_blocks; ++b)
+            {
+                int    dim    = p.get_int();
+                int    entity = p.get_int();
+                int    type   = p.get_int();
+                size_t n      = p.get_count();
+                uint   npe    = msh_nodes_per_element(type);
+                bool   keep   = (dim==3 && (msh_is_tet(type) || msh_is_hex(type)));
+                uint   nc     = msh_is_tet(type) ? 4 : 8; // corners
+
+                if(npe==0 && p.binary)
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : unknown element type " << type << std::endl;
+                    return false;
+                }
+                if(n>buf.size() || (p.binary && n*(1+npe)*p.dsize>size_t(p.end-p.c)))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : invalid element block " << b << std::endl;
+                    return false;
+                }
+
+                if(!keep)
+                {
+                    if(p.binary) p.c += n*(1+npe)*p.dsize;
+                    else for(size_t i=0; i<=n; ++i) p.skip_line(); // (header line + elements)
+                    continue;
+                }
+
+                size_t off = p2tags.size();
+                p2tags.resize(off + n*nc);
+                for(size_t i=0; i<n; ++i)
+                {
+                    p_offset.push_back(off + i*nc);
+                    p_entity.push_back(entity);
+                }
+
+                if(p.binary)
+                {
+                    const char *ptr = p.c;
+                    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+                    {
+                        const char *e = ptr + i*(1+npe)*p.dsize + p.dsize; // skip element tag
+                        for(uint j=0; j<nc; ++j) p2tags[off + i*nc + j] = p.raw_size(e + j*p.dsize);
+                    });
+                    p.c += n*(1+npe)*p.dsize;
+                }
+                else
+                {
+                    for(size_t i=0; i<n; ++i)
+                    {
+                        p.get_size(); // element tag
+                        for(uint j=0; j<npe; ++j)
+                        {
+                            size_t t = p.get_size();
+                            if(j<nc) p2tags[off + i*nc + j] = t;
+                        }
+                    }
+                }
+            }
+        }
+        if(p.bad)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : invalid or truncated section " << tag << std::endl;
+            return false;
+        }
+        p.close_section(tag);
+    }
+
+    // keep only the nodes referenced by volume elements (preserving their order)
+    const uint UNUSED = std::numeric_limits<uint>::max();
+    std::vector<uint> node2vid(nodes.size(), UNUSED);
+    for(size_t t : p2tags)
+    {
+        if(t>=tag2node.size() || tag2node[t]>=nodes.size())
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_MSH() : element refers to unknown node " << t << std::endl;
+            return false;
+        }
+        node2vid.at(tag2node.at(t)) = 0;
+    }
+    for(uint node=0; node<nodes.size(); ++node)
+    {
+        if(node2vid.at(node)==UNUSED) continue;
+        node2vid.at(node) = verts.size();
+        verts.push_back(nodes.at(node));
+    }
+
+    uint np = p_offset.size();
+    polys.resize(np);
+    poly_labels.resize(np);
+    std::set<int> unique_labels;
+    for(uint pid=0; pid<np; ++pid)
+    {
+        uint beg = p_offset.at(pid);
+        uint end = (pid+1<np) ? p_offset.at(pid+1) : p2tags.size();
+        polys.at(pid).reserve(end-beg);
+        for(uint i=beg; i<end; ++i)
+        {
+            polys.at(pid).push_back(node2vid.at(tag2node.at(p2tags.at(i))));
+        }
+        auto it = vol_labels.find(p_entity.at(pid));
+        poly_labels.at(pid) = (it!=vol_labels.end()) ? it->second : -1;
+        unique_labels.insert(poly_labels.at(pid));
+    }
+    if(unique_labels.size()==1 && *unique_labels.begin()==-1) poly_labels.clear(); // no physical tags
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys)
+{
+    std::vector<int> poly_labels;
+    return read_MSH(filename, verts, polys, poly_labels);
+}
+
+}
@@ -50,6 +50,8 @@
 #include <string>
 #include <string.h>
 #include <assert.h>
+#include <algorithm>
+#include <tuple>
 
 namespace cinolib
 {
@@ -59,7 +61,7 @@ namespace cinolib
 // https://stackoverflow.com/questions/9310327/sscanf-optional-column
 //
 CINO_INLINE
-void read_point_id(char * s, int & v, int & vt, int & vn)
+void read_point_id(const char * s, int & v, int & vt, int & vn)
 {
     v = vt = vn = -1;
          if(sscanf(s, "%d/%d/%d", &v, &vt, &vn) == 3) { --v; --vt; --vn; }
@@ -71,7 +73,7 @@ void read_point_id(char * s, int & v, int & vt, int & vn)
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & poly)
 {
@@ -79,13 +81,13 @@ void read_OBJ(const char                     * filename,
     std::vector<std::vector<uint>> poly_tex, poly_nor;
     std::vector<Color> poly_col;
     std::vector<int> poly_lab;
-    read_OBJ(filename, verts, tex, nor, poly, poly_tex, poly_nor, poly_col, poly_lab);
+    return read_OBJ(filename, verts, tex, nor, poly, poly_tex, poly_nor, poly_col, poly_lab);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & poly,
               std::vector<int>               & labels) // => cluster by OBJ groups
@@ -93,13 +95,13 @@ void read_OBJ(const char                     * filename,
     std::vector<vec3d> tex, nor;
     std::vector<std::vector<uint>> poly_tex, poly_nor;
     std::vector<Color> poly_col;
-    read_OBJ(filename, verts, tex, nor, poly, poly_tex, poly_nor, poly_col, labels);
+    return read_OBJ(filename, verts, tex, nor, poly, poly_tex, poly_nor, poly_col, labels);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & xyz,
               std::vector<vec3d>             & uvw,
               std::vector<std::vector<uint>> & poly)
@@ -108,38 +110,63 @@ void read_OBJ(const char                     * filename,
     std::vector<std::vector<uint>> poly_pos, poly_tex, poly_nor;
     std::vector<Color> poly_col;
     std::vector<int>   poly_lab;
-    read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab);
+    if(!read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab)) return false;
 
     if (poly_pos.size() == poly_tex.size())
     {
         to_openGL_unified_verts(pos, tex, poly_pos, poly_tex, xyz, uvw, poly);
     }
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+namespace
+{
+
+// polygons as three serialized streams of ids (positions, texture coordinates and
+// normals). Polygons without texture coordinates (or normals) are not in that stream
+//
+struct OBJ_polys
+{
+    std::vector<uint> pos, pos_offsets = {0};
+    std::vector<uint> tex, tex_offsets = {0};
+    std::vector<uint> nor, nor_offsets = {0};
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_OBJ(const char                     * filename,
-              std::vector<vec3d>             & pos,           // vertex xyz positions
-              std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
-              std::vector<vec3d>             & nor,           // vertex normals
-              std::vector<std::vector<uint>> & poly_pos,      // polygons with references to pos
-              std::vector<std::vector<uint>> & poly_tex,      // polygons with references to tex
-              std::vector<std::vector<uint>> & poly_nor,      // polygons with references to nor
-              std::vector<Color>             & poly_col,      // per polygon colors
-              std::vector<int>               & poly_lab,      // per polygon labels (cluster by OBJ groups "g")
-              std::string                    & diffuse_path,  // path of the image encoding the diffuse  texture component
-              std::string                    & specular_path, // path of the image encoding the specular texture component
-              std::string                    & normal_path)   // path of the image encoding the normal   texture component
+std::vector<std::vector<uint>> OBJ_unserialize(const std::vector<uint> & ids, const std::vector<uint> & offsets)
+{
+    std::vector<std::vector<uint>> polys(offsets.size()-1);
+    for(uint pid=0; pid<polys.size(); ++pid)
+    {
+        polys[pid].assign(ids.begin()+offsets[pid], ids.begin()+offsets[pid+1]);
+    }
+    return polys;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool parse_OBJ(const char         * filename,
+               std::vector<vec3d> & pos,
+               std::vector<vec3d> & tex,
+               std::vector<vec3d> & nor,
+               OBJ_polys          & polys,
+               std::vector<Color> & poly_col,
+               std::vector<int>   & poly_lab,
+               std::string        & diffuse_path,
+               std::string        & specular_path,
+               std::string        & normal_path)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     pos.clear();
     tex.clear();
     nor.clear();
-    poly_pos.clear();
-    poly_tex.clear();
-    poly_nor.clear();
+    polys = OBJ_polys();
     poly_col.clear();
     poly_lab.clear();
     diffuse_path.clear();
@@ -150,7 +177,7 @@ void read_OBJ(const char                     * filename,
     if(!f.is_open())
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OBJ() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     int fresh_label = 0;
@@ -180,23 +207,22 @@ void read_OBJ(const char                     * filename,
             {
                 line = line.substr(1,line.size()-1); // discard the 'f' letter
                 std::istringstream ss(line);
-                std::vector<uint> p_pos, p_tex, p_nor;
                 for(std::string sub_str; ss >> sub_str;)
                 {
                     int v_pos, v_tex, v_nor;
-                    read_point_id(strdup(sub_str.c_str()), v_pos, v_tex, v_nor);
-                    if (v_pos >= 0) p_pos.push_back(v_pos);
-                    if (v_tex >= 0) p_tex.push_back(v_tex);
-                    if (v_nor >= 0) p_nor.push_back(v_nor);
+                    read_point_id(sub_str.c_str(), v_pos, v_tex, v_nor);
+                    if (v_pos >= 0) polys.pos.push_back(v_pos);
+                    if (v_tex >= 0) polys.tex.push_back(v_tex);
+                    if (v_nor >= 0) polys.nor.push_back(v_nor);
                 }
-                if (!p_tex.empty()) poly_tex.push_back(p_tex);
-                if (!p_nor.empty()) poly_nor.push_back(p_nor);
-                if (!p_pos.empty())
+                if (polys.tex.size() > polys.tex_offsets.back()) polys.tex_offsets.push_back(polys.tex.size());
+                if (polys.nor.size() > polys.nor_offsets.back()) polys.nor_offsets.push_back(polys.nor.size());
+                if (polys.pos.size() > polys.pos_offsets.back())
                 {
-                    poly_pos.push_back(p_pos);
+                    polys.pos_offsets.push_back(polys.pos.size());
                     poly_col.push_back(curr_color);
+                    poly_lab.push_back(fresh_label);
                 }
-                poly_lab.push_back(fresh_label);
                 break;
             }
 
@@ -251,12 +277,87 @@ void read_OBJ(const char                     * filename,
 
     if(!has_per_face_color) poly_col.clear();
     if(!has_groups)         poly_lab.clear();
+    return true;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_OBJ(const char                     * filename,
+              std::vector<vec3d>             & pos,           // vertex xyz positions
+              std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
+              std::vector<vec3d>             & nor,           // vertex normals
+              std::vector<std::vector<uint>> & poly_pos,      // polygons with references to pos
+              std::vector<std::vector<uint>> & poly_tex,      // polygons with references to tex
+              std::vector<std::vector<uint>> & poly_nor,      // polygons with references to nor
+              std::vector<Color>             & poly_col,      // per polygon colors
+              std::vector<int>               & poly_lab,      // per polygon labels (cluster by OBJ groups "g")
+              std::string                    & diffuse_path,  // path of the image encoding the diffuse  texture component
+              std::string                    & specular_path, // path of the image encoding the specular texture component
+              std::string                    & normal_path)   // path of the image encoding the normal   texture component
+{
+    OBJ_polys polys;
+    bool ok = parse_OBJ(filename, pos, tex, nor, polys, poly_col, poly_lab, diffuse_path, specular_path, normal_path);
+    poly_pos = OBJ_unserialize(polys.pos, polys.pos_offsets);
+    poly_tex = OBJ_unserialize(polys.tex, polys.tex_offsets);
+    poly_nor = OBJ_unserialize(polys.nor, polys.nor_offsets);
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_OBJ(const char * filename, IOData & data)
+{
+    data.clear();
+
+    std::vector<vec3d> tex, nor;
+    OBJ_polys          polys;
+    std::string        diffuse_path, specular_path, normal_path;
+    if(!parse_OBJ(filename, data.verts, tex, nor, polys, data.poly_colors, data.poly_labels, diffuse_path, specular_path, normal_path)) return false;
+    data.polys        = std::move(polys.pos);
+    data.poly_offsets = std::move(polys.pos_offsets);
+
+    // texture coordinates (normals) are used only if all the polygons have them
+    bool has_tex = data.num_polys()>0 && polys.tex_offsets==data.poly_offsets;
+    bool has_nor = data.num_polys()>0 && polys.nor_offsets==data.poly_offsets;
+    auto in_range = [](const std::vector<uint> & ids, const size_t n)
+    {
+        return std::all_of(ids.begin(), ids.end(), [n](const uint id){ return id<n; });
+    };
+    if(!in_range(data.polys, data.verts.size()) || (has_tex && !in_range(polys.tex, tex.size())) || (has_nor && !in_range(polys.nor, nor.size())))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OBJ() : polygons refer to missing vertices in " << filename << std::endl;
+        return false;
+    }
+    if(!has_tex && !has_nor) return true;
+
+    // cut along seams, so that uvw and normals can be stored per vertex. Polygons are updated in place
+    std::vector<vec3d> xyz;
+    std::map<std::tuple<uint,uint,uint>,uint> v_map;
+    for(size_t i=0; i<data.polys.size(); ++i)
+    {
+        uint vt = has_tex ? polys.tex[i] : 0;
+        uint vn = has_nor ? polys.nor[i] : 0;
+        auto it = v_map.insert(std::make_pair(std::make_tuple(data.polys[i],vt,vn), uint(xyz.size())));
+        if(it.second)
+        {
+            xyz.push_back(data.verts[data.polys[i]]);
+            if(has_tex) data.vert_uvw.push_back(tex[vt]);
+            if(has_nor) data.vert_normals.push_back(nor[vn]);
+        }
+        data.polys[i] = it.first->second;
+    }
+    data.verts = std::move(xyz);
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & pos,         // vertex xyz positions
               std::vector<vec3d>             & tex,         // vertex uv(w) texture coordinates
               std::vector<vec3d>             & nor,         // vertex normals
@@ -269,7 +370,7 @@ void read_OBJ(const char                     * filename,
     std::string  diffuse_path;
     std::string  specular_path;
     std::string  normal_path;
-    read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab, diffuse_path, specular_path, normal_path);
+    return read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab, diffuse_path, specular_path, normal_path);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
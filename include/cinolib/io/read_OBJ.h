@@ -43,14 +43,22 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
 #include <cinolib/color.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
 
+// polygons are parsed straight into the serialized buffers of data, along with
+// their colors and labels (if any). If all the polygons have texture coordinates
+// (or normals), the mesh is cut along seams so that they can be stored per vertex
+//
+CINO_INLINE
+bool read_OBJ(const char * filename, IOData & data);
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & pos,           // vertex xyz positions
               std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
               std::vector<vec3d>             & nor,           // vertex normals
@@ -66,7 +74,7 @@ void read_OBJ(const char                     * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & pos,         // vertex xyz positions
               std::vector<vec3d>             & tex,         // vertex uv(w) texture coordinates
               std::vector<vec3d>             & nor,         // vertex normals
@@ -79,14 +87,14 @@ void read_OBJ(const char                     * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & poly);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & poly,
               std::vector<int>               & labels); // => cluster by OBJ groups
@@ -94,7 +102,7 @@ void read_OBJ(const char                     * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OBJ(const char                     * filename,
+bool read_OBJ(const char                     * filename,
               std::vector<vec3d>             & xyz,
               std::vector<vec3d>             & uvw,
               std::vector<std::vector<uint>> & poly);
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_OFF.h>
+#include <cinolib/string_utilities.h>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -43,52 +44,46 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_OFF(const char                     * filename,
-              std::vector<vec3d>             & verts,
-              std::vector<std::vector<uint>> & polys)
-{
-    std::vector<Color> poly_colors;
-    read_OFF(filename, verts, polys, poly_colors);
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void read_OFF(const char                     * filename,
-              std::vector<vec3d>             & verts,
-              std::vector<std::vector<uint>> & polys,
-              std::vector<Color>             & poly_colors)
+bool read_OFF(const char * filename, IOData & data)
 {
-    verts.clear();
-    polys.clear();
-    poly_colors.clear();
+    data.clear();
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::ifstream f(filename);
     if(!f.is_open())
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     std::string line;
     uint        nv, np, ne;
 
     // read header and number of elements
-    do getline(f, line, '\n'); while(line.find("OFF")==std::string::npos);
-    do getline(f, line, '\n'); while(sscanf(line.c_str(), "%d %d %d\n", &nv, &np, &ne)!=3);
+    bool eof = false;
+    do eof = !getline(f, line, '\n'); while(!eof && line.find("OFF")==std::string::npos);
+    do eof = eof || !getline(f, line, '\n'); while(!eof && sscanf(line.c_str(), "%d %d %d\n", &nv, &np, &ne)!=3);
+    if(eof)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : missing header in " << filename << std::endl;
+        return false;
+    }
 
     // read verts
     for(uint i=0; i<nv; ++i)
     {
-        getline(f, line, '\n');
+        if(!getline(f, line, '\n'))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : unexpected end of file " << filename << std::endl;
+            return false;
+        }
         std::stringstream ss(line);
 
         double x, y, z;
         if(ss >> x >> y >> z)
         {
-            verts.push_back(vec3d(x,y,z));
+            data.verts.push_back(vec3d(x,y,z));
         }
         else --i;
     }
@@ -96,20 +91,27 @@ void read_OFF(const char                     * filename,
     // read polys
     for(uint i=0; i<np; ++i)
     {
-        getline(f, line, '\n');
+        if(!getline(f, line, '\n'))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : unexpected end of file " << filename << std::endl;
+            return false;
+        }
         std::stringstream ss(line);
 
         uint n_corners;
         if(ss >> n_corners)
         {
             uint vid;
-            std::vector<uint> p;
             for(uint j=0; j<n_corners; ++j)
             {
-                ss >> vid;
-                p.push_back(vid);
+                if(!(ss >> vid))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : poly " << i << " has less than " << n_corners << " vertices" << std::endl;
+                    return false;
+                }
+                data.polys.push_back(vid);
             }
-            polys.push_back(p);
+            data.poly_offsets.push_back(data.polys.size());
 
             float val;
             std::vector<float> attr;
@@ -118,13 +120,41 @@ void read_OFF(const char                     * filename,
             switch(attr.size())
             {
                 case 1 : break; // TODO: READ LABEL (cast to int)!!!
-                case 3 : poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2))); break;
-                case 4 : poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2), attr.at(3))); break;
+                case 3 : data.poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2))); break;
+                case 4 : data.poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2), attr.at(3))); break;
                 default: break;
             }
         }
         else --i;
     }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_OFF(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys)
+{
+    std::vector<Color> poly_colors;
+    return read_OFF(filename, verts, polys, poly_colors);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_OFF(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<Color>             & poly_colors)
+{
+    IOData data;
+    bool ok = read_OFF(filename, data);
+    verts       = std::move(data.verts);
+    polys       = data.vector_polys();
+    poly_colors = std::move(data.poly_colors);
+    return ok;
 }
 
 }
@@ -41,19 +41,28 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
 #include <cinolib/color.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
 
+// polys (and their colors, if any) are appended straight to the serialized
+// buffers of data. The other readers below are built on top of this one
+//
 CINO_INLINE
-void read_OFF(const char                     * filename,
+bool read_OFF(const char * filename, IOData & data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_OFF(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & polys);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_OFF(const char                     * filename,
+bool read_OFF(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & polys,
               std::vector<Color>             & poly_colors);
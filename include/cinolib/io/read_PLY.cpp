@@ -0,0 +1,530 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_PLY.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace cinolib
+{
+
+// compiled layout of a PLY element. Fixed size elements (i.e. without list
+// properties) have a constant stride, and each property a constant offset
+//
+typedef double (*PLY_decoder)(const char *);
+
+struct PLY_property
+{
+    std::string name;
+    PLY_type    type         = PLY_UNKNOWN;
+    PLY_type    count_type   = PLY_UNKNOWN; // lists only
+    uint        offset       = 0;           // fixed size elements only
+    PLY_decoder decode       = nullptr;
+    PLY_decoder decode_count = nullptr;
+
+    bool is_list() const { return count_type!=PLY_UNKNOWN; }
+};
+
+struct PLY_element
+{
+    std::string               name;
+    size_t                    count      = 0;
+    bool                      fixed_size = true;
+    uint                      stride     = 0;
+    std::vector<PLY_property> props;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+template<typename T, bool swap>
+double ply_decode(const char * ptr)
+{
+    T val;
+    if(swap)
+    {
+        char tmp[sizeof(T)];
+        for(size_t b=0; b<sizeof(T); ++b) tmp[b] = ptr[sizeof(T)-1-b];
+        memcpy(&val, tmp, sizeof(T));
+    }
+    else memcpy(&val, ptr, sizeof(T));
+    return double(val);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<bool swap>
+PLY_decoder ply_decoder(const PLY_type type)
+{
+    switch(type)
+    {
+        case PLY_INT8    : return &ply_decode<int8_t,  swap>;
+        case PLY_UINT8   : return &ply_decode<uint8_t, swap>;
+        case PLY_INT16   : return &ply_decode<int16_t, swap>;
+        case PLY_UINT16  : return &ply_decode<uint16_t,swap>;
+        case PLY_INT32   : return &ply_decode<int32_t, swap>;
+        case PLY_UINT32  : return &ply_decode<uint32_t,swap>;
+        case PLY_FLOAT32 : return &ply_decode<float,   swap>;
+        case PLY_FLOAT64 : return &ply_decode<double,  swap>;
+        default          : return nullptr;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int ply_find(const PLY_element & e, const std::vector<std::string> & names)
+{
+    for(const std::string & name : names)
+    {
+        for(uint i=0; i<e.props.size(); ++i)
+        {
+            if(!e.props.at(i).is_list() && e.props.at(i).name==name) return i;
+        }
+    }
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ply_is_index_list(const PLY_property & p)
+{
+    return p.is_list() && (p.name=="vertex_indices" || p.name=="vertex_index");
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// decodes all the records of an element, starting from ptr. Scalar properties
+// are stored column-wise in cols (one column per property), vertex index lists
+// in lists. Returns the position right after the last record (or nullptr if
+// the data ends prematurely)
+//
+CINO_INLINE
+const char * ply_decode_binary(const PLY_element                    & e,
+                               const char                           * ptr,
+                               const char                           * end,
+                               std::vector<std::vector<double>>     & cols,
+                               std::vector<std::vector<uint>>       & lists)
+{
+    if(e.fixed_size)
+    {
+        if(ptr + e.count*e.stride > end) return nullptr;
+        PARALLEL_FOR(0, e.count, 10000, [&](const uint i)
+        {
+            const char *rec = ptr + i*e.stride;
+            for(uint j=0; j<e.props.size(); ++j)
+            {
+                cols[j][i] = e.props[j].decode(rec + e.props[j].offset);
+            }
+        });
+        return ptr + e.count*e.stride;
+    }
+
+    // records have variable size: locate them first, then decode them in parallel
+    std::vector<const char*> records(e.count);
+    for(size_t i=0; i<e.count; ++i)
+    {
+        records[i] = ptr;
+        for(const PLY_property & p : e.props)
+        {
+            if(p.is_list())
+            {
+                if(ptr + PLY_type_size(p.count_type) > end) return nullptr;
+                size_t n = size_t(p.decode_count(ptr));
+                ptr += PLY_type_size(p.count_type);
+                if(n > size_t(end-ptr)/PLY_type_size(p.type)) return nullptr;
+                ptr += n*PLY_type_size(p.type);
+            }
+            else ptr += PLY_type_size(p.type);
+        }
+        if(ptr>end) return nullptr;
+    }
+
+    PARALLEL_FOR(0, e.count, 10000, [&](const uint i)
+    {
+        const char *rec = records[i];
+        for(uint j=0; j<e.props.size(); ++j)
+        {
+            const PLY_property & p = e.props[j];
+            if(p.is_list())
+            {
+                uint n  = uint(p.decode_count(rec));
+                uint sz = PLY_type_size(p.type);
+                rec += PLY_type_size(p.count_type);
+                if(ply_is_index_list(p) && !lists.empty())
+                {
+                    lists[i].resize(n);
+                    for(uint k=0; k<n; ++k) lists[i][k] = uint(p.decode(rec + k*sz));
+                }
+                rec += n*sz;
+            }
+            else
+            {
+                cols[j][i] = p.decode(rec);
+                rec += PLY_type_size(p.type);
+            }
+        }
+    });
+    return ptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const char * ply_decode_ascii(const PLY_element                & e,
+                              const char                       * ptr,
+                              const char                       * end,
+                              std::vector<std::vector<double>> & cols,
+                              std::vector<std::vector<uint>>   & lists)
+{
+    char *next;
+    for(size_t i=0; i<e.count; ++i)
+    {
+        for(uint j=0; j<e.props.size(); ++j)
+        {
+            const PLY_property & p = e.props[j];
+            if(p.is_list())
+            {
+                uint n = uint(strtoul(ptr, &next, 10));
+                if(next==ptr || n>size_t(end-next)) return nullptr; // (at least one char per item)
+                ptr = next;
+                bool store = ply_is_index_list(p) && !lists.empty();
+                if(store) lists[i].resize(n);
+                for(uint k=0; k<n; ++k)
+                {
+                    double val = strtod(ptr, &next);
+                    if(next==ptr) return nullptr;
+                    ptr = next;
+                    if(store) lists[i][k] = uint(val);
+                }
+            }
+            else
+            {
+                cols[j][i] = strtod(ptr, &next);
+                if(next==ptr) return nullptr;
+                ptr = next;
+            }
+        }
+    }
+    return ptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// moves standard properties from cols to the attributes of each element
+// (vertex or face), and all the other scalar properties to fields
+//
+template<class Attributes>
+CINO_INLINE
+void ply_map_properties(const PLY_element                       & e,
+                        const std::vector<std::vector<double>>  & cols,
+                        std::vector<Attributes>                 & attr,
+                        int                                     & props,
+                        std::map<std::string,ScalarField>       & fields,
+                        std::vector<bool>                       & used)
+{
+    auto color_scale = [&](const int col) -> float
+    {
+        return PLY_type_is_integer(e.props.at(col).type) ? 1.f/255.f : 1.f;
+    };
+
+    int nx = ply_find(e, {"nx"});
+    int ny = ply_find(e, {"ny"});
+    int nz = ply_find(e, {"nz"});
+    int r  = ply_find(e, {"red",   "diffuse_red"  });
+    int g  = ply_find(e, {"green", "diffuse_green"});
+    int b  = ply_find(e, {"blue",  "diffuse_blue" });
+    int a  = ply_find(e, {"alpha", "diffuse_alpha"});
+    int l  = ply_find(e, {"label"});
+    int q  = ply_find(e, {"quality"});
+
+    props = 0;
+    if(nx>=0 && ny>=0 && nz>=0) props |= PLY_NORMAL;
+    if(r>=0  && g>=0  && b>=0 ) props |= PLY_COLOR;
+    if(l>=0)                    props |= PLY_LABEL;
+    if(q>=0)                    props |= PLY_QUALITY;
+
+    if(props) attr.resize(e.count);
+    PARALLEL_FOR(0, e.count, 10000, [&](const uint i)
+    {
+        if(props & PLY_NORMAL)
+        {
+            attr[i].normal = vec3d(cols[nx][i], cols[ny][i], cols[nz][i]);
+        }
+        if(props & PLY_COLOR)
+        {
+            attr[i].color = Color(float(cols[r][i])*color_scale(r),
+                                  float(cols[g][i])*color_scale(g),
+                                  float(cols[b][i])*color_scale(b),
+                                  (a>=0) ? float(cols[a][i])*color_scale(a) : 1.f);
+        }
+        if(props & PLY_LABEL  ) attr[i].label   = int(cols[l][i]);
+        if(props & PLY_QUALITY) attr[i].quality = float(cols[q][i]);
+    });
+
+    if(props & PLY_NORMAL ) used[nx] = used[ny] = used[nz] = true;
+    if(props & PLY_COLOR  ) used[r]  = used[g]  = used[b]  = true;
+    if(props & PLY_COLOR && a>=0) used[a] = true;
+    if(props & PLY_LABEL  ) used[l] = true;
+    if(props & PLY_QUALITY) used[q] = true;
+
+    for(uint j=0; j<e.props.size(); ++j)
+    {
+        if(used[j] || e.props[j].is_list()) continue;
+        fields[e.props[j].name] = ScalarField(cols[j]);
+    }
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_PLY(const char                          * filename,
+              std::vector<vec3d>                  & verts,
+              std::vector<std::vector<uint>>      & polys,
+              std::vector<Vert_std_attributes>    & vert_attr,
+              int                                 & vert_props,
+              std::vector<Polygon_std_attributes> & poly_attr,
+              int                                 & poly_props,
+              std::map<std::string,ScalarField>   & vert_fields,
+              std::map<std::string,ScalarField>   & poly_fields)
+{
+    verts.clear();
+    polys.clear();
+    vert_attr.clear();
+    poly_attr.clear();
+    vert_fields.clear();
+    poly_fields.clear();
+    vert_props = 0;
+    poly_props = 0;
+
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "rb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : couldn't open input file " << filename << std::endl;
+        return false;
+    }
+
+    // the whole file is loaded in memory and parsed from there
+    std::string buf;
+    fseek(fp, 0, SEEK_END);
+    buf.resize(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    size_t n_read = fread(&buf[0], 1, buf.size(), fp);
+    fclose(fp);
+    if(n_read!=buf.size())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : error reading input file " << filename << std::endl;
+        return false;
+    }
+
+    // parse the header
+    std::vector<PLY_element> elements;
+    bool binary = false;
+    bool swap   = false;
+    size_t pos  = 0;
+    bool   eoh  = false;
+    while(!eoh && pos<buf.size())
+    {
+        size_t eol = buf.find('\n', pos);
+        if(eol==std::string::npos) eol = buf.size();
+        std::istringstream ss(buf.substr(pos, eol-pos));
+        pos = eol+1;
+
+        std::string key;
+        ss >> key;
+        if(key=="format")
+        {
+            std::string format;
+            ss >> format;
+            if(format=="binary_little_endian") { binary = true; swap = !PLY_host_is_little_endian(); }
+            else if(format=="binary_big_endian") { binary = true; swap =  PLY_host_is_little_endian(); }
+            else if(format!="ascii")
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : unknown format " << format << std::endl;
+                return false;
+            }
+        }
+        else if(key=="element")
+        {
+            PLY_element e;
+            ss >> e.name >> e.count;
+            if(e.count>buf.size()) // each record takes at least one byte
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : invalid count for element " << e.name << std::endl;
+                return false;
+            }
+            elements.push_back(e);
+        }
+        else if(key=="property")
+        {
+            if(elements.empty())
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : property declared outside of an element" << std::endl;
+                return false;
+            }
+            PLY_property p;
+            std::string type;
+            ss >> type;
+            bool is_list = (type=="list");
+            if(is_list)
+            {
+                std::string count_type;
+                ss >> count_type >> type;
+                p.count_type = PLY_type_from_string(count_type);
+                elements.back().fixed_size = false;
+            }
+            ss >> p.name;
+            p.type = PLY_type_from_string(type);
+            if(p.type==PLY_UNKNOWN || (is_list && p.count_type==PLY_UNKNOWN))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : unknown type for property " << p.name << std::endl;
+                return false;
+            }
+            p.offset = elements.back().stride;
+            elements.back().stride += PLY_type_size(p.type);
+            elements.back().props.push_back(p);
+        }
+        else if(key=="end_header") eoh = true;
+        // ply, comment and obj_info lines are ignored
+    }
+
+    // compile the decoders
+    for(PLY_element & e : elements)
+    {
+        for(PLY_property & p : e.props)
+        {
+            p.decode       = swap ? ply_decoder<true>(p.type) : ply_decoder<false>(p.type);
+            p.decode_count = swap ? ply_decoder<true>(p.count_type) : ply_decoder<false>(p.count_type);
+        }
+    }
+
+    const char *ptr = buf.c_str() + std::min(pos, buf.size());
+    const char *end = buf.c_str() + buf.size();
+    for(const PLY_element & e : elements)
+    {
+        std::vector<std::vector<double>> cols(e.props.size());
+        for(uint j=0; j<e.props.size(); ++j) if(!e.props[j].is_list()) cols[j].resize(e.count);
+
+        std::vector<std::vector<uint>> lists;
+        if(e.name=="face") lists.resize(e.count);
+
+        ptr = binary ? ply_decode_binary(e, ptr, end, cols, lists)
+                     : ply_decode_ascii (e, ptr, end, cols, lists);
+        if(ptr==nullptr)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : unexpected end of data in element " << e.name << std::endl;
+            return false;
+        }
+
+        std::vector<bool> used(e.props.size(), false);
+        if(e.name=="vertex")
+        {
+            int x = ply_find(e, {"x"});
+            int y = ply_find(e, {"y"});
+            int z = ply_find(e, {"z"});
+            if(x<0 || y<0 || z<0)
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : missing vertex coordinates" << std::endl;
+                return false;
+            }
+            used[x] = used[y] = used[z] = true;
+            verts.resize(e.count);
+            for(size_t i=0; i<e.count; ++i) verts[i] = vec3d(cols[x][i], cols[y][i], cols[z][i]);
+
+            ply_map_properties(e, cols, vert_attr, vert_props, vert_fields, used);
+
+            // texture coordinates are specific to vertices
+            int u = ply_find(e, {"u", "s", "texture_u", "texture_s"});
+            int v = ply_find(e, {"v", "t", "texture_v", "texture_t"});
+            int w = ply_find(e, {"w"});
+            if(u>=0 && v>=0)
+            {
+                if(vert_attr.empty()) vert_attr.resize(e.count);
+                for(size_t i=0; i<e.count; ++i)
+                {
+                    vert_attr[i].uvw = vec3d(cols[u][i], cols[v][i], (w>=0) ? cols[w][i] : 0.0);
+                }
+                vert_fields.erase(e.props[u].name);
+                vert_fields.erase(e.props[v].name);
+                if(w>=0) vert_fields.erase(e.props[w].name);
+                vert_props |= PLY_UVW;
+            }
+        }
+        else if(e.name=="face")
+        {
+            polys = std::move(lists);
+            ply_map_properties(e, cols, poly_attr, poly_props, poly_fields, used);
+        }
+    }
+
+    for(const std::vector<uint> & p : polys)
+    {
+        for(uint vid : p)
+        {
+            if(vid>=verts.size())
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_PLY() : vertex index out of bounds" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_PLY(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys)
+{
+    std::vector<Vert_std_attributes>    vert_attr;
+    std::vector<Polygon_std_attributes> poly_attr;
+    std::map<std::string,ScalarField>   vert_fields, poly_fields;
+    int vert_props, poly_props;
+    return read_PLY(filename, verts, polys, vert_attr, vert_props, poly_attr, poly_props, vert_fields, poly_fields);
+}
+
+}
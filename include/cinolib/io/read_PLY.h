@@ -0,0 +1,86 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_READ_PLY_H
+#define CINO_READ_PLY_H
+
+#include <sys/types.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/meshes/mesh_attributes.h>
+#include <cinolib/scalar_field.h>
+#include <cinolib/io/PLY_utilities.h>
+
+namespace cinolib
+{
+
+/* Reads ASCII and binary (little/big endian) PLY files. The header is first
+ * compiled into a per element layout (byte offset and decoder of each property),
+ * then records are decoded in bulk, in parallel for binary files. Properties
+ * matching a standard attribute are stored in vert_attr/poly_attr, and the
+ * corresponding PLY_NORMAL, PLY_COLOR,... flags are set in vert_props/poly_props
+ * (attribute vectors are left empty if no standard property is found). Any other
+ * scalar property of vertices and faces is returned as a scalar field, indexed
+ * by its name. Elements other than vertex and face are skipped.
+*/
+
+CINO_INLINE
+bool read_PLY(const char                          * filename,
+              std::vector<vec3d>                  & verts,
+              std::vector<std::vector<uint>>      & polys,
+              std::vector<Vert_std_attributes>    & vert_attr,
+              int                                 & vert_props,
+              std::vector<Polygon_std_attributes> & poly_attr,
+              int                                 & poly_props,
+              std::map<std::string,ScalarField>   & vert_fields,
+              std::map<std::string,ScalarField>   & poly_fields);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_PLY(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "read_PLY.cpp"
+#endif
+
+#endif // CINO_READ_PLY
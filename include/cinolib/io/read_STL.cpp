@@ -42,6 +42,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_STL.h>
+#include <cinolib/string_utilities.h>
 #include <cinolib/io/io_utilities.h>
 #include <map>
 
@@ -49,19 +50,19 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_STL(const char         * filename,
+bool read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<uint>  & tris,
               const bool           merge_duplicated_verts)
 {
     std::vector<vec3d> normals;
-    read_STL(filename, verts, normals, tris, merge_duplicated_verts);
+    return read_STL(filename, verts, normals, tris, merge_duplicated_verts);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_STL(const char         * filename,
+bool read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<vec3d> & normals,
               std::vector<uint>  & tris,
@@ -73,13 +74,13 @@ void read_STL(const char         * filename,
     normals.clear();
     tris.clear();
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "r");
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     std::map<vec3d,uint> vmap;
@@ -99,21 +100,24 @@ void read_STL(const char         * filename,
             is_binary = false;
 
             vec3d n;
-            if(!seek_keyword(fp, "normal")) assert(false && "could not find keyword NORMAL");
-            if(!eat_double(fp, n.x()))      assert(false && "could not parse x coord");
-            if(!eat_double(fp, n.y()))      assert(false && "could not parse y coord");
-            if(!eat_double(fp, n.z()))      assert(false && "could not parse z coord");
+            if(!seek_keyword(fp, "normal") || !eat_double(fp, n.x()) || !eat_double(fp, n.y()) || !eat_double(fp, n.z()) ||
+               !seek_keyword(fp, "outer")  || !seek_keyword(fp, "loop"))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : could not parse facet " << normals.size() << std::endl;
+                fclose(fp);
+                return false;
+            }
             normals.push_back(n);
 
-            if(!seek_keyword(fp, "outer")) assert(false && "could not find keyword OUTER");
-            if(!seek_keyword(fp, "loop"))  assert(false && "could not find keyword LOOP");
             for(int i=0; i<3; ++i)
             {
                 vec3d v;
-                if(!seek_keyword(fp, "vertex")) assert(false && "could not find keyword VERTEX");
-                if(!eat_double(fp, v.x()))      assert(false && "could not parse x coord");
-                if(!eat_double(fp, v.y()))      assert(false && "could not parse y coord");
-                if(!eat_double(fp, v.z()))      assert(false && "could not parse z coord");
+                if(!seek_keyword(fp, "vertex") || !eat_double(fp, v.x()) || !eat_double(fp, v.y()) || !eat_double(fp, v.z()))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : could not parse vertex " << i << " of facet " << normals.size()-1 << std::endl;
+                    fclose(fp);
+                    return false;
+                }
 
                 if(merge_duplicated_verts)
                 {
@@ -133,8 +137,12 @@ void read_STL(const char         * filename,
                     verts.push_back(v);
                 }
             }
-            if(!seek_keyword(fp, "endloop"))  assert(false && "could not find keyword ENDLOOP");
-            if(!seek_keyword(fp, "endfacet")) assert(false && "could not find keyword ENDFACET");
+            if(!seek_keyword(fp, "endloop") || !seek_keyword(fp, "endfacet"))
+            {
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : could not parse facet " << normals.size()-1 << std::endl;
+                fclose(fp);
+                return false;
+            }
         }
     }
     fclose(fp);
@@ -146,16 +154,23 @@ void read_STL(const char         * filename,
         if(!fp)
         {
             std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
-            exit(-1);
+            return false;
         }
 
-        // read header
+        // read header. Each triangle takes 50 bytes (normal, verts and attribute)
         char header[80];
-        if(fread(header, 1, 80, fp)!=80) assert(false && "error reading STL binary header");
+        unsigned int nt;
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        rewind(fp);
+        if(fread(header, 1, 80, fp)!=80 || fread(&nt, sizeof(unsigned int), 1, fp)!=1 || nt>(size-84)/50)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : " << filename << " is neither ASCII nor binary STL" << std::endl;
+            fclose(fp);
+            return false;
+        }
 
         // read triangles
-        unsigned int nt;
-        if(fread(&nt, sizeof(unsigned int), 1, fp)!=1) assert(false && "error reading number of triangles");
         for(unsigned int i=0; i<nt; ++i)
         {
             // read normal
@@ -196,6 +211,21 @@ void read_STL(const char         * filename,
         }
         fclose(fp);
     }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_STL(const char * filename,
+              IOData     & data,
+              const bool   merge_duplicated_verts)
+{
+    data.clear();
+    if(!read_STL(filename, data.verts, data.polys, merge_duplicated_verts)) return false;
+    data.poly_offsets.resize(data.polys.size()/3+1);
+    for(uint pid=0; pid<data.poly_offsets.size(); ++pid) data.poly_offsets[pid] = 3*pid;
+    return true;
 }
 
 }
@@ -38,12 +38,13 @@
 
 #include <vector>
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
 
 CINO_INLINE
-void read_STL(const char         * filename,
+bool read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<uint>  & tris,
               const bool           merge_duplicated_verts = true);
@@ -51,11 +52,20 @@ void read_STL(const char         * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_STL(const char         * filename,
+bool read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<vec3d> & normals,
               std::vector<uint>  & tris,
               const bool           merge_duplicated_verts = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// triangles are parsed straight into the serialized polys of data
+//
+CINO_INLINE
+bool read_STL(const char * filename,
+              IOData     & data,
+              const bool   merge_duplicated_verts = true);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -34,43 +34,49 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_TET.h>
+#include <cinolib/string_utilities.h>
 #include <iostream>
 
 namespace cinolib
 {
 
 CINO_INLINE
-void read_TET(const char          * filename,
+bool read_TET(const char          * filename,
               std::vector<double> & xyz,
               std::vector<uint>  & tets)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "r");
 
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     uint  nv, nt;
     char line[1024];
 
-    fgets(line,1024,fp);
-    sscanf(line, "%d vertices", &nv);
-
-    fgets(line,1024,fp);
-    sscanf(line, "%d tets", &nt);
+    if(!fgets(line,1024,fp) || sscanf(line, "%d vertices", &nv)!=1 ||
+       !fgets(line,1024,fp) || sscanf(line, "%d tets", &nt)!=1)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : missing header in " << filename << std::endl;
+        fclose(fp);
+        return false;
+    }
 
     for(uint vid=0; vid<nv; ++vid)
     {
-        fgets(line, 1024, fp);
-
         // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
         //
         double x,y,z;
-        sscanf(line, "%lf %lf %lf ", &x, &y, &z);
+        if(!fgets(line, 1024, fp) || sscanf(line, "%lf %lf %lf ", &x, &y, &z)!=3)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : failed reading vert" << std::endl;
+            fclose(fp);
+            return false;
+        }
 
         xyz.push_back(x);
         xyz.push_back(y);
@@ -79,10 +85,13 @@ void read_TET(const char          * filename,
 
     for(uint tid=0; tid<nt; ++tid)
     {
-        fgets(line, 1024, fp);
-
         uint v0, v1, v2, v3;
-        sscanf(line, "4 %d %d %d %d", &v0, &v1, &v2, &v3);
+        if(!fgets(line, 1024, fp) || sscanf(line, "4 %d %d %d %d", &v0, &v1, &v2, &v3)!=4)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : failed reading tet" << std::endl;
+            fclose(fp);
+            return false;
+        }
 
         tets.push_back(v0);
         tets.push_back(v3);
@@ -91,54 +100,60 @@ void read_TET(const char          * filename,
     }
 
     fclose(fp);
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_TET(const char                     * filename,
+bool read_TET(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & polys)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "r");
 
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : couldn't open input file " << filename << std::endl;
-        exit(-1);
+        return false;
     }
 
     uint  nv, np;
     char line[1024];
 
-    fgets(line,1024,fp);
-    sscanf(line, "%d vertices", &nv);
-
-    fgets(line,1024,fp);
-    sscanf(line, "%d tets", &np);
-
-    verts.reserve(nv);
-    polys.reserve(np);
+    if(!fgets(line,1024,fp) || sscanf(line, "%d vertices", &nv)!=1 ||
+       !fgets(line,1024,fp) || sscanf(line, "%d tets", &np)!=1)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : missing header in " << filename << std::endl;
+        fclose(fp);
+        return false;
+    }
 
     for(uint vid=0; vid<nv; ++vid)
     {
-        fgets(line, 1024, fp);
-
         // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
         //
         vec3d p;
-        sscanf(line, "%lf %lf %lf ", &p.x(), &p.y(), &p.z());
+        if(!fgets(line, 1024, fp) || sscanf(line, "%lf %lf %lf ", &p.x(), &p.y(), &p.z())!=3)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : failed reading vert" << std::endl;
+            fclose(fp);
+            return false;
+        }
         verts.push_back(p);
     }
 
     for(uint pid=0; pid<np; ++pid)
     {
-        fgets(line, 1024, fp);
-
         uint v0, v1, v2, v3;
-        sscanf(line, "4 %d %d %d %d", &v0, &v1, &v2, &v3);
+        if(!fgets(line, 1024, fp) || sscanf(line, "4 %d %d %d %d", &v0, &v1, &v2, &v3)!=4)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_TET() : failed reading tet" << std::endl;
+            fclose(fp);
+            return false;
+        }
 
         std::vector<uint> tet;
         tet.push_back(v0);
@@ -149,6 +164,7 @@ void read_TET(const char                     * filename,
     }
 
     fclose(fp);
+    return true;
 }
 
 }
@@ -45,14 +45,14 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_TET(const char          * filename,
+bool read_TET(const char          * filename,
               std::vector<double> & xyz,
               std::vector<uint>  & tet);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_TET(const char                     * filename,
+bool read_TET(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<uint>> & polys);
 
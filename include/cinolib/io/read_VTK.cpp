@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTK.h>
+#include <cinolib/string_utilities.h>
 
 #ifdef CINOLIB_USES_VTK
 #include <vtkGenericDataObjectReader.h>
@@ -48,11 +49,11 @@ namespace cinolib
 #ifdef CINOLIB_USES_VTK
 
 CINO_INLINE
-void read_VTK(const char                      * filename,
+bool read_VTK(const char                      * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
     reader->SetFileName(filename);
@@ -80,16 +81,17 @@ void read_VTK(const char                      * filename,
 
         if(!polyhedron.empty()) poly.push_back(polyhedron);
     }
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char                      * filename,
+bool read_VTK(const char                      * filename,
                std::vector<double>            & xyz,
                std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
     reader->SetFileName(filename);
@@ -119,17 +121,18 @@ void read_VTK(const char                      * filename,
 
         if(!polyhedron.empty()) poly.push_back(polyhedron);
     }
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char          * filename,
+bool read_VTK(const char          * filename,
                std::vector<double> & xyz,
                std::vector<uint>  & tets,
                std::vector<uint>  & hexa)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
     reader->SetFileName(filename);
@@ -156,37 +159,37 @@ void read_VTK(const char          * filename,
             case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) hexa.push_back(c->GetPointId(j)); break;
         }
     }
-
+    return true;
 }
 
 #else
 
 CINO_INLINE
-void read_VTK(const char          *,
+bool read_VTK(const char          *,
                std::vector<double> &,
                std::vector<uint>   &,
                std::vector<uint>   &)
 {
     std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    return false;
 }
 
 CINO_INLINE
-void read_VTK(const char                      *,
+bool read_VTK(const char                      *,
                std::vector<double>            &,
                std::vector<std::vector<uint>> &)
 {
     std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    return false;
 }
 
 CINO_INLINE
-void read_VTK(const char                      *,
+bool read_VTK(const char                      *,
                std::vector<vec3d>             &,
                std::vector<std::vector<uint>> &)
 {
     std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    return false;
 }
 
 #endif
@@ -46,7 +46,7 @@ namespace cinolib
 {
 
 CINO_INLINE
-void read_VTK(const char          * filename,
+bool read_VTK(const char          * filename,
                std::vector<double> & xyz,
                std::vector<uint>  & tet,
                std::vector<uint>  & hexa);
@@ -54,7 +54,7 @@ void read_VTK(const char          * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char                      * filename,
+bool read_VTK(const char                      * filename,
                std::vector<double>            & xyz,
                std::vector<std::vector<uint>> & poly);
 
@@ -62,7 +62,7 @@ void read_VTK(const char                      * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char                      * filename,
+bool read_VTK(const char                      * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & poly);
 
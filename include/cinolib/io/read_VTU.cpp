@@ -34,6 +34,13 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTU.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/standard_elements_tables.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <map>
 
 #ifdef CINOLIB_USES_VTK
 #include <vtkSmartPointer.h>
@@ -45,92 +52,813 @@
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
+namespace
+{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+enum
+{
+    VTU_INT8,
+    VTU_UINT8,
+    VTU_INT16,
+    VTU_UINT16,
+    VTU_INT32,
+    VTU_UINT32,
+    VTU_INT64,
+    VTU_UINT64,
+    VTU_FLOAT32,
+    VTU_FLOAT64,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct VTU_xml_array
+{
+    std::string  name;
+    int          type         = -1;
+    uint         n_components = 1;
+    int          format       = -1;      // VTU_ASCII, VTU_BINARY, or VTU_APPENDED_RAW for appended data (any encoding)
+    size_t       offset       = 0;       // position in the appended data section
+    const char * beg          = nullptr; // inline data (ASCII or base64)
+    const char * end          = nullptr;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct VTU_xml_file
+{
+    std::string         buf;
+    bool                swap_bytes   = false;
+    uint                header_size  = 4; // UInt32 (default) or UInt64
+    bool                compressed   = false;
+    bool                appended_b64 = false;
+    const char        * appended     = nullptr; // first byte after the '_' marker
+    const char        * appended_end = nullptr;
+    std::vector<size_t> offsets;                // sorted offsets of all the appended arrays
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char                      * filename,
-               std::vector<vec3d>             & verts,
-               std::vector<std::vector<uint>> & poly)
+bool xml_attribute(const char * tag_beg, const char * tag_end, const char * key, std::string & val)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    size_t len = strlen(key);
+    for(const char *c=tag_beg+1; c+len+1<tag_end; ++c)
+    {
+        if(isspace(c[-1]) && strncmp(c, key, len)==0 && c[len]=='=' && (c[len+1]=='"' || c[len+1]=='\''))
+        {
+            const char *beg = c+len+2;
+            const char *end = beg;
+            while(end<tag_end && *end!=c[len+1]) ++end;
+            val = std::string(beg,end);
+            return true;
+        }
+    }
+    return false;
+}
 
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetOutput());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+CINO_INLINE
+std::string xml_tag_name(const char * tag_beg)
+{
+    const char *beg = tag_beg+1;
+    if(*beg=='/') ++beg;
+    const char *end = beg;
+    while(*end && !isspace(*end) && *end!='>' && *end!='/') ++end;
+    return std::string(beg,end);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int vtu_type(const std::string & s)
+{
+    if(s=="Int8"    || s=="Char")   return VTU_INT8;
+    if(s=="UInt8"   || s=="UChar")  return VTU_UINT8;
+    if(s=="Int16"   || s=="Short")  return VTU_INT16;
+    if(s=="UInt16"  || s=="UShort") return VTU_UINT16;
+    if(s=="Int32"   || s=="Int")    return VTU_INT32;
+    if(s=="UInt32"  || s=="UInt")   return VTU_UINT32;
+    if(s=="Int64"   || s=="Long")   return VTU_INT64;
+    if(s=="UInt64"  || s=="ULong")  return VTU_UINT64;
+    if(s=="Float32" || s=="Float")  return VTU_FLOAT32;
+    if(s=="Float64" || s=="Double") return VTU_FLOAT64;
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint vtu_type_size(const int type)
+{
+    switch(type)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
+        case VTU_INT8:
+        case VTU_UINT8:   return 1;
+        case VTU_INT16:
+        case VTU_UINT16:  return 2;
+        case VTU_INT32:
+        case VTU_UINT32:
+        case VTU_FLOAT32: return 4;
+        case VTU_INT64:
+        case VTU_UINT64:
+        case VTU_FLOAT64: return 8;
+    }
+    assert(false && "unknown VTU type");
+    return 1;
+}
 
-        verts.push_back(vec3d(pnt[0],pnt[1],pnt[2]));
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename S, typename T>
+CINO_INLINE
+void vtu_cast(const unsigned char * src, const size_t n, const bool swap_bytes, T * dst)
+{
+    const size_t size = sizeof(S);
+    unsigned char tmp[sizeof(S)];
+    for(size_t i=0; i<n; ++i)
+    {
+        S s;
+        if(swap_bytes)
+        {
+            for(size_t b=0; b<size; ++b) tmp[b] = src[i*size + size-1-b];
+            memcpy(&s, tmp, size);
+        }
+        else memcpy(&s, src + i*size, size);
+        dst[i] = T(s);
     }
+}
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void vtu_cast(const unsigned char * src, const size_t n, const int type, const bool swap_bytes, T * dst)
+{
+    switch(type)
     {
-        vtkCell *c = grid->GetCell(i);
+        case VTU_INT8:    vtu_cast<int8_t  ,T>(src, n, swap_bytes, dst); break;
+        case VTU_UINT8:   vtu_cast<uint8_t ,T>(src, n, swap_bytes, dst); break;
+        case VTU_INT16:   vtu_cast<int16_t ,T>(src, n, swap_bytes, dst); break;
+        case VTU_UINT16:  vtu_cast<uint16_t,T>(src, n, swap_bytes, dst); break;
+        case VTU_INT32:   vtu_cast<int32_t ,T>(src, n, swap_bytes, dst); break;
+        case VTU_UINT32:  vtu_cast<uint32_t,T>(src, n, swap_bytes, dst); break;
+        case VTU_INT64:   vtu_cast<int64_t ,T>(src, n, swap_bytes, dst); break;
+        case VTU_UINT64:  vtu_cast<uint64_t,T>(src, n, swap_bytes, dst); break;
+        case VTU_FLOAT32: vtu_cast<float   ,T>(src, n, swap_bytes, dst); break;
+        case VTU_FLOAT64: vtu_cast<double  ,T>(src, n, swap_bytes, dst); break;
+        default: assert(false && "unknown VTU type");
+    }
+}
 
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+bool vtu_decode(const VTU_xml_file & f, const VTU_xml_array & a, std::vector<T> & out)
+{
+    out.clear();
+
+    if(a.format==VTU_ASCII)
+    {
+        bool is_float = (a.type==VTU_FLOAT32 || a.type==VTU_FLOAT64);
+        const char *c = a.beg;
+        char *next;
+        while(c<a.end)
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
+            T val = is_float ? T(strtod(c, &next)) : T(strtoll(c, &next, 10));
+            if(next==c || next>a.end) break;
+            out.push_back(val);
+            c = next;
         }
+        return true;
+    }
 
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
+    // locate the binary block (header + data)
+    std::vector<unsigned char> decoded;
+    const unsigned char *payload;
+    size_t               avail;
+    if(a.format==VTU_BINARY)
+    {
+        base64_decode(a.beg, a.end, decoded);
+        payload = decoded.data();
+        avail   = decoded.size();
+    }
+    else if(f.appended==nullptr)
+    {
+        return false;
+    }
+    else if(a.offset>size_t(f.appended_end-f.appended))
+    {
+        return false;
+    }
+    else if(f.appended_b64)
+    {
+        auto it = std::upper_bound(f.offsets.begin(), f.offsets.end(), a.offset);
+        const char *beg = f.appended + a.offset;
+        const char *end = (it==f.offsets.end()) ? f.appended_end : f.appended + std::min(*it, size_t(f.appended_end-f.appended));
+        base64_decode(beg, end, decoded);
+        payload = decoded.data();
+        avail   = decoded.size();
+    }
+    else
+    {
+        payload = (const unsigned char*)f.appended + a.offset;
+        avail   = (const unsigned char*)f.appended_end - payload;
+    }
+
+    auto header = [&](const size_t i) -> uint64_t
+    {
+        if(f.header_size==8)
+        {
+            uint64_t h;
+            vtu_cast<uint64_t,uint64_t>(payload + i*8, 1, f.swap_bytes, &h);
+            return h;
+        }
+        uint32_t h;
+        vtu_cast<uint32_t,uint32_t>(payload + i*4, 1, f.swap_bytes, &h);
+        return h;
+    };
+
+    if(avail<f.header_size) return false;
+
+    std::vector<unsigned char> uncompressed;
+    const unsigned char *data;
+    size_t               n_bytes;
+    if(f.compressed)
+    {
+        size_t nb = header(0);
+        if(nb>avail/f.header_size || avail<(3+nb)*f.header_size) return false;
+        std::vector<uint64_t> block_table(3+nb);
+        for(size_t i=0; i<3+nb; ++i) block_table.at(i) = header(i);
+        // compressed blocks must fit in the payload, and zlib expands data at most ~1032:1
+        size_t compressed = 0;
+        for(size_t i=0; i<nb; ++i)
+        {
+            size_t bs = (i+1<nb || block_table.at(2)==0) ? block_table.at(1) : block_table.at(2);
+            if(block_table.at(3+i) > avail-(3+nb)*f.header_size-compressed) return false;
+            if(bs/1032 > block_table.at(3+i)) return false;
+            compressed += block_table.at(3+i);
+        }
+        if(!zlib_uncompress_blocks(block_table, payload + (3+nb)*f.header_size, uncompressed)) return false;
+        data    = uncompressed.data();
+        n_bytes = uncompressed.size();
+    }
+    else
+    {
+        n_bytes = header(0);
+        data    = payload + f.header_size;
+        if(n_bytes>avail-f.header_size) return false;
     }
+
+    out.resize(n_bytes/vtu_type_size(a.type));
+    vtu_cast(data, out.size(), a.type, f.swap_bytes, out.data());
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char                      * filename,
-               std::vector<double>            & xyz,
-               std::vector<std::vector<uint>> & poly)
+bool vtu_decode(const VTU_xml_file & f, const VTU_xml_array & a, VTU_data_array & out)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    out.name         = a.name;
+    out.n_components = a.n_components;
+    return vtu_decode(f, a, out.values);
+}
 
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetOutput());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+// cells are serialized (cell_offsets has one entry more than the number of cells)
+//
+CINO_INLINE
+bool VTU_parse(const char                                  * filename,
+               std::vector<vec3d>                          & verts,
+               std::vector<uint>                           & cells,
+               std::vector<uint>                           & cell_offsets,
+               std::vector<std::vector<std::vector<uint>>> & polys_faces,
+               std::vector<VTU_data_array>                 & vert_data,
+               std::vector<VTU_data_array>                 & poly_data)
+{
+    verts.clear();
+    cells.clear();
+    cell_offsets.assign(1, 0);
+    polys_faces.clear();
+    vert_data.clear();
+    poly_data.clear();
+
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "rb");
+    if(!fp)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : couldn't open input file " << filename << std::endl;
+        return false;
+    }
 
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+    // the whole file is loaded in memory and parsed from there
+    VTU_xml_file f;
+    fseek(fp, 0, SEEK_END);
+    f.buf.resize(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    size_t n_read = fread(&f.buf[0], 1, f.buf.size(), fp);
+    fclose(fp);
+    if(n_read!=f.buf.size())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : error reading input file " << filename << std::endl;
+        return false;
     }
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
+    const char *root = strstr(f.buf.c_str(), "<VTKFile");
+    if(root==nullptr)
     {
-        vtkCell *c = grid->GetCell(i);
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : not a VTK XML file " << filename << std::endl;
+        return false;
+    }
+    const char *root_end = strchr(root, '>');
+    if(root_end==nullptr)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : truncated VTKFile tag " << filename << std::endl;
+        return false;
+    }
 
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
+    std::string attr;
+    if(xml_attribute(root, root_end, "type", attr) && attr!="UnstructuredGrid")
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : unsupported dataset " << attr << std::endl;
+        return false;
+    }
+    uint16_t one = 1;
+    bool host_is_little_endian = (*(unsigned char*)&one)==1;
+    if(xml_attribute(root, root_end, "byte_order", attr))
+    {
+        f.swap_bytes = (attr=="BigEndian") == host_is_little_endian;
+    }
+    if(xml_attribute(root, root_end, "header_type", attr))
+    {
+        f.header_size = (attr=="UInt64") ? 8 : 4;
+    }
+    if(xml_attribute(root, root_end, "compressor", attr) && !attr.empty())
+    {
+        if(attr!="vtkZLibDataCompressor")
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : unsupported compressor " << attr << std::endl;
+            return false;
         }
+        f.compressed = true;
+    }
 
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
+    // appended data (raw binary data may contain anything, so tags are parsed only before it)
+    const char *xml_end  = f.buf.c_str() + f.buf.size();
+    const char *appended = strstr(root, "<AppendedData");
+    if(appended!=nullptr)
+    {
+        const char *tag_end = strchr(appended, '>');
+        const char *marker  = (tag_end!=nullptr) ? strchr(tag_end, '_') : nullptr;
+        if(marker==nullptr)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : missing '_' marker in AppendedData " << filename << std::endl;
+            return false;
+        }
+        f.appended_b64 = !(xml_attribute(appended, tag_end, "encoding", attr) && attr=="raw");
+        f.appended     = marker + 1;
+        f.appended_end = xml_end;
+        if(f.appended_b64)
+        {
+            const char *c = strstr(f.appended, "</AppendedData>");
+            if(c!=nullptr) f.appended_end = c;
+        }
+        xml_end = appended;
+    }
+
+    // scan the XML tree
+    enum { NONE, POINT_DATA, CELL_DATA, POINTS, CELLS } section = NONE;
+    std::vector<VTU_xml_array> point_arrays, cell_arrays;
+    VTU_xml_array points, connectivity, offsets, types, faces, faceoffsets;
+    uint n_pieces = 0;
+    const char *c = root_end;
+    while((c = (const char*)memchr(c, '<', xml_end-c)) != nullptr)
+    {
+        const char *tag_end = (const char*)memchr(c, '>', xml_end-c);
+        if(tag_end==nullptr) break;
+        bool closing      = (c[1]=='/');
+        bool self_closing = (tag_end[-1]=='/');
+        std::string tag   = xml_tag_name(c);
+
+        if(tag=="Piece" && !closing)
+        {
+            if(++n_pieces>1)
+            {
+                std::cerr << "WARNING : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : only the first piece will be read" << std::endl;
+                break;
+            }
+        }
+        else if(tag=="PointData" || tag=="CellData" || tag=="Points" || tag=="Cells")
+        {
+            if(closing || self_closing) section = NONE; else
+            if(tag=="PointData")        section = POINT_DATA; else
+            if(tag=="CellData")         section = CELL_DATA;  else
+            if(tag=="Points")           section = POINTS;     else
+                                        section = CELLS;
+        }
+        else if(tag=="DataArray" && !closing)
+        {
+            VTU_xml_array a;
+            if(xml_attribute(c, tag_end, "Name", attr))               a.name         = attr;
+            if(xml_attribute(c, tag_end, "type", attr))               a.type         = vtu_type(attr);
+            if(xml_attribute(c, tag_end, "NumberOfComponents", attr)) a.n_components = std::max(1, atoi(attr.c_str()));
+            if(xml_attribute(c, tag_end, "format", attr))
+            {
+                if(attr=="ascii")  a.format = VTU_ASCII;  else
+                if(attr=="binary") a.format = VTU_BINARY; else
+                if(attr=="appended")
+                {
+                    a.format = VTU_APPENDED_RAW;
+                    if(xml_attribute(c, tag_end, "offset", attr)) a.offset = strtoull(attr.c_str(), nullptr, 10);
+                    f.offsets.push_back(a.offset);
+                }
+            }
+            if(a.type<0 || a.format<0)
+            {
+                std::cerr << "WARNING : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : skipping unsupported array " << a.name << std::endl;
+            }
+            if(!self_closing)
+            {
+                a.beg = tag_end+1;
+                a.end = strstr(a.beg, "</DataArray>");
+                if(a.end==nullptr) a.end = xml_end;
+                tag_end = a.end;
+            }
+            if(a.type>=0 && a.format>=0)
+            {
+                switch(section)
+                {
+                    case POINT_DATA : point_arrays.push_back(a); break;
+                    case CELL_DATA  : cell_arrays.push_back(a);  break;
+                    case POINTS     : points = a;                break;
+                    case CELLS      :
+                    {
+                        if(a.name=="connectivity") connectivity = a;
+                        else if(a.name=="offsets")      offsets      = a;
+                        else if(a.name=="types")        types        = a;
+                        else if(a.name=="faces")        faces        = a;
+                        else if(a.name=="faceoffsets")  faceoffsets  = a;
+                        break;
+                    }
+                    default: break;
+                }
+            }
+        }
+        c = tag_end;
+    }
+    std::sort(f.offsets.begin(), f.offsets.end());
+
+    // vertices
+    std::vector<double> xyz;
+    if(points.type>=0 && !vtu_decode(f, points, xyz))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : failed decoding points " << filename << std::endl;
+        return false;
+    }
+    verts.resize(xyz.size()/3);
+    for(size_t vid=0; vid<verts.size(); ++vid)
+    {
+        verts[vid] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+    }
+
+    // cells
+    std::vector<int64_t> conn, offs, type, fstream;
+    for(auto obj : {std::make_pair(&connectivity, &conn), std::make_pair(&offsets, &offs), std::make_pair(&types, &type), std::make_pair(&faces, &fstream)})
+    {
+        if(obj.first->type>=0 && !vtu_decode(f, *obj.first, *obj.second))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : failed decoding " << obj.first->name << " " << filename << std::endl;
+            return false;
+        }
+    }
+    if(offs.size()!=type.size())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : " << offs.size() << " offsets for " << type.size() << " cells " << filename << std::endl;
+        return false;
+    }
+    auto valid_vid = [&](const int64_t vid) { return vid>=0 && vid<int64_t(verts.size()); };
+
+    std::vector<size_t> kept_cells;
+    size_t fpos = 0; // polyhedra face streams are stored sequentially
+    cells.reserve(conn.size());
+    cell_offsets.reserve(type.size()+1);
+    polys_faces.reserve(type.size());
+    for(size_t cid=0; cid<type.size(); ++cid)
+    {
+        int64_t beg = (cid>0) ? offs[cid-1] : 0;
+        int64_t end = offs[cid];
+        if(beg>end || end>int64_t(conn.size()) || !std::all_of(conn.begin()+beg, conn.begin()+end, valid_vid))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : invalid connectivity for cell " << cid << " " << filename << std::endl;
+            return false;
+        }
+        switch(type[cid])
+        {
+            case 10: // VTK_TETRA
+            case 12: // VTK_HEXAHEDRON
+            {
+                if(end-beg != (type[cid]==10 ? 4 : 8))
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : wrong number of vertices for cell " << cid << " " << filename << std::endl;
+                    return false;
+                }
+                cells.insert(cells.end(), conn.begin()+beg, conn.begin()+end);
+                cell_offsets.push_back(cells.size());
+                polys_faces.push_back({});
+                kept_cells.push_back(cid);
+                break;
+            }
+            case 42: // VTK_POLYHEDRON
+            {
+                // each face takes at least one entry (its size) in the stream
+                bool ok = fpos<fstream.size() && fstream[fpos]>=0 && fstream[fpos]<int64_t(fstream.size()-fpos);
+                std::vector<std::vector<uint>> p_faces(ok ? fstream[fpos++] : 0);
+                for(auto & pf : p_faces)
+                {
+                    ok = fpos<fstream.size() && fstream[fpos]>=0 && fstream[fpos]<int64_t(fstream.size()-fpos);
+                    if(!ok) break;
+                    pf.resize(fstream[fpos++]);
+                    for(uint & vid : pf)
+                    {
+                        ok = valid_vid(fstream[fpos]);
+                        if(!ok) break;
+                        vid = fstream[fpos++];
+                    }
+                    if(!ok) break;
+                }
+                if(!ok)
+                {
+                    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : invalid face stream for cell " << cid << " " << filename << std::endl;
+                    return false;
+                }
+                cells.insert(cells.end(), conn.begin()+beg, conn.begin()+end);
+                cell_offsets.push_back(cells.size());
+                polys_faces.push_back(p_faces);
+                kept_cells.push_back(cid);
+                break;
+            }
+            default: break;
+        }
+    }
+    if(kept_cells.size()<type.size())
+    {
+        std::cerr << "WARNING : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : skipped "
+                  << type.size()-kept_cells.size() << " unsupported cells" << std::endl;
+    }
+
+    // point and cell data (arrays that cannot be decoded, or have the wrong size, are skipped)
+    for(const VTU_xml_array & a : point_arrays)
+    {
+        VTU_data_array d;
+        if(vtu_decode(f, a, d) && d.values.size()==verts.size()*d.n_components) vert_data.push_back(d);
+        else std::cerr << "WARNING : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : skipping invalid array " << a.name << std::endl;
+    }
+    for(const VTU_xml_array & a : cell_arrays)
+    {
+        VTU_data_array d;
+        if(!vtu_decode(f, a, d) || d.values.size()!=type.size()*d.n_components)
+        {
+            std::cerr << "WARNING : " << __FILE__ << ", line " << __LINE__ << " : load_VTU() : skipping invalid array " << a.name << std::endl;
+            continue;
+        }
+        if(kept_cells.size()<type.size())
+        {
+            std::vector<double> tmp;
+            tmp.reserve(kept_cells.size()*d.n_components);
+            for(size_t cid : kept_cells)
+            for(uint i=0; i<d.n_components; ++i)
+            {
+                tmp.push_back(d.values.at(cid*d.n_components+i));
+            }
+            d.values.swap(tmp);
+        }
+        poly_data.push_back(d);
+    }
+    return true;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char                                  * filename,
+              std::vector<vec3d>                          & verts,
+              std::vector<std::vector<uint>>              & polys,
+              std::vector<std::vector<std::vector<uint>>> & polys_faces,
+              std::vector<VTU_data_array>                 & vert_data,
+              std::vector<VTU_data_array>                 & poly_data)
+{
+    std::vector<uint> cells, cell_offsets;
+    bool ok = VTU_parse(filename, verts, cells, cell_offsets, polys_faces, vert_data, poly_data);
+    polys.resize(cell_offsets.size()-1);
+    for(uint pid=0; pid<polys.size(); ++pid)
+    {
+        polys[pid].assign(cells.begin()+cell_offsets[pid], cells.begin()+cell_offsets[pid+1]);
+    }
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char                  * filename,
+              IOData                      & data,
+              std::vector<VTU_data_array> & vert_data,
+              std::vector<VTU_data_array> & poly_data)
+{
+    data.clear();
+
+    std::vector<std::vector<std::vector<uint>>> polys_faces;
+    if(!VTU_parse(filename, data.verts, data.polys, data.poly_offsets, polys_faces, vert_data, poly_data)) return false;
+
+    bool polyhedra = std::any_of(polys_faces.begin(), polys_faces.end(), [](const std::vector<std::vector<uint>> & f)
+    {
+        return !f.empty();
+    });
+    if(polyhedra)
+    {
+        std::vector<std::vector<uint>> cells = data.vector_polys(), faces, polys;
+        std::vector<std::vector<bool>> winding;
+        VTU_cells_to_polyhedra(cells, polys_faces, faces, polys, winding);
+        data.set_faces(faces);
+        data.set_polys(polys, winding);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char * filename, IOData & data)
+{
+    std::vector<VTU_data_array> vert_data, poly_data;
+    return read_VTU(filename, data, vert_data, poly_data);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding)
+{
+    faces.clear();
+    polys.clear();
+    polys_face_winding.clear();
+
+    std::vector<std::vector<uint>>              cells;
+    std::vector<std::vector<std::vector<uint>>> cells_faces;
+    std::vector<VTU_data_array>                 vert_data, poly_data;
+    if(!read_VTU(filename, verts, cells, cells_faces, vert_data, poly_data)) return false;
+
+    VTU_cells_to_polyhedra(cells, cells_faces, faces, polys, polys_face_winding);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void VTU_cells_to_polyhedra(const std::vector<std::vector<uint>>              & cells,
+                            const std::vector<std::vector<std::vector<uint>>> & cells_faces,
+                                  std::vector<std::vector<uint>>              & faces,
+                                  std::vector<std::vector<uint>>              & polys,
+                                  std::vector<std::vector<bool>>              & polys_face_winding)
+{
+    faces.clear();
+    polys.clear();
+    polys_face_winding.clear();
+
+    // faces shared by adjacent cells are stored only once. The winding is true if the
+    // face is oriented as in the cell that refers to it (VTK faces point outwards)
+    std::map<std::vector<uint>,uint> f_map;
+    for(uint cid=0; cid<cells.size(); ++cid)
+    {
+        std::vector<std::vector<uint>> c_faces = cells_faces.at(cid);
+        if(c_faces.empty())
+        {
+            const std::vector<uint> & c = cells.at(cid);
+            if(c.size()==4) for(uint i=0; i<4; ++i) c_faces.push_back({c[TET_FACES[i][0]],  c[TET_FACES[i][1]],  c[TET_FACES[i][2]]});
+            if(c.size()==8) for(uint i=0; i<6; ++i) c_faces.push_back({c[HEXA_FACES[i][0]], c[HEXA_FACES[i][1]], c[HEXA_FACES[i][2]], c[HEXA_FACES[i][3]]});
+        }
+
+        std::vector<uint> p;
+        std::vector<bool> w;
+        for(const auto & f : c_faces)
+        {
+            std::vector<uint> key = f;
+            std::sort(key.begin(), key.end());
+            auto it = f_map.find(key);
+            if(it==f_map.end())
+            {
+                uint fid = faces.size();
+                f_map[key] = fid;
+                faces.push_back(f);
+                p.push_back(fid);
+                w.push_back(true);
+            }
+            else
+            {
+                const std::vector<uint> & g = faces.at(it->second);
+                uint off = std::find(g.begin(), g.end(), f[0]) - g.begin();
+                p.push_back(it->second);
+                w.push_back(g[(off+1)%g.size()]==f[1]);
+            }
+        }
+        polys.push_back(p);
+        polys_face_winding.push_back(w);
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char           * filename,
+bool read_VTU(const char                      * filename,
+               std::vector<vec3d>             & verts,
+               std::vector<std::vector<uint>> & poly)
+{
+    poly.clear();
+
+    std::vector<std::vector<uint>>              cells;
+    std::vector<std::vector<std::vector<uint>>> cells_faces;
+    std::vector<VTU_data_array>                 vert_data, poly_data;
+    if(!read_VTU(filename, verts, cells, cells_faces, vert_data, poly_data)) return false;
+
+    for(uint cid=0; cid<cells.size(); ++cid)
+    {
+        if(cells_faces.at(cid).empty()) poly.push_back(cells.at(cid));
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char                      * filename,
+               std::vector<double>            & xyz,
+               std::vector<std::vector<uint>> & poly)
+{
+    std::vector<vec3d> verts;
+    if(!read_VTU(filename, verts, poly)) return false;
+
+    xyz.clear();
+    xyz.reserve(verts.size()*3);
+    for(const vec3d & v : verts)
+    {
+        xyz.push_back(v.x());
+        xyz.push_back(v.y());
+        xyz.push_back(v.z());
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_VTU(const char           * filename,
                std::vector<double> & xyz,
                std::vector<uint>   & tets,
                std::vector<uint>   & hexa)
 {
+    tets.clear();
+    hexa.clear();
+
+    std::vector<std::vector<uint>> poly;
+    if(!read_VTU(filename, xyz, poly)) return false;
+
+    for(const auto & p : poly)
+    {
+        if(p.size()==4) tets.insert(tets.end(), p.begin(), p.end()); else
+        if(p.size()==8) hexa.insert(hexa.end(), p.begin(), p.end());
+    }
+    return true;
+}
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_VTK
+
+CINO_INLINE
+bool read_VTU_with_VTK(const char                     * filename,
+                       std::vector<vec3d>             & verts,
+                       std::vector<std::vector<uint>> & poly)
+{
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
     reader->SetFileName(filename);
@@ -142,51 +870,23 @@ void read_VTU(const char           * filename,
         double pnt[3];
         grid->GetPoint(i, pnt);
 
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+        verts.push_back(vec3d(pnt[0],pnt[1],pnt[2]));
     }
 
     for(uint i=0; i<grid->GetNumberOfCells(); ++i)
     {
         vtkCell *c = grid->GetCell(i);
 
+        std::vector<uint> polyhedron;
         switch (c->GetCellType())
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) tets.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) hexa.push_back(c->GetPointId(j)); break;
+            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
+            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
         }
-    }
-}
-
-#else
-
-CINO_INLINE
-void read_VTU(const char          *,
-               std::vector<double> &,
-               std::vector<uint>   &,
-               std::vector<uint>   &)
-{
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
-}
 
-CINO_INLINE
-void read_VTU(const char                      *,
-               std::vector<double>            &,
-               std::vector<std::vector<uint>> &)
-{
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
-}
-
-CINO_INLINE
-void read_VTU(const char                      *,
-               std::vector<vec3d>             &,
-               std::vector<std::vector<uint>> &)
-{
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+        if(!polyhedron.empty()) poly.push_back(polyhedron);
+    }
+    return true;
 }
 
 #endif
@@ -40,13 +40,74 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/VTU_utilities.h>
+#include <cinolib/io/io_data.h>
 
 
 namespace cinolib
 {
 
+/* Native reader for VTK XML unstructured grids (.vtu). It does not depend on
+ * VTK, and parses ASCII, binary (base64) and appended (raw or base64) data.
+ * Compressed files are supported only if CINOLIB_USES_ZLIB is defined.
+ * Supported cells are tetrahedra (VTK_TETRA), hexahedra (VTK_HEXAHEDRON) and
+ * general polyhedra (VTK_POLYHEDRON). Any other cell type is skipped, and so
+ * are its entries in the cell data arrays.
+*/
+
+CINO_INLINE
+bool read_VTU(const char                                  * filename,
+              std::vector<vec3d>                          & verts,
+              std::vector<std::vector<uint>>              & polys,       // vertices of each cell
+              std::vector<std::vector<std::vector<uint>>> & polys_faces, // faces of each VTK_POLYHEDRON (empty for tets and hexa)
+              std::vector<VTU_data_array>                 & vert_data,
+              std::vector<VTU_data_array>                 & poly_data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// cells are parsed straight into the serialized polys of data. Tetrahedra and
+// hexahedra are stored by vertices. If there is any VTK_POLYHEDRON, all the cells
+// are converted into general polyhedra (see VTU_cells_to_polyhedra below)
+//
+CINO_INLINE
+bool read_VTU(const char                  * filename,
+              IOData                      & data,
+              std::vector<VTU_data_array> & vert_data,
+              std::vector<VTU_data_array> & poly_data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_VTU(const char          * filename,
+bool read_VTU(const char * filename, IOData & data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// explicit representation of the cells (same as HEDRA files), suitable for general polyhedral meshes
+//
+CINO_INLINE
+bool read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// converts the cells returned by the first reader above into general polyhedra (the
+// faces of tets and hexa are generated, and faces shared by two cells are merged)
+CINO_INLINE
+void VTU_cells_to_polyhedra(const std::vector<std::vector<uint>>              & cells,
+                            const std::vector<std::vector<std::vector<uint>>> & cells_faces,
+                                  std::vector<std::vector<uint>>              & faces,
+                                  std::vector<std::vector<uint>>              & polys,
+                                  std::vector<std::vector<bool>>              & polys_face_winding);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the following readers only consider tetrahedra and hexahedra
+
+CINO_INLINE
+bool read_VTU(const char          * filename,
                std::vector<double> & xyz,
                std::vector<uint>   & tet,
                std::vector<uint>   & hexa);
@@ -54,7 +115,7 @@ void read_VTU(const char          * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char                      * filename,
+bool read_VTU(const char                      * filename,
                std::vector<double>            & xyz,
                std::vector<std::vector<uint>> & poly);
 
@@ -62,10 +123,20 @@ void read_VTU(const char                      * filename,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char                      * filename,
+bool read_VTU(const char                      * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<uint>> & poly);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_VTK
+// legacy reader, based on the VTK library (only tetrahedra and hexahedra)
+CINO_INLINE
+bool read_VTU_with_VTK(const char                     * filename,
+                       std::vector<vec3d>             & verts,
+                       std::vector<std::vector<uint>> & poly);
+#endif
+
 }
 
 #ifndef  CINO_STATIC_LIB
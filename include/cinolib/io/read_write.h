@@ -39,11 +39,13 @@
 // SURFACE READERS
 #include <cinolib/io/read_OBJ.h>
 #include <cinolib/io/read_OFF.h>
+#include <cinolib/io/read_PLY.h>
 #include <cinolib/io/read_IV.h>
 #include <cinolib/io/read_STL.h>
 // SURFACE WRITERS
 #include <cinolib/io/write_OBJ.h>
 #include <cinolib/io/write_OFF.h>
+#include <cinolib/io/write_PLY.h>
 #include <cinolib/io/write_STL.h>
 #include <cinolib/io/write_NODE_ELE.h>
 
@@ -52,6 +54,7 @@
 #include <cinolib/io/read_HEDRA.h>
 #include <cinolib/io/read_HYBRID.h>
 #include <cinolib/io/read_MESH.h>
+#include <cinolib/io/read_MSH.h>
 #include <cinolib/io/read_TET.h>
 #include <cinolib/io/read_VTU.h>
 #include <cinolib/io/read_VTK.h>
@@ -59,11 +62,16 @@
 // VOLUME WRITERS
 #include <cinolib/io/write_HEDRA.h>
 #include <cinolib/io/write_MESH.h>
+#include <cinolib/io/write_MSH.h>
 #include <cinolib/io/write_TET.h>
 #include <cinolib/io/write_VTU.h>
 #include <cinolib/io/write_VTK.h>
 
 
+// GENERIC READER/WRITER (any of the formats above, through IOData)
+#include <cinolib/io/read_write_IOData.h>
+
+
 // SKELETON READERS
 #include <cinolib/io/read_LIVESU2012.h>
 #include <cinolib/io/read_TAGLIASACCHI2012.h>
@@ -0,0 +1,255 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_write_IOData.h>
+#include <cinolib/io/read_OBJ.h>
+#include <cinolib/io/read_OFF.h>
+#include <cinolib/io/read_STL.h>
+#include <cinolib/io/read_PLY.h>
+#include <cinolib/io/read_HEDRA.h>
+#include <cinolib/io/read_MESH.h>
+#include <cinolib/io/read_MSH.h>
+#include <cinolib/io/read_TET.h>
+#include <cinolib/io/read_VTU.h>
+#include <cinolib/io/read_VTK.h>
+#include <cinolib/io/write_OBJ.h>
+#include <cinolib/io/write_OFF.h>
+#include <cinolib/io/write_STL.h>
+#include <cinolib/io/write_PLY.h>
+#include <cinolib/io/write_HEDRA.h>
+#include <cinolib/io/write_MESH.h>
+#include <cinolib/io/write_MSH.h>
+#include <cinolib/io/write_TET.h>
+#include <cinolib/io/write_VTU.h>
+#include <cinolib/io/write_VTK.h>
+#include <cinolib/string_utilities.h>
+#include <algorithm>
+#include <iostream>
+
+namespace cinolib
+{
+
+namespace
+{
+
+CINO_INLINE
+bool ids_in_range(const std::vector<uint> & ids, const size_t n)
+{
+    return std::all_of(ids.begin(), ids.end(), [n](const uint id){ return id<n; });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool parse_mesh(const char * filename, IOData & data)
+{
+    std::string ext = get_file_extension(filename);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    // OFF, OBJ, STL, MESH and VTU readers fill data directly. The other parsers
+    // still return elements as vectors of vectors, which are serialized here
+    if(ext=="off")  return read_OFF (filename, data);
+    if(ext=="obj")  return read_OBJ (filename, data);
+    if(ext=="stl")  return read_STL (filename, data);
+    if(ext=="mesh") return read_MESH(filename, data);
+    if(ext=="vtu")  return read_VTU (filename, data);
+
+    std::vector<std::vector<uint>> polys;
+
+    if(ext=="ply")
+    {
+        std::vector<Vert_std_attributes>    v_attr;
+        std::vector<Polygon_std_attributes> p_attr;
+        std::map<std::string,ScalarField>   v_fields, p_fields;
+        int v_props, p_props;
+        if(!read_PLY(filename, data.verts, polys, v_attr, v_props, p_attr, p_props, v_fields, p_fields)) return false;
+        for(const auto & a : v_attr)
+        {
+            if(v_props & PLY_UVW   ) data.vert_uvw.push_back(a.uvw);
+            if(v_props & PLY_NORMAL) data.vert_normals.push_back(a.normal);
+            if(v_props & PLY_COLOR ) data.vert_colors.push_back(a.color);
+            if(v_props & PLY_LABEL ) data.vert_labels.push_back(a.label);
+        }
+        for(const auto & a : p_attr)
+        {
+            if(p_props & PLY_COLOR) data.poly_colors.push_back(a.color);
+            if(p_props & PLY_LABEL) data.poly_labels.push_back(a.label);
+        }
+    }
+    else if(ext=="msh")
+    {
+        if(!read_MSH(filename, data.verts, polys, data.poly_labels)) return false;
+    }
+    else if(ext=="tet")
+    {
+        if(!read_TET(filename, data.verts, polys)) return false;
+    }
+    else if(ext=="vtk")
+    {
+        if(!read_VTK(filename, data.verts, polys)) return false;
+    }
+    else if(ext=="hedra")
+    {
+        std::vector<std::vector<uint>> faces;
+        std::vector<std::vector<bool>> winding;
+        if(!read_HEDRA(filename, data.verts, faces, polys, winding)) return false;
+        data.set_faces(faces);
+        data.set_polys(polys, winding);
+        return true;
+    }
+    else
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_mesh() : file format not supported yet " << std::endl;
+        return false;
+    }
+
+    data.set_polys(polys);
+    return true;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_mesh(const char * filename, IOData & data)
+{
+    data.clear();
+
+    if(!parse_mesh(filename, data)) return false;
+
+    // elements with less than three vertices (or faces), or referring to missing
+    // ones, cannot become a mesh
+    uint n = (data.num_faces()>0) ? data.num_faces() : data.num_verts();
+    bool valid = ids_in_range(data.faces, data.num_verts()) && ids_in_range(data.polys, n);
+    for(uint fid=0; fid<data.num_faces() && valid; ++fid) valid = data.verts_per_face(fid)>=3;
+    for(uint pid=0; pid<data.num_polys() && valid; ++pid) valid = data.verts_per_poly(pid)>=3;
+    if(!valid)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_mesh() : invalid elements in " << filename << std::endl;
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool write_mesh(const char * filename, const IOData & data)
+{
+    std::string ext = get_file_extension(filename);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    // general polyhedra can only be written in formats that support them
+    if(data.num_faces()>0)
+    {
+        if(ext=="vtu")
+        {
+            write_VTU(filename, data);
+        }
+        else if(ext=="hedra")
+        {
+            write_HEDRA(filename, data.verts, data.vector_faces(), data.vector_polys(), data.vector_poly_winding());
+        }
+        else
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_mesh() : general polyhedra cannot be written in ." << ext << " format" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // OFF, OBJ, STL, MESH and VTU writers read the serialized elements directly.
+    // The other writers still take elements as vectors of vectors
+    if(ext=="off")  { write_OFF (filename, data); return true; }
+    if(ext=="obj")  { write_OBJ (filename, data); return true; }
+    if(ext=="stl")  { write_STL (filename, data); return true; }
+    if(ext=="mesh") { write_MESH(filename, data); return true; }
+    if(ext=="vtu")  { write_VTU (filename, data); return true; }
+
+    std::vector<std::vector<uint>> polys = data.vector_polys();
+
+    if(ext=="ply")
+    {
+        int v_props = 0, p_props = 0;
+        if(data.vert_uvw.size()     == data.num_verts()) v_props |= PLY_UVW;
+        if(data.vert_normals.size() == data.num_verts()) v_props |= PLY_NORMAL;
+        if(data.vert_colors.size()  == data.num_verts()) v_props |= PLY_COLOR;
+        if(data.vert_labels.size()  == data.num_verts()) v_props |= PLY_LABEL;
+        if(data.poly_colors.size()  == data.num_polys()) p_props |= PLY_COLOR;
+        if(data.poly_labels.size()  == data.num_polys()) p_props |= PLY_LABEL;
+
+        std::vector<Vert_std_attributes>    v_attr(v_props ? data.num_verts() : 0);
+        std::vector<Polygon_std_attributes> p_attr(p_props ? data.num_polys() : 0);
+        for(uint vid=0; vid<v_attr.size(); ++vid)
+        {
+            if(v_props & PLY_UVW   ) v_attr[vid].uvw    = data.vert_uvw[vid];
+            if(v_props & PLY_NORMAL) v_attr[vid].normal = data.vert_normals[vid];
+            if(v_props & PLY_COLOR ) v_attr[vid].color  = data.vert_colors[vid];
+            if(v_props & PLY_LABEL ) v_attr[vid].label  = data.vert_labels[vid];
+        }
+        for(uint pid=0; pid<p_attr.size(); ++pid)
+        {
+            if(p_props & PLY_COLOR) p_attr[pid].color = data.poly_colors[pid];
+            if(p_props & PLY_LABEL) p_attr[pid].label = data.poly_labels[pid];
+        }
+        write_PLY(filename, data.verts, polys, v_attr, v_props, p_attr, p_props);
+    }
+    else if(ext=="msh")
+    {
+        if(data.poly_labels.size()==data.num_polys())
+        {
+            write_MSH(filename, data.verts, polys, data.poly_labels);
+        }
+        else write_MSH(filename, data.verts, polys);
+    }
+    else if(ext=="tet")
+    {
+        write_TET(filename, data.verts, polys);
+    }
+    else if(ext=="vtk")
+    {
+        write_VTK(filename, data.verts, polys);
+    }
+    else
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_mesh() : file format not supported yet " << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,72 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_READ_WRITE_IODATA_H
+#define CINO_READ_WRITE_IODATA_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/io_data.h>
+
+namespace cinolib
+{
+
+/* Reads any of the supported surface (OFF, OBJ, STL, PLY) and volume
+ * (MESH, MSH, TET, VTU, VTK, HEDRA) formats into an IOData container,
+ * selecting the parser from the file extension. Returns false if the
+ * format is not supported, or if the file cannot be read (in which case
+ * data may be partially filled).
+*/
+
+CINO_INLINE
+bool read_mesh(const char * filename, IOData & data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Writes the content of an IOData container in any of the supported surface
+ * (OFF, OBJ, STL, PLY) and volume (MESH, MSH, TET, VTU, VTK, HEDRA) formats,
+ * selecting the writer from the file extension. Attributes the format cannot
+ * store are ignored. Returns false if the format is not supported.
+*/
+
+CINO_INLINE
+bool write_mesh(const char * filename, const IOData & data);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "read_write_IOData.cpp"
+#endif
+
+#endif // CINO_READ_WRITE_IODATA_H
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_HEDRA.h>
+#include <cinolib/string_utilities.h>
 #include <iostream>
 
 namespace cinolib
@@ -46,7 +47,7 @@ void write_HEDRA(const char                           * filename,
                  const std::vector<std::vector<uint>> & polys,
                  const std::vector<std::vector<bool>> & polys_winding)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
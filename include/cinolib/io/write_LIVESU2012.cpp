@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_LIVESU2012.h>
+#include <cinolib/string_utilities.h>
 
 #include <vector>
 
@@ -46,7 +47,7 @@ void write_Livesu2012(const char                       * filename,
                       const std::vector<double>           max_spheres,
                       const std::vector<std::vector<int>> adj_vtx2vtx)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *f = fopen(filename,"w");
 
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_MESH.h>
+#include <cinolib/string_utilities.h>
 
 #include <iostream>
 
@@ -50,7 +51,7 @@ void write_MESH(const char                           * filename,
     assert(vert_labels.size() == verts.size());
     assert(poly_labels.size() == polys.size());
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -130,4 +131,82 @@ void write_MESH(const char                           * filename,
     write_MESH(filename, verts, polys, vert_labels, poly_labels);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MESH(const char * filename, const IOData & data)
+{
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "w");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_MESH() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    bool has_vert_labels = data.vert_labels.size()==data.num_verts();
+    bool has_poly_labels = data.poly_labels.size()==data.num_polys();
+    auto vert_label = [&](const uint vid) { return has_vert_labels ? data.vert_labels[vid] : 0; };
+    auto poly_label = [&](const uint pid) { return has_poly_labels ? data.poly_labels[pid] : 0; };
+
+    fprintf(fp, "MeshVersionFormatted 1\n" );
+    fprintf(fp, "Dimension 3\n" );
+
+    uint nv = data.num_verts();
+    uint nt = 0;
+    uint nh = 0;
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        if (data.verts_per_poly(pid) == 4) ++nt; else
+        if (data.verts_per_poly(pid) == 8) ++nh;
+    }
+
+    if (nv > 0)
+    {
+        fprintf(fp, "Vertices\n" );
+        fprintf(fp, "%d\n", nv);
+        for(uint vid=0; vid<nv; ++vid)
+        {
+            // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+            //
+            const vec3d & v = data.verts[vid];
+            fprintf( fp, "%.17g %.17g %.17g %d\n", v.x(), v.y(), v.z(), vert_label(vid));
+        }
+    }
+
+    if (nt > 0)
+    {
+        fprintf(fp, "Tetrahedra\n" );
+        fprintf(fp, "%d\n", nt );
+        for(uint pid=0; pid<data.num_polys(); ++pid)
+        {
+            if (data.verts_per_poly(pid) == 4)
+            {
+                const uint * tet = data.poly(pid);
+                fprintf(fp, "%d %d %d %d %d\n", tet[0]+1, tet[1]+1, tet[2]+1, tet[3]+1, poly_label(pid));
+            }
+        }
+    }
+
+    if (nh > 0)
+    {
+        fprintf(fp, "Hexahedra\n" );
+        fprintf(fp, "%d\n", nh );
+        for(uint pid=0; pid<data.num_polys(); ++pid)
+        {
+            if (data.verts_per_poly(pid) == 8)
+            {
+                const uint * hex = data.poly(pid);
+                fprintf(fp, "%d %d %d %d %d %d %d %d %d\n", hex[0]+1, hex[1]+1, hex[2]+1, hex[3]+1,
+                                                            hex[4]+1, hex[5]+1, hex[6]+1, hex[7]+1,
+                                                            poly_label(pid));
+            }
+        }
+    }
+
+    fprintf(fp, "End\n\n");
+    fclose(fp);
+}
+
 }
@@ -40,6 +40,7 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/io_data.h>
 
 
 namespace cinolib
@@ -59,6 +60,14 @@ void write_MESH(const char                           * filename,
                 const std::vector<vec3d>             & verts,
                 const std::vector<std::vector<uint>> & polys);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys are read straight from the serialized buffers of data. Missing vertex
+// or poly labels are written as zeros
+//
+CINO_INLINE
+void write_MESH(const char * filename, const IOData & data);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -0,0 +1,228 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_MSH.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/geometry/aabb.h>
+#include <cassert>
+#include <iostream>
+#include <map>
+
+namespace cinolib
+{
+
+struct MSH_writer
+{
+    FILE * fp;
+    bool   binary;
+
+    void put_int   (const int    & i) { if(binary) fwrite(&i, sizeof(int),    1, fp); else fprintf(fp, "%d ", i);    }
+    void put_size  (const size_t & s) { if(binary) fwrite(&s, sizeof(size_t), 1, fp); else fprintf(fp, "%zu ", s);  }
+    void put_double(const double & d) { if(binary) fwrite(&d, sizeof(double), 1, fp); else fprintf(fp, "%.17g ", d); }
+    void new_line  ()                 { if(!binary) fprintf(fp, "\n"); }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & poly_labels,
+               const bool                             binary)
+{
+    assert(poly_labels.empty() || poly_labels.size()==polys.size());
+
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_MSH() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    MSH_writer w;
+    w.fp     = fp;
+    w.binary = binary;
+
+    // one volume entity for each label. Element blocks are made of consecutive
+    // polys with same label and type, so that the original ordering is preserved
+    std::map<int,int>        entities; // label => entity tag
+    std::vector<uint>        blocks;   // first pid of each block
+    for(uint pid=0; pid<polys.size(); ++pid)
+    {
+        assert(polys.at(pid).size()==4 || polys.at(pid).size()==8);
+        int label = poly_labels.empty() ? -1 : poly_labels.at(pid);
+        if(entities.count(label)==0)
+        {
+            int etag = entities.size()+1;
+            entities[label] = etag;
+        }
+        if(pid==0 ||
+           polys.at(pid).size()!=polys.at(pid-1).size() ||
+           label!=(poly_labels.empty() ? -1 : poly_labels.at(pid-1)))
+        {
+            blocks.push_back(pid);
+        }
+    }
+    if(entities.empty()) entities[-1] = 1; // entity for the nodes
+
+    fprintf(fp, "$MeshFormat\n4.1 %d %zu\n", binary ? 1 : 0, sizeof(size_t));
+    if(binary)
+    {
+        int one = 1;
+        fwrite(&one, sizeof(int), 1, fp);
+        fprintf(fp, "\n");
+    }
+    fprintf(fp, "$EndMeshFormat\n");
+
+    AABB bb(verts);
+    fprintf(fp, "$Entities\n");
+    w.put_size(0);
+    w.put_size(0);
+    w.put_size(0);
+    w.put_size(entities.size());
+    w.new_line();
+    for(auto e : entities)
+    {
+        w.put_int(e.second);
+        w.put_double(bb.min.x());
+        w.put_double(bb.min.y());
+        w.put_double(bb.min.z());
+        w.put_double(bb.max.x());
+        w.put_double(bb.max.y());
+        w.put_double(bb.max.z());
+        if(e.first>=0)
+        {
+            w.put_size(1);
+            w.put_int(e.first);
+        }
+        else w.put_size(0);
+        w.put_size(0); // bounding surfaces
+        w.new_line();
+    }
+    if(binary) fprintf(fp, "\n");
+    fprintf(fp, "$EndEntities\n");
+
+    // all nodes are assigned to the first volume entity
+    fprintf(fp, "$Nodes\n");
+    w.put_size(1);
+    w.put_size(verts.size());
+    w.put_size(1);
+    w.put_size(verts.size());
+    w.new_line();
+    w.put_int(3);
+    w.put_int(entities.begin()->second);
+    w.put_int(0);
+    w.put_size(verts.size());
+    w.new_line();
+    if(binary)
+    {
+        std::vector<size_t> tags(verts.size());
+        std::vector<double> xyz(verts.size()*3);
+        for(size_t vid=0; vid<verts.size(); ++vid)
+        {
+            tags[vid]      = vid+1;
+            xyz[3*vid+0]   = verts[vid].x();
+            xyz[3*vid+1]   = verts[vid].y();
+            xyz[3*vid+2]   = verts[vid].z();
+        }
+        fwrite(tags.data(), sizeof(size_t), tags.size(), fp);
+        fwrite(xyz.data(),  sizeof(double), xyz.size(),  fp);
+        fprintf(fp, "\n");
+    }
+    else
+    {
+        for(size_t vid=0; vid<verts.size(); ++vid) fprintf(fp, "%zu\n", vid+1);
+        for(const vec3d & v : verts) fprintf(fp, "%.17g %.17g %.17g\n", v.x(), v.y(), v.z());
+    }
+    fprintf(fp, "$EndNodes\n");
+
+    fprintf(fp, "$Elements\n");
+    w.put_size(blocks.size());
+    w.put_size(polys.size());
+    w.put_size(1);
+    w.put_size(polys.size());
+    w.new_line();
+    for(size_t b=0; b<blocks.size(); ++b)
+    {
+        uint beg   = blocks.at(b);
+        uint end   = (b+1<blocks.size()) ? blocks.at(b+1) : polys.size();
+        uint npe   = polys.at(beg).size();
+        int  label = poly_labels.empty() ? -1 : poly_labels.at(beg);
+        w.put_int(3);
+        w.put_int(entities.at(label));
+        w.put_int((npe==4) ? 4 : 5); // Gmsh element types
+        w.put_size(end-beg);
+        w.new_line();
+        if(binary)
+        {
+            std::vector<size_t> data;
+            data.reserve((end-beg)*(1+npe));
+            for(uint pid=beg; pid<end; ++pid)
+            {
+                data.push_back(pid+1);
+                for(uint vid : polys.at(pid)) data.push_back(vid+1);
+            }
+            fwrite(data.data(), sizeof(size_t), data.size(), fp);
+        }
+        else
+        {
+            for(uint pid=beg; pid<end; ++pid)
+            {
+                w.put_size(pid+1);
+                for(uint vid : polys.at(pid)) w.put_size(vid+1);
+                w.new_line();
+            }
+        }
+    }
+    if(binary) fprintf(fp, "\n");
+    fprintf(fp, "$EndElements\n");
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary)
+{
+    write_MSH(filename, verts, polys, {}, binary);
+}
+
+}
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_NODE_ELE.h>
+#include <cinolib/string_utilities.h>
 #include <iostream>
 
 namespace cinolib
@@ -44,7 +45,7 @@ void write_NODE_ELE(const char                           * basename,
                     const std::vector<vec3d>             & verts,
                     const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string node_filename = std::string(basename) + ".node";
     std::string ele_filename  = std::string(basename) + ".ele";
@@ -86,7 +87,7 @@ void write_NODE_ELE_2D(const char                           * basename,
                        const std::vector<vec3d>             & verts,
                        const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string node_filename = std::string(basename) + ".node";
     std::string ele_filename  = std::string(basename) + ".ele";
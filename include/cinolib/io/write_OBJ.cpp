@@ -50,7 +50,7 @@ void write_OBJ(const char                * filename,
                const std::vector<uint>   & tri,
                const std::vector<uint>   & quad)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -87,7 +87,7 @@ void write_OBJ(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -123,7 +123,7 @@ void write_OBJ(const char                * filename,
                const std::vector<uint>   & quad,
                const std::vector<Color>  & colors)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string mtl_filename(filename);
     mtl_filename.resize(mtl_filename.size()-4);
@@ -186,7 +186,7 @@ void write_OBJ(const char                * filename,
                const std::vector<uint>   & quad,
                const Color               & color)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string mtl_filename(filename);
     mtl_filename.resize(mtl_filename.size()-4);
@@ -235,7 +235,7 @@ void write_OBJ(const char                           * filename,
                const std::vector<std::vector<uint>> & poly,
                const std::vector<Color>             & colors)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string mtl_filename(filename);
     mtl_filename.resize(mtl_filename.size()-4);
@@ -293,7 +293,7 @@ void write_OBJ(const char                           *filename,
                const std::vector<std::vector<uint>> &poly,
                const std::vector<int>               &labels)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     std::string mtl_filename(filename);
     mtl_filename.resize(mtl_filename.size()-4);
@@ -340,4 +340,76 @@ void write_OBJ(const char                           *filename,
     fclose(f_mtl);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_OBJ(const char * filename, const IOData & data)
+{
+    use_dot_as_decimal_separator();
+
+    bool has_colors = data.num_polys()>0 && data.poly_colors.size()==data.num_polys();
+    bool has_labels = data.num_polys()>0 && data.poly_labels.size()==data.num_polys() && !has_colors;
+
+    FILE *f_mtl = nullptr;
+    FILE *f_obj = fopen(filename, "w");
+    std::string mtl_filename(filename);
+    if(has_colors || has_labels)
+    {
+        mtl_filename.resize(mtl_filename.size()-4);
+        mtl_filename.append(".mtu");
+        f_mtl = fopen(mtl_filename.c_str(), "w");
+    }
+
+    if(!f_obj || ((has_colors || has_labels) && !f_mtl))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_OBJ() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    std::map<Color,uint> color_map;
+    if(has_colors)
+    {
+        for(const Color & c : data.poly_colors)
+        {
+            if (DOES_NOT_CONTAIN(color_map, c))
+            {
+                uint fresh_id = color_map.size();
+                color_map[c]  = fresh_id;
+                fprintf(f_mtl, "newmtl color_%d\nKd %f %f %f\n", fresh_id, c.r, c.g, c.b);
+            }
+        }
+    }
+    if(has_labels)
+    {
+        int min = *std::min_element(data.poly_labels.begin(), data.poly_labels.end());
+        int max = *std::max_element(data.poly_labels.begin(), data.poly_labels.end());
+        int delta  = max - min + 1;
+        for(int l = min; l <= max; l++)
+        {
+            Color c = Color::scatter(delta, l);
+            fprintf(f_mtl, "newmtl label_%d\nKd %f %f %f\n", l, c.r, c.g, c.b);
+        }
+    }
+    if(f_mtl) fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
+
+    for(const vec3d & v : data.verts)
+    {
+        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+        //
+        fprintf(f_obj, "v %.17g %.17g %.17g\n", v.x(), v.y(), v.z());
+    }
+
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        if(has_colors) fprintf(f_obj, "usemtl color_%d\n", color_map.at(data.poly_colors.at(pid)));
+        if(has_labels) fprintf(f_obj, "usemtl label_%d\n", data.poly_labels.at(pid));
+        fprintf(f_obj, "f ");
+        for(uint i=0; i<data.verts_per_poly(pid); ++i) fprintf(f_obj, "%d ", data.poly(pid)[i]+1);
+        fprintf(f_obj, "\n");
+    }
+
+    fclose(f_obj);
+    if(f_mtl) fclose(f_mtl);
+}
+
 }
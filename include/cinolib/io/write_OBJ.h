@@ -40,6 +40,7 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/color.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
@@ -91,6 +92,14 @@ void write_OBJ(const char                           * filename,
                const std::vector<std::vector<uint>> & poly,
                const std::vector<int>               & labels);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys are read straight from the serialized buffers of data. Per poly colors
+// (or labels, if there are no colors) are written as materials, as above
+//
+CINO_INLINE
+void write_OBJ(const char * filename, const IOData & data);
+
 }
 
 #ifndef  CINO_STATIC_LIB
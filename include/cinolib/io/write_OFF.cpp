@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_OFF.h>
+#include <cinolib/string_utilities.h>
 
 
 #include <iostream>
@@ -47,7 +48,7 @@ void write_OFF(const char                * filename,
               const std::vector<uint>  & tri,
               const std::vector<uint>  & quad)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -87,7 +88,7 @@ void write_OFF(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & faces)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -120,5 +121,40 @@ void write_OFF(const char                           * filename,
     fclose(fp);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_OFF(const char * filename, const IOData & data)
+{
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "w");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_OFF() : couldn't save file " << filename << std::endl;
+        exit(-1);
+    }
+
+    fprintf (fp, "OFF\n%d %d 0\n", data.num_verts(), data.num_polys());
+
+    for(const vec3d & v : data.verts)
+    {
+        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+        //
+        fprintf(fp, "%.17g %.17g %.17g\n", v.x(), v.y(), v.z());
+    }
+
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        fprintf(fp, "%d ", data.verts_per_poly(pid));
+        for(uint i=0; i<data.verts_per_poly(pid); ++i)
+        {
+            fprintf(fp, "%d ", data.poly(pid)[i]);
+        }
+        fprintf(fp, "\n");
+    }
+
+    fclose(fp);
+}
 
 }
@@ -39,6 +39,7 @@
 #include <sys/types.h>
 #include <vector>
 #include <cinolib/cino_inline.h>
+#include <cinolib/io/io_data.h>
 
 
 namespace cinolib
@@ -57,6 +58,13 @@ void write_OFF(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & faces);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys are read straight from the serialized buffers of data
+//
+CINO_INLINE
+void write_OFF(const char * filename, const IOData & data);
+
 }
 
 #ifndef  CINO_STATIC_LIB
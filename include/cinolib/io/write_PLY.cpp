@@ -0,0 +1,234 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_PLY.h>
+#include <cinolib/string_utilities.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace cinolib
+{
+
+// buffers binary records (written in bulk at the end of each element),
+// or prints ASCII values straight to file
+//
+struct PLY_writer
+{
+    FILE              * fp;
+    bool                binary;
+    std::vector<char>   buf;
+
+    template<typename T>
+    void put(const T val)
+    {
+        if(binary)
+        {
+            size_t off = buf.size();
+            buf.resize(off + sizeof(T));
+            memcpy(&buf[off], &val, sizeof(T));
+        }
+        else if(std::is_integral<T>::value) fprintf(fp, "%lld ", (long long)val);
+        else fprintf(fp, "%.17g ", double(val));
+    }
+
+    void end_record()
+    {
+        if(!binary) fprintf(fp, "\n");
+    }
+
+    void flush()
+    {
+        if(binary && !buf.empty()) fwrite(buf.data(), 1, buf.size(), fp);
+        buf.clear();
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+CINO_INLINE
+unsigned char ply_color_channel(const float c)
+{
+    return (unsigned char)(std::min(std::max(c, 0.f), 1.f)*255.f + 0.5f);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Attributes>
+CINO_INLINE
+void ply_write_attributes(PLY_writer & w, const Attributes & a, const int props)
+{
+    if(props & PLY_NORMAL)
+    {
+        w.put(float(a.normal.x()));
+        w.put(float(a.normal.y()));
+        w.put(float(a.normal.z()));
+    }
+    if(props & PLY_COLOR)
+    {
+        w.put(ply_color_channel(a.color.r));
+        w.put(ply_color_channel(a.color.g));
+        w.put(ply_color_channel(a.color.b));
+        w.put(ply_color_channel(a.color.a));
+    }
+    if(props & PLY_LABEL  ) w.put(int32_t(a.label));
+    if(props & PLY_QUALITY) w.put(float(a.quality));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ply_write_header(FILE * fp, const int props, const std::map<std::string,ScalarField> & fields)
+{
+    if(props & PLY_NORMAL)
+    {
+        fprintf(fp, "property float nx\nproperty float ny\nproperty float nz\n");
+    }
+    if(props & PLY_COLOR)
+    {
+        fprintf(fp, "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n");
+    }
+    if(props & PLY_LABEL  ) fprintf(fp, "property int label\n");
+    if(props & PLY_QUALITY) fprintf(fp, "property float quality\n");
+    for(const auto & f : fields) fprintf(fp, "property double %s\n", f.first.c_str());
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_PLY(const char                                * filename,
+               const std::vector<vec3d>                  & verts,
+               const std::vector<std::vector<uint>>      & polys,
+               const std::vector<Vert_std_attributes>    & vert_attr,
+               const int                                   vert_props,
+               const std::vector<Polygon_std_attributes> & poly_attr,
+               const int                                   poly_props,
+               const std::map<std::string,ScalarField>   & vert_fields,
+               const std::map<std::string,ScalarField>   & poly_fields,
+               const bool                                  binary)
+{
+    assert(vert_props==0 || vert_attr.size()==verts.size());
+    assert(poly_props==0 || poly_attr.size()==polys.size());
+    for(const auto & f : vert_fields) assert(f.second.size()==verts.size());
+    for(const auto & f : poly_fields) assert(f.second.size()==polys.size());
+
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_PLY() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    uint max_poly_size = 0;
+    for(const auto & p : polys) max_poly_size = std::max(max_poly_size, uint(p.size()));
+    bool short_lists = (max_poly_size<256);
+
+    // the third texture coordinate is written only if it is actually used
+    bool uvw_3d = false;
+    if(vert_props & PLY_UVW) for(const auto & a : vert_attr) uvw_3d |= (a.uvw.z()!=0);
+
+    fprintf(fp, "ply\n");
+    if(!binary) fprintf(fp, "format ascii 1.0\n");
+    else if(PLY_host_is_little_endian()) fprintf(fp, "format binary_little_endian 1.0\n");
+    else fprintf(fp, "format binary_big_endian 1.0\n");
+    fprintf(fp, "comment generated by CinoLib\n");
+    fprintf(fp, "element vertex %zu\n", verts.size());
+    fprintf(fp, "property double x\nproperty double y\nproperty double z\n");
+    ply_write_header(fp, vert_props & ~PLY_UVW, vert_fields);
+    if(vert_props & PLY_UVW) fprintf(fp, "property float u\nproperty float v\n");
+    if(uvw_3d)               fprintf(fp, "property float w\n");
+    fprintf(fp, "element face %zu\n", polys.size());
+    fprintf(fp, "property list %s int vertex_indices\n", short_lists ? "uchar" : "int");
+    ply_write_header(fp, poly_props & ~PLY_UVW, poly_fields);
+    fprintf(fp, "end_header\n");
+
+    PLY_writer w;
+    w.fp     = fp;
+    w.binary = binary;
+
+    w.buf.reserve(verts.size()*(24 + 12*vert_fields.size()));
+    for(uint vid=0; vid<verts.size(); ++vid)
+    {
+        w.put(verts[vid].x());
+        w.put(verts[vid].y());
+        w.put(verts[vid].z());
+        if(vert_props) ply_write_attributes(w, vert_attr[vid], vert_props);
+        for(const auto & f : vert_fields) w.put(double(f.second[vid]));
+        if(vert_props & PLY_UVW)
+        {
+            w.put(float(vert_attr[vid].uvw.x()));
+            w.put(float(vert_attr[vid].uvw.y()));
+            if(uvw_3d) w.put(float(vert_attr[vid].uvw.z()));
+        }
+        w.end_record();
+    }
+    w.flush();
+
+    w.buf.reserve(polys.size()*(1 + 4*max_poly_size));
+    for(uint pid=0; pid<polys.size(); ++pid)
+    {
+        if(short_lists) w.put(uint8_t(polys[pid].size()));
+        else            w.put(int32_t(polys[pid].size()));
+        for(uint vid : polys[pid]) w.put(int32_t(vid));
+        if(poly_props) ply_write_attributes(w, poly_attr[pid], poly_props & ~PLY_UVW);
+        for(const auto & f : poly_fields) w.put(double(f.second[pid]));
+        w.end_record();
+    }
+    w.flush();
+
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_PLY(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary)
+{
+    write_PLY(filename, verts, polys, {}, 0, {}, 0, {}, {}, binary);
+}
+
+}
@@ -0,0 +1,84 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WRITE_PLY_H
+#define CINO_WRITE_PLY_H
+
+#include <sys/types.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/meshes/mesh_attributes.h>
+#include <cinolib/scalar_field.h>
+#include <cinolib/io/PLY_utilities.h>
+
+namespace cinolib
+{
+
+/* Writes a PLY file, either ASCII or binary (with the byte order of the host).
+ * The standard attributes selected by vert_props/poly_props (PLY_NORMAL,
+ * PLY_COLOR,...) are written as the usual PLY properties, and fields are written
+ * as additional double precision properties, named after their key.
+*/
+
+CINO_INLINE
+void write_PLY(const char                                * filename,
+               const std::vector<vec3d>                  & verts,
+               const std::vector<std::vector<uint>>      & polys,
+               const std::vector<Vert_std_attributes>    & vert_attr,
+               const int                                   vert_props,
+               const std::vector<Polygon_std_attributes> & poly_attr,
+               const int                                   poly_props,
+               const std::map<std::string,ScalarField>   & vert_fields = {},
+               const std::map<std::string,ScalarField>   & poly_fields = {},
+               const bool                                  binary = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_PLY(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary = true);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "write_PLY.cpp"
+#endif
+
+#endif // CINO_WRITE_PLY
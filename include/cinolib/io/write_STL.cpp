@@ -33,6 +33,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_STL.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/geometry/polygon_utils.h>
 #include <iostream>
 
 namespace cinolib
@@ -44,7 +46,7 @@ void write_STL(const char                           * filename,
                const std::vector<std::vector<uint>> & poly,
                const std::vector<double>            & normals)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
     if(!fp)
@@ -68,4 +70,40 @@ void write_STL(const char                           * filename,
     fclose(fp);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_STL(const char * filename, const IOData & data)
+{
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "w");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_STL() : couldn't save file " << filename << std::endl;
+        exit(-1);
+    }
+
+    fprintf(fp, "solid cinolib_mesh\n");
+    std::vector<vec3d> pts;
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        const uint * p = data.poly(pid);
+        pts.clear();
+        for(uint i=0; i<data.verts_per_poly(pid); ++i) pts.push_back(data.verts.at(p[i]));
+        vec3d n = polygon_normal(pts);
+
+        fprintf(fp, "facet normal %f %f %f\n", n.x(), n.y(), n.z());
+        fprintf(fp, "  outer loop\n");
+        fprintf(fp, "    vertex %f %f %f\n", pts.at(0).x(), pts.at(0).y(), pts.at(0).z());
+        fprintf(fp, "    vertex %f %f %f\n", pts.at(1).x(), pts.at(1).y(), pts.at(1).z());
+        fprintf(fp, "    vertex %f %f %f\n", pts.at(2).x(), pts.at(2).y(), pts.at(2).z());
+        fprintf(fp, "  endloop\n");
+        fprintf(fp, "endfacet\n");
+    }
+    fprintf(fp, "endsolid cinolib_mesh\n");
+
+    fclose(fp);
+}
+
 }
@@ -37,6 +37,7 @@
 
 #include <vector>
 #include <cinolib/cino_inline.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
@@ -46,6 +47,14 @@ void write_STL(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & poly,
                const std::vector<double>            & normals);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys are read straight from the serialized buffers of data, and their
+// normals are computed on the fly. As above, only triangles can be stored
+//
+CINO_INLINE
+void write_STL(const char * filename, const IOData & data);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_TET.h>
+#include <cinolib/string_utilities.h>
 
 
 #include <iostream>
@@ -46,7 +47,7 @@ void write_TET(const char                           * filename,
                const std::vector<vec3d>             & verts,
                const std::vector<std::vector<uint>> & tets)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
@@ -81,7 +82,7 @@ void write_TET(const char                * filename,
                const std::vector<double> & xyz,
                const std::vector<uint>   & tets)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     FILE *fp = fopen(filename, "w");
 
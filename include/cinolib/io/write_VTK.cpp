@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTK.h>
+#include <cinolib/string_utilities.h>
 
 
 #ifdef CINOLIB_USES_VTK
@@ -55,7 +56,7 @@ void write_VTK(const char                           * filename,
                const std::vector<vec3d>             & verts,
                const std::vector<std::vector<uint>> & polys)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
     vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
@@ -126,7 +127,7 @@ void write_VTK(const char                * filename,
                const std::vector<uint>   & tets,
                const std::vector<uint>   & hexa)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
     vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
@@ -34,7 +34,12 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTU.h>
-
+#include <cinolib/string_utilities.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <set>
 
 #ifdef CINOLIB_USES_VTK
 #include <vtkSmartPointer.h>
@@ -48,14 +53,424 @@
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
+namespace
+{
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE const char * vtu_type_name(const double  &) { return "Float64"; }
+CINO_INLINE const char * vtu_type_name(const int64_t &) { return "Int64";   }
+CINO_INLINE const char * vtu_type_name(const uint8_t &) { return "UInt8";   }
+
+CINO_INLINE int vtu_print(char * buf, const double  & v) { return sprintf(buf, "%.17g", v);       }
+CINO_INLINE int vtu_print(char * buf, const int64_t & v) { return sprintf(buf, "%lld", (long long)v); }
+CINO_INLINE int vtu_print(char * buf, const uint8_t & v) { return sprintf(buf, "%u", uint(v));   }
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct VTU_writer
+{
+    int         format;
+    bool        compress;
+    std::string xml;
+    std::string appended; // raw bytes or base64 text
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    // header (size in bytes, or block table if compressed) + data
+    void binary_block(const unsigned char * data, const size_t n_bytes, std::string & out, const bool b64)
+    {
+        std::vector<uint64_t>      header;
+        std::vector<unsigned char> compressed;
+        if(compress) zlib_compress_blocks(data, n_bytes, header, compressed);
+        else         header.push_back(n_bytes);
+
+        const unsigned char *h = (const unsigned char*)header.data();
+        const size_t         s = header.size()*sizeof(uint64_t);
+
+        if(!b64)
+        {
+            out.append((const char*)h, s);
+            if(compress) out.append((const char*)compressed.data(), compressed.size());
+            else         out.append((const char*)data, n_bytes);
+        }
+        else if(compress)
+        {
+            // compressed data: header and blocks are encoded separately
+            base64_encode(h, s, out);
+            base64_encode(compressed.data(), compressed.size(), out);
+        }
+        else
+        {
+            // uncompressed data: header and data are encoded as a unique stream
+            std::vector<unsigned char> tmp(h, h+s);
+            tmp.insert(tmp.end(), data, data+n_bytes);
+            base64_encode(tmp.data(), tmp.size(), out);
+        }
+    }
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    template<typename T>
+    void add_array(const std::string & name, const uint n_components, const std::vector<T> & data)
+    {
+        xml += "        <DataArray type=\"" + std::string(vtu_type_name(T())) + "\"";
+        if(!name.empty())   xml += " Name=\"" + name + "\"";
+        if(n_components>1)  xml += " NumberOfComponents=\"" + std::to_string(n_components) + "\"";
+
+        const unsigned char *bytes = (const unsigned char*)data.data();
+        switch(format)
+        {
+            case VTU_ASCII:
+            {
+                xml += " format=\"ascii\">\n";
+                char buf[64];
+                for(size_t i=0; i<data.size(); ++i)
+                {
+                    xml.append(buf, vtu_print(buf, data[i]));
+                    xml += ((i+1)%(3*n_components)==0 || i+1==data.size()) ? '\n' : ' ';
+                }
+                xml += "        </DataArray>\n";
+                break;
+            }
+            case VTU_BINARY:
+            {
+                xml += " format=\"binary\">\n";
+                binary_block(bytes, data.size()*sizeof(T), xml, true);
+                xml += "\n        </DataArray>\n";
+                break;
+            }
+            case VTU_APPENDED_RAW:
+            case VTU_APPENDED_BASE64:
+            {
+                xml += " format=\"appended\" offset=\"" + std::to_string(appended.size()) + "\"/>\n";
+                binary_block(bytes, data.size()*sizeof(T), appended, format==VTU_APPENDED_BASE64);
+                break;
+            }
+            default: assert(false && "unknown VTU format");
+        }
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// cells are given in the serialized form VTU files use. The faces of general
+// polyhedra are listed in faces (with a -1 in faceoffs for tets and hexa)
+//
+CINO_INLINE
+void VTU_write(const char                        * filename,
+               const std::vector<vec3d>          & verts,
+               const std::vector<int64_t>        & conn,
+               const std::vector<int64_t>        & offs,
+               const std::vector<uint8_t>        & types,
+               const std::vector<int64_t>        & faces,
+               const std::vector<int64_t>        & faceoffs,
+               const std::vector<VTU_data_array> & vert_data,
+               const std::vector<VTU_data_array> & poly_data,
+               const int                           format,
+               const bool                          compress)
+{
+    use_dot_as_decimal_separator();
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_VTU() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    VTU_writer w;
+    w.format   = format;
+    w.compress = compress && format!=VTU_ASCII;
+#ifndef CINOLIB_USES_ZLIB
+    if(w.compress)
+    {
+        std::cerr << "WARNING : ZLIB missing. Data will not be compressed. Install ZLIB and recompile defining symbol CINOLIB_USES_ZLIB" << std::endl;
+        w.compress = false;
+    }
+#endif
+
+    std::vector<double> xyz;
+    xyz.reserve(verts.size()*3);
+    for(const vec3d & v : verts)
+    {
+        xyz.push_back(v.x());
+        xyz.push_back(v.y());
+        xyz.push_back(v.z());
+    }
+    bool has_polyhedra = !faces.empty();
+
+    uint16_t one = 1;
+    bool little_endian = (*(unsigned char*)&one)==1;
+
+    w.xml += "<?xml version=\"1.0\"?>\n";
+    w.xml += "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\"";
+    w.xml += little_endian ? " byte_order=\"LittleEndian\"" : " byte_order=\"BigEndian\"";
+    w.xml += " header_type=\"UInt64\"";
+    if(w.compress) w.xml += " compressor=\"vtkZLibDataCompressor\"";
+    w.xml += ">\n";
+    w.xml += "  <UnstructuredGrid>\n";
+    w.xml += "    <Piece NumberOfPoints=\"" + std::to_string(verts.size()) + "\" NumberOfCells=\"" + std::to_string(types.size()) + "\">\n";
+    if(!vert_data.empty())
+    {
+        w.xml += "      <PointData>\n";
+        for(const VTU_data_array & d : vert_data)
+        {
+            assert(d.values.size()==verts.size()*d.n_components);
+            w.add_array(d.name, d.n_components, d.values);
+        }
+        w.xml += "      </PointData>\n";
+    }
+    if(!poly_data.empty())
+    {
+        w.xml += "      <CellData>\n";
+        for(const VTU_data_array & d : poly_data)
+        {
+            assert(d.values.size()==types.size()*d.n_components);
+            w.add_array(d.name, d.n_components, d.values);
+        }
+        w.xml += "      </CellData>\n";
+    }
+    w.xml += "      <Points>\n";
+    w.add_array("Points", 3, xyz);
+    w.xml += "      </Points>\n";
+    w.xml += "      <Cells>\n";
+    w.add_array("connectivity", 1, conn);
+    w.add_array("offsets",      1, offs);
+    w.add_array("types",        1, types);
+    if(has_polyhedra)
+    {
+        w.add_array("faces",       1, faces);
+        w.add_array("faceoffsets", 1, faceoffs);
+    }
+    w.xml += "      </Cells>\n";
+    w.xml += "    </Piece>\n";
+    w.xml += "  </UnstructuredGrid>\n";
+    fwrite(w.xml.data(), 1, w.xml.size(), fp);
+
+    if(format==VTU_APPENDED_RAW || format==VTU_APPENDED_BASE64)
+    {
+        fprintf(fp, "  <AppendedData encoding=\"%s\">\n   _", (format==VTU_APPENDED_RAW) ? "raw" : "base64");
+        fwrite(w.appended.data(), 1, w.appended.size(), fp);
+        fprintf(fp, "\n  </AppendedData>\n");
+    }
+    fprintf(fp, "</VTKFile>\n");
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// arrays that allow each element type to be viewed alone by thresholding
+//
+CINO_INLINE
+std::vector<VTU_data_array> VTU_type_selectors(const std::vector<uint8_t> & types)
+{
+    VTU_data_array tetselector, hexselector;
+    tetselector.name = "tet_selector";
+    hexselector.name = "hex_selector";
+    for(uint8_t t : types)
+    {
+        tetselector.values.push_back(t==10);
+        hexselector.values.push_back(t==12);
+    }
+
+    std::vector<VTU_data_array> poly_data;
+    if(std::find(tetselector.values.begin(), tetselector.values.end(), 1)!=tetselector.values.end()) poly_data.push_back(tetselector);
+    if(std::find(hexselector.values.begin(), hexselector.values.end(), 1)!=hexselector.values.end()) poly_data.push_back(hexselector);
+    return poly_data;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint8_t VTU_cell_type(const size_t nv)
+{
+    switch(nv)
+    {
+        case 4 : return 10; // VTK_TETRA
+        case 8 : return 12; // VTK_HEXAHEDRON
+        default: assert(false && "Unsupported Polyhedron!");
+    }
+    return 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTU(const char                                        * filename,
+               const std::vector<vec3d>                          & verts,
+               const std::vector<std::vector<uint>>              & polys,
+               const std::vector<std::vector<std::vector<uint>>> & polys_faces,
+               const std::vector<VTU_data_array>                 & vert_data,
+               const std::vector<VTU_data_array>                 & poly_data,
+               const int                                           format,
+               const bool                                          compress)
+{
+    assert(polys_faces.empty() || polys_faces.size()==polys.size());
+
+    // serialize cells
+    std::vector<int64_t> conn, offs, faces, faceoffs;
+    std::vector<uint8_t> types;
+    offs.reserve(polys.size());
+    types.reserve(polys.size());
+    bool has_polyhedra = false;
+    for(size_t pid=0; pid<polys.size(); ++pid)
+    {
+        const std::vector<uint> & p = polys.at(pid);
+        conn.insert(conn.end(), p.begin(), p.end());
+        offs.push_back(conn.size());
+
+        if(!polys_faces.empty() && !polys_faces.at(pid).empty())
+        {
+            const auto & p_faces = polys_faces.at(pid);
+            faces.push_back(p_faces.size());
+            for(const auto & f : p_faces)
+            {
+                faces.push_back(f.size());
+                faces.insert(faces.end(), f.begin(), f.end());
+            }
+            faceoffs.push_back(faces.size());
+            types.push_back(42); // VTK_POLYHEDRON
+            has_polyhedra = true;
+        }
+        else
+        {
+            faceoffs.push_back(-1);
+            types.push_back(VTU_cell_type(p.size()));
+        }
+    }
+    if(!has_polyhedra) faceoffs.clear();
+
+    VTU_write(filename, verts, conn, offs, types, faces, faceoffs, vert_data, poly_data, format, compress);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding,
+               const int                              format,
+               const bool                             compress)
+{
+    assert(polys.size()==polys_face_winding.size());
+
+    std::vector<std::vector<uint>>              cells(polys.size());
+    std::vector<std::vector<std::vector<uint>>> cells_faces(polys.size());
+    for(size_t pid=0; pid<polys.size(); ++pid)
+    {
+        std::set<uint> vids;
+        for(size_t off=0; off<polys.at(pid).size(); ++off)
+        {
+            std::vector<uint> f = faces.at(polys.at(pid).at(off));
+            if(!polys_face_winding.at(pid).at(off)) std::reverse(f.begin(), f.end());
+            vids.insert(f.begin(), f.end());
+            cells_faces.at(pid).push_back(f);
+        }
+        cells.at(pid) = std::vector<uint>(vids.begin(), vids.end());
+    }
+    write_VTU(filename, verts, cells, cells_faces, {}, {}, format, compress);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
 void write_VTU(const char                           * filename,
                const std::vector<vec3d>             & verts,
                const std::vector<std::vector<uint>> & polys)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    std::vector<uint8_t> types;
+    types.reserve(polys.size());
+    for(const auto & p : polys) types.push_back(VTU_cell_type(p.size()));
+
+    write_VTU(filename, verts, polys, {}, {}, VTU_type_selectors(types));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTU(const char   * filename,
+               const IOData & data,
+               const int      format,
+               const bool     compress)
+{
+    std::vector<int64_t> conn, offs, faces, faceoffs;
+    std::vector<uint8_t> types(data.num_polys());
+
+    if(data.num_faces()==0)
+    {
+        // cells are already serialized the way VTU files want them
+        conn.assign(data.polys.begin(), data.polys.end());
+        offs.assign(data.poly_offsets.begin()+1, data.poly_offsets.end());
+        for(uint pid=0; pid<data.num_polys(); ++pid) types.at(pid) = VTU_cell_type(data.verts_per_poly(pid));
+        VTU_write(filename, data.verts, conn, offs, types, faces, faceoffs, {}, VTU_type_selectors(types), format, compress);
+        return;
+    }
+
+    // general polyhedra: list the faces of each cell, all pointing outwards
+    offs.reserve(data.num_polys());
+    faceoffs.reserve(data.num_polys());
+    for(uint pid=0; pid<data.num_polys(); ++pid)
+    {
+        std::set<uint> vids;
+        faces.push_back(data.verts_per_poly(pid));
+        for(uint off=0; off<data.verts_per_poly(pid); ++off)
+        {
+            uint         fid = data.poly(pid)[off];
+            uint         nv  = data.verts_per_face(fid);
+            const uint * f   = data.face(fid);
+            bool         ccw = data.poly_winding.at(data.poly_offsets.at(pid)+off);
+            faces.push_back(nv);
+            for(uint i=0; i<nv; ++i) faces.push_back(ccw ? f[i] : f[nv-1-i]);
+            vids.insert(f, f+nv);
+        }
+        faceoffs.push_back(faces.size());
+        conn.insert(conn.end(), vids.begin(), vids.end());
+        offs.push_back(conn.size());
+        types.at(pid) = 42; // VTK_POLYHEDRON
+    }
+    VTU_write(filename, data.verts, conn, offs, types, faces, faceoffs, {}, {}, format, compress);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTU(const char                * filename,
+               const std::vector<double> & xyz,
+               const std::vector<uint>   & tets,
+               const std::vector<uint>   & hexa)
+{
+    std::vector<vec3d> verts;
+    verts.reserve(xyz.size()/3);
+    for(size_t i=0; i<xyz.size(); i+=3)
+    {
+        verts.push_back(vec3d(xyz[i], xyz[i+1], xyz[i+2]));
+    }
+
+    std::vector<std::vector<uint>> polys;
+    polys.reserve(tets.size()/4 + hexa.size()/8);
+    for(size_t i=0; i<tets.size(); i+=4) polys.push_back(std::vector<uint>(tets.begin()+i, tets.begin()+i+4));
+    for(size_t i=0; i<hexa.size(); i+=8) polys.push_back(std::vector<uint>(hexa.begin()+i, hexa.begin()+i+8));
+
+    write_VTU(filename, verts, polys);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_VTK
+
+CINO_INLINE
+void write_VTU_with_VTK(const char                           * filename,
+                        const std::vector<vec3d>             & verts,
+                        const std::vector<std::vector<uint>> & polys)
+{
+    use_dot_as_decimal_separator();
 
     vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
     vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
@@ -118,95 +533,6 @@ void write_VTU(const char                           * filename,
     writer->Write();
 }
 
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void write_VTU(const char                * filename,
-               const std::vector<double> & xyz,
-               const std::vector<uint>   & tets,
-               const std::vector<uint>   & hexa)
-{
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                    points = vtkSmartPointer<vtkPoints>::New();
-
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
-
-    // write the vertex coordinates
-    //
-    for(size_t i=0; i<xyz.size(); i+=3)
-    {
-        points->InsertNextPoint(xyz[i+0], xyz[i+1], xyz[i+2]);
-    }
-
-    // write the tetrahedra
-    //
-    for(size_t i=0; i<tets.size(); i+=4)
-    {
-        vtkIdType pid[] = { tets[i+0], tets[i+1], tets[i+2], tets[i+3] };
-        grid->InsertNextCell(VTK_TETRA, 4, pid);
-        tetselector->InsertNextValue(1);
-        hexselector->InsertNextValue(0);
-    }
-
-    // write the hexahedra
-    //
-    for(size_t i=0; i<hexa.size(); i+=8 )
-    {
-        vtkIdType pid[] = { hexa[i+0], hexa[i+1], hexa[i+2], hexa[i+3],
-                            hexa[i+4], hexa[i+5], hexa[i+6], hexa[i+7] };
-        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-        tetselector->InsertNextValue(0);
-        hexselector->InsertNextValue(1);
-    }
-
-    // create the output mesh
-    //
-    grid->SetPoints(points);
-
-    if (tets.size() > 0) grid->GetCellData()->AddArray(tetselector);
-    if (hexa.size() > 0) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
-}
-
-#else
-
-CINO_INLINE
-void write_VTU(const char                *,
-               const std::vector<double> &,
-               const std::vector<uint>   &,
-               const std::vector<uint>   &)
-{
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void write_VTU(const char                           *,
-               const std::vector<vec3d>             &,
-               const std::vector<std::vector<uint>> &)
-{
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
-}
-
-
 #endif
 
 }
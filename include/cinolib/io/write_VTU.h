@@ -40,10 +40,45 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/VTU_utilities.h>
+#include <cinolib/io/io_data.h>
 
 namespace cinolib
 {
 
+/* Native writer for VTK XML unstructured grids (.vtu). It does not depend on VTK.
+ * Arrays can be stored as ASCII, binary (base64) or appended (raw or base64) data
+ * (see VTU_utilities.h), and binary data can be compressed if CINOLIB_USES_ZLIB is
+ * defined. Cells with a non empty list of faces are exported as general polyhedra
+ * (VTK_POLYHEDRON, faces must point outwards), the others must be either tetrahedra
+ * or hexahedra.
+*/
+
+CINO_INLINE
+void write_VTU(const char                                        * filename,
+               const std::vector<vec3d>                          & verts,
+               const std::vector<std::vector<uint>>              & polys,
+               const std::vector<std::vector<std::vector<uint>>> & polys_faces, // empty for tets and hexa
+               const std::vector<VTU_data_array>                 & vert_data,
+               const std::vector<VTU_data_array>                 & poly_data,
+               const int                                           format   = VTU_APPENDED_RAW,
+               const bool                                          compress = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// explicit representation of the cells (same as HEDRA files). All cells are exported as general polyhedra
+//
+CINO_INLINE
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding,
+               const int                              format   = VTU_APPENDED_RAW,
+               const bool                             compress = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void write_VTU(const char                * filename,
                const std::vector<double> & xyz,
@@ -57,6 +92,27 @@ void write_VTU(const char                           * filename,
                const std::vector<vec3d>             & verts,
                const std::vector<std::vector<uint>> & polys);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// cells are read straight from the serialized buffers of data. If data has faces,
+// cells are exported as general polyhedra, as in the explicit overload above
+//
+CINO_INLINE
+void write_VTU(const char   * filename,
+               const IOData & data,
+               const int      format   = VTU_APPENDED_RAW,
+               const bool     compress = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_VTK
+// legacy writer, based on the VTK library (only tetrahedra and hexahedra)
+CINO_INLINE
+void write_VTU_with_VTK(const char                           * filename,
+                        const std::vector<vec3d>             & verts,
+                        const std::vector<std::vector<uint>> & polys);
+#endif
+
 }
 
 #ifndef  CINO_STATIC_LIB
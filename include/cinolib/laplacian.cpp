@@ -34,8 +34,11 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/laplacian.h>
+#include <cinolib/sparse_matrix_assembly.h>
+#include <cinolib/parallel_for.h>
 #include <cinolib/symbols.h>
 #include <Eigen/Sparse>
+#include <atomic>
 
 namespace cinolib
 {
@@ -48,50 +51,84 @@ std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<
                                                              const int mode,
                                                              const int n) // diagonally replicate n times
 {
+    Eigen::SparseMatrix<double> L = laplacian(m, mode, n);
+
     std::vector<Entry> entries;
+    entries.reserve(L.nonZeros());
+    for(int col=0; col<L.outerSize(); ++col)
+    for(Eigen::SparseMatrix<double>::InnerIterator it(L,col); it; ++it)
+    {
+        entries.push_back(Entry(it.row(), it.col(), it.value()));
+    }
+    return entries;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Laplacian weights are defined per edge, hence they are computed only once for
+ * each edge (rather than once for each endpoint), and the matrix is symmetric.
+ * This allows to fill it column by column (in parallel) directly in compressed
+ * form: column vid contains the weights of all the edges incident to vid, plus
+ * the diagonal entry.
+*/
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m, const int mode, const int n)
+{
+    std::vector<double> w(m.num_edges());
+    PARALLEL_FOR(0, m.num_edges(), 1000, [&](uint eid)
+    {
+        w[eid] = m.edge_weight(eid, mode);
+    });
 
     uint nv = m.num_verts();
-    std::vector<uint> base(n);
-    for(int i=0; i<n; ++i) base[i] = nv*i;
+    Eigen::SparseMatrix<double> L;
+    sparse_alloc(L, n*nv, n*nv, [&](uint col)
+    {
+        return m.adj_v2e(col%nv).size() + 1;
+    });
 
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+    std::atomic<uint> null_rows(0);
+    PARALLEL_FOR(0, nv, 1000, [&](uint vid)
     {
-        std::vector<std::pair<uint,double>> wgts;
-        m.vert_weights(vid, mode, wgts);
-        double sum = 0.0;
-        for(auto item : wgts)
+        int    *idx = L.innerIndexPtr() + L.outerIndexPtr()[vid];
+        double *val = L.valuePtr()      + L.outerIndexPtr()[vid];
+        double  sum = 0.0;
+        uint    k   = 0;
+        for(uint eid : m.adj_v2e(vid))
         {
-            for(int i=0; i<n; ++i)
-            {
-                entries.push_back(Entry(base[i] + vid, base[i] + item.first, item.second));
-            }
-            sum -= item.second;
+            idx[k] = m.vert_opposite_to(eid, vid);
+            val[k] = w[eid];
+            sum   -= w[eid];
+            ++k;
         }
         if(sum == 0.0)
         {
-            std::cerr << "WARNING: null row in the matrix! (disconnected vertex? I put 1 in the diagonal)" << std::endl;
+            ++null_rows;
             sum = 1.0;
         }
-        for(int i=0; i<n; ++i)
+        idx[k] = vid;
+        val[k] = sum;
+        ++k;
+
+        for(int i=1; i<n; ++i)
         {
-            entries.push_back(Entry(base[i] + vid, base[i] + vid, sum));
+            uint col = nv*i + vid;
+            int    *idx_i = L.innerIndexPtr() + L.outerIndexPtr()[col];
+            double *val_i = L.valuePtr()      + L.outerIndexPtr()[col];
+            for(uint j=0; j<k; ++j)
+            {
+                idx_i[j] = nv*i + idx[j];
+                val_i[j] = val[j];
+            }
         }
-    }
-
-    return entries;
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-template<class M, class V, class E, class P>
-CINO_INLINE
-Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m, const int mode, const int n)
-{
-    std::vector<Entry> entries = laplacian_matrix_entries(m, mode, n);
+    });
+    sparse_sort_inner(L);
 
-    uint nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> L(nv,nv);
-    L.setFromTriplets(entries.begin(), entries.end());
+    if(null_rows>0)
+    {
+        std::cerr << "WARNING: " << null_rows << " null row(s) in the matrix! (disconnected vertex? I put 1 in the diagonal)" << std::endl;
+    }
 
     return L;
 }
@@ -60,6 +60,8 @@ Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// same as above, but returns the list of non zero entries (sorted by column)
+//
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<M,V,E,P> & m,
@@ -0,0 +1,86 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/laplacian_operator.h>
+#include <cinolib/parallel_for.h>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+LaplacianOperator<M,V,E,P>::LaplacianOperator(const AbstractMesh<M,V,E,P> & m,
+                                              const int                     mode,
+                                              const double                  scale,
+                                              const std::vector<double>   & shift)
+    : m(m)
+    , scale(scale)
+{
+    assert(shift.empty() || shift.size()==m.num_verts());
+
+    w.resize(m.num_edges());
+    PARALLEL_FOR(0, m.num_edges(), 1000, [&](uint eid)
+    {
+        w[eid] = m.edge_weight(eid, mode);
+    });
+
+    diag.resize(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+    {
+        double sum = 0.0;
+        for(uint eid : m.adj_v2e(vid)) sum -= w[eid];
+        if(sum == 0.0) sum = 1.0; // same as laplacian()
+        diag[vid] = scale * sum;
+        if(!shift.empty()) diag[vid] += shift[vid];
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void LaplacianOperator<M,V,E,P>::apply(const Eigen::VectorXd & x, Eigen::VectorXd & y) const
+{
+    assert(x.size() == diag.size());
+    y.resize(x.size());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+    {
+        double sum = 0.0;
+        for(uint eid : m.adj_v2e(vid)) sum += w[eid] * x[m.vert_opposite_to(eid,vid)];
+        y[vid] = diag[vid] * x[vid] + scale * sum;
+    });
+}
+
+}
@@ -0,0 +1,155 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_LAPLACIAN_OPERATOR_H
+#define CINO_LAPLACIAN_OPERATOR_H
+
+#include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/symbols.h>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P> class LaplacianOperator;
+
+}
+
+namespace Eigen
+{
+namespace internal
+{
+// the operator behaves as a (column major) sparse matrix of doubles
+template<class M, class V, class E, class P>
+struct traits<cinolib::LaplacianOperator<M,V,E,P>> : public traits<SparseMatrix<double>> {};
+}
+}
+
+namespace cinolib
+{
+
+/* Matrix-free version of laplacian(m,mode). The operator does not store the
+ * matrix: edge weights are computed once (one double per edge), and products
+ * y = A*x are evaluated on the fly from the mesh connectivity, in parallel.
+ * This saves the memory of the assembled matrix and, most importantly, of its
+ * factorization, and is meant to be used with iterative solvers (see solve_PCG
+ * in linear_solvers.h, or Eigen::ConjugateGradient).
+ *
+ * To directly express the systems used by most algorithms, the operator can be
+ * scaled and shifted by a per vertex diagonal term, that is
+ *
+ *     A = diag(shift) + scale * L
+ *
+ * e.g. -L for harmonic maps (scale = -1), or M - t*L for the heat flow (shift =
+ * vertex masses, scale = -t). As for laplacian(), null rows (e.g. isolated
+ * vertices) get a 1 in the diagonal of L.
+*/
+
+template<class M, class V, class E, class P>
+class LaplacianOperator : public Eigen::EigenBase<LaplacianOperator<M,V,E,P>>
+{
+    public:
+
+        typedef double Scalar;
+        typedef double RealScalar;
+        typedef int    StorageIndex;
+        enum
+        {
+            ColsAtCompileTime    = Eigen::Dynamic,
+            MaxColsAtCompileTime = Eigen::Dynamic,
+            IsRowMajor           = false
+        };
+
+        explicit LaplacianOperator(const AbstractMesh<M,V,E,P> & m,
+                                   const int                     mode  = COTANGENT,
+                                   const double                  scale = 1.0,
+                                   const std::vector<double>   & shift = {});
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        Eigen::Index rows() const { return m.num_verts(); }
+        Eigen::Index cols() const { return m.num_verts(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void                    apply   (const Eigen::VectorXd & x, Eigen::VectorXd & y) const; // y = A*x
+        const Eigen::VectorXd & diagonal() const { return diag; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // Eigen-style product (lazy evaluation, see generic_product_impl below)
+        template<typename Rhs>
+        Eigen::Product<LaplacianOperator,Rhs,Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<Rhs> & x) const
+        {
+            return Eigen::Product<LaplacianOperator,Rhs,Eigen::AliasFreeProduct>(*this, x.derived());
+        }
+
+    protected:
+
+        const AbstractMesh<M,V,E,P> & m;
+        double                        scale;
+        std::vector<double>           w;     // per edge weights
+        Eigen::VectorXd               diag;  // diagonal of A
+};
+
+}
+
+namespace Eigen
+{
+namespace internal
+{
+template<class M, class V, class E, class P, typename Rhs>
+struct generic_product_impl<cinolib::LaplacianOperator<M,V,E,P>, Rhs, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<cinolib::LaplacianOperator<M,V,E,P>, Rhs, generic_product_impl<cinolib::LaplacianOperator<M,V,E,P>,Rhs>>
+{
+    typedef typename Product<cinolib::LaplacianOperator<M,V,E,P>,Rhs>::Scalar Scalar;
+
+    template<typename Dest>
+    static void scaleAndAddTo(Dest & dst, const cinolib::LaplacianOperator<M,V,E,P> & lhs, const Rhs & rhs, const Scalar & alpha)
+    {
+        Eigen::VectorXd y;
+        lhs.apply(rhs, y);
+        dst += alpha * y;
+    }
+};
+}
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "laplacian_operator.cpp"
+#endif
+
+#endif // CINO_LAPLACIAN_OPERATOR_H
@@ -35,6 +35,10 @@
 *********************************************************************************/
 #include <cinolib/linear_solvers.h>
 #include <cinolib/stl_container_utilities.h>
+#include <cinolib/multigrid.h>
+#include <cinolib/parallel_for.h>
+#include <iostream>
+#include <vector>
 
 namespace cinolib
 {
@@ -43,13 +47,73 @@ typedef Eigen::Triplet<double> Entry;
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+namespace
+{
+
+// solves the columns of B independently, in parallel (solve() is const, and thread safe, for these solvers)
+template<class Solver>
+CINO_INLINE
+void solve_columns(const Solver & s, const Eigen::MatrixXd & B, Eigen::MatrixXd & X)
+{
+    X.resize(B.rows(), B.cols());
+    PARALLEL_FOR(0, B.cols(), 2, [&](uint col)
+    {
+        Eigen::VectorXd b = B.col(col);
+        X.col(col) = s.solve(b);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Precond>
+CINO_INLINE
+void solve_columns_PCG(const Eigen::SparseMatrix<double> & A,
+                       const Precond                     & P,
+                       const Eigen::MatrixXd             & B,
+                             Eigen::MatrixXd             & X,
+                       const bool                          warm_start,
+                       const bool                          parallel = true)
+{
+    X.resize(B.rows(), B.cols()); // (keeps the guess, if warm_start)
+    PARALLEL_FOR(0, B.cols(), parallel ? 2 : B.cols()+1, [&](uint col)
+    {
+        Eigen::VectorXd b = B.col(col);
+        Eigen::VectorXd x = warm_start ? Eigen::VectorXd(X.col(col)) : Eigen::VectorXd::Zero(b.size());
+        solve_PCG(A, P, b, x);
+        X.col(col) = x;
+    });
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void solve_square_system(const Eigen::SparseMatrix<double> & A,
                          const Eigen::VectorXd             & b,
                                Eigen::VectorXd             & x,
-                         int   solver)
+                         int   solver,
+                         bool  warm_start)
+{
+    Eigen::MatrixXd X;
+    if(warm_start && x.size()==b.size()) X = x;
+    solve_square_system(A, Eigen::MatrixXd(b), X, solver, warm_start);
+    x = X.col(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system(const Eigen::SparseMatrix<double> & A,
+                         const Eigen::MatrixXd             & B,
+                               Eigen::MatrixXd             & X,
+                         int   solver,
+                         bool  warm_start)
 {
     assert(A.rows() == A.cols());
+    assert(A.rows() == B.rows());
+
+    warm_start &= (X.rows()==B.rows() && X.cols()==B.cols());
 
     switch (solver)
     {
@@ -57,7 +121,7 @@ void solve_square_system(const Eigen::SparseMatrix<double> & A,
         {
             Eigen::SimplicialLLT< Eigen::SparseMatrix<double> > solver(A);
             assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            solve_columns(solver, B, X);
             break;
         }
 
@@ -65,18 +129,56 @@ void solve_square_system(const Eigen::SparseMatrix<double> & A,
         {
             Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(A);
             assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            solve_columns(solver, B, X);
             break;
         }
 
         case BiCGSTAB:
         {
+            // (iteration stats are stored in the solver, hence columns are solved serially)
             Eigen::BiCGSTAB< Eigen::SparseMatrix<double> , Eigen::IncompleteLUT<double> > solver;
             //solver.setMaxIterations(100);
             solver.setTolerance(1e-5);
             solver.compute(A);
             assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            X = warm_start ? solver.solveWithGuess(B,X).eval() : solver.solve(B).eval();
+            break;
+        }
+
+        case CG_JACOBI:
+        case CG_MATRIX_FREE:
+        {
+            JacobiPreconditioner P(A);
+            solve_columns_PCG(A, P, B, X, warm_start);
+            break;
+        }
+
+        case CG_INCOMPLETE_CHOLESKY:
+        {
+            Eigen::IncompleteCholesky<double> P(A);
+            assert(P.info() == Eigen::Success);
+            solve_columns_PCG(A, P, B, X, warm_start);
+            break;
+        }
+
+        case CG_MULTIGRID:
+        {
+            // (V-cycles are already parallel)
+            Multigrid P(A);
+            solve_columns_PCG(A, P, B, X, warm_start, false);
+            break;
+        }
+
+        case MULTIGRID:
+        {
+            Multigrid mg(A);
+            X.resize(B.rows(), B.cols());
+            for(int col=0; col<B.cols(); ++col)
+            {
+                Eigen::VectorXd x = warm_start ? Eigen::VectorXd(X.col(col)) : Eigen::VectorXd::Zero(B.rows());
+                mg.solve(B.col(col), x);
+                X.col(col) = x;
+            }
             break;
         }
 
@@ -87,7 +189,7 @@ void solve_square_system(const Eigen::SparseMatrix<double> & A,
             Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver;
             solver.analyzePattern(Ac);
             solver.factorize(Ac);
-            x = solver.solve(b);
+            solve_columns(solver, B, X);
             break;
         }
 
@@ -103,10 +205,28 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
                                        Eigen::VectorXd             & x,
                                  const std::map<uint,double>       & bc, // Dirichlet boundary conditions
                                  int   solver)
+{
+    std::map<uint,Eigen::RowVectorXd> bc_rows;
+    for(const auto & obj : bc) bc_rows[obj.first] = Eigen::RowVectorXd::Constant(1, obj.second);
+
+    Eigen::MatrixXd X;
+    solve_square_system_with_bc(A, Eigen::MatrixXd(b), X, bc_rows, solver);
+    x = X.col(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double>       & A,
+                                 const Eigen::MatrixXd                   & B,
+                                       Eigen::MatrixXd                   & X,
+                                 const std::map<uint,Eigen::RowVectorXd> & bc, // Dirichlet boundary conditions
+                                 int   solver)
 {
     std::vector<int> col_map(A.rows(), 0);
     for(const auto & obj : bc)
     {
+        assert(obj.second.size() == B.cols());
         col_map[obj.first] = -1;
     }
     uint fresh_id = 0;
@@ -121,13 +241,13 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
     uint size = A.rows() - bc.size();
 
     std::vector<Entry> Aprime_entries;
-    Eigen::VectorXd    bprime(size);
+    Eigen::MatrixXd    Bprime(size, B.cols());
 
     for(uint row=0; row<A.rows(); ++row)
     {
         if (col_map[row] >= 0)
         {
-            bprime[ col_map[row] ] = b[row];
+            Bprime.row(col_map[row]) = B.row(row);
         }
     }
 
@@ -147,7 +267,7 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
 
             if (col_map[col] < 0)
             {
-                bprime[ col_map[row] ] -= bc.at(col) * val;
+                Bprime.row(col_map[row]) -= bc.at(col) * val;
             }
             else
             {
@@ -159,37 +279,62 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
     Eigen::SparseMatrix<double> Aprime(size, size);
     Aprime.setFromTriplets(Aprime_entries.begin(), Aprime_entries.end());
 
-    Eigen::VectorXd tmp_x(size);
+    Eigen::MatrixXd tmp_X;
 
-    solve_square_system(Aprime, bprime, tmp_x, solver);
+    solve_square_system(Aprime, Bprime, tmp_X, solver);
 
-    x.resize(A.cols());
+    X.resize(A.cols(), B.cols());
     for(uint col=0; col<A.cols(); ++col)
     {
         if (col_map[col] >= 0)
         {
-            x[col] = tmp_x[ col_map[col] ];
+            X.row(col) = tmp_X.row(col_map[col]);
         }
         else
         {
-            x[col] = bc.at(col);
+            X.row(col) = bc.at(col);
         }
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
+                                 const Eigen::VectorXd             & b,
+                                       Eigen::VectorXd             & x,
+                                 const std::map<uint,double>       & bc,
+                                 FactorizationCache                & cache)
+{
+    cache.solve(A, b, x, bc);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double>       & A,
+                                 const Eigen::MatrixXd                   & B,
+                                       Eigen::MatrixXd                   & X,
+                                 const std::map<uint,Eigen::RowVectorXd> & bc,
+                                 FactorizationCache                      & cache)
+{
+    cache.solve(A, B, X, bc);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void solve_least_squares(const Eigen::SparseMatrix<double> & A,
                          const Eigen::VectorXd             & b,
                                Eigen::VectorXd             & x,
-                         int   solver)
+                         int   solver,
+                         bool  warm_start)
 {
     Eigen::SparseMatrix<double> At  = A.transpose();
     Eigen::SparseMatrix<double> AtA = At * A;
     Eigen::VectorXd             Atb = At * b;
 
-    solve_square_system(AtA, Atb, x, solver);
+    solve_square_system(AtA, Atb, x, solver, warm_start);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -215,13 +360,30 @@ void solve_weighted_least_squares(const Eigen::SparseMatrix<double> & A,
                                   const Eigen::VectorXd             & w,
                                   const Eigen::VectorXd             & b,
                                         Eigen::VectorXd             & x,
-                                  int   solver)
+                                  int   solver,
+                                  bool  warm_start)
 {
     Eigen::SparseMatrix<double> At   = A.transpose();
     Eigen::SparseMatrix<double> AtWA = At * w.asDiagonal() * A;
     Eigen::VectorXd             AtWb = At * w.asDiagonal() * b;
 
-    solve_square_system(AtWA, AtWb, x, solver);
+    solve_square_system(AtWA, AtWb, x, solver, warm_start);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_weighted_least_squares(const Eigen::SparseMatrix<double> & A,
+                                  const Eigen::VectorXd             & w,
+                                  const Eigen::VectorXd             & b,
+                                        Eigen::VectorXd             & x,
+                                  FactorizationCache                & cache)
+{
+    Eigen::SparseMatrix<double> At   = A.transpose();
+    Eigen::SparseMatrix<double> AtWA = At * w.asDiagonal() * A;
+    Eigen::VectorXd             AtWb = At * w.asDiagonal() * b;
+
+    cache.solve(AtWA, AtWb, x);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -241,6 +403,65 @@ void solve_weighted_least_squares_with_bc(const Eigen::SparseMatrix<double> & A,
     solve_square_system_with_bc(AtWA, AtWb, x, bc, solver);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class Op, class Precond>
+CINO_INLINE
+uint solve_PCG(const Op                    & A,
+               const Precond               & P,
+               const Eigen::VectorXd       & b,
+                     Eigen::VectorXd       & x,
+               const std::map<uint,double> & bc,
+               const double                  tol,
+               const uint                    max_iter)
+{
+    assert(A.rows() == b.size());
+
+    // constrained variables are kept fixed, and excluded from the iterations
+    std::vector<uint> fixed;
+    fixed.reserve(bc.size());
+    for(const auto & obj : bc) fixed.push_back(obj.first);
+    auto mask = [&](Eigen::VectorXd & v) { for(uint i : fixed) v[i] = 0.0; };
+
+    if(x.size() != b.size()) x = Eigen::VectorXd::Zero(b.size());
+    Eigen::VectorXd x_bc = Eigen::VectorXd::Zero(b.size());
+    for(const auto & obj : bc) x_bc[obj.first] = obj.second;
+
+    // reduced right hand side, and initial residual
+    Eigen::VectorXd b_free = b - A*x_bc;
+    mask(b_free);
+    mask(x);
+    Eigen::VectorXd r = b_free - A*x;
+    mask(r);
+
+    double threshold = tol * b_free.norm();
+    uint   iter      = 0;
+    bool   converged = (r.norm() <= threshold);
+    if(!converged)
+    {
+        Eigen::VectorXd z = P.solve(r); mask(z);
+        Eigen::VectorXd p = z;
+        Eigen::VectorXd Ap(b.size());
+        double rz = r.dot(z);
+        for(; iter<max_iter; ++iter)
+        {
+            Ap = A*p;
+            mask(Ap);
+            double alpha = rz / p.dot(Ap);
+            x += alpha * p;
+            r -= alpha * Ap;
+            if(r.norm() <= threshold) { converged = true; ++iter; break; }
+            z = P.solve(r);
+            mask(z);
+            double rz_new = r.dot(z);
+            p  = z + (rz_new/rz) * p;
+            rz = rz_new;
+        }
+        if(!converged) std::cerr << "WARNING : solve_PCG() : no convergence after " << max_iter << " iterations" << std::endl;
+    }
+
+    x += x_bc;
+    return iter;
+}
 
 }
@@ -40,6 +40,7 @@
 #include <map>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
+#include <cinolib/factorization_cache.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -56,6 +57,35 @@ namespace cinolib
  * --------------------------------------------------------------
  * BiCGSTAB     none
  * (iterative)
+ * --------------------------------------------------------------
+ * CG_JACOBI    positive definite
+ * (iterative,  symmetric
+ *  Jacobi preconditioner)
+ * --------------------------------------------------------------
+ * CG_INCOMPLETE_CHOLESKY
+ * (iterative,  positive definite
+ *  IC preconditioner)
+ * --------------------------------------------------------------
+ * CG_MATRIX_FREE
+ * (iterative)  positive definite
+ * --------------------------------------------------------------
+ * CG_MULTIGRID positive definite
+ * (iterative,  symmetric
+ *  multigrid preconditioner)
+ * --------------------------------------------------------------
+ * MULTIGRID    positive definite
+ * (iterative)  symmetric
+ *
+ * Iterative solvers do not factorize the matrix, hence their memory footprint
+ * is linear in the size of the system. CG_MATRIX_FREE does not even assemble it:
+ * functions that solve Laplacian systems (e.g. harmonic_map, heat_flow) use a
+ * LaplacianOperator instead. If a matrix is given (as in solve_square_system),
+ * it falls back to CG_JACOBI.
+ *
+ * Iterative solvers can be warm started: if warm_start is true and x already
+ * has the proper size, x is used as initial guess (e.g. the solution of the
+ * previous iteration of an algorithm that solves a sequence of similar systems).
+ * Direct solvers ignore the initial guess.
  */
 
 enum
@@ -64,16 +94,26 @@ enum
     SIMPLICIAL_LDLT,
     SparseLU,
     BiCGSTAB,
+    CG_JACOBI,
+    CG_INCOMPLETE_CHOLESKY,
+    CG_MATRIX_FREE,
+    CG_MULTIGRID,
+    MULTIGRID,
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-static const std::string txt[4] =
+static const std::string txt[9] =
 {
     "SIMPLICIAL_LLT"  ,
     "SIMPLICIAL_LDLT" ,
     "SparseLU",
     "BiCGSTAB",
+    "CG_JACOBI",
+    "CG_INCOMPLETE_CHOLESKY",
+    "CG_MATRIX_FREE",
+    "CG_MULTIGRID",
+    "MULTIGRID",
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -82,7 +122,8 @@ CINO_INLINE
 void solve_square_system(const Eigen::SparseMatrix<double> & A,
                          const Eigen::VectorXd             & b,
                                Eigen::VectorXd             & x,
-                         int   solver = SIMPLICIAL_LLT);
+                         int   solver     = SIMPLICIAL_LLT,
+                         bool  warm_start = false);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -95,11 +136,49 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// batched versions of the above: A is factorized once, and the columns of B
+// (e.g. x/y/z coordinates, or many heat sources) are solved in parallel.
+// For each constrained row, bc holds one value per column of B
+CINO_INLINE
+void solve_square_system(const Eigen::SparseMatrix<double> & A,
+                         const Eigen::MatrixXd             & B,
+                               Eigen::MatrixXd             & X,
+                         int   solver     = SIMPLICIAL_LLT,
+                         bool  warm_start = false);
+
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double>       & A,
+                                 const Eigen::MatrixXd                   & B,
+                                       Eigen::MatrixXd                   & X,
+                                 const std::map<uint,Eigen::RowVectorXd> & bc, // Dirichlet boundary conditions
+                                 int   solver = SIMPLICIAL_LLT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, but the factorization of A is kept in (or fetched from) the cache,
+// and reused by subsequent calls with the same matrix and set of constrained DOFs
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
+                                 const Eigen::VectorXd             & b,
+                                       Eigen::VectorXd             & x,
+                                 const std::map<uint,double>       & bc, // Dirichlet boundary conditions
+                                 FactorizationCache                & cache);
+
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double>       & A,
+                                 const Eigen::MatrixXd                   & B,
+                                       Eigen::MatrixXd                   & X,
+                                 const std::map<uint,Eigen::RowVectorXd> & bc, // Dirichlet boundary conditions
+                                 FactorizationCache                      & cache);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void solve_least_squares(const Eigen::SparseMatrix<double> & A,
                          const Eigen::VectorXd             & b,
                                Eigen::VectorXd             & x,
-                         int   solver = SIMPLICIAL_LLT);
+                         int   solver     = SIMPLICIAL_LLT,
+                         bool  warm_start = false);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -117,7 +196,20 @@ void solve_weighted_least_squares(const Eigen::SparseMatrix<double> & A,
                                   const Eigen::VectorXd             & w,
                                   const Eigen::VectorXd             & b,
                                         Eigen::VectorXd             & x,
-                                  int   solver = SIMPLICIAL_LLT);
+                                  int   solver     = SIMPLICIAL_LLT,
+                                  bool  warm_start = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, but the factorization of A^T*W*A is kept in (or fetched from)
+// the cache. Sequences of systems with the same pattern (e.g. the iterations of
+// a smoother) reuse the symbolic analysis, and only refactorize numerically
+CINO_INLINE
+void solve_weighted_least_squares(const Eigen::SparseMatrix<double> & A,
+                                  const Eigen::VectorXd             & w,
+                                  const Eigen::VectorXd             & b,
+                                        Eigen::VectorXd             & x,
+                                  FactorizationCache                & cache);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -129,6 +221,53 @@ void solve_weighted_least_squares_with_bc(const Eigen::SparseMatrix<double> & A,
                                           const std::map<uint,double>       & bc, // Dirichlet boundary conditions
                                           int   solver = SIMPLICIAL_LLT);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Preconditioned Conjugate Gradient, for symmetric positive definite systems.
+ *
+ * A can be anything that has rows() and can be multiplied by a dense vector:
+ * an Eigen sparse matrix, or a matrix-free operator (e.g. LaplacianOperator).
+ * P is the preconditioner, that is, anything that has a method solve(r) which
+ * returns an approximation of inv(A)*r: Eigen preconditioners, JacobiPreconditioner
+ * below, Multigrid (see multigrid.h), or user defined ones. Dirichlet boundary
+ * conditions are handled by restricting the iterations to the free variables,
+ * without assembling the reduced system.
+ *
+ * If x has the proper size, it is used as initial guess. Iterations stop when
+ * the residual is below tol times the norm of the (reduced) right hand side.
+ * Returns the number of iterations.
+*/
+
+template<class Op, class Precond>
+CINO_INLINE
+uint solve_PCG(const Op                    & A,
+               const Precond               & P,
+               const Eigen::VectorXd       & b,
+                     Eigen::VectorXd       & x,
+               const std::map<uint,double> & bc       = {}, // Dirichlet boundary conditions
+               const double                  tol      = 1e-8,
+               const uint                    max_iter = 10000);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class JacobiPreconditioner
+{
+    public:
+
+        template<class Op>
+        explicit JacobiPreconditioner(const Op & A)
+        {
+            inv_diag = A.diagonal();
+            for(int i=0; i<inv_diag.size(); ++i) inv_diag[i] = (inv_diag[i]!=0) ? 1.0/inv_diag[i] : 1.0;
+        }
+
+        Eigen::VectorXd solve(const Eigen::VectorXd & r) const { return inv_diag.cwiseProduct(r); }
+
+    protected:
+
+        Eigen::VectorXd inv_diag;
+};
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -0,0 +1,852 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/mesh_arrangement.h>
+#include <cinolib/segment_insertion_linear_earcut.h>
+#include <cinolib/octree.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/ipair.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_set>
+
+namespace cinolib
+{
+
+// all the points and segments found inside an input triangle. Corners are
+// sorted so as to be counterclockwise in the projection on the coordinate
+// plane orthogonal to the drop axis, and are the first three points
+struct TriangleCut
+{
+    uint                       drop    = 2;
+    bool                       flipped = false;
+    std::vector<ImplicitPoint> pts;      // points (corners first)
+    std::vector<uint>          ids;      // global id of each point (UINT_MAX if not known yet)
+    std::vector<uint>          pos;      // location of each point: on edge 0,1,2 (from corner i to i+1) or interior (3)
+    std::vector<uint>          segs;     // constrained segments (serialized pairs of indices in pts)
+    std::vector<uint>          coplanar; // coplanar input triangles having non empty intersection with this one
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+CINO_INLINE
+int sign(const double x)
+{
+    return (x>0) - (x<0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact orientation of four explicit points. The floating point filter is the one of
+// the Shewchuk predicates; uncertain cases resort to the implicit point predicates
+CINO_INLINE
+int orient3d_exact(const vec3d & a, const vec3d & b, const vec3d & c, const vec3d & d)
+{
+    double adx = a[0]-d[0], bdx = b[0]-d[0], cdx = c[0]-d[0];
+    double ady = a[1]-d[1], bdy = b[1]-d[1], cdy = c[1]-d[1];
+    double adz = a[2]-d[2], bdz = b[2]-d[2], cdz = c[2]-d[2];
+
+    double bdxcdy = bdx*cdy, cdxbdy = cdx*bdy;
+    double cdxady = cdx*ady, adxcdy = adx*cdy;
+    double adxbdy = adx*bdy, bdxady = bdx*ady;
+
+    double det = adz*(bdxcdy-cdxbdy) + bdz*(cdxady-adxcdy) + cdz*(adxbdy-bdxady);
+    double per = (std::fabs(bdxcdy)+std::fabs(cdxbdy))*std::fabs(adz) +
+                 (std::fabs(cdxady)+std::fabs(adxcdy))*std::fabs(bdz) +
+                 (std::fabs(adxbdy)+std::fabs(bdxady))*std::fabs(cdz);
+
+    const double eps = std::numeric_limits<double>::epsilon()*0.5;
+    if(std::fabs(det) > (7.0+56.0*eps)*eps*per) return sign(det);
+    return sign(orient3d(ImplicitPoint(a), ImplicitPoint(b), ImplicitPoint(c), ImplicitPoint(d)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a point that does not lie on the plane of a triangle which projects
+// without degeneracies on the coordinate plane orthogonal to axis. It is
+// used to define planes that pass through a segment of the triangle and
+// are transversal to it (i.e. the segment is where the two planes meet)
+CINO_INLINE
+vec3d lift(const vec3d & p, const uint axis)
+{
+    vec3d q = p;
+    q[axis] += std::max(1.0, std::fabs(q[axis]));
+    return q;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// exact lexicographic order (x,y,z)
+CINO_INLINE
+bool lex_less(const ImplicitPoint & a, const ImplicitPoint & b)
+{
+    for(uint axis=0; axis<3; ++axis)
+    {
+        int c = compare_coord(a, b, axis);
+        if(c!=0) return c<0;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a coordinate axis along which the points (which are assumed to be colinear)
+// are not all the same. Returns false if all the points are coincident
+CINO_INLINE
+bool line_axis(const std::vector<ImplicitPoint> & pts, uint & axis)
+{
+    for(uint i=1; i<pts.size(); ++i)
+    for(axis=0; axis<3; ++axis)
+    {
+        if(compare_coord(pts.front(), pts.at(i), axis)!=0) return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint add_point(TriangleCut & tc, const ImplicitPoint & p, const uint id)
+{
+    tc.pts.push_back(p);
+    tc.ids.push_back(id);
+    return tc.pts.size()-1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void add_segment(TriangleCut & tc, std::vector<vec3d> & planes, const uint a, const uint b,
+                 const vec3d & p0, const vec3d & p1, const vec3d & p2)
+{
+    tc.segs.push_back(a);
+    tc.segs.push_back(b);
+    planes.push_back(p0);
+    planes.push_back(p1);
+    planes.push_back(p2);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if p is inside the (closed) triangle
+CINO_INLINE
+bool in_triangle(const TriangleCut & tc, const ImplicitPoint & p)
+{
+    for(uint i=0; i<3; ++i)
+    {
+        if(orient2d(tc.pts.at(i), tc.pts.at((i+1)%3), p, tc.drop)<0) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the points where triangle u meets the plane of another triangle p. Vertex
+// u[i] is above, on, or below the plane depending on the sign of o[i]
+CINO_INLINE
+void plane_cut(const vec3d                * u[3],
+               const uint                   uv[3],
+               const int                    o[3],
+               const vec3d                * p[3],
+                     std::vector<ImplicitPoint> & pts,
+                     std::vector<uint>          & ids)
+{
+    for(uint i=0; i<3; ++i)
+    {
+        if(o[i]==0)
+        {
+            pts.push_back(ImplicitPoint(*u[i]));
+            ids.push_back(uv[i]);
+        }
+    }
+    for(uint i=0; i<3; ++i)
+    {
+        uint j = (i+1)%3;
+        if(o[i]*o[j]<0)
+        {
+            pts.push_back(ImplicitPoint::line_plane(*u[i], *u[j], *p[0], *p[1], *p[2]));
+            ids.push_back(UINT_MAX);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// intersection between the triangle and a non coplanar triangle j. Both
+// intersect the line where their planes meet in a segment (or a point):
+// the intersection between the two triangles is the overlap of these segments
+CINO_INLINE
+void cut_transversal(TriangleCut                & tc,
+                     std::vector<vec3d>         & planes,
+                     const vec3d                * t[3],
+                     const uint                   tv[3],
+                     const int                    ot[3],
+                     const vec3d                * j[3],
+                     const uint                   jv[3],
+                     const int                    oj[3])
+{
+    std::vector<ImplicitPoint> st, sj;
+    std::vector<uint>          it, ij;
+    plane_cut(t, tv, ot, j, st, it);
+    if(st.empty()) return;
+    plane_cut(j, jv, oj, t, sj, ij);
+    if(sj.empty()) return;
+
+    std::vector<ImplicitPoint> all = st;
+    all.insert(all.end(), sj.begin(), sj.end());
+    uint axis;
+    if(!line_axis(all, axis))
+    {
+        // the triangles touch at a single point
+        if(it.front()!=UINT_MAX) add_point(tc, st.front(), it.front());
+        else                     add_point(tc, sj.front(), ij.front());
+        return;
+    }
+
+    // sort endpoints along the line
+    if(st.size()==2 && compare_coord(st[0], st[1], axis)>0) { std::swap(st[0],st[1]); std::swap(it[0],it[1]); }
+    if(sj.size()==2 && compare_coord(sj[0], sj[1], axis)>0) { std::swap(sj[0],sj[1]); std::swap(ij[0],ij[1]); }
+
+    // overlap [max(lo_t,lo_j), min(hi_t,hi_j)]. Coincident endpoints are
+    // taken from the triangle where they are explicit (i.e. a vertex), if any
+    int  c_lo = compare_coord(st.front(), sj.front(), axis);
+    int  c_hi = compare_coord(st.back(),  sj.back(),  axis);
+    bool lo_t = c_lo>0 || (c_lo==0 && it.front()!=UINT_MAX);
+    bool hi_t = c_hi<0 || (c_hi==0 && it.back() !=UINT_MAX);
+    const ImplicitPoint & lo = lo_t ? st.front() : sj.front();
+    const ImplicitPoint & hi = hi_t ? st.back()  : sj.back();
+    int c = compare_coord(lo, hi, axis);
+    if(c>0) return;
+
+    uint id_lo = lo_t ? it.front() : ij.front();
+    uint id_hi = hi_t ? it.back()  : ij.back();
+    if(c==0)
+    {
+        if(id_lo!=UINT_MAX) add_point(tc, lo, id_lo);
+        else                add_point(tc, hi, id_hi);
+        return;
+    }
+    uint a = add_point(tc, lo, id_lo);
+    uint b = add_point(tc, hi, id_hi);
+    add_segment(tc, planes, a, b, *j[0], *j[1], *j[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// intersection between the triangle and a coplanar triangle j: the
+// portions of the edges of j that are inside the triangle are clipped,
+// and become constrained segments
+CINO_INLINE
+void cut_coplanar(TriangleCut        & tc,
+                  std::vector<vec3d> & planes,
+                  const vec3d        * t[3],
+                  const uint           tv[3],
+                  const vec3d        * j[3],
+                  const uint           jv[3])
+{
+    for(uint e=0; e<3; ++e)
+    {
+        const vec3d & A = *j[e];
+        const vec3d & B = *j[(e+1)%3];
+        ImplicitPoint PA(A), PB(B);
+
+        std::vector<ImplicitPoint> cand;
+        std::vector<uint>          ids;
+        if(in_triangle(tc, PA)) { cand.push_back(PA); ids.push_back(jv[e]);       }
+        if(in_triangle(tc, PB)) { cand.push_back(PB); ids.push_back(jv[(e+1)%3]); }
+
+        uint axis = 0;
+        while(A[axis]==B[axis]) ++axis;
+        for(uint i=0; i<3; ++i)
+        {
+            // corners of the triangle in the interior of the edge
+            const vec3d & C = *t[i];
+            if(orient2d(PA, PB, tc.pts.at(i), tc.drop)==0 &&
+               (C[axis]-A[axis])*(B[axis]-A[axis])>0 &&
+               (B[axis]-C[axis])*(B[axis]-A[axis])>0)
+            {
+                cand.push_back(tc.pts.at(i));
+                ids.push_back(tv[i]);
+            }
+            // edges of the triangle crossed by the edge
+            uint k = (i+1)%3;
+            int oc = sign(orient2d(PA, PB, tc.pts.at(i), tc.drop));
+            int ok = sign(orient2d(PA, PB, tc.pts.at(k), tc.drop));
+            if(oc*ok>=0) continue;
+            int oa = sign(orient2d(tc.pts.at(i), tc.pts.at(k), PA, tc.drop));
+            int ob = sign(orient2d(tc.pts.at(i), tc.pts.at(k), PB, tc.drop));
+            if(oa*ob>=0) continue;
+            cand.push_back(ImplicitPoint::line_plane(A, B, *t[i], *t[k], lift(*t[i], tc.drop)));
+            ids.push_back(UINT_MAX);
+        }
+        if(cand.empty()) continue;
+
+        // the clipped edge goes from the first to the last candidate
+        uint lo = 0, hi = 0;
+        for(uint i=1; i<cand.size(); ++i)
+        {
+            if(compare_coord(cand.at(i), cand.at(lo), axis)*sign(B[axis]-A[axis])<0) lo = i;
+            if(compare_coord(cand.at(i), cand.at(hi), axis)*sign(B[axis]-A[axis])>0) hi = i;
+        }
+        uint a = add_point(tc, cand.at(lo), ids.at(lo));
+        if(compare_coord(cand.at(lo), cand.at(hi), axis)==0) continue;
+        uint b = add_point(tc, cand.at(hi), ids.at(hi));
+        add_segment(tc, planes, a, b, A, B, lift(A, tc.drop));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// merges coincident points (preferring explicit ones, and keeping the corners
+// in first position), and updates the segments accordingly
+CINO_INLINE
+void merge_coincident_points(TriangleCut & tc)
+{
+    uint n = tc.pts.size();
+    std::vector<uint> order(n);
+    for(uint i=0; i<n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](const uint a, const uint b)
+    {
+        return lex_less(tc.pts.at(a), tc.pts.at(b));
+    });
+
+    std::vector<uint> rep(n);
+    for(uint i=0; i<n;)
+    {
+        uint j = i+1;
+        while(j<n && !lex_less(tc.pts.at(order[i]), tc.pts.at(order[j]))) ++j;
+        // representative: explicit points first, then lowest index
+        uint r = order[i];
+        for(uint k=i+1; k<j; ++k)
+        {
+            uint c = order[k];
+            bool c_exp = tc.pts.at(c).type()==EXPLICIT;
+            bool r_exp = tc.pts.at(r).type()==EXPLICIT;
+            if((c_exp && !r_exp) || (c_exp==r_exp && c<r)) r = c;
+        }
+        for(uint k=i; k<j; ++k) rep[order[k]] = r;
+        i = j;
+    }
+
+    std::vector<uint> new_id(n, UINT_MAX);
+    std::vector<ImplicitPoint> pts;
+    std::vector<uint>          ids;
+    for(uint i=0; i<n; ++i)
+    {
+        if(rep[i]!=i) continue;
+        new_id[i] = pts.size();
+        pts.push_back(tc.pts.at(i));
+        ids.push_back(tc.ids.at(i));
+    }
+    assert(new_id[0]==0 && new_id[1]==1 && new_id[2]==2);
+    for(uint & s : tc.segs) s = new_id[rep[s]];
+    tc.pts.swap(pts);
+    tc.ids.swap(ids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// computes all the points and segments inside triangle tid
+CINO_INLINE
+void cut_triangle(const std::vector<vec3d> & verts,
+                  const std::vector<uint>  & tris,
+                  const uint                 tid,
+                  const std::vector<uint>  & candidates,
+                        TriangleCut        & tc)
+{
+    uint tv[3] = { tris.at(3*tid), tris.at(3*tid+1), tris.at(3*tid+2) };
+
+    // project on the coordinate plane where the triangle is largest
+    vec3d n = (verts.at(tv[1])-verts.at(tv[0])).cross(verts.at(tv[2])-verts.at(tv[0]));
+    tc.drop = 0;
+    if(std::fabs(n[1])>std::fabs(n[tc.drop])) tc.drop = 1;
+    if(std::fabs(n[2])>std::fabs(n[tc.drop])) tc.drop = 2;
+    for(uint i=0; i<3; ++i) tc.pts.push_back(ImplicitPoint(verts.at(tv[i])));
+    double o = orient2d(tc.pts[0], tc.pts[1], tc.pts[2], tc.drop);
+    for(uint axis=0; o==0 && axis<3; ++axis)
+    {
+        // the floating point normal may be inaccurate for almost degenerate triangles
+        tc.drop = axis;
+        o = orient2d(tc.pts[0], tc.pts[1], tc.pts[2], tc.drop);
+    }
+    assert(o!=0);
+    if(o<0)
+    {
+        tc.flipped = true;
+        std::swap(tv[1], tv[2]);
+        std::swap(tc.pts[1], tc.pts[2]);
+    }
+    tc.ids.assign(tv, tv+3);
+
+    const vec3d * t[3] = { &verts.at(tv[0]), &verts.at(tv[1]), &verts.at(tv[2]) };
+    std::vector<vec3d> planes; // supporting plane of each segment (3 points each)
+
+    for(uint jid : candidates)
+    {
+        if(jid==tid) continue;
+        uint jv[3] = { tris.at(3*jid), tris.at(3*jid+1), tris.at(3*jid+2) };
+        const vec3d * j[3] = { &verts.at(jv[0]), &verts.at(jv[1]), &verts.at(jv[2]) };
+
+        // shared vertices (i.e. the neighbors of a triangle in a mesh) are
+        // trivially on the plane: skip the predicate, which would always
+        // resort to the slow exact evaluation for such degenerate inputs
+        auto is_t_vert = [&](const uint vid) { return vid==tv[0] || vid==tv[1] || vid==tv[2]; };
+        auto is_j_vert = [&](const uint vid) { return vid==jv[0] || vid==jv[1] || vid==jv[2]; };
+
+        int oj[3];
+        for(uint i=0; i<3; ++i) oj[i] = is_t_vert(jv[i]) ? 0 : orient3d_exact(*t[0], *t[1], *t[2], *j[i]);
+        if(oj[0]==oj[1] && oj[1]==oj[2])
+        {
+            if(oj[0]!=0) continue; // fully above or below
+            tc.coplanar.push_back(jid);
+            cut_coplanar(tc, planes, t, tv, j, jv);
+            continue;
+        }
+
+        uint shared = is_j_vert(tv[0]) + is_j_vert(tv[1]) + is_j_vert(tv[2]);
+        if(shared==2) continue; // non coplanar triangles sharing an edge meet only there
+
+        int ot[3];
+        for(uint i=0; i<3; ++i) ot[i] = is_j_vert(tv[i]) ? 0 : orient3d_exact(*j[0], *j[1], *j[2], *t[i]);
+        if(ot[0]==ot[1] && ot[1]==ot[2] && ot[0]!=0) continue;
+
+        cut_transversal(tc, planes, t, tv, ot, j, jv, oj);
+    }
+
+    if(tc.pts.size()==3)
+    {
+        tc.pos.assign(3, UINT_MAX);
+        return;
+    }
+    merge_coincident_points(tc);
+
+    // intersect segments with each other
+    uint np = tc.pts.size();
+    uint ns = tc.segs.size()/2;
+    for(uint s0=0;    s0<ns; ++s0)
+    for(uint s1=s0+1; s1<ns; ++s1)
+    {
+        uint a = tc.segs[2*s0], b = tc.segs[2*s0+1];
+        uint c = tc.segs[2*s1], d = tc.segs[2*s1+1];
+        if(a==c || a==d || b==c || b==d) continue;
+        if(sign(orient2d(tc.pts[a], tc.pts[b], tc.pts[c], tc.drop))*
+           sign(orient2d(tc.pts[a], tc.pts[b], tc.pts[d], tc.drop))>=0) continue;
+        if(sign(orient2d(tc.pts[c], tc.pts[d], tc.pts[a], tc.drop))*
+           sign(orient2d(tc.pts[c], tc.pts[d], tc.pts[b], tc.drop))>=0) continue;
+        add_point(tc, ImplicitPoint::three_planes(*t[0], *t[1], *t[2],
+                                                  planes[3*s0], planes[3*s0+1], planes[3*s0+2],
+                                                  planes[3*s1], planes[3*s1+1], planes[3*s1+2]), UINT_MAX);
+    }
+    if(tc.pts.size()>np) merge_coincident_points(tc);
+
+    // locate points
+    np = tc.pts.size();
+    tc.pos.assign(np, 3);
+    for(uint i=0; i<3; ++i) tc.pos[i] = UINT_MAX;
+    for(uint p=3; p<np; ++p)
+    for(uint e=0; e<3; ++e)
+    {
+        if(orient2d(tc.pts[e], tc.pts[(e+1)%3], tc.pts[p], tc.drop)==0) tc.pos[p] = e;
+    }
+
+    // split segments at the points they contain, and drop segments on the boundary
+    std::vector<uint> segs;
+    for(uint s=0; s<ns; ++s)
+    {
+        uint a = tc.segs[2*s], b = tc.segs[2*s+1];
+        if(a==b) continue;
+        uint axis = 0;
+        int  dir  = 0;
+        for(; axis<3; ++axis) if((dir = compare_coord(tc.pts[b], tc.pts[a], axis))!=0) break;
+        std::vector<uint> chain;
+        for(uint p=0; p<np; ++p)
+        {
+            if(p==a || p==b) continue;
+            if(orient2d(tc.pts[a], tc.pts[b], tc.pts[p], tc.drop)!=0) continue;
+            if(compare_coord(tc.pts[p], tc.pts[a], axis)!=dir) continue;
+            if(compare_coord(tc.pts[b], tc.pts[p], axis)!=dir) continue;
+            chain.push_back(p);
+        }
+        std::sort(chain.begin(), chain.end(), [&](const uint p, const uint q)
+        {
+            return compare_coord(tc.pts[q], tc.pts[p], axis)==dir;
+        });
+        chain.insert(chain.begin(), a);
+        chain.push_back(b);
+        for(uint i=0; i+1<chain.size(); ++i)
+        {
+            uint p = chain[i], q = chain[i+1];
+            auto on_edge = [&](const uint v, const uint e) { return v<3 ? (v==e || v==(e+1)%3) : tc.pos[v]==e; };
+            bool boundary = false;
+            for(uint e=0; e<3; ++e) if(on_edge(p,e) && on_edge(q,e)) boundary = true;
+            if(boundary) continue;
+            segs.push_back(std::min(p,q));
+            segs.push_back(std::max(p,q));
+        }
+    }
+    // remove duplicated segments
+    std::vector<ipair> tmp;
+    for(uint i=0; i<segs.size(); i+=2) tmp.push_back(std::make_pair(segs[i], segs[i+1]));
+    std::sort(tmp.begin(), tmp.end());
+    tmp.erase(std::unique(tmp.begin(), tmp.end()), tmp.end());
+    tc.segs.clear();
+    for(const ipair & s : tmp)
+    {
+        tc.segs.push_back(s.first);
+        tc.segs.push_back(s.second);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// index of the triangle having the oriented edge a->b, or -1
+CINO_INLINE
+int tri_with_edge(const std::vector<uint> & tris, const uint a, const uint b)
+{
+    for(uint i=0; i<tris.size(); i+=3)
+    for(uint j=0; j<3; ++j)
+    {
+        if(tris[i+j]==a && tris[i+(j+1)%3]==b) return i/3;
+    }
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// inserts point p in a triangulation of counterclockwise triangles
+CINO_INLINE
+void insert_point(const std::vector<ImplicitPoint> & pts,
+                  const uint                         drop,
+                  const uint                         p,
+                        std::vector<uint>          & tris)
+{
+    for(uint i=0; i<tris.size(); i+=3)
+    {
+        int o[3];
+        for(uint j=0; j<3; ++j) o[j] = sign(orient2d(pts[tris[i+j]], pts[tris[i+(j+1)%3]], pts[p], drop));
+        if(o[0]<0 || o[1]<0 || o[2]<0) continue;
+
+        uint zeros = (o[0]==0) + (o[1]==0) + (o[2]==0);
+        assert(zeros<2); // would be a vertex
+        if(zeros==0)
+        {
+            uint a = tris[i], b = tris[i+1], c = tris[i+2];
+            tris[i+2] = p;
+            tris.insert(tris.end(), { b, c, p, c, a, p });
+            return;
+        }
+        // on edge a-b: split this triangle and the adjacent one (if any)
+        uint j = (o[0]==0) ? 0 : (o[1]==0) ? 1 : 2;
+        uint a = tris[i+j], b = tris[i+(j+1)%3], c = tris[i+(j+2)%3];
+        int  k = tri_with_edge(tris, b, a);
+        tris[i] = a; tris[i+1] = p; tris[i+2] = c;
+        tris.insert(tris.end(), { p, b, c });
+        if(k>=0)
+        {
+            uint d = tris[3*k] + tris[3*k+1] + tris[3*k+2] - a - b;
+            tris[3*k] = b; tris[3*k+1] = p; tris[3*k+2] = d;
+            tris.insert(tris.end(), { p, a, d });
+        }
+        return;
+    }
+    assert(false && "point outside of the triangulation");
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// inserts segment a-b in a triangulation of counterclockwise triangles,
+// assuming that no vertex lies in the interior of the segment
+CINO_INLINE
+void insert_segment(const std::vector<ImplicitPoint> & pts,
+                    const uint                         drop,
+                    const uint                         a,
+                    const uint                         b,
+                          std::vector<uint>          & tris)
+{
+    if(tri_with_edge(tris,a,b)>=0 || tri_with_edge(tris,b,a)>=0) return;
+
+    // find the triangle incident to a which is crossed by the segment
+    int  t = -1;
+    uint u = 0, w = 0;
+    for(uint i=0; i<tris.size() && t<0; i+=3)
+    for(uint j=0; j<3; ++j)
+    {
+        if(tris[i+j]!=a) continue;
+        u = tris[i+(j+1)%3];
+        w = tris[i+(j+2)%3];
+        if(orient2d(pts[a], pts[u], pts[b], drop)>0 &&
+           orient2d(pts[a], pts[b], pts[w], drop)>0) t = i/3;
+        break;
+    }
+    assert(t>=0);
+
+    // walk along the segment, collecting the vertices at its right and left
+    std::vector<uint> removed = { (uint)t };
+    std::vector<uint> right   = { a, u };
+    std::vector<uint> left    = { a, w };
+    while(true)
+    {
+        int k = tri_with_edge(tris, w, u);
+        assert(k>=0);
+        removed.push_back(k);
+        uint x = tris[3*k] + tris[3*k+1] + tris[3*k+2] - u - w;
+        if(x==b) break;
+        if(orient2d(pts[a], pts[b], pts[x], drop)>0) { left.push_back(x);  w = x; }
+        else                                         { right.push_back(x); u = x; }
+    }
+    right.push_back(b);
+    left.push_back(b);
+    std::reverse(left.begin(), left.end());
+
+    // remove the triangles crossed by the segment
+    std::sort(removed.begin(), removed.end());
+    for(auto it=removed.rbegin(); it!=removed.rend(); ++it)
+    {
+        uint last = tris.size()/3-1;
+        for(uint j=0; j<3; ++j) tris[3*(*it)+j] = tris[3*last+j];
+        tris.resize(3*last);
+    }
+
+    // re-triangulate the two polygons at the sides of the segment
+    for(const std::vector<uint> * poly : { &right, &left })
+    {
+        std::vector<ImplicitPoint> p;
+        for(uint v : *poly) p.push_back(pts[v]);
+        std::vector<uint> ears;
+        segment_insertion_linear_earcut(p, ears, drop);
+        for(uint v : ears) tris.push_back(poly->at(v));
+    }
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void mesh_arrangement(const std::vector<vec3d>             & verts_in,
+                      const std::vector<uint>              & tris_in,
+                            std::vector<ImplicitPoint>     & verts_out,
+                            std::vector<uint>              & tris_out,
+                            std::vector<std::vector<uint>> & tris_src)
+{
+    // merge coincident vertices
+    std::vector<vec3d> verts;
+    std::vector<uint>  vmap(verts_in.size());
+    std::map<vec3d,uint> unique_verts;
+    for(uint vid=0; vid<verts_in.size(); ++vid)
+    {
+        auto it = unique_verts.insert(std::make_pair(verts_in.at(vid), (uint)verts.size()));
+        if(it.second) verts.push_back(verts_in.at(vid));
+        vmap.at(vid) = it.first->second;
+    }
+    std::vector<uint> tris(tris_in.size());
+    for(uint i=0; i<tris_in.size(); ++i) tris.at(i) = vmap.at(tris_in.at(i));
+
+    // find degenerate triangles (i.e. with colinear vertices)
+    uint nt = tris.size()/3;
+    std::vector<bool> degenerate(nt);
+    PARALLEL_FOR(0, nt, 1000, [&](uint tid)
+    {
+        ImplicitPoint v0(verts.at(tris.at(3*tid)));
+        ImplicitPoint v1(verts.at(tris.at(3*tid+1)));
+        ImplicitPoint v2(verts.at(tris.at(3*tid+2)));
+        degenerate[tid] = orient2d(v0,v1,v2,0)==0 &&
+                          orient2d(v0,v1,v2,1)==0 &&
+                          orient2d(v0,v1,v2,2)==0;
+    });
+
+    Octree o(8,50);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        if(degenerate[tid]) continue;
+        o.push_triangle(tid, verts.at(tris.at(3*tid)), verts.at(tris.at(3*tid+1)), verts.at(tris.at(3*tid+2)));
+    }
+    o.build();
+
+    // intersect each triangle with all the others
+    std::vector<TriangleCut> cuts(nt);
+    PARALLEL_FOR(0, nt, 100, [&](uint tid)
+    {
+        if(degenerate[tid]) return;
+        std::vector<vec3d> v = { verts.at(tris.at(3*tid)), verts.at(tris.at(3*tid+1)), verts.at(tris.at(3*tid+2)) };
+        std::unordered_set<uint> ids;
+        o.intersects_box(AABB(v), ids);
+        std::vector<uint> candidates(ids.begin(), ids.end());
+        std::sort(candidates.begin(), candidates.end());
+        cut_triangle(verts, tris, tid, candidates, cuts[tid]);
+    });
+
+    // give a global id to the new points, merging the ones found by different triangles
+    std::vector<ipair> implicit_pts; // (tid, point index)
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        for(uint i=0; i<cuts[tid].ids.size(); ++i)
+        {
+            if(cuts[tid].ids[i]==UINT_MAX) implicit_pts.push_back(std::make_pair(tid,i));
+        }
+    }
+    auto pt = [&](const ipair & p) -> const ImplicitPoint & { return cuts[p.first].pts[p.second]; };
+    std::sort(implicit_pts.begin(), implicit_pts.end(), [&](const ipair & a, const ipair & b)
+    {
+        return lex_less(pt(a), pt(b));
+    });
+    verts_out.clear();
+    verts_out.reserve(verts.size()+implicit_pts.size());
+    for(const vec3d & v : verts) verts_out.push_back(ImplicitPoint(v));
+    for(uint i=0; i<implicit_pts.size(); ++i)
+    {
+        if(i==0 || lex_less(pt(implicit_pts[i-1]), pt(implicit_pts[i])))
+        {
+            verts_out.push_back(pt(implicit_pts[i]));
+        }
+        cuts[implicit_pts[i].first].ids[implicit_pts[i].second] = verts_out.size()-1;
+    }
+
+    // points on the edges of the input triangles
+    std::map<ipair,std::vector<uint>> edge_pts;
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        const TriangleCut & tc = cuts[tid];
+        for(uint i=3; i<tc.pos.size(); ++i)
+        {
+            if(tc.pos[i]>2) continue;
+            ipair e = unique_pair(tc.ids[tc.pos[i]], tc.ids[(tc.pos[i]+1)%3]);
+            edge_pts[e].push_back(tc.ids[i]);
+        }
+    }
+    for(auto & e : edge_pts)
+    {
+        std::sort(e.second.begin(), e.second.end());
+        e.second.erase(std::unique(e.second.begin(), e.second.end()), e.second.end());
+    }
+
+    // re-triangulate each triangle
+    std::vector<std::vector<uint>>              sub_tris(nt);
+    std::vector<std::vector<std::vector<uint>>> sub_src(nt);
+    PARALLEL_FOR(0, nt, 100, [&](uint tid)
+    {
+        if(degenerate[tid]) return;
+        const TriangleCut & tc = cuts[tid];
+
+        // global ids of the vertices, and local triangulation
+        std::vector<uint> gid(tc.ids.begin(), tc.ids.begin()+3);
+        for(uint e=0; e<3; ++e)
+        {
+            auto it = edge_pts.find(unique_pair(gid[e], gid[(e+1)%3]));
+            if(it!=edge_pts.end()) gid.insert(gid.end(), it->second.begin(), it->second.end());
+        }
+        for(uint i=3; i<tc.pos.size(); ++i) if(tc.pos[i]==3) gid.push_back(tc.ids[i]);
+
+        std::vector<ImplicitPoint> pts;
+        for(uint v : gid) pts.push_back(verts_out.at(v));
+        std::vector<uint> local = { 0, 1, 2 };
+        for(uint p=3; p<pts.size(); ++p) insert_point(pts, tc.drop, p, local);
+
+        if(!tc.segs.empty())
+        {
+            std::map<uint,uint> g2l;
+            for(uint i=0; i<gid.size(); ++i) g2l[gid[i]] = i;
+            for(uint i=0; i<tc.segs.size(); i+=2)
+            {
+                insert_segment(pts, tc.drop, g2l.at(tc.ids[tc.segs[i]]), g2l.at(tc.ids[tc.segs[i+1]]), local);
+            }
+        }
+
+        // coplanar triangles containing each sub triangle. If there are any, the sub
+        // triangle is output only by the input triangle with lowest index among them
+        std::vector<ImplicitPoint> cop;
+        std::vector<int>           cop_sign;
+        for(uint jid : tc.coplanar)
+        {
+            for(uint i=0; i<3; ++i) cop.push_back(ImplicitPoint(verts.at(tris.at(3*jid+i))));
+            cop_sign.push_back(sign(orient2d(cop[cop.size()-3], cop[cop.size()-2], cop.back(), tc.drop)));
+        }
+        for(uint i=0; i<local.size(); i+=3)
+        {
+            std::vector<uint> src = { tid };
+            for(uint j=0; j<tc.coplanar.size(); ++j)
+            {
+                bool inside = true;
+                for(uint k=0; k<3 && inside; ++k)
+                for(uint e=0; e<3 && inside; ++e)
+                {
+                    if(cop_sign[j]*orient2d(cop[3*j+e], cop[3*j+(e+1)%3], pts[local[i+k]], tc.drop)<0) inside = false;
+                }
+                if(inside) src.push_back(tc.coplanar[j]);
+            }
+            std::sort(src.begin(), src.end());
+            if(src.front()!=tid) continue;
+
+            sub_tris[tid].push_back(gid[local[i]]);
+            sub_tris[tid].push_back(gid[local[i + (tc.flipped ? 2 : 1)]]);
+            sub_tris[tid].push_back(gid[local[i + (tc.flipped ? 1 : 2)]]);
+            sub_src[tid].push_back(src);
+        }
+    });
+
+    tris_out.clear();
+    tris_src.clear();
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        tris_out.insert(tris_out.end(), sub_tris[tid].begin(), sub_tris[tid].end());
+        tris_src.insert(tris_src.end(), sub_src[tid].begin(), sub_src[tid].end());
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void mesh_arrangement(const std::vector<vec3d>             & verts_in,
+                      const std::vector<uint>              & tris_in,
+                            std::vector<vec3d>             & verts_out,
+                            std::vector<uint>              & tris_out,
+                            std::vector<std::vector<uint>> & tris_src)
+{
+    std::vector<ImplicitPoint> verts;
+    mesh_arrangement(verts_in, tris_in, verts, tris_out, tris_src);
+    verts_out.resize(verts.size());
+    PARALLEL_FOR(0, verts.size(), 1000, [&](uint vid)
+    {
+        verts_out[vid] = verts[vid].approx();
+    });
+}
+
+}
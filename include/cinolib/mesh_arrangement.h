@@ -0,0 +1,109 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MESH_ARRANGEMENT_H
+#define CINO_MESH_ARRANGEMENT_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/implicit_point.h>
+#include <vector>
+
+namespace cinolib
+{
+
+/* Computes the arrangement of a triangle soup, that is: splits the input triangles along
+ * all their mutual intersections, producing a triangle mesh where any two triangles meet
+ * only at a shared vertex or at a shared edge. The method works as follows:
+ *
+ *   i)   coincident input vertices are merged, and zero area triangles are discarded
+ *
+ *   ii)  for each triangle, an octree provides all the triangles having overlapping bounding
+ *        box, and the intersection with each of them is computed. Depending on their mutual
+ *        position, the intersection is empty, a point, a segment or (if the triangles are
+ *        coplanar) a polygon, whose edges are portions of the edges of the input triangles.
+ *        Intersection segments found inside the same triangle are then intersected with
+ *        each other, and split at all the points that lie on them
+ *
+ *   iii) points that lie on the edges of the input triangles are shared among all the
+ *        triangles incident to the same edge, so that the output mesh is conforming
+ *
+ *   iv)  each triangle is re-triangulated inserting all its intersection points, and then
+ *        all its intersection segments as constraints (see segment_insertion_linear_earcut.h)
+ *
+ * Steps (ii) and (iv) run in parallel, one triangle at a time. All the intersection points
+ * are implicit points (see implicit_point.h), hence they are never rounded, and all the
+ * geometric predicates used along the pipeline are exact, regardless of the symbol
+ * CINOLIB_USES_SHEWCHUK_PREDICATES. The only source of approximation is the conversion of
+ * the output vertices to floating point (approx()), which may introduce flipped or
+ * intersecting triangles in the vicinity of the intersection lines.
+ *
+ * Where coplanar triangles overlap, the overlapping region is output only once. For each
+ * output triangle, tris_src lists all the input triangles that contain it: the first is
+ * the one it was cut from (and whose orientation it inherits), the others are the input
+ * triangles that overlap with it, if any. The first vertices in verts_out are the input
+ * vertices, in the same order (coincident input vertices are merged, keeping the first
+ * occurrence), followed by the intersection points.
+ *
+ * For more details refer to:
+ *
+ *     Fast and Robust Mesh Arrangements using Floating-point Arithmetic
+ *     Gianmarco Cherchi, Marco Livesu, Riccardo Scateni, Marco Attene
+ *     ACM Transactions on Graphics, 2020
+*/
+
+CINO_INLINE
+void mesh_arrangement(const std::vector<vec3d>             & verts_in,
+                      const std::vector<uint>              & tris_in,
+                            std::vector<ImplicitPoint>     & verts_out,
+                            std::vector<uint>              & tris_out,
+                            std::vector<std::vector<uint>> & tris_src);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, with output vertices rounded to floating point
+CINO_INLINE
+void mesh_arrangement(const std::vector<vec3d>             & verts_in,
+                      const std::vector<uint>              & tris_in,
+                            std::vector<vec3d>             & verts_out,
+                            std::vector<uint>              & tris_out,
+                            std::vector<std::vector<uint>> & tris_src);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "mesh_arrangement.cpp"
+#endif
+
+#endif // CINO_MESH_ARRANGEMENT_H
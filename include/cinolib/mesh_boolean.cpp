@@ -0,0 +1,268 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/mesh_boolean.h>
+#include <cinolib/mesh_arrangement.h>
+#include <cinolib/implicit_point.h>
+#include <cinolib/solid_angle.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/geometry/aabb.h>
+#include <cinolib/ipair.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+
+namespace cinolib
+{
+
+namespace
+{
+
+// +1 if the input triangles t and k (which are coplanar) have the same
+// orientation, -1 otherwise. Orientations are compared exactly, in the
+// projection on a coordinate plane where t is not degenerate
+CINO_INLINE
+int coplanar_orientation(const std::vector<vec3d> & verts,
+                         const std::vector<uint>  & tris,
+                         const uint                 t,
+                         const uint                 k)
+{
+    ImplicitPoint t0(verts.at(tris.at(3*t))), t1(verts.at(tris.at(3*t+1))), t2(verts.at(tris.at(3*t+2)));
+    ImplicitPoint k0(verts.at(tris.at(3*k))), k1(verts.at(tris.at(3*k+1))), k2(verts.at(tris.at(3*k+2)));
+
+    vec3d n = (t1.approx()-t0.approx()).cross(t2.approx()-t0.approx());
+    uint drop = 2;
+    if(std::fabs(n[0])>=std::fabs(n[1]) && std::fabs(n[0])>=std::fabs(n[2])) drop = 0; else
+    if(std::fabs(n[1])>=std::fabs(n[2]))                                      drop = 1;
+
+    for(uint i=0; i<3; ++i, drop=(drop+1)%3)
+    {
+        double ot = orient2d(t0, t1, t2, drop);
+        if(ot==0) continue;
+        return (ot*orient2d(k0, k1, k2, drop)>0) ? 1 : -1;
+    }
+    assert(false && "degenerate triangle");
+    return 1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if a point having winding number w[i] w.r.t. the i-th part belongs
+// to the result of the operation (non zero winding numbers are inside)
+CINO_INLINE
+bool in_result(const std::vector<double> & w, const BooleanOperation op)
+{
+    switch(op)
+    {
+        case BOOLEAN_UNION:
+        {
+            for(double wi : w) if(std::lround(wi)!=0) return true;
+            return false;
+        }
+        case BOOLEAN_INTERSECTION:
+        {
+            for(double wi : w) if(std::lround(wi)==0) return false;
+            return !w.empty();
+        }
+        case BOOLEAN_DIFFERENCE:
+        {
+            if(w.empty() || std::lround(w.front())==0) return false;
+            for(uint i=1; i<w.size(); ++i) if(std::lround(w.at(i))!=0) return false;
+            return true;
+        }
+    }
+    assert(false);
+    return false;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void mesh_boolean(const std::vector<vec3d>  & verts_in,
+                  const std::vector<uint>   & tris_in,
+                  const std::vector<uint>   & labels,
+                  const BooleanOperation      op,
+                        std::vector<vec3d>  & verts_out,
+                        std::vector<uint>   & tris_out)
+{
+    assert(labels.size()*3==tris_in.size());
+
+    verts_out.clear();
+    tris_out.clear();
+    if(labels.empty()) return;
+
+    std::vector<vec3d>             verts;
+    std::vector<uint>              tris;
+    std::vector<std::vector<uint>> src;
+    mesh_arrangement(verts_in, tris_in, verts, tris, src);
+
+    // input triangles and bounding box of each part
+    uint n_parts = *std::max_element(labels.begin(), labels.end()) + 1;
+    std::vector<std::vector<uint>> part_tris(n_parts);
+    std::vector<AABB>              part_bbox(n_parts);
+    for(uint tid=0; tid<labels.size(); ++tid)
+    {
+        part_tris.at(labels.at(tid)).push_back(tid);
+        for(uint i=0; i<3; ++i) part_bbox.at(labels.at(tid)).push(verts_in.at(tris_in.at(3*tid+i)));
+    }
+
+    // split the output triangles into patches that are not crossed by any intersection
+    // line, that is: flood across manifold edges, between triangles of the same part.
+    // Triangles where coplanar parts overlap form a patch on their own
+    uint nt = tris.size()/3;
+    std::map<ipair,std::vector<uint>> edge_tris;
+    for(uint tid=0; tid<nt; ++tid)
+    for(uint i=0; i<3; ++i)
+    {
+        edge_tris[unique_pair(tris.at(3*tid+i), tris.at(3*tid+(i+1)%3))].push_back(tid);
+    }
+    auto area = [&](const uint tid)
+    {
+        const vec3d & v0 = verts.at(tris.at(3*tid));
+        return (verts.at(tris.at(3*tid+1))-v0).cross(verts.at(tris.at(3*tid+2))-v0).norm();
+    };
+    std::vector<uint> patch(nt, UINT_MAX);
+    std::vector<uint> seed; // largest triangle of each patch
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        if(patch.at(tid)!=UINT_MAX) continue;
+        uint pid = seed.size();
+        seed.push_back(tid);
+        patch.at(tid) = pid;
+        if(src.at(tid).size()>1) continue;
+
+        std::vector<uint> q(1,tid);
+        while(!q.empty())
+        {
+            uint curr = q.back();
+            q.pop_back();
+            for(uint i=0; i<3; ++i)
+            {
+                const std::vector<uint> & nbrs = edge_tris.at(unique_pair(tris.at(3*curr+i), tris.at(3*curr+(i+1)%3)));
+                if(nbrs.size()!=2) continue;
+                uint nbr = (nbrs.front()==curr) ? nbrs.back() : nbrs.front();
+                if(patch.at(nbr)!=UINT_MAX || src.at(nbr).size()>1) continue;
+                if(labels.at(src.at(nbr).front())!=labels.at(src.at(curr).front())) continue;
+                patch.at(nbr) = pid;
+                q.push_back(nbr);
+                if(area(nbr)>area(seed.at(pid))) seed.at(pid) = nbr;
+            }
+        }
+    }
+
+    // compare the winding numbers right below and right above each patch. At
+    // the centroid of the seed triangle, each input triangle containing it adds
+    // +/-1/2 (depending on the side), all the others add their solid angle
+    std::vector<int> action(seed.size()); // 0: discard, 1: keep, -1: flip
+    PARALLEL_FOR(0, seed.size(), 8, [&](uint pid)
+    {
+        uint tid = seed.at(pid);
+        const std::vector<uint> & s = src.at(tid);
+        vec3d p = (verts.at(tris.at(3*tid)) + verts.at(tris.at(3*tid+1)) + verts.at(tris.at(3*tid+2)))/3.0;
+
+        std::vector<double> w(n_parts, 0.0);
+        for(uint m=0; m<n_parts; ++m)
+        {
+            if(!part_bbox.at(m).contains(p)) continue;
+            for(uint t : part_tris.at(m))
+            {
+                if(std::binary_search(s.begin(), s.end(), t)) continue;
+                w.at(m) += solid_angle(verts_in.at(tris_in.at(3*t)),
+                                       verts_in.at(tris_in.at(3*t+1)),
+                                       verts_in.at(tris_in.at(3*t+2)), p);
+            }
+        }
+        std::vector<double> below = w;
+        std::vector<double> above = w;
+        for(uint k : s)
+        {
+            int o = (k==s.front()) ? 1 : coplanar_orientation(verts_in, tris_in, s.front(), k);
+            below.at(labels.at(k)) += 0.5*o;
+            above.at(labels.at(k)) -= 0.5*o;
+        }
+        bool in_below = in_result(below, op);
+        bool in_above = in_result(above, op);
+        if( in_below && !in_above) action.at(pid) =  1; else
+        if(!in_below &&  in_above) action.at(pid) = -1; else
+                                   action.at(pid) =  0;
+    });
+
+    // output the triangles that bound the result (and only the vertices they use)
+    std::vector<uint> vmap(verts.size(), UINT_MAX);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        int a = action.at(patch.at(tid));
+        if(a==0) continue;
+        uint t[3] = { tris.at(3*tid), tris.at(3*tid+1), tris.at(3*tid+2) };
+        if(a<0) std::swap(t[1], t[2]);
+        for(uint vid : t)
+        {
+            if(vmap.at(vid)==UINT_MAX)
+            {
+                vmap.at(vid) = verts_out.size();
+                verts_out.push_back(verts.at(vid));
+            }
+            tris_out.push_back(vmap.at(vid));
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void mesh_boolean(const std::vector<vec3d>  & verts_A,
+                  const std::vector<uint>   & tris_A,
+                  const std::vector<vec3d>  & verts_B,
+                  const std::vector<uint>   & tris_B,
+                  const BooleanOperation      op,
+                        std::vector<vec3d>  & verts_out,
+                        std::vector<uint>   & tris_out)
+{
+    std::vector<vec3d> verts = verts_A;
+    verts.insert(verts.end(), verts_B.begin(), verts_B.end());
+
+    std::vector<uint> tris = tris_A;
+    for(uint vid : tris_B) tris.push_back(vid + verts_A.size());
+
+    std::vector<uint> labels(tris_A.size()/3, 0);
+    labels.resize(tris.size()/3, 1);
+
+    mesh_boolean(verts, tris, labels, op, verts_out, tris_out);
+}
+
+}
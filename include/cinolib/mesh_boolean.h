@@ -0,0 +1,98 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MESH_BOOLEAN_H
+#define CINO_MESH_BOOLEAN_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <vector>
+
+namespace cinolib
+{
+
+typedef enum
+{
+    BOOLEAN_UNION,        // points inside at least one part
+    BOOLEAN_INTERSECTION, // points inside all the parts
+    BOOLEAN_DIFFERENCE,   // points inside the first part, and outside all the others
+}
+BooleanOperation;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Boolean operations between solids. The input is a triangle soup made of one or more
+ * parts, where labels[i] is the part (0,1,2,...) of the i-th triangle. Each part is
+ * expected to be a closed surface, with triangles oriented outwards. Parts may intersect
+ * each other (and themselves) arbitrarily, also with coplanar overlaps, and may share
+ * vertices and edges.
+ *
+ * The soup is first resolved with a mesh arrangement (see mesh_arrangement.h), and then
+ * each output triangle is classified by looking at the generalized winding number of each
+ * part on the two sides of it: the triangle is kept if it separates the result of the
+ * operation from its complement, and is flipped if needed, so that the output triangles
+ * are oriented outwards. Winding numbers are computed once for each patch of triangles
+ * not crossed by any intersection line, summing the solid angles of the input triangles.
+ *
+ * Output vertices are rounded to floating point (see mesh_arrangement.h), and only the
+ * vertices referenced by the output triangles are returned.
+*/
+
+CINO_INLINE
+void mesh_boolean(const std::vector<vec3d>  & verts_in,
+                  const std::vector<uint>   & tris_in,
+                  const std::vector<uint>   & labels,
+                  const BooleanOperation      op,
+                        std::vector<vec3d>  & verts_out,
+                        std::vector<uint>   & tris_out);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, for two solids A and B (e.g. A minus B for BOOLEAN_DIFFERENCE)
+CINO_INLINE
+void mesh_boolean(const std::vector<vec3d>  & verts_A,
+                  const std::vector<uint>   & tris_A,
+                  const std::vector<vec3d>  & verts_B,
+                  const std::vector<uint>   & tris_B,
+                  const BooleanOperation      op,
+                        std::vector<vec3d>  & verts_out,
+                        std::vector<uint>   & tris_out);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "mesh_boolean.cpp"
+#endif
+
+#endif // CINO_MESH_BOOLEAN_H
@@ -37,6 +37,7 @@
 #include <cinolib/meshes/mesh_attributes.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/geometry/point_utils.h>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
@@ -114,7 +115,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::translate(const vec3d & delta)
 {
-    for(uint vid=0; vid<num_verts(); ++vid) vert(vid) += delta;
+    points_translate(this->verts, delta);
     bb.min += delta;
     bb.max += delta;
 }
@@ -128,12 +129,9 @@ void AbstractMesh<M,V,E,P>::rotate(const vec3d & axis, const double angle)
     vec3d  c = centroid();
     mat3d R = mat3d::ROT_3D(axis, angle);
 
-    for(uint vid=0; vid<num_verts(); ++vid)
-    {
-        vert(vid) -= c;
-        vert(vid)  = R*vert(vid);
-        vert(vid) += c;
-    }
+    points_translate(this->verts, -c);
+    points_transform(this->verts, R);
+    points_translate(this->verts,  c);
     //
     if(m_data.update_bbox)    update_bbox();
     if(m_data.update_normals) update_normals();
@@ -147,7 +145,7 @@ void AbstractMesh<M,V,E,P>::scale(const double scale_factor)
 {
     vec3d c = centroid();
     translate(-c);
-    for(uint vid=0; vid<num_verts(); ++vid) vert(vid) *= scale_factor;
+    points_scale(this->verts, scale_factor);
     translate(c);
     if(m_data.update_bbox) update_bbox();
 }
@@ -159,7 +157,7 @@ CINO_INLINE
 void AbstractMesh<M,V,E,P>::normalize_bbox()
 {
     double s = 1.0/bbox().diag();
-    for(uint vid=0; vid<num_verts(); ++vid) vert(vid) *= s;
+    points_scale(this->verts, s);
     if(m_data.update_bbox) update_bbox();
 }
 
@@ -169,8 +167,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::update_bbox()
 {
-    bb.reset();
-    bb.push(this->verts);
+    points_bbox(this->verts, bb.min, bb.max);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1093,7 +1090,7 @@ CINO_INLINE
 void AbstractMesh<M,V,E,P>::center_bbox()
 {
     vec3d center = bb.center();
-    for(uint vid=0; vid<num_verts(); ++vid) vert(vid) -= center;
+    points_translate(this->verts, -center);
     bb.min -= center;
     bb.max -= center;
 }
@@ -45,6 +45,7 @@
 #include <cinolib/color.h>
 #include <cinolib/symbols.h>
 #include <cinolib/ipair.h>
+#include <cinolib/meshes/mesh_attributes.h>
 
 typedef enum
 {
@@ -71,7 +72,7 @@ class AbstractMesh
 
         AABB bb;
 
-        std::vector<vec3d>             verts;
+        std::vector<typename mesh_point_type<M>::type> verts;
         std::vector<uint>              edges;
         std::vector<std::vector<uint>> polys; // either polygons or polyhedra
 
@@ -94,6 +95,8 @@ class AbstractMesh
         typedef E E_type;
         typedef P P_type;
 
+        typedef typename mesh_point_type<M>::type point_type; // vec3d, unless M says otherwise (see mesh_attributes.h)
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         explicit AbstractMesh() {}
@@ -144,8 +147,8 @@ class AbstractMesh
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         const AABB                           & bbox()          const { return bb;    }
-        const std::vector<vec3d>             & vector_verts()  const { return verts; }
-              std::vector<vec3d>             & vector_verts()        { return verts; }
+        const std::vector<point_type>        & vector_verts()  const { return verts; }
+              std::vector<point_type>        & vector_verts()        { return verts; }
         const std::vector<uint>              & vector_edges()  const { return edges; }
               std::vector<uint>              & vector_edges()        { return edges; }
         const std::vector<std::vector<uint>> & vector_polys()  const { return polys; }
@@ -211,8 +214,8 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-          const vec3d          & vert                       (const uint vid) const { return verts.at(vid); }
-                vec3d          & vert                       (const uint vid)       { return verts.at(vid); }
+          const point_type     & vert                       (const uint vid) const { return verts.at(vid); }
+                point_type     & vert                       (const uint vid)       { return verts.at(vid); }
                 void             vert_weights_uniform       (const uint vid, std::vector<std::pair<uint,double>> & wgts) const;
                 std::set<uint>   vert_n_ring                (const uint vid, const uint n) const;
                 bool             verts_are_adjacent         (const uint vid0, const uint vid1) const;
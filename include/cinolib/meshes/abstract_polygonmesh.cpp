@@ -39,6 +39,7 @@
 #include <cinolib/quality.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/geometry/polygon_utils.h>
+#include <cinolib/geometry/point_utils.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/how_many_seconds.h>
 #include <cinolib/deg_rad.h>
@@ -58,42 +59,54 @@ void AbstractPolygonMesh<M,V,E,P>::load(const char * filename)
     this->clear();
     this->mesh_data().filename = std::string(filename);
 
-    std::vector<vec3d>             pos;      // vertex xyz positions
-    std::vector<vec3d>             tex;      // vertex uv(w) texture coordinates
-    std::vector<vec3d>             nor;      // vertex normals
-    std::vector<std::vector<uint>> poly_pos; // polygons with references to pos
-    std::vector<std::vector<uint>> poly_tex; // polygons with references to tex
-    std::vector<std::vector<uint>> poly_nor; // polygons with references to nor
-    std::vector<Color>             poly_col; // per polygon colors
-    std::vector<int>               poly_lab; // per polygon labels
-
     std::string str(filename);
     std::string filetype = str.substr(str.size()-4,4);
 
     if (filetype.compare(".off") == 0 ||
-        filetype.compare(".OFF") == 0)
-    {
-        read_OFF(filename, pos, poly_pos, poly_col);
-    }
-    else if (filetype.compare(".obj") == 0 ||
-             filetype.compare(".OBJ") == 0)
-    {
-        //read_OBJ(filename, pos, poly_pos);
-        read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab);
-    }
-    else if (filetype.compare(".stl") == 0 ||
-             filetype.compare(".STL") == 0)
-    {
-        std::vector<uint> tris;
-        read_STL(filename, pos, tris);
-        poly_pos = polys_from_serialized_vids(tris, 3);
+        filetype.compare(".OFF") == 0 ||
+        filetype.compare(".obj") == 0 ||
+        filetype.compare(".OBJ") == 0 ||
+        filetype.compare(".stl") == 0 ||
+        filetype.compare(".STL") == 0)
+    {
+        // polygons are parsed straight into serialized buffers, and vertex
+        // positions (and their attributes) are then moved into the mesh
+        IOData data;
+        if(!read_mesh(filename, data)) exit(-1);
+        init(std::move(data));
+    }
+    else if (filetype.compare(".ply") == 0 ||
+             filetype.compare(".PLY") == 0)
+    {
+        std::vector<vec3d>                  pos;
+        std::vector<std::vector<uint>>      poly_pos;
+        std::vector<Vert_std_attributes>    v_attr;
+        std::vector<Polygon_std_attributes> p_attr;
+        std::map<std::string,ScalarField>   v_fields, p_fields;
+        int v_props, p_props;
+        if(!read_PLY(filename, pos, poly_pos, v_attr, v_props, p_attr, p_props, v_fields, p_fields)) exit(-1);
+        init(pos, poly_pos);
+
+        for(uint vid=0; vid<this->num_verts(); ++vid)
+        {
+            if(v_props & PLY_NORMAL ) this->vert_data(vid).normal  = v_attr.at(vid).normal;
+            if(v_props & PLY_COLOR  ) this->vert_data(vid).color   = v_attr.at(vid).color;
+            if(v_props & PLY_UVW    ) this->vert_data(vid).uvw     = v_attr.at(vid).uvw;
+            if(v_props & PLY_LABEL  ) this->vert_data(vid).label   = v_attr.at(vid).label;
+            if(v_props & PLY_QUALITY) this->vert_data(vid).quality = v_attr.at(vid).quality;
+        }
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            if(p_props & PLY_NORMAL ) this->poly_data(pid).normal  = p_attr.at(pid).normal;
+            if(p_props & PLY_COLOR  ) this->poly_data(pid).color   = p_attr.at(pid).color;
+            if(p_props & PLY_LABEL  ) this->poly_data(pid).label   = p_attr.at(pid).label;
+            if(p_props & PLY_QUALITY) this->poly_data(pid).quality = p_attr.at(pid).quality;
+        }
     }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
     }
-
-    init(pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col, poly_lab);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -102,7 +115,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 {
-    std::vector<double> coords = serialized_xyz_from_vec3d(this->verts);
+    const std::vector<vec3d> & xyz    = points_as_vec3d(this->verts);
+    std::vector<double>        coords = serialized_xyz_from_vec3d(xyz);
 
     std::string str(filename);
     std::string filetype = str.substr(str.size()-3,3);
@@ -133,7 +147,27 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
             normals.push_back(this->poly_data(pid).normal.z());
         }
 
-        write_STL(filename, serialized_xyz_from_vec3d(this->vector_verts()), this->polys, normals);
+        write_STL(filename, coords, this->polys, normals);
+    }
+    else if (filetype.compare("ply") == 0 ||
+             filetype.compare("PLY") == 0)
+    {
+        std::vector<Vert_std_attributes>    v_attr(this->num_verts());
+        std::vector<Polygon_std_attributes> p_attr(this->num_polys());
+        for(uint vid=0; vid<this->num_verts(); ++vid)
+        {
+            v_attr.at(vid).normal = this->vert_data(vid).normal;
+            v_attr.at(vid).color  = this->vert_data(vid).color;
+        }
+        int p_props = 0;
+        if(this->polys_are_colored()) p_props |= PLY_COLOR;
+        if(this->polys_are_labeled()) p_props |= PLY_LABEL;
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            p_attr.at(pid).color = this->poly_data(pid).color;
+            p_attr.at(pid).label = this->poly_data(pid).label;
+        }
+        write_PLY(filename, xyz, this->polys, v_attr, PLY_NORMAL | PLY_COLOR, p_attr, p_props);
     }
     else
     {
@@ -223,28 +257,28 @@ void AbstractPolygonMesh<M,V,E,P>::init(      std::vector<vec3d>             & p
         std::vector<vec3d> tmp_xyz, tmp_uvw, tmp_nor;
         std::vector<std::vector<uint>> tmp_poly;
         to_openGL_unified_verts(pos, tex, nor, poly_pos, poly_tex, poly_nor, tmp_xyz, tmp_uvw, tmp_nor, tmp_poly);
-        pos      = tmp_xyz;
-        tex      = tmp_uvw;
-        nor      = tmp_nor;
-        poly_pos = tmp_poly;
+        pos      = std::move(tmp_xyz);
+        tex      = std::move(tmp_uvw);
+        nor      = std::move(tmp_nor);
+        poly_pos = std::move(tmp_poly);
     }
     else if (poly_pos.size() == poly_tex.size())
     {
         std::vector<vec3d> tmp_xyz, tmp_uvw;
         std::vector<std::vector<uint>> tmp_poly;
         to_openGL_unified_verts(pos, tex, poly_pos, poly_tex, tmp_xyz, tmp_uvw, tmp_poly);
-        pos      = tmp_xyz;
-        tex      = tmp_uvw;
-        poly_pos = tmp_poly;
+        pos      = std::move(tmp_xyz);
+        tex      = std::move(tmp_uvw);
+        poly_pos = std::move(tmp_poly);
     }
     else if (poly_pos.size() == poly_nor.size())
     {
         std::vector<vec3d> tmp_xyz, tmp_nor;
         std::vector<std::vector<uint>> tmp_poly;
         to_openGL_unified_verts(pos, nor, poly_pos, poly_nor, tmp_xyz, tmp_nor, tmp_poly);
-        pos      = tmp_xyz;
-        nor      = tmp_nor;
-        poly_pos = tmp_poly;
+        pos      = std::move(tmp_xyz);
+        nor      = std::move(tmp_nor);
+        poly_pos = std::move(tmp_poly);
     }
 
     init(pos, poly_pos);
@@ -288,6 +322,95 @@ void AbstractPolygonMesh<M,V,E,P>::init(      std::vector<vec3d>             & p
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::init(IOData && data)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    // pre-allocate memory
+    uint nv = data.num_verts();
+    uint np = data.num_polys();
+    uint ne = 1.5*np;
+    this->edges.reserve(ne*2);
+    this->polys.reserve(np);
+    this->poly_triangles.reserve(np);
+    this->p2e.reserve(np);
+    this->p2p.reserve(np);
+    this->e2p.reserve(ne);
+    this->e_data.reserve(ne);
+    this->p_data.reserve(np);
+
+    // vertex positions are moved in (only if the mesh is empty)
+    uint base = this->num_verts();
+    if(base==0)
+    {
+        points_assign(this->verts, std::move(data.verts));
+        this->v_data.resize(nv);
+        this->v2v.resize(nv);
+        this->v2e.resize(nv);
+        this->v2p.resize(nv);
+        if(this->mesh_data().update_bbox) this->update_bbox();
+    }
+    else for(const vec3d & v : data.verts) this->vert_add(v);
+
+    std::vector<uint> p;
+    for(uint pid=0; pid<np; ++pid)
+    {
+        p.assign(data.poly(pid), data.poly(pid) + data.verts_per_poly(pid));
+        if(base>0) for(uint & vid : p) vid += base;
+        this->poly_add(p);
+    }
+
+    if(data.vert_normals.size()==nv)
+    {
+        for(uint vid=0; vid<nv; ++vid) this->vert_data(base+vid).normal = data.vert_normals.at(vid);
+    }
+    else if(this->mesh_data().update_normals) this->update_v_normals();
+
+    if(data.vert_uvw.size()==nv)
+    {
+        for(uint vid=0; vid<nv; ++vid) this->vert_data(base+vid).uvw = data.vert_uvw.at(vid);
+    }
+    else this->copy_xyz_to_uvw(UVW_param);
+
+    if(data.vert_colors.size()==nv)
+    {
+        for(uint vid=0; vid<nv; ++vid) this->vert_data(base+vid).color = data.vert_colors.at(vid);
+    }
+
+    if(data.vert_labels.size()==nv)
+    {
+        for(uint vid=0; vid<nv; ++vid) this->vert_data(base+vid).label = data.vert_labels.at(vid);
+    }
+
+    uint pbase = this->num_polys() - np;
+    if(data.poly_colors.size()==np)
+    {
+        for(uint pid=0; pid<np; ++pid) this->poly_data(pbase+pid).color = data.poly_colors.at(pid);
+    }
+
+    if(data.poly_labels.size()==np)
+    {
+        for(uint pid=0; pid<np; ++pid) this->poly_data(pbase+pid).label = data.poly_labels.at(pid);
+    }
+
+    for(uint eid=0; eid<this->num_edges(); ++eid)
+    {
+        this->edge_data(eid).flags[MARKED] = (this->edge_is_boundary(eid) || !this->edge_is_manifold(eid));
+    }
+
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    std::cout << "load mesh\t"     <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_polys() << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
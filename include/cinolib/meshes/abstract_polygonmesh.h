@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/abstract_mesh.h>
 #include <cinolib/meshes/mesh_attributes.h>
+#include <cinolib/io/io_data.h>
 #include <cinolib/ipair.h>
 #include <cinolib/symbols.h>
 
@@ -78,6 +79,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
                   const std::vector<std::vector<uint>> & poly_nor,  // polygons with references to nor
                   const std::vector<Color>             & poly_col,  // per polygon colors
                   const std::vector<int>               & poly_lab); // per polygon labels
+        void init(IOData && data); // vertex positions are moved into the mesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -36,6 +36,8 @@
 #include <cinolib/meshes/abstract_polyhedralmesh.h>
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/polygon_utils.h>
+#include <cinolib/geometry/point_utils.h>
+#include <cinolib/quality_batch.h>
 #include <cinolib/how_many_seconds.h>
 #include <unordered_set>
 #include <unordered_map>
@@ -195,6 +197,103 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::init(IOData && data)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    // pre-allocate memory
+    uint nv = data.num_verts();
+    uint nf = data.num_faces();
+    uint np = data.num_polys();
+    this->faces.reserve(nf);
+    this->polys.reserve(np);
+    this->f2e.reserve(nf);
+    this->f2f.reserve(nf);
+    this->f2p.reserve(nf);
+    this->f_data.reserve(nf);
+    this->face_triangles.reserve(nf);
+    this->p2v.reserve(np);
+    this->p2e.reserve(np);
+    this->p2p.reserve(np);
+    this->p_data.reserve(np);
+    this->polys_face_winding.reserve(np);
+
+    // vertex positions are moved in (only if the mesh is empty)
+    uint vbase = this->num_verts();
+    uint fbase = this->num_faces();
+    if(vbase==0)
+    {
+        points_assign(this->verts, std::move(data.verts));
+        this->v_data.resize(nv);
+        this->v2v.resize(nv);
+        this->v2e.resize(nv);
+        this->v2f.resize(nv);
+        this->v2p.resize(nv);
+        this->update_bbox();
+    }
+    else for(const vec3d & v : data.verts) vert_add(v);
+
+    std::vector<uint> f;
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        f.assign(data.face(fid), data.face(fid) + data.verts_per_face(fid));
+        for(uint & vid : f) vid += vbase;
+        face_add(f);
+    }
+
+    std::vector<uint> p;
+    std::vector<bool> w;
+    for(uint pid=0; pid<np; ++pid)
+    {
+        p.assign(data.poly(pid), data.poly(pid) + data.verts_per_poly(pid));
+        if(nf>0)
+        {
+            for(uint & fid : p) fid += fbase;
+            w.assign(data.poly_winding.begin() + data.poly_offsets[pid],
+                     data.poly_winding.begin() + data.poly_offsets[pid+1]);
+            this->poly_add(p, w);
+        }
+        else
+        {
+            for(uint & vid : p) vid += vbase;
+            this->poly_add(p);
+        }
+    }
+    if(this->mesh_data().update_normals) this->update_v_normals();
+
+    this->copy_xyz_to_uvw(UVW_param);
+
+    if(data.vert_labels.size()==nv)
+    {
+        for(uint vid=0; vid<nv; ++vid) this->vert_data(vbase+vid).label = data.vert_labels.at(vid);
+    }
+
+    uint pbase = this->num_polys() - np;
+    if(data.poly_labels.size()==np)
+    {
+        for(uint pid=0; pid<np; ++pid) this->poly_data(pbase+pid).label = data.poly_labels.at(pid);
+        if(data.poly_colors.size()!=np) this->poly_color_wrt_label();
+    }
+
+    if(data.poly_colors.size()==np)
+    {
+        for(uint pid=0; pid<np; ++pid) this->poly_data(pbase+pid).color = data.poly_colors.at(pid);
+    }
+
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    std::cout << "load mesh\t"     <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_faces() << "F / " <<
+                 this->num_polys() << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 double AbstractPolyhedralMesh<M,V,E,F,P>::mesh_srf_area() const
@@ -465,10 +564,28 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_quality()
 {
+    // gather tets and hexa in flat lists of corners, and evaluate
+    // them in batches (see quality_batch.h)
+    std::vector<uint> tets, hexa, tet_pids, hex_pids;
     for(uint pid=0; pid<this->num_polys(); ++pid)
     {
-        update_p_quality(pid);
+        if(this->poly_is_tetrahedron(pid))
+        {
+            tets.insert(tets.end(), this->p2v.at(pid).begin(), this->p2v.at(pid).end());
+            tet_pids.push_back(pid);
+        }
+        else if(this->poly_is_hexahedron(pid))
+        {
+            hexa.insert(hexa.end(), this->p2v.at(pid).begin(), this->p2v.at(pid).end());
+            hex_pids.push_back(pid);
+        }
     }
+
+    std::vector<double> q(std::max(tet_pids.size(), hex_pids.size()));
+    tet_scaled_jacobian_batch(this->verts.data(), tets.data(), tet_pids.size(), q.data());
+    for(uint i=0; i<tet_pids.size(); ++i) this->poly_data(tet_pids.at(i)).quality = q.at(i);
+    hex_scaled_jacobian_batch(this->verts.data(), hexa.data(), hex_pids.size(), q.data());
+    for(uint i=0; i<hex_pids.size(); ++i) this->poly_data(hex_pids.at(i)).quality = q.at(i);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
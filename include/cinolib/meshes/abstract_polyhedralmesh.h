@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/abstract_mesh.h>
 #include <cinolib/meshes/mesh_attributes.h>
+#include <cinolib/io/io_data.h>
 #include <cinolib/ipair.h>
 
 namespace cinolib
@@ -90,6 +91,8 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
                   const std::vector<int>               & vert_labels,
                   const std::vector<int>               & poly_labels);
 
+        void init(IOData && data); // vertex positions are moved into the mesh
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         double mesh_srf_area() const;
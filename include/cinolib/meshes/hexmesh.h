@@ -59,6 +59,8 @@ class Hexmesh : public AbstractPolyhedralMesh<M,V,E,F,P>
 
         explicit Hexmesh(const char * filename);
 
+        explicit Hexmesh(IOData && data);
+
         explicit Hexmesh(const std::vector<double> & coords,
                          const std::vector<uint>   & polys);
 
@@ -68,6 +68,22 @@ namespace cinolib
  * Tetmesh<M,V,E,F,P>        my_tetmesh;
  * Hexmesh<M,V,E,F,P>        my_hexmesh;
  * Polyhedralmesh<M,V,E,F,P> my_hexmesh;
+ *
+ * Vertex positions are stored as vec3d, unless the mesh attributes define a
+ * different point type, e.g.
+ *
+ * struct My_mesh_attributes : Mesh_std_attributes { typedef vec3f point_type; };
+ *
+ * The _float_ attributes below define single precision meshes, which halve the
+ * memory footprint (and bandwidth) of positions, normals and uvw coordinates:
+ *
+ * Trimesh<Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes> my_trimesh;
+ * Tetmesh<Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes, Polyhedron_std_attributes> my_tetmesh;
+ *
+ * or, in short, Trimeshf my_trimesh, Tetmeshf my_tetmesh (and so on, see meshes.h).
+ * Points are promoted to double as soon as they are read (e.g. vec3d p = m.vert(vid)),
+ * hence all the geometric computations (normals, areas, predicates, linear solvers...)
+ * are still done in double precision. Only the stored results are rounded.
 */
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -131,6 +147,28 @@ struct Mesh_std_attributes
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// point type of a mesh: M::point_type if defined, vec3d otherwise
+template<class M, class = void>
+struct mesh_point_type
+{
+    typedef vec3d type;
+};
+
+template<class M>
+struct mesh_point_type<M, decltype(void(sizeof(typename M::point_type)))>
+{
+    typedef typename M::point_type type;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct Mesh_float_attributes : Mesh_std_attributes
+{
+    typedef vec3f point_type;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 struct Vert_std_attributes
 {
     vec3d          normal  = vec3d(0,0,0);
@@ -143,6 +181,18 @@ struct Vert_std_attributes
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+struct Vert_float_attributes
+{
+    vec3f          normal  = vec3f(0,0,0);
+    Color          color   = Color::WHITE();
+    vec3f          uvw     = vec3f(0,0,0);
+    int            label   = -1;
+    float          quality = 0.0;
+    std::bitset<8> flags   = 0x00;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 struct Edge_std_attributes
 {
     Color          color = Color::BLACK();
@@ -164,6 +214,18 @@ struct Polygon_std_attributes
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+struct Polygon_float_attributes
+{
+    vec3f          normal  = vec3f(0,0,0);
+    Color          color   = Color::WHITE();
+    int            label   = -1;
+    float          quality = 0.0;
+    float          AO      = 1.0;
+    std::bitset<8> flags   = 0x00;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 struct Polyhedron_std_attributes
 {
     Color          color   = Color::WHITE();
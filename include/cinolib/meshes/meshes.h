@@ -52,4 +52,17 @@
 #include <cinolib/meshes/drawable_hexmesh.h>
 #include <cinolib/meshes/drawable_polyhedralmesh.h>
 
+namespace cinolib
+{
+
+// SINGLE PRECISION MESHES (see mesh_attributes.h)
+typedef Trimesh       <Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes>                            Trimeshf;
+typedef Quadmesh      <Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes>                            Quadmeshf;
+typedef Polygonmesh   <Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes>                            Polygonmeshf;
+typedef Tetmesh       <Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes, Polyhedron_std_attributes> Tetmeshf;
+typedef Hexmesh       <Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes, Polyhedron_std_attributes> Hexmeshf;
+typedef Polyhedralmesh<Mesh_float_attributes, Vert_float_attributes, Edge_std_attributes, Polygon_float_attributes, Polyhedron_std_attributes> Polyhedralmeshf;
+
+}
+
 #endif // CINO_MESHES_H
@@ -53,6 +53,15 @@ Polygonmesh<M,V,E,P>::Polygonmesh(const char * filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+Polygonmesh<M,V,E,P>::Polygonmesh(IOData && data)
+{
+    this->init(std::move(data));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 Polygonmesh<M,V,E,P>::Polygonmesh(const std::vector<vec3d> & verts)
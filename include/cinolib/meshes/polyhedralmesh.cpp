@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/meshes/polyhedralmesh.h>
+#include <cinolib/geometry/point_utils.h>
 #include <cinolib/io/read_write.h>
 #include <cinolib/geometry/aabb.h>
 #include <cinolib/geometry/vec_mat.h>
@@ -59,6 +60,15 @@ Polyhedralmesh<M,V,E,F,P>::Polyhedralmesh(const char * filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+Polyhedralmesh<M,V,E,F,P>::Polyhedralmesh(IOData && data)
+{
+    this->init(std::move(data));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 Polyhedralmesh<M,V,E,F,P>::Polyhedralmesh(const std::vector<vec3d>             & verts,
@@ -97,25 +107,30 @@ void Polyhedralmesh<M,V,E,F,P>::load(const char * filename)
     else if (filetype.compare(".hedra") == 0 ||
              filetype.compare(".HEDRA") == 0)
     {
-        read_HEDRA(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
+        if(!read_HEDRA(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding)) exit(-1);
         this->init(tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
     }
     else if (filetype.compare(".mesh") == 0 ||
-             filetype.compare(".MESH") == 0)
+             filetype.compare(".MESH") == 0 ||
+             filetype.compare(".vtu")  == 0 ||
+             filetype.compare(".VTU")  == 0)
     {
-        read_MESH(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
-        this->init(tmp_verts, tmp_polys, vert_labels, poly_labels);
+        // elements are parsed straight into serialized buffers, and vertex
+        // positions are then moved into the mesh
+        IOData data;
+        if(!read_mesh(filename, data)) exit(-1);
+        this->init(std::move(data));
     }
-    else if (filetype.compare(".vtu") == 0 ||
-             filetype.compare(".VTU") == 0)
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
     {
-        read_VTU(filename, tmp_verts, tmp_polys);
+        if(!read_MSH(filename, tmp_verts, tmp_polys, poly_labels)) exit(-1);
         this->init(tmp_verts, tmp_polys, vert_labels, poly_labels);
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        read_VTK(filename, tmp_verts, tmp_polys);
+        if(!read_VTK(filename, tmp_verts, tmp_polys)) exit(-1);
         this->init(tmp_verts, tmp_polys, vert_labels, poly_labels);
     }
     else
@@ -130,13 +145,19 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void Polyhedralmesh<M,V,E,F,P>::save(const char * filename) const
 {
+    const std::vector<vec3d> & xyz = points_as_vec3d(this->verts);
     std::string str(filename);
-    std::string filetype = str.substr(str.size()-6,6);
+    std::string filetype = "." + get_file_extension(str);
 
     if (filetype.compare(".hedra") == 0 ||
         filetype.compare(".HEDRA") == 0)
     {
-        write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+        write_HEDRA(filename, xyz, this->faces, this->polys, this->polys_face_winding);
+    }
+    else if (filetype.compare(".vtu") == 0 ||
+             filetype.compare(".VTU") == 0)
+    {
+        write_VTU(filename, xyz, this->faces, this->polys, this->polys_face_winding);
     }
     else
     {
@@ -57,6 +57,8 @@ class Polyhedralmesh : public AbstractPolyhedralMesh<M,V,E,F,P>
 
         explicit Polyhedralmesh(const char * filename);
 
+        explicit Polyhedralmesh(IOData && data);
+
         explicit Polyhedralmesh(const std::vector<vec3d>             & verts,
                                 const std::vector<std::vector<uint>> & faces,
                                 const std::vector<std::vector<uint>> & polys,
@@ -56,6 +56,15 @@ Quadmesh<M,V,E,P>::Quadmesh(const char * filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+Quadmesh<M,V,E,P>::Quadmesh(IOData && data)
+{
+    this->init(std::move(data));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 Quadmesh<M,V,E,P>::Quadmesh(const std::vector<vec3d> & verts,
@@ -56,6 +56,8 @@ class Quadmesh : public AbstractPolygonMesh<M,V,E,P>
 
         explicit Quadmesh(const char * filename);
 
+        explicit Quadmesh(IOData && data);
+
         explicit Quadmesh(const std::vector<vec3d> & verts,
                           const std::vector<uint>  & polys);
 
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/meshes/tetmesh.h>
+#include <cinolib/geometry/point_utils.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/tetrahedron.h>
@@ -87,6 +88,15 @@ Tetmesh<M,V,E,F,P>::Tetmesh(const char * filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+Tetmesh<M,V,E,F,P>::Tetmesh(IOData && data)
+{
+    this->init(std::move(data));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void Tetmesh<M,V,E,F,P>::load(const char * filename)
@@ -103,24 +113,31 @@ void Tetmesh<M,V,E,F,P>::load(const char * filename)
     std::string filetype = "." + get_file_extension(str);
 
     if (filetype.compare(".mesh") == 0 ||
-        filetype.compare(".MESH") == 0)
+        filetype.compare(".MESH") == 0 ||
+        filetype.compare(".vtu")  == 0 ||
+        filetype.compare(".VTU")  == 0)
     {
-        read_MESH(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
+        // elements are parsed straight into serialized buffers, and vertex
+        // positions are then moved into the mesh
+        IOData data;
+        if(!read_mesh(filename, data)) exit(-1);
+        this->init(std::move(data));
+        return;
     }
-    else if (filetype.compare(".vtu") == 0 ||
-             filetype.compare(".VTU") == 0)
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
     {
-        read_VTU(filename, tmp_verts, tmp_polys);
+        if(!read_MSH(filename, tmp_verts, tmp_polys, poly_labels)) exit(-1);
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        read_VTK(filename, tmp_verts, tmp_polys);
+        if(!read_VTK(filename, tmp_verts, tmp_polys)) exit(-1);
     }
     else if (filetype.compare(".tet") == 0 ||
              filetype.compare(".TET") == 0)
     {
-        read_TET(filename, tmp_verts, tmp_polys);
+        if(!read_TET(filename, tmp_verts, tmp_polys)) exit(-1);
     }
     else
     {
@@ -136,6 +153,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void Tetmesh<M,V,E,F,P>::save(const char * filename) const
 {
+    const std::vector<vec3d> & xyz = points_as_vec3d(this->verts);
     std::string str(filename);
     std::string filetype = "." + get_file_extension(str);
 
@@ -144,29 +162,38 @@ void Tetmesh<M,V,E,F,P>::save(const char * filename) const
     {
         if(this->polys_are_labeled())
         {
-            write_MESH(filename, this->verts, this->p2v, std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
+            write_MESH(filename, xyz, this->p2v, std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
+        }
+        else write_MESH(filename, xyz, this->p2v);
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        if(this->polys_are_labeled())
+        {
+            write_MSH(filename, xyz, this->p2v, this->vector_poly_labels());
         }
-        else write_MESH(filename, this->verts, this->p2v);
+        else write_MSH(filename, xyz, this->p2v);
     }
     else if (filetype.compare(".tet") == 0 ||
              filetype.compare(".TET") == 0)
     {
-        write_TET(filename, this->verts, this->p2v);
+        write_TET(filename, xyz, this->p2v);
     }
     else if (filetype.compare(".vtu") == 0 ||
              filetype.compare(".VTU") == 0)
     {
-        write_VTU(filename, this->verts, this->p2v);
+        write_VTU(filename, xyz, this->p2v);
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        write_VTK(filename, this->verts, this->p2v);
+        write_VTK(filename, xyz, this->p2v);
     }
     else if (filetype.compare(".hedra") == 0 ||
              filetype.compare(".HEDRA") == 0)
     {
-        write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+        write_HEDRA(filename, xyz, this->faces, this->polys, this->polys_face_winding);
     }
     else
     {
@@ -59,6 +59,8 @@ class Tetmesh : public AbstractPolyhedralMesh<M,V,E,F,P>
 
         explicit Tetmesh(const char * filename);
 
+        explicit Tetmesh(IOData && data);
+
         explicit Tetmesh(const std::vector<double> & coords,
                          const std::vector<uint>   & polys);
 
@@ -55,6 +55,15 @@ Trimesh<M,V,E,P>::Trimesh(const char * filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+Trimesh<M,V,E,P>::Trimesh(IOData && data)
+{
+    this->init(std::move(data));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 Trimesh<M,V,E,P>::Trimesh(const std::vector<vec3d>              & verts,
@@ -56,6 +56,8 @@ class Trimesh : public AbstractPolygonMesh<M,V,E,P>
 
         explicit Trimesh(const char * filename);
 
+        explicit Trimesh(IOData && data);
+
         explicit Trimesh(const std::vector<vec3d>             & coords,
                          const std::vector<std::vector<uint>> & polys);
 
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/mst.h>
+#include <cinolib/indexed_heap.h>
 
 namespace cinolib
 {
@@ -53,16 +54,15 @@ void MST_on_dual_mask_on_edges(const AbstractPolygonMesh<M,V,E,P> & m,
     cost.at(0) = 0.f; // start with poly #0
 
     // enqueue all elements
-    std::set<std::pair<float,uint>> q;
-    for(uint pid=0; pid<m.num_polys(); ++pid) q.insert(std::make_pair(cost.at(pid), pid));
+    IndexedHeap<> q(m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid) q.push_or_decrease(pid, cost.at(pid));
 
     // initialize an empty MST
     tree = std::vector<bool>(m.num_edges(), false);
 
     while(!q.empty())
     {
-        uint pid = q.begin()->second;
-        q.erase(q.begin());
+        uint pid = q.pop();
         dequeued.at(pid) = true;
 
         if(prev.at(pid)!=-1) // add an edge to the MST
@@ -79,15 +79,10 @@ void MST_on_dual_mask_on_edges(const AbstractPolygonMesh<M,V,E,P> & m,
                 if(mask.at(eid)) continue;
                 if(cost.at(nbr) > weights.at(eid))
                 {
-                    // remove previous entry from queue
-                    auto it = q.find(std::make_pair(cost.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-
                     // update values and queue
                     cost.at(nbr) = weights.at(eid);
                     prev.at(nbr) = pid;
-                    q.insert(std::make_pair(weights.at(eid),nbr));
+                    q.push_or_decrease(nbr, weights.at(eid));
                 }
             }
         }
@@ -0,0 +1,363 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/multigrid.h>
+#include <cinolib/parallel_for.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace cinolib
+{
+
+namespace
+{
+
+// y = A*x, for symmetric (column major) matrices: rows are read as columns,
+// hence each entry of y is computed independently from the others
+//
+CINO_INLINE
+void mg_spmv(const Eigen::SparseMatrix<double> & A, const Eigen::VectorXd & x, Eigen::VectorXd & y)
+{
+    y.resize(A.rows());
+    PARALLEL_FOR(0, A.outerSize(), 1000, [&](uint i)
+    {
+        double sum = 0.0;
+        for(Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it) sum += it.value() * x[it.row()];
+        y[i] = sum;
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// groups the unknowns in aggregates, each made of a seed and its strongly
+// connected neighbors. Returns the number of aggregates
+//
+CINO_INLINE
+uint mg_aggregate(const Eigen::SparseMatrix<double> & A, const Eigen::VectorXd & diag, const double eps, std::vector<int> & agg)
+{
+    typedef Eigen::SparseMatrix<double>::InnerIterator Iter;
+    auto is_strong = [&](const Iter & it)
+    {
+        return it.row()!=it.col() && std::fabs(it.value()) > eps*std::sqrt(std::fabs(diag[it.row()]*diag[it.col()]));
+    };
+
+    uint n  = A.rows();
+    uint na = 0;
+    agg.assign(n,-1);
+
+    // phase 1: seeds whose strong neighborhood is entirely free
+    for(uint i=0; i<n; ++i)
+    {
+        if(agg[i]>=0) continue;
+        bool free = true;
+        for(Iter it(A,i); it && free; ++it) if(is_strong(it) && agg[it.row()]>=0) free = false;
+        if(!free) continue;
+        agg[i] = na;
+        for(Iter it(A,i); it; ++it) if(is_strong(it)) agg[it.row()] = na;
+        ++na;
+    }
+
+    // phase 2: free unknowns join the aggregate they are most strongly connected to
+    std::vector<int> agg1 = agg;
+    for(uint i=0; i<n; ++i)
+    {
+        if(agg1[i]>=0) continue;
+        double best = 0.0;
+        for(Iter it(A,i); it; ++it)
+        {
+            if(is_strong(it) && agg1[it.row()]>=0 && std::fabs(it.value())>best)
+            {
+                best   = std::fabs(it.value());
+                agg[i] = agg1[it.row()];
+            }
+        }
+    }
+
+    // phase 3: leftovers form new aggregates with their free neighbors
+    for(uint i=0; i<n; ++i)
+    {
+        if(agg[i]>=0) continue;
+        agg[i] = na;
+        for(Iter it(A,i); it; ++it) if(is_strong(it) && agg[it.row()]<0) agg[it.row()] = na;
+        ++na;
+    }
+
+    return na;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// greedy coloring of the graph of A (unknowns of the same color are not coupled)
+//
+CINO_INLINE
+std::vector<std::vector<uint>> mg_coloring(const Eigen::SparseMatrix<double> & A)
+{
+    std::vector<int>               color(A.rows(),-1);
+    std::vector<uint>              used; // used[c]==i if color c is taken by a neighbor of i
+    std::vector<std::vector<uint>> colors;
+    for(uint i=0; i<A.rows(); ++i)
+    {
+        for(Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it)
+        {
+            int c = color[it.row()];
+            if(c>=0) used[c] = i;
+        }
+        uint c = 0;
+        while(c<used.size() && used[c]==i) ++c;
+        if(c==used.size())
+        {
+            used.push_back(uint(-1));
+            colors.emplace_back();
+        }
+        color[i] = c;
+        colors[c].push_back(i);
+    }
+    return colors;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// estimates the spectral radius of inv(D)*A with a few power iterations
+//
+CINO_INLINE
+double mg_spectral_radius(const Eigen::SparseMatrix<double> & A, const Eigen::VectorXd & inv_diag)
+{
+    Eigen::VectorXd x = Eigen::VectorXd::Random(A.rows()), y;
+    double rho = 1.0;
+    for(uint i=0; i<15; ++i)
+    {
+        x.normalize();
+        mg_spmv(A, x, y);
+        y   = inv_diag.cwiseProduct(y);
+        rho = y.norm();
+        if(rho==0) return 1.0;
+        x   = y;
+    }
+    return rho;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Multigrid::Multigrid(const Eigen::SparseMatrix<double> & A, const MultigridOptions & opt) : opt(opt)
+{
+    assert(A.rows() == A.cols());
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    levels.emplace_back();
+    levels.back().A = A;
+    levels.back().A.makeCompressed();
+
+    while(levels.back().A.rows() > opt.min_coarse_size && levels.size() < opt.max_levels)
+    {
+        const Eigen::SparseMatrix<double> & Af = levels.back().A;
+        Eigen::VectorXd diag     = Af.diagonal();
+        Eigen::VectorXd inv_diag = diag.cwiseInverse();
+
+        std::vector<int> agg;
+        uint n  = Af.rows();
+        uint nc = mg_aggregate(Af, diag, opt.strength, agg);
+        if(nc == 0 || nc > 0.9*n) break; // coarsening stagnates
+
+        // tentative (piecewise constant) prolongation
+        Eigen::SparseMatrix<double> Pt(n,nc);
+        Pt.reserve(Eigen::VectorXi::Constant(nc, int(n/nc)+8));
+        for(uint i=0; i<n; ++i) Pt.insert(i,agg[i]) = 1.0;
+        Pt.makeCompressed();
+
+        // smoothed prolongation P = (I - omega*inv(D)*A) * Pt, with omega = 4/(3*rho(inv(D)*A))
+        double omega = 4.0/(3.0*mg_spectral_radius(Af, inv_diag));
+        Eigen::SparseMatrix<double> DinvA = inv_diag.asDiagonal() * Af;
+        Eigen::SparseMatrix<double> P     = Pt - omega * (DinvA * Pt);
+        Eigen::SparseMatrix<double> R     = P.transpose();
+        Eigen::SparseMatrix<double> Ac    = (R * Af * P).pruned();
+
+        levels.back().P = P;
+        levels.back().R = R;
+        levels.emplace_back();
+        levels.back().A = Ac;
+        levels.back().A.makeCompressed();
+    }
+
+    for(uint l=0; l+1<levels.size(); ++l)
+    {
+        levels.at(l).inv_diag = levels.at(l).A.diagonal().cwiseInverse();
+        if(opt.smoother == MG_GAUSS_SEIDEL) levels.at(l).colors = mg_coloring(levels.at(l).A);
+    }
+    coarse_solver.compute(levels.back().A);
+    assert(coarse_solver.info() == Eigen::Success);
+
+    for(const Level & l : levels)
+    {
+        mg_stats.level_size.push_back(l.A.rows());
+        mg_stats.level_nnz.push_back(l.A.nonZeros());
+    }
+    mg_stats.setup_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::VectorXd Multigrid::solve(const Eigen::VectorXd & r) const
+{
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(r.size());
+    v_cycle(0, r, x);
+    return x;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint Multigrid::solve(const Eigen::VectorXd & b,
+                            Eigen::VectorXd & x,
+                      const double            tol,
+                      const uint              max_iter)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    const Eigen::SparseMatrix<double> & A = levels.front().A;
+    if(x.size() != b.size()) x = Eigen::VectorXd::Zero(b.size());
+
+    double b_norm = b.norm();
+    if(b_norm == 0) b_norm = 1.0;
+
+    Eigen::VectorXd Ax;
+    mg_spmv(A, x, Ax);
+    double res = (b-Ax).norm()/b_norm;
+
+    mg_stats.residuals.clear();
+    mg_stats.iterations = 0;
+    while(res > tol && mg_stats.iterations < max_iter)
+    {
+        v_cycle(0, b, x);
+        mg_spmv(A, x, Ax);
+        res = (b-Ax).norm()/b_norm;
+        mg_stats.residuals.push_back(res);
+        ++mg_stats.iterations;
+    }
+    if(res > tol) std::cerr << "WARNING : Multigrid::solve() : no convergence after " << max_iter << " cycles" << std::endl;
+
+    mg_stats.solve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+    return mg_stats.iterations;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::v_cycle(const uint level, const Eigen::VectorXd & b, Eigen::VectorXd & x) const
+{
+    const Level & l = levels.at(level);
+
+    if(level+1 == levels.size())
+    {
+        x = coarse_solver.solve(b);
+        return;
+    }
+
+    smooth(level, b, x, true);
+
+    Eigen::VectorXd Ax;
+    mg_spmv(l.A, x, Ax);
+    Eigen::VectorXd rc = l.R * (b - Ax);
+    Eigen::VectorXd xc = Eigen::VectorXd::Zero(rc.size());
+    v_cycle(level+1, rc, xc);
+    x += l.P * xc;
+
+    smooth(level, b, x, false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::smooth(const uint level, const Eigen::VectorXd & b, Eigen::VectorXd & x, const bool forward) const
+{
+    const Level & l = levels.at(level);
+
+    for(uint step=0; step<opt.n_smooth; ++step)
+    {
+        if(opt.smoother == MG_JACOBI)
+        {
+            Eigen::VectorXd Ax;
+            mg_spmv(l.A, x, Ax);
+            x += opt.jacobi_omega * l.inv_diag.cwiseProduct(b - Ax);
+        }
+        else // MG_GAUSS_SEIDEL
+        {
+            uint nc = l.colors.size();
+            for(uint c=0; c<nc; ++c)
+            {
+                const std::vector<uint> & set = l.colors.at(forward ? c : nc-1-c);
+                PARALLEL_FOR(0, set.size(), 1000, [&](uint k)
+                {
+                    uint   i   = set[k];
+                    double sum = 0.0;
+                    for(Eigen::SparseMatrix<double>::InnerIterator it(l.A,i); it; ++it) sum += it.value() * x[it.row()];
+                    x[i] += (b[i] - sum) * l.inv_diag[i];
+                });
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double MultigridStats::convergence_factor() const
+{
+    if(residuals.size()<2) return 0;
+    return std::pow(residuals.back()/residuals.front(), 1.0/(residuals.size()-1));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MultigridStats::print() const
+{
+    std::cout << "multigrid: " << level_size.size() << " levels [setup " << setup_seconds << "s]" << std::endl;
+    for(uint l=0; l<level_size.size(); ++l)
+    {
+        std::cout << "  level " << l << "\t" << level_size.at(l) << " unknowns\t" << level_nnz.at(l) << " non zeros" << std::endl;
+    }
+    if(iterations>0)
+    {
+        std::cout << "  " << iterations << " cycles [" << solve_seconds << "s], final residual " << residuals.back()
+                  << ", convergence factor " << convergence_factor() << std::endl;
+    }
+}
+
+}
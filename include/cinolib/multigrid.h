@@ -0,0 +1,160 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MULTIGRID_H
+#define CINO_MULTIGRID_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Multigrid solver for symmetric positive definite systems A*x = b arising from
+ * elliptic (Poisson-like) problems on meshes, such as -L, M - t*L, or the normal
+ * equations of harmonic maps and parameterizations.
+ *
+ * The hierarchy is obtained by clustering: at each level, vertices are grouped
+ * into small aggregates made of a seed and its strongly connected neighbors, and
+ * each aggregate becomes a vertex of the next (coarser) level. For Laplacian-like
+ * matrices the graph of A coincides with the edge graph of the mesh, hence the
+ * first level clusters mesh vertices into (topological) patches, and coarser
+ * levels cluster patches into bigger patches. Prolongation operators are smoothed
+ * piecewise constant interpolants (smoothed aggregation), restriction operators
+ * are their transposes, and coarse matrices are computed as R*A*P. The coarsest
+ * level is solved with a direct (LDLT) solver.
+ *
+ * Smoothing is done either with damped Jacobi, or with multi-color Gauss-Seidel
+ * (vertices of the same color are not coupled in A, hence they are relaxed in
+ * parallel). The V-cycle is symmetric (Gauss-Seidel sweeps colors backwards in
+ * post smoothing), hence the solver can be used both standalone, or as a
+ * preconditioner for CG (e.g. solve_PCG in linear_solvers.h, or CG_MULTIGRID in
+ * the solver enum).
+ *
+ * Reference:
+ *
+ *   Algebraic Multigrid by Smoothed Aggregation for Second and Fourth Order Elliptic Problems
+ *   Petr Vanek, Jan Mandel, Marian Brezina
+ *   Computing (1996)
+*/
+
+enum
+{
+    MG_JACOBI,
+    MG_GAUSS_SEIDEL,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct MultigridOptions
+{
+    uint   min_coarse_size = 500;          // stop coarsening when a level is smaller than this
+    uint   max_levels      = 20;
+    int    smoother        = MG_GAUSS_SEIDEL;
+    uint   n_smooth        = 2;            // pre and post smoothing steps
+    double jacobi_omega    = 2.0/3.0;      // damping of the Jacobi smoother
+    double strength        = 0.08;         // a_ij is strong if |a_ij| > strength * sqrt(a_ii*a_jj)
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct MultigridStats
+{
+    std::vector<uint>   level_size;       // number of unknowns, from finest to coarsest
+    std::vector<uint>   level_nnz;        // number of non zeros, from finest to coarsest
+    std::vector<double> residuals;        // relative residual after each cycle (standalone solver only)
+    uint                iterations    = 0;
+    double              setup_seconds = 0;
+    double              solve_seconds = 0;
+
+    double convergence_factor() const;    // average residual reduction per cycle
+    void   print() const;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class Multigrid
+{
+    public:
+
+        explicit Multigrid(const Eigen::SparseMatrix<double> & A,
+                           const MultigridOptions            & opt = MultigridOptions());
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // preconditioner interface: one V-cycle, starting from a zero initial guess
+        Eigen::VectorXd solve(const Eigen::VectorXd & r) const;
+
+        // standalone solver: V-cycles until the relative residual drops below tol.
+        // If x has the proper size it is used as initial guess. Returns the number of cycles
+        uint solve(const Eigen::VectorXd & b,
+                         Eigen::VectorXd & x,
+                   const double            tol      = 1e-8,
+                   const uint              max_iter = 100);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint                   num_levels() const { return levels.size(); }
+        const MultigridStats & stats()      const { return mg_stats; }
+
+    protected:
+
+        struct Level
+        {
+            Eigen::SparseMatrix<double>    A;        // system matrix at this level
+            Eigen::SparseMatrix<double>    P;        // prolongation from the next (coarser) level
+            Eigen::SparseMatrix<double>    R;        // restriction to the next (coarser) level
+            Eigen::VectorXd                inv_diag;
+            std::vector<std::vector<uint>> colors;   // independent sets, for Gauss-Seidel
+        };
+
+        void v_cycle(const uint level, const Eigen::VectorXd & b, Eigen::VectorXd & x) const;
+        void smooth (const uint level, const Eigen::VectorXd & b, Eigen::VectorXd & x, const bool forward) const;
+
+        MultigridOptions                               opt;
+        MultigridStats                                 mg_stats;
+        std::vector<Level>                             levels;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> coarse_solver;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "multigrid.cpp"
+#endif
+
+#endif // CINO_MULTIGRID_H
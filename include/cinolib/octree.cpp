@@ -42,6 +42,7 @@
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/tetrahedron.h>
 #include <stack>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -173,6 +174,32 @@ void Octree::build()
         }
     }
 
+    // copy the triangles of each leaf in SoA blocks (see ray_triangle_intersection_batch.h)
+    std::vector<OctreeNode*> tri_leaves;
+    std::stack<OctreeNode*> stack;
+    stack.push(root);
+    while(!stack.empty())
+    {
+        OctreeNode *node = stack.top();
+        stack.pop();
+        if(node->is_inner())
+        {
+            for(int i=0; i<8; ++i) stack.push(node->children[i]);
+        }
+        else if(std::all_of(node->item_indices.begin(), node->item_indices.end(), [&](const uint i){ return items.at(i)->item_type==TRIANGLE; }))
+        {
+            tri_leaves.push_back(node);
+        }
+    }
+    PARALLEL_FOR(0, tri_leaves.size(), 1000, [&](uint i)
+    {
+        for(uint j : tri_leaves.at(i)->item_indices)
+        {
+            const Triangle *t = static_cast<const Triangle*>(items.at(j));
+            tri_leaves.at(i)->tris.push_back(t->v[0], t->v[1], t->v[2]);
+        }
+    });
+
     if(print_debug_info)
     {
         Time::time_point t1 = Time::now();
@@ -488,6 +515,8 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
     PrioQueue q;
     q.push(obj);
 
+    std::vector<std::pair<double,uint>> hits; // batched ray/triangle tests (see OctreeNode::tris)
+
     while(!q.empty() && q.top().node->is_inner())
     {
         Obj obj = q.top();
@@ -505,6 +534,19 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
                     obj.dist = t;
                     q.push(obj);
                 }
+                else if(child->tris.size()>0)
+                {
+                    hits.clear();
+                    ray_triangle_intersection_batch(p, dir, child->tris, hits);
+                    for(const auto & h : hits)
+                    {
+                        Obj obj;
+                        obj.node  = child;
+                        obj.index = items.at(child->item_indices.at(h.second))->id;
+                        obj.dist  = h.first;
+                        q.push(obj);
+                    }
+                }
                 else
                 {
                     for(uint i : child->item_indices)
@@ -554,6 +596,8 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
     PrioQueue q;
     q.push(obj);
 
+    std::vector<std::pair<double,uint>> hits; // batched ray/triangle tests (see OctreeNode::tris)
+
     while(!q.empty())
     {
         Obj obj = q.top();
@@ -571,6 +615,15 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
                     obj.dist = t;
                     q.push(obj);
                 }
+                else if(child->tris.size()>0)
+                {
+                    hits.clear();
+                    ray_triangle_intersection_batch(p, dir, child->tris, hits);
+                    for(const auto & h : hits)
+                    {
+                        all_hits.insert(std::make_pair(h.first,items.at(child->item_indices.at(h.second))->id));
+                    }
+                }
                 else
                 {
                     for(uint i : child->item_indices)
@@ -37,6 +37,7 @@
 #define CINO_OCTREE_H
 
 #include <cinolib/geometry/spatial_data_structure_item.h>
+#include <cinolib/ray_triangle_intersection_batch.h>
 #include <cinolib/meshes/meshes.h>
 #include <queue>
 
@@ -50,6 +51,7 @@ class OctreeNode
        ~OctreeNode();
         AABB              bbox;
         std::vector<uint> item_indices; // index Octree::items, avoiding to store a copy of the same object multiple times in each node it appears
+        TriangleSoA       tris;         // leaves made of triangles only also store them in SoA blocks, to answer ray queries with batched kernels
         OctreeNode       *children[8] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
         bool              is_inner() const { return children[0]!=nullptr; }
 };
@@ -36,16 +36,23 @@
 #include <cinolib/predicates.h>
 #include <algorithm>
 #include <bitset>
+#include <cmath>
+#include <vector>
 
 namespace cinolib
 {
 
-#ifndef CINOLIB_USES_SHEWCHUK_PREDICATES
-/*********************************************************
- * BEGIN OF IMPlEMENTATION OF INEXACT GEOMETRIC PREDICATES
- *********************************************************/
+// error bounds of the first (floating point) stage of Shewchuk's adaptive
+// predicates, i.e. (3+16e)e, (7+56e)e and (10+96e)e, with e = 2^-53
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+static const double orient2d_err_bound = 3.3306690738754716e-16;
+static const double orient3d_err_bound = 7.7715611723761027e-16;
+static const double incircle_err_bound = 1.1102230246251577e-15;
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// basically the Shewchuk's orient2dfast()
+// basically the Shewchuk's orient2dfast(), filtered if exact predicates are enabled
 CINO_INLINE
 double orient2d(const double * pa,
                 const double * pb,
@@ -56,12 +63,21 @@ double orient2d(const double * pa,
     double acy = pa[1] - pc[1];
     double bcy = pb[1] - pc[1];
 
-    return acx * bcy - acy * bcx;
+    double detleft  = acx * bcy;
+    double detright = acy * bcx;
+    double det      = detleft - detright;
+
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    double detsum = std::fabs(detleft) + std::fabs(detright);
+    if(std::fabs(det) < orient2d_err_bound * detsum) return shewchuk::orient2d(pa, pb, pc);
+#endif
+
+    return det;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// basically the Shewchuk's orient3dfast()
+// basically the Shewchuk's orient3dfast(), filtered if exact predicates are enabled
 CINO_INLINE
 double orient3d(const double * pa,
                 const double * pb,
@@ -78,14 +94,30 @@ double orient3d(const double * pa,
     double bdz = pb[2] - pd[2];
     double cdz = pc[2] - pd[2];
 
-    return adx * (bdy * cdz - bdz * cdy)
-         + bdx * (cdy * adz - cdz * ady)
-         + cdx * (ady * bdz - adz * bdy);
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+
+    double det = adz * (bdxcdy - cdxbdy)
+               + bdz * (cdxady - adxcdy)
+               + cdz * (adxbdy - bdxady);
+
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+                     + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+                     + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    if(std::fabs(det) <= orient3d_err_bound * permanent) return shewchuk::orient3d(pa, pb, pc, pd);
+#endif
+
+    return det;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// basically the Shewchuk's incirclefast()
+// basically the Shewchuk's incirclefast(), filtered if exact predicates are enabled
 CINO_INLINE
 double incircle(const double * pa,
                 const double * pb,
@@ -99,19 +131,35 @@ double incircle(const double * pa,
     double cdx = pc[0] - pd[0];
     double cdy = pc[1] - pd[1];
 
-    double abdet = adx * bdy - bdx * ady;
-    double bcdet = bdx * cdy - cdx * bdy;
-    double cadet = cdx * ady - adx * cdy;
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+
     double alift = adx * adx + ady * ady;
     double blift = bdx * bdx + bdy * bdy;
     double clift = cdx * cdx + cdy * cdy;
 
-    return alift * bcdet + blift * cadet + clift * abdet;
+    double det = alift * (bdxcdy - cdxbdy)
+               + blift * (cdxady - adxcdy)
+               + clift * (adxbdy - bdxady);
+
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                     + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                     + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    if(std::fabs(det) <= incircle_err_bound * permanent) return shewchuk::incircle(pa, pb, pc, pd);
+#endif
+
+    return det;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// basically the Shewchuk's inspherefast()
+// basically the Shewchuk's inspherefast(). If exact predicates are
+// enabled, it directly calls Shewchuk's insphere (which is filtered as well)
 CINO_INLINE
 double insphere(const double * pa,
                 const double * pb,
@@ -119,6 +167,9 @@ double insphere(const double * pa,
                 const double * pd,
                 const double * pe)
 {
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    return shewchuk::insphere(pa, pb, pc, pd, pe);
+#else
     double aex = pa[0] - pe[0];
     double bex = pb[0] - pe[0];
     double cex = pc[0] - pe[0];
@@ -151,12 +202,94 @@ double insphere(const double * pa,
     double dlift = dex * dex + dey * dey + dez * dez;
 
     return (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+#endif
 }
 
-/*******************************************************
- * END OF IMPlEMENTATION OF INEXACT GEOMETRIC PREDICATES
- *******************************************************/
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void orient2d_batch(const double * pa,
+                    const double * pb,
+                    const double * pc,
+                    const uint     n,
+                          double * res)
+{
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    std::vector<double> err(n);
+#endif
+
+    for(uint i=0; i<n; ++i)
+    {
+        double acx = pa[2*i  ] - pc[2*i  ];
+        double bcx = pb[2*i  ] - pc[2*i  ];
+        double acy = pa[2*i+1] - pc[2*i+1];
+        double bcy = pb[2*i+1] - pc[2*i+1];
+        double detleft  = acx * bcy;
+        double detright = acy * bcx;
+        res[i] = detleft - detright;
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+        err[i] = orient2d_err_bound * (std::fabs(detleft) + std::fabs(detright));
 #endif
+    }
+
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    for(uint i=0; i<n; ++i)
+    {
+        if(std::fabs(res[i]) < err[i]) res[i] = shewchuk::orient2d(pa+2*i, pb+2*i, pc+2*i);
+    }
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void orient3d_batch(const double * pa,
+                    const double * pb,
+                    const double * pc,
+                    const double * pd,
+                    const uint     n,
+                          double * res)
+{
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    std::vector<double> err(n);
+#endif
+
+    for(uint i=0; i<n; ++i)
+    {
+        double adx = pa[3*i  ] - pd[3*i  ];
+        double bdx = pb[3*i  ] - pd[3*i  ];
+        double cdx = pc[3*i  ] - pd[3*i  ];
+        double ady = pa[3*i+1] - pd[3*i+1];
+        double bdy = pb[3*i+1] - pd[3*i+1];
+        double cdy = pc[3*i+1] - pd[3*i+1];
+        double adz = pa[3*i+2] - pd[3*i+2];
+        double bdz = pb[3*i+2] - pd[3*i+2];
+        double cdz = pc[3*i+2] - pd[3*i+2];
+
+        double bdxcdy = bdx * cdy;
+        double cdxbdy = cdx * bdy;
+        double cdxady = cdx * ady;
+        double adxcdy = adx * cdy;
+        double adxbdy = adx * bdy;
+        double bdxady = bdx * ady;
+
+        res[i] = adz * (bdxcdy - cdxbdy)
+               + bdz * (cdxady - adxcdy)
+               + cdz * (adxbdy - bdxady);
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+        err[i] = orient3d_err_bound * ((std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+                                     + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+                                     + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz));
+#endif
+    }
+
+#ifdef CINOLIB_USES_SHEWCHUK_PREDICATES
+    for(uint i=0; i<n; ++i)
+    {
+        if(std::fabs(res[i]) <= err[i]) res[i] = shewchuk::orient3d(pa+3*i, pb+3*i, pc+3*i, pd+3*i);
+    }
+#endif
+}
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
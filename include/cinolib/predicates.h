@@ -38,6 +38,7 @@
 
 #include <cinolib/geometry/vec_mat.h>
 #include <bitset>
+#include <sys/types.h>
 
 namespace cinolib
 {
@@ -132,8 +133,11 @@ SimplexIntersection;
  * WARNING: if you use these predicates, you should include in your
  * project <CINOLIB_HOME>/external/predicates/shewchuk.c and compile it,
  * otherwise the linker will not find an implementation for the methods
- * below
+ * below. They are not meant to be called directly: orient2d, orient3d,
+ * incircle and insphere below call them only when needed
  */
+namespace shewchuk
+{
 extern "C"
 {
 
@@ -163,11 +167,24 @@ double insphere(const double * pa,
                 const double * pd,
                 const double * pe);
 }
+}
+
+#endif
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// These are equivalent to the "fast" version of Shewchuk's predicates. Hence are INEXACT
-// geometric predicates solely based on the accuracy of the floating point system
+/* If CINOLIB_USES_SHEWCHUK_PREDICATES is not defined, these are equivalent to
+ * the "fast" version of Shewchuk's predicates. Hence are INEXACT geometric
+ * predicates solely based on the accuracy of the floating point system.
+ *
+ * If CINOLIB_USES_SHEWCHUK_PREDICATES is defined, they are EXACT and filtered:
+ * the determinant is evaluated inline in floating point, together with a
+ * semi-static bound of its rounding error (the same used by the first stage of
+ * Shewchuk's adaptive predicates). The exact code is called only when the
+ * error may flip the sign of the result, which is rare unless the points are
+ * (almost) degenerate. Exact predicates therefore cost about as much as the
+ * inexact ones on typical inputs.
+*/
 
 CINO_INLINE
 double orient2d(const double * pa,
@@ -198,7 +215,33 @@ double insphere(const double * pa,
                 const double * pc,
                 const double * pd,
                 const double * pe);
-#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Batched orient2d/orient3d: res[i] is the orientation of the i-th points of the
+ * input arrays, which store n points each, with interleaved coordinates (e.g.
+ * pa[3*i], pa[3*i+1], pa[3*i+2] for orient3d). Determinants and error bounds are
+ * computed by a branch free loop, which the compiler vectorizes. Exact evaluations
+ * (if CINOLIB_USES_SHEWCHUK_PREDICATES is defined) are done afterwards, only for
+ * the queries whose filter failed.
+*/
+
+CINO_INLINE
+void orient2d_batch(const double * pa,
+                    const double * pb,
+                    const double * pc,
+                    const uint     n,
+                          double * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void orient3d_batch(const double * pa,
+                    const double * pb,
+                    const double * pc,
+                    const double * pd,
+                    const uint     n,
+                          double * res);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
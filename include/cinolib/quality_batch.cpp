@@ -0,0 +1,246 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/quality_batch.h>
+#include <cinolib/simd.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+namespace
+{
+
+CINO_INLINE
+dvec determinant(const dvec3 & col0, const dvec3 & col1, const dvec3 & col2)
+{
+    return col0.dot(col1.cross(col2));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// see tet_scaled_jacobian() in quality_tet.cpp
+CINO_INLINE
+dvec tet_scaled_jacobian_kernel(const dvec3 * p)
+{
+    dvec3 L0 = p[1] - p[0];
+    dvec3 L1 = p[2] - p[1];
+    dvec3 L2 = p[0] - p[2];
+    dvec3 L3 = p[3] - p[0];
+    dvec3 L4 = p[3] - p[1];
+    dvec3 L5 = p[3] - p[2];
+
+    dvec L0_length = L0.norm();
+    dvec L1_length = L1.norm();
+    dvec L2_length = L2.norm();
+    dvec L3_length = L3.norm();
+    dvec L4_length = L4.norm();
+    dvec L5_length = L5.norm();
+
+    dvec J = (L2.cross(L0)).dot(L3);
+
+    dvec lambda_max = L0_length * L2_length * L3_length;
+    lambda_max = max(lambda_max, L0_length * L1_length * L4_length);
+    lambda_max = max(lambda_max, L1_length * L2_length * L5_length);
+    lambda_max = max(lambda_max, L3_length * L4_length * L5_length);
+    lambda_max = max(lambda_max, J);
+
+    return J * dvec(1.414213562373095) / lambda_max;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// see tet_volume() in quality_tet.cpp
+CINO_INLINE
+dvec tet_volume_kernel(const dvec3 * p)
+{
+    dvec3 L0 = p[1] - p[0];
+    dvec3 L2 = p[0] - p[2];
+    dvec3 L3 = p[3] - p[0];
+
+    return (L2.cross(L0)).dot(L3) / dvec(6.0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// see hex_principal_axes() in quality_hex.cpp
+CINO_INLINE
+void hex_principal_axes_kernel(const dvec3 * p, dvec3 X[], const bool normalized)
+{
+    X[0] = (p[1] - p[0]) + (p[2] - p[3]) + (p[5] - p[4]) + (p[6] - p[7]);
+    X[1] = (p[3] - p[0]) + (p[2] - p[1]) + (p[7] - p[4]) + (p[6] - p[5]);
+    X[2] = (p[4] - p[0]) + (p[5] - p[1]) + (p[6] - p[2]) + (p[7] - p[3]);
+
+    if(normalized) for(int i=0; i<3; ++i) X[i].normalize();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// see hex_scaled_jacobian() in quality_hex.cpp
+CINO_INLINE
+dvec hex_scaled_jacobian_kernel(const dvec3 * p)
+{
+    dvec3 L[12];
+    L[0] = p[1] - p[0];    L[4] = p[4] - p[0];    L[8]  = p[5] - p[4];
+    L[1] = p[2] - p[1];    L[5] = p[5] - p[1];    L[9]  = p[6] - p[5];
+    L[2] = p[3] - p[2];    L[6] = p[6] - p[2];    L[10] = p[7] - p[6];
+    L[3] = p[3] - p[0];    L[7] = p[7] - p[3];    L[11] = p[7] - p[4];
+    for(int i=0; i<12; ++i) L[i].normalize();
+
+    dvec3 X[3];
+    hex_principal_axes_kernel(p, X, true);
+
+    dvec msj =         determinant( L[0],   L[3],   L[4]);
+    msj = min(msj, determinant( L[1],  -L[0],   L[5]));
+    msj = min(msj, determinant( L[2],  -L[1],   L[6]));
+    msj = min(msj, determinant(-L[3],  -L[2],   L[7]));
+    msj = min(msj, determinant( L[11],  L[8],  -L[4]));
+    msj = min(msj, determinant(-L[8],   L[9],  -L[5]));
+    msj = min(msj, determinant(-L[9],   L[10], -L[6]));
+    msj = min(msj, determinant(-L[10], -L[11], -L[7]));
+    msj = min(msj, determinant( X[0],   X[1],   X[2]));
+
+    return select(msj > dvec(1.0001), dvec(-1.0), msj);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// see hex_volume() in quality_hex.cpp
+CINO_INLINE
+dvec hex_volume_kernel(const dvec3 * p)
+{
+    dvec3 X[3];
+    hex_principal_axes_kernel(p, X, false);
+    return determinant(X[0],X[1],X[2]) / dvec(64.0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// gathers the N corners of W elements at a time in SoA blocks, and evaluates
+// the kernel on them. If n is not a multiple of W, the last block is padded
+// replicating its last element
+template<uint N, dvec (*kernel)(const dvec3 *), class T>
+CINO_INLINE
+void batch_eval(const mat<3,1,T> * verts,
+                const uint       * ids,
+                const uint         n,
+                      double     * res)
+{
+    const uint W = dvec::W;
+    uint n_blocks = (n+W-1)/W;
+    PARALLEL_FOR(0, n_blocks, 256, [&](uint b)
+    {
+        double x[N][W], y[N][W], z[N][W];
+        for(uint l=0; l<W; ++l)
+        {
+            const uint * e = ids + N*std::min(b*W+l, n-1);
+            for(uint k=0; k<N; ++k)
+            {
+                const mat<3,1,T> & v = verts[e[k]];
+                x[k][l] = v[0];
+                y[k][l] = v[1];
+                z[k][l] = v[2];
+            }
+        }
+        dvec3 p[N];
+        for(uint k=0; k<N; ++k)
+        {
+            p[k] = dvec3::load(x[k], y[k], z[k]);
+        }
+        if(b*W+W <= n)
+        {
+            kernel(p).store(res + b*W);
+        }
+        else
+        {
+            double tmp[W];
+            kernel(p).store(tmp);
+            std::copy(tmp, tmp+(n-b*W), res+b*W);
+        }
+    });
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void tet_scaled_jacobian_batch(const mat<3,1,T> * verts,
+                               const uint       * tets,
+                               const uint         n,
+                                     double     * res)
+{
+    batch_eval<4,tet_scaled_jacobian_kernel>(verts, tets, n, res);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void tet_volume_batch(const mat<3,1,T> * verts,
+                      const uint       * tets,
+                      const uint         n,
+                            double     * res)
+{
+    batch_eval<4,tet_volume_kernel>(verts, tets, n, res);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void hex_scaled_jacobian_batch(const mat<3,1,T> * verts,
+                               const uint       * hexa,
+                               const uint         n,
+                                     double     * res)
+{
+    batch_eval<8,hex_scaled_jacobian_kernel>(verts, hexa, n, res);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void hex_volume_batch(const mat<3,1,T> * verts,
+                      const uint       * hexa,
+                      const uint         n,
+                            double     * res)
+{
+    batch_eval<8,hex_volume_kernel>(verts, hexa, n, res);
+}
+
+}
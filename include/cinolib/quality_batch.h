@@ -0,0 +1,98 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_QUALITY_BATCH_H
+#define CINO_QUALITY_BATCH_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+/* Batched versions of the element metrics in quality_tet.h and quality_hex.h,
+ * meant for loops that evaluate the quality of many elements at once (e.g. the
+ * update of all the per element qualities of a mesh, or hex mesh optimization).
+ *
+ * Elements are given as a list of vertices and a flat list of corners (4 vertex
+ * ids per tet, 8 per hex, in the same order expected by the single element
+ * functions). Corner coordinates are gathered in SoA blocks of dvec::W elements
+ * (see simd.h), so that each SIMD instruction processes W elements at once.
+ * Results are written in res[0...n-1] and coincide with the ones of the single
+ * element functions (unless the compiler contracts the scalar code in fused
+ * multiply-adds, e.g. with -mfma). Long lists are split among multiple threads.
+*/
+
+template<class T>
+CINO_INLINE
+void tet_scaled_jacobian_batch(const mat<3,1,T> * verts,
+                               const uint       * tets,
+                               const uint         n,
+                                     double     * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void tet_volume_batch(const mat<3,1,T> * verts,
+                      const uint       * tets,
+                      const uint         n,
+                            double     * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void hex_scaled_jacobian_batch(const mat<3,1,T> * verts,
+                               const uint       * hexa,
+                               const uint         n,
+                                     double     * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void hex_volume_batch(const mat<3,1,T> * verts,
+                      const uint       * hexa,
+                      const uint         n,
+                            double     * res);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "quality_batch.cpp"
+#endif
+
+#endif // CINO_QUALITY_BATCH_H
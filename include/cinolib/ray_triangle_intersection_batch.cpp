@@ -0,0 +1,331 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/ray_triangle_intersection_batch.h>
+#include <cinolib/simd.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void TriangleSoA::clear()
+{
+    data.clear();
+    n = 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TriangleSoA::push_back(const vec3d & v0, const vec3d & v1, const vec3d & v2)
+{
+    const uint W = dvec::W;
+    if(n%W==0) data.resize(data.size()+9*W, 0.0);
+    double *p = data.data() + (n/W)*9*W + n%W;
+    const vec3d * v[3] = { &v0, &v1, &v2 };
+    for(uint i=0; i<3; ++i)
+    for(uint j=0; j<3; ++j)
+    {
+        p[(3*i+j)*W] = (*v[i])[j];
+    }
+    ++n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint TriangleSoA::num_blocks() const
+{
+    return (n+dvec::W-1)/dvec::W;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const double * TriangleSoA::block(const uint b) const
+{
+    return data.data() + b*9*dvec::W;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+// same as: Moller_Trumbore_intersection(o,d,v0,v1,v2,...) && t>=0
+// (see Moller_Trumbore_intersection.cpp)
+CINO_INLINE
+dmask Moller_Trumbore_kernel(const dvec3 & o,
+                             const dvec3 & d,
+                             const dvec3 & v0,
+                             const dvec3 & v1,
+                             const dvec3 & v2,
+                                   dvec  & t)
+{
+    const dvec zero(0.0), one(1.0);
+
+    dvec3 e0   = v1 - v0;
+    dvec3 e1   = v2 - v0;
+    dvec3 pvec = d.cross(e1);
+    dvec  det  = e0.dot(pvec);
+    dmask hit  = ~(max(det,-det) < dvec(0.0000001)); // coplanar
+
+    dvec invDet = one/det;
+
+    dvec3 tvec = o - v0;
+    dvec  b1   = tvec.dot(pvec) * invDet;
+    hit = hit & ~((b1 < zero) | (b1 > one));
+
+    dvec3 qvec = tvec.cross(e0);
+    dvec  b2   = d.dot(qvec) * invDet;
+    dvec  b0   = b2 + b1;
+    hit = hit & ~((b2 < zero) | (b0 > one));
+
+    t = e1.dot(qvec) * invDet;
+    return hit & (t >= zero);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// watertight test of Woop et al. A, B and C are the triangle vertices
+// relative to the ray origin, with coordinates permuted so that the z
+// axis is the dominant axis of the ray, and S contains the shear (see
+// watertight_setup)
+CINO_INLINE
+dmask watertight_kernel(const dvec3 & A,
+                        const dvec3 & B,
+                        const dvec3 & C,
+                        const dvec3 & S,
+                              dvec  & t)
+{
+    const dvec zero(0.0);
+
+    dvec Ax = A.x - S.x*A.z;
+    dvec Ay = A.y - S.y*A.z;
+    dvec Bx = B.x - S.x*B.z;
+    dvec By = B.y - S.y*B.z;
+    dvec Cx = C.x - S.x*C.z;
+    dvec Cy = C.y - S.y*C.z;
+
+    // scaled barycentric coordinates (i.e. edge tests)
+    dvec U = Cx*By - Cy*Bx;
+    dvec V = Ax*Cy - Ay*Cx;
+    dvec W = Bx*Ay - By*Ax;
+
+    dmask some_neg = (U < zero) | (V < zero) | (W < zero);
+    dmask some_pos = (U > zero) | (V > zero) | (W > zero);
+    dvec  det      = U + V + W;
+    dmask hit      = ~(some_neg & some_pos) & ((det < zero) | (det > zero));
+
+    t = (U*(S.z*A.z) + V*(S.z*B.z) + W*(S.z*C.z)) / det;
+    return hit & (t >= zero);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// k is the permutation that moves the dominant axis of the ray in the
+// last position (preserving the winding), S the shear that maps the
+// ray direction to the z axis
+CINO_INLINE
+void watertight_setup(const vec3d & dir, uint k[3], double S[3])
+{
+    uint kz = 0;
+    if(std::fabs(dir[1]) > std::fabs(dir[kz])) kz = 1;
+    if(std::fabs(dir[2]) > std::fabs(dir[kz])) kz = 2;
+    uint kx = (kz+1)%3;
+    uint ky = (kx+1)%3;
+    if(dir[kz]<0) std::swap(kx,ky);
+
+    k[0] = kx;
+    k[1] = ky;
+    k[2] = kz;
+    S[0] = dir[kx]/dir[kz];
+    S[1] = dir[ky]/dir[kz];
+    S[2] = 1.0/dir[kz];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<bool watertight>
+CINO_INLINE
+void one_ray_many_triangles(const vec3d                         & ray_orig,
+                            const vec3d                         & ray_dir,
+                            const TriangleSoA                   & tris,
+                            std::vector<std::pair<double,uint>> & hits)
+{
+    const uint W = dvec::W;
+
+    uint   k[3] = { 0, 1, 2 };
+    double S[3];
+    if(watertight) watertight_setup(ray_dir, k, S);
+
+    dvec3 o = { dvec(ray_orig[k[0]]), dvec(ray_orig[k[1]]), dvec(ray_orig[k[2]]) };
+    dvec3 d = watertight ? dvec3{ dvec(S[0]), dvec(S[1]), dvec(S[2]) }
+                         : dvec3{ dvec(ray_dir[0]), dvec(ray_dir[1]), dvec(ray_dir[2]) };
+
+    for(uint b=0; b<tris.num_blocks(); ++b)
+    {
+        const double *p = tris.block(b);
+        dvec3 v[3];
+        for(uint i=0; i<3; ++i)
+        {
+            v[i] = dvec3::load(p+(3*i+k[0])*W, p+(3*i+k[1])*W, p+(3*i+k[2])*W);
+        }
+
+        dvec t;
+        int mask = watertight ? bits(watertight_kernel(v[0]-o, v[1]-o, v[2]-o, d, t))
+                              : bits(Moller_Trumbore_kernel(o, d, v[0], v[1], v[2], t));
+        if(mask==0) continue;
+
+        double tt[W];
+        t.store(tt);
+        for(uint l=0; l<W; ++l)
+        {
+            uint i = b*W+l;
+            if((mask & (1<<l)) && i<tris.size()) hits.push_back(std::make_pair(tt[l],i));
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<bool watertight>
+CINO_INLINE
+void many_rays_one_triangle(const vec3d  * ray_orig,
+                            const vec3d  * ray_dir,
+                            const uint     n,
+                            const vec3d    v[3],
+                                  double * t)
+{
+    const uint W = dvec::W;
+    uint n_blocks = (n+W-1)/W;
+    PARALLEL_FOR(0, n_blocks, 256, [&](uint b)
+    {
+        // gather the rays in SoA form. If n is not a multiple
+        // of W the last block is padded replicating its last ray
+        double o[3][W], d[3][W], p[3][3][W];
+        for(uint l=0; l<W; ++l)
+        {
+            uint r = std::min(b*W+l, n-1);
+            if(watertight)
+            {
+                uint   k[3];
+                double S[3];
+                watertight_setup(ray_dir[r], k, S);
+                for(uint j=0; j<3; ++j)
+                {
+                    o[j][l] = ray_orig[r][k[j]];
+                    d[j][l] = S[j];
+                    for(uint i=0; i<3; ++i) p[i][j][l] = v[i][k[j]];
+                }
+            }
+            else
+            {
+                for(uint j=0; j<3; ++j)
+                {
+                    o[j][l] = ray_orig[r][j];
+                    d[j][l] = ray_dir[r][j];
+                }
+            }
+        }
+
+        dvec3 O = dvec3::load(o[0], o[1], o[2]);
+        dvec3 D = dvec3::load(d[0], d[1], d[2]);
+
+        dvec  tt;
+        dmask hit;
+        if(watertight)
+        {
+            hit = watertight_kernel(dvec3::load(p[0][0], p[0][1], p[0][2]) - O,
+                                    dvec3::load(p[1][0], p[1][1], p[1][2]) - O,
+                                    dvec3::load(p[2][0], p[2][1], p[2][2]) - O, D, tt);
+        }
+        else
+        {
+            dvec3 V[3];
+            for(uint i=0; i<3; ++i) V[i] = { dvec(v[i][0]), dvec(v[i][1]), dvec(v[i][2]) };
+            hit = Moller_Trumbore_kernel(O, D, V[0], V[1], V[2], tt);
+        }
+        tt = select(hit, tt, dvec(inf_double));
+
+        if(b*W+W <= n)
+        {
+            tt.store(t + b*W);
+        }
+        else
+        {
+            double tmp[W];
+            tt.store(tmp);
+            std::copy(tmp, tmp+(n-b*W), t+b*W);
+        }
+    });
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ray_triangle_intersection_batch(const vec3d                         & ray_orig,
+                                     const vec3d                         & ray_dir,
+                                     const TriangleSoA                   & tris,
+                                     std::vector<std::pair<double,uint>> & hits,
+                                     const bool                            watertight)
+{
+    if(watertight) one_ray_many_triangles<true> (ray_orig, ray_dir, tris, hits);
+    else           one_ray_many_triangles<false>(ray_orig, ray_dir, tris, hits);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ray_triangle_intersection_batch(const vec3d  * ray_orig,
+                                     const vec3d  * ray_dir,
+                                     const uint     n,
+                                     const vec3d  & v0,
+                                     const vec3d  & v1,
+                                     const vec3d  & v2,
+                                           double * t,
+                                     const bool     watertight)
+{
+    const vec3d v[3] = { v0, v1, v2 };
+    if(watertight) many_rays_one_triangle<true> (ray_orig, ray_dir, n, v, t);
+    else           many_rays_one_triangle<false>(ray_orig, ray_dir, n, v, t);
+}
+
+}
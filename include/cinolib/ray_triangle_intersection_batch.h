@@ -0,0 +1,129 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RAY_TRIANGLE_INTERSECTION_BATCH_H
+#define CINO_RAY_TRIANGLE_INTERSECTION_BATCH_H
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <vector>
+
+namespace cinolib
+{
+
+/* Batched versions of ray_triangle_intersection, meant for the many ray/triangle
+ * tests of spatial queries (e.g. the leaves of an Octree), picking, ambient occlusion
+ * or overhang detection. There are two flavours: one ray against many triangles, and
+ * many rays against one triangle. In both cases the data are arranged in SoA blocks
+ * of dvec::W elements (see simd.h), so that each SIMD instruction processes W tests.
+ *
+ * Intersections are computed in one of two ways:
+ *
+ *  - Moller-Trumbore (default). Results coincide with the ones of the single ray/triangle
+ *    functions (Moller_Trumbore_intersection followed by t>=0), hence rays passing through
+ *    an edge or a vertex shared by multiple triangles may miss all of them due to roundoff
+ *
+ *  - watertight, as described in
+ *
+ *        Watertight Ray/Triangle Intersection
+ *        S.Woop, C.Benthin, I.Wald
+ *        Journal of Computer Graphics Techniques, 2013
+ *
+ *    here the coordinates of each vertex are transformed in a ray-specific reference
+ *    frame in the very same way for all the triangles incident to it, and the edge tests
+ *    of two triangles sharing an edge are the exact opposite of each other. Therefore, a
+ *    ray passing through an edge (or vertex) hits at least one of its incident triangles.
+ *    This holds as long as the compiler does not contract the arithmetic in fused
+ *    multiply-adds (e.g. -ffp-contract=off when compiling with -mfma)
+ *
+ * In both cases triangles coplanar to the ray are not reported, and only intersections
+ * along the ray (i.e. at t>=0, with P = ray_orig + t * ray_dir) are considered.
+*/
+
+// a list of triangles, stored in SoA blocks of dvec::W triangles each.
+// Each block contains 9*W doubles, that is: the x, y and z coordinates of
+// the first vertex of the W triangles, then those of the second and third
+// vertices. Unused slots in the last block are filled with degenerate
+// triangles, which are never hit by any ray
+class TriangleSoA
+{
+    public:
+
+        void clear();
+        void push_back(const vec3d & v0, const vec3d & v1, const vec3d & v2);
+
+        uint size      () const { return n; }
+        uint num_blocks() const;
+
+        const double * block(const uint b) const;
+
+    protected:
+
+        std::vector<double> data;
+        uint n = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// one ray against many triangles. For each hit, a pair (t,i) is appended
+// to the list of hits, where i is the index of the triangle in tris
+CINO_INLINE
+void ray_triangle_intersection_batch(const vec3d                         & ray_orig,
+                                     const vec3d                         & ray_dir,
+                                     const TriangleSoA                   & tris,
+                                     std::vector<std::pair<double,uint>> & hits,
+                                     const bool                            watertight = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// many rays against one triangle. For each ray i, t[i] is the parameter of the
+// intersection point, or inf_double if the ray misses the triangle. Long lists
+// of rays are split among multiple threads
+CINO_INLINE
+void ray_triangle_intersection_batch(const vec3d  * ray_orig,
+                                     const vec3d  * ray_dir,
+                                     const uint     n,
+                                     const vec3d  & v0,
+                                     const vec3d  & v1,
+                                     const vec3d  & v2,
+                                           double * t,
+                                     const bool     watertight = false);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ray_triangle_intersection_batch.cpp"
+#endif
+
+#endif // CINO_RAY_TRIANGLE_INTERSECTION_BATCH_H
@@ -35,19 +35,42 @@
 *********************************************************************************/
 #include <cinolib/segment_insertion_linear_earcut.h>
 #include <cinolib/predicates.h>
+#include <cinolib/implicit_point.h>
+#include <numeric>
 
 namespace cinolib
 {
 
+namespace
+{
+
 template<class vec>
 CINO_INLINE
-void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
-                                           std::vector<uint> & tris)
+double ear_orient(const vec & a, const vec & b, const vec & c)
 {
-    assert(poly.size()>=3);
+    return orient2d(a.ptr(), b.ptr(), c.ptr());
+}
+
+// implicit points (e.g. the intersection points of a mesh arrangement) are
+// tested with exact implicit predicates, on the XY plane (see implicit_point.h)
+CINO_INLINE
+double ear_orient(const ImplicitPoint & a, const ImplicitPoint & b, const ImplicitPoint & c)
+{
+    return orient2d(a, b, c);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// orient(i,j,k) is the orientation of the i-th, j-th and k-th polygon vertices
+template<class Orient>
+CINO_INLINE
+void linear_earcut(const uint                size,
+                   const Orient            & orient,
+                         std::vector<uint> & tris)
+{
+    assert(size>=3);
 
     // doubly linked list for fast polygon inspection
-    uint size = poly.size();
     std::vector<uint> prev(size);
     std::vector<uint> next(size);
     std::iota(prev.begin(), prev.end(),-1);
@@ -69,9 +92,7 @@ void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
     {
         // NOTE: the polygon may contain dangling edges,
         // clause prev!=next avoids to even do the ear test for them
-        if(prev!=next && orient2d(poly.at(prev[curr]).ptr(),
-                                  poly.at(curr).ptr(),
-                                  poly.at(next[curr]).ptr())>0)
+        if(prev!=next && orient(prev[curr], curr, next[curr])>0)
         {
             ears.emplace_back(curr);
             is_ear.at(curr) = true;
@@ -100,9 +121,7 @@ void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
         // check if prev and next have become new ears
         if(!is_ear.at(prev[curr]) && prev[curr]!=0)
         {
-            if(prev[prev[curr]]!=next[curr] && orient2d(poly.at(prev[prev[curr]]).ptr(),
-                                                        poly.at(prev[curr]).ptr(),
-                                                        poly.at(next[curr]).ptr())>0)
+            if(prev[prev[curr]]!=next[curr] && orient(prev[prev[curr]], prev[curr], next[curr])>0)
             {
                 ears.emplace_back(prev[curr]);
                 is_ear.at(prev[curr]) = true;
@@ -110,9 +129,7 @@ void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
         }
         if(!is_ear.at(next[curr]) && next[curr]<size-1)
         {
-            if(next[next[curr]]!=prev[curr] && orient2d(poly.at(prev[curr]).ptr(),
-                                                        poly.at(next[curr]).ptr(),
-                                                        poly.at(next[next[curr]]).ptr())>0)
+            if(next[next[curr]]!=prev[curr] && orient(prev[curr], next[curr], next[next[curr]])>0)
             {
                 ears.emplace_back(next[curr]);
                 is_ear.at(next[curr]) = true;
@@ -122,3 +139,33 @@ void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
 }
 
 }
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class vec>
+CINO_INLINE
+void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
+                                           std::vector<uint> & tris)
+{
+    linear_earcut(poly.size(), [&](const uint i, const uint j, const uint k)
+    {
+        return ear_orient(poly.at(i), poly.at(j), poly.at(k));
+    },
+    tris);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void segment_insertion_linear_earcut(const std::vector<ImplicitPoint> & poly,
+                                           std::vector<uint>          & tris,
+                                     const uint                         drop_axis)
+{
+    linear_earcut(poly.size(), [&](const uint i, const uint j, const uint k)
+    {
+        return orient2d(poly.at(i), poly.at(j), poly.at(k), drop_axis);
+    },
+    tris);
+}
+
+}
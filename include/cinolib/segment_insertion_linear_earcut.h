@@ -39,6 +39,7 @@
 #include <sys/types.h>
 #include <vector>
 #include <cinolib/cino_inline.h>
+#include <cinolib/implicit_point.h>
 
 namespace cinolib
 {
@@ -56,12 +57,25 @@ namespace cinolib
  *     Deterministic Linear Time Constrained Triangulation using Simplified Earcut
  *     Marco Livesu, Gianmarco Cherchi, Riccardo Scateni, Marco Attene
  *     IEEE Transactions on Visualization and Computer Graphics, 2021
+ *
+ * The polygon can be made of vec2d, vec3d (projected on XY) or ImplicitPoint
+ * (see implicit_point.h). In the latter case all the orientation tests are
+ * exact, even for vertices that were constructed as intersection points.
 */
 
 template<class vec>
 CINO_INLINE
 void segment_insertion_linear_earcut(const std::vector<vec>  & poly,
                                            std::vector<uint> & tris);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polygon of implicit points lying on a common plane, which is projected on the
+// coordinate plane orthogonal to drop_axis (see orient2d in implicit_point.h)
+CINO_INLINE
+void segment_insertion_linear_earcut(const std::vector<ImplicitPoint> & poly,
+                                           std::vector<uint>          & tris,
+                                     const uint                         drop_axis);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -48,13 +48,16 @@ namespace cinolib
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const uint root, std::vector<bool> & tree)
+void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m,
+                        const uint                     root,
+                        std::vector<bool>            & tree,
+                        const SSSPMethod               method)
 {
     // if true, the edge is on the tree
     tree = std::vector<bool>(m.num_edges(), false);
 
     std::vector<double> dist;
-    dijkstra_exhaustive(m, root, dist);
+    shortest_paths_exhaustive(m, {root}, dist, method);
 
     for(uint vid=0; vid<m.num_verts(); ++vid)
     {
@@ -37,6 +37,7 @@
 #define CINO_SHORTEST_PATH_TREE_H
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/delta_stepping.h>
 
 namespace cinolib
 {
@@ -46,11 +47,17 @@ namespace cinolib
  * compute point to point distances, and generates the tree as described in
  *
  * https://en.wikipedia.org/wiki/Shortest-path_tree
+ *
+ * Distances from the root can be computed either with the serial Dijkstra, or
+ * with the parallel delta-stepping (see delta_stepping.h). Both give the same tree.
 */
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const uint root, std::vector<bool> & tree);
+void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m,
+                        const uint                     root,
+                        std::vector<bool>            & tree,
+                        const SSSPMethod               method = SSSP_DIJKSTRA);
 
 }
 
@@ -0,0 +1,221 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SIMD_H
+#define CINO_SIMD_H
+
+#include <sys/types.h>
+#include <cmath>
+
+/* Detection of the SIMD instruction sets available on the target.
+ * SSE2 is part of any x86-64 target, AVX is enabled by compiler flags
+ * (e.g. -mavx, see the option CINOLIB_USES_AVX in cinolib-config.cmake).
+ * Defining the symbol CINOLIB_NO_SIMD disables all SIMD code paths.
+*/
+
+#if !defined(CINOLIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CINO_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define CINO_SIMD_AVX
+#include <immintrin.h>
+#endif
+#endif
+
+namespace cinolib
+{
+
+/* Minimal wrapper around the widest SIMD register of the target, used to write
+ * batched kernels (e.g. element quality, ray-triangle tests) that process several
+ * elements at once, with their data stored in SoA blocks (i.e. one array for each
+ * coordinate). A dvec holds dvec::W doubles: 4 with AVX, 2 with SSE2, 1 otherwise.
+ * Comparisons return a dmask, that can be combined with &, | and ~, used to blend
+ * vectors with select(), or converted to a bit mask (one bit per lane) with bits().
+ * A dvec3 holds W 3D vectors, one per lane.
+ *
+ * Example (lane-wise normalization of W 3D vectors stored in x[], y[] and z[]):
+ *
+ *  dvec vx = dvec::load(x), vy = dvec::load(y), vz = dvec::load(z);
+ *  dvec l  = sqrt(vx*vx + vy*vy + vz*vz);
+ *  l = select(l > dvec(0.0), l, dvec(1.0));
+ *  (vx/l).store(x); (vy/l).store(y); (vz/l).store(z);
+*/
+
+#if defined(CINO_SIMD_AVX)
+
+struct dmask
+{
+    __m256d m;
+    friend dmask operator&(const dmask & a, const dmask & b) { return { _mm256_and_pd(a.m, b.m) }; }
+    friend dmask operator|(const dmask & a, const dmask & b) { return { _mm256_or_pd (a.m, b.m) }; }
+    friend dmask operator~(const dmask & a)                  { return { _mm256_xor_pd(a.m, _mm256_cmp_pd(a.m, a.m, _CMP_TRUE_UQ)) }; }
+    friend int   bits     (const dmask & a)                  { return _mm256_movemask_pd(a.m);    }
+};
+
+struct dvec
+{
+    static const uint W = 4;
+    __m256d v;
+    dvec() {}
+    dvec(const __m256d & v) : v(v) {}
+    explicit dvec(const double s) : v(_mm256_set1_pd(s)) {}
+    static dvec load (const double * p)       { return _mm256_loadu_pd(p); }
+           void store(      double * p) const { _mm256_storeu_pd(p, v);     }
+    friend dvec  operator+(const dvec & a, const dvec & b) { return _mm256_add_pd(a.v, b.v); }
+    friend dvec  operator-(const dvec & a, const dvec & b) { return _mm256_sub_pd(a.v, b.v); }
+    friend dvec  operator*(const dvec & a, const dvec & b) { return _mm256_mul_pd(a.v, b.v); }
+    friend dvec  operator/(const dvec & a, const dvec & b) { return _mm256_div_pd(a.v, b.v); }
+    friend dvec  operator-(const dvec & a)                 { return _mm256_sub_pd(_mm256_setzero_pd(), a.v); }
+    friend dvec  sqrt     (const dvec & a)                 { return _mm256_sqrt_pd(a.v);     }
+    friend dvec  min      (const dvec & a, const dvec & b) { return _mm256_min_pd(a.v, b.v); }
+    friend dvec  max      (const dvec & a, const dvec & b) { return _mm256_max_pd(a.v, b.v); }
+    friend dmask operator<(const dvec & a, const dvec & b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+    friend dmask operator>(const dvec & a, const dvec & b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+    friend dmask operator<=(const dvec & a, const dvec & b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+    friend dmask operator>=(const dvec & a, const dvec & b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+    friend dvec  select(const dmask & m, const dvec & a, const dvec & b) { return _mm256_blendv_pd(b.v, a.v, m.m); }
+};
+
+#elif defined(CINO_SIMD_SSE2)
+
+struct dmask
+{
+    __m128d m;
+    friend dmask operator&(const dmask & a, const dmask & b) { return { _mm_and_pd(a.m, b.m) }; }
+    friend dmask operator|(const dmask & a, const dmask & b) { return { _mm_or_pd (a.m, b.m) }; }
+    friend dmask operator~(const dmask & a)                  { return { _mm_xor_pd(a.m, _mm_castsi128_pd(_mm_set1_epi32(-1))) }; }
+    friend int   bits     (const dmask & a)                  { return _mm_movemask_pd(a.m);    }
+};
+
+struct dvec
+{
+    static const uint W = 2;
+    __m128d v;
+    dvec() {}
+    dvec(const __m128d & v) : v(v) {}
+    explicit dvec(const double s) : v(_mm_set1_pd(s)) {}
+    static dvec load (const double * p)       { return _mm_loadu_pd(p); }
+           void store(      double * p) const { _mm_storeu_pd(p, v);     }
+    friend dvec  operator+(const dvec & a, const dvec & b) { return _mm_add_pd(a.v, b.v); }
+    friend dvec  operator-(const dvec & a, const dvec & b) { return _mm_sub_pd(a.v, b.v); }
+    friend dvec  operator*(const dvec & a, const dvec & b) { return _mm_mul_pd(a.v, b.v); }
+    friend dvec  operator/(const dvec & a, const dvec & b) { return _mm_div_pd(a.v, b.v); }
+    friend dvec  operator-(const dvec & a)                 { return _mm_sub_pd(_mm_setzero_pd(), a.v); }
+    friend dvec  sqrt     (const dvec & a)                 { return _mm_sqrt_pd(a.v);     }
+    friend dvec  min      (const dvec & a, const dvec & b) { return _mm_min_pd(a.v, b.v); }
+    friend dvec  max      (const dvec & a, const dvec & b) { return _mm_max_pd(a.v, b.v); }
+    friend dmask operator<(const dvec & a, const dvec & b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+    friend dmask operator>(const dvec & a, const dvec & b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+    friend dmask operator<=(const dvec & a, const dvec & b) { return { _mm_cmple_pd(a.v, b.v) }; }
+    friend dmask operator>=(const dvec & a, const dvec & b) { return { _mm_cmpge_pd(a.v, b.v) }; }
+    friend dvec  select(const dmask & m, const dvec & a, const dvec & b) { return _mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v)); }
+};
+
+#else
+
+struct dmask
+{
+    bool m;
+    friend dmask operator&(const dmask & a, const dmask & b) { return { a.m && b.m }; }
+    friend dmask operator|(const dmask & a, const dmask & b) { return { a.m || b.m }; }
+    friend dmask operator~(const dmask & a)                  { return { !a.m };        }
+    friend int   bits     (const dmask & a)                  { return a.m ? 1 : 0;     }
+};
+
+struct dvec
+{
+    static const uint W = 1;
+    double v;
+    dvec() {}
+    explicit dvec(const double s) : v(s) {}
+    static dvec load (const double * p)       { return dvec(*p); }
+           void store(      double * p) const { *p = v;          }
+    friend dvec  operator+(const dvec & a, const dvec & b) { return dvec(a.v + b.v); }
+    friend dvec  operator-(const dvec & a, const dvec & b) { return dvec(a.v - b.v); }
+    friend dvec  operator*(const dvec & a, const dvec & b) { return dvec(a.v * b.v); }
+    friend dvec  operator/(const dvec & a, const dvec & b) { return dvec(a.v / b.v); }
+    friend dvec  operator-(const dvec & a)                 { return dvec(-a.v);      }
+    friend dvec  sqrt     (const dvec & a)                 { return dvec(std::sqrt(a.v)); }
+    friend dvec  min      (const dvec & a, const dvec & b) { return dvec(a.v < b.v ? a.v : b.v); }
+    friend dvec  max      (const dvec & a, const dvec & b) { return dvec(a.v > b.v ? a.v : b.v); }
+    friend dmask operator<(const dvec & a, const dvec & b) { return { a.v <  b.v }; }
+    friend dmask operator>(const dvec & a, const dvec & b) { return { a.v >  b.v }; }
+    friend dmask operator<=(const dvec & a, const dvec & b) { return { a.v <= b.v }; }
+    friend dmask operator>=(const dvec & a, const dvec & b) { return { a.v >= b.v }; }
+    friend dvec  select(const dmask & m, const dvec & a, const dvec & b) { return m.m ? a : b; }
+};
+
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// W 3D vectors, one per lane. Operations are done in the same order
+// of the corresponding operations on vec3d (see vec_mat_utils.h)
+struct dvec3
+{
+    dvec x, y, z;
+
+    static dvec3 load(const double * x, const double * y, const double * z)
+    {
+        return { dvec::load(x), dvec::load(y), dvec::load(z) };
+    }
+
+    dvec3 operator+(const dvec3 & v) const { return { x+v.x, y+v.y, z+v.z }; }
+    dvec3 operator-(const dvec3 & v) const { return { x-v.x, y-v.y, z-v.z }; }
+    dvec3 operator-()                const { return { -x, -y, -z }; }
+
+    dvec  dot  (const dvec3 & v) const { return x*v.x + y*v.y + z*v.z; }
+    dvec  norm ()                const { return sqrt(dot(*this)); }
+    dvec3 cross(const dvec3 & v) const
+    {
+        return { y*v.z - z*v.y,
+                 z*v.x - x*v.z,
+                 x*v.y - y*v.x };
+    }
+
+    // same as: if(!v.is_null()) v.normalize();
+    void normalize()
+    {
+        dvec n = norm();
+        n = select(n > dvec(0.0), n, dvec(1.0));
+        x = x/n;
+        y = y/n;
+        z = z/n;
+    }
+};
+
+}
+
+#endif // CINO_SIMD_H
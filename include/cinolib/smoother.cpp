@@ -224,6 +224,9 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     };
 
     // SMOOTHING ITERATIONS
+    // (the system matrix changes at each iteration, but its pattern does not:
+    //  the cache reuses its symbolic analysis, and only refactorizes numerically)
+    FactorizationCache cache(1);
     for(uint i=0; i<opt.n_iters; ++i)
     {
         laplacian();
@@ -243,7 +246,7 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
         Eigen::VectorXd RHS = Eigen::Map<Eigen::VectorXd>(rhs.data(), rhs.size());
         Eigen::VectorXd W   = Eigen::Map<Eigen::VectorXd>(w.data(), w.size());
         Eigen::VectorXd res;
-        solve_weighted_least_squares(A, W, RHS, res);
+        solve_weighted_least_squares(A, W, RHS, res, cache);
 
         uint nv = m.num_verts();
         for(uint vid=0; vid<nv; ++vid)
@@ -0,0 +1,95 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/sparse_matrix_assembly.h>
+#include <cinolib/parallel_for.h>
+
+namespace cinolib
+{
+
+template<typename T, int Options, typename Func>
+CINO_INLINE
+void sparse_alloc(Eigen::SparseMatrix<T,Options> & A,
+                  const uint                       rows,
+                  const uint                       cols,
+                  const Func                     & outer_size)
+{
+    typedef typename Eigen::SparseMatrix<T,Options>::StorageIndex Index;
+
+    A.resize(rows, cols); // compressed, with all outer indices set to zero
+    Index *outer = A.outerIndexPtr();
+    uint   n     = A.outerSize();
+
+    PARALLEL_FOR(0, n, 1000, [&](uint i)
+    {
+        outer[i+1] = Index(outer_size(i));
+    });
+    for(uint i=0; i<n; ++i) outer[i+1] += outer[i];
+
+    A.resizeNonZeros(outer[n]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, int Options>
+CINO_INLINE
+void sparse_sort_inner(Eigen::SparseMatrix<T,Options> & A)
+{
+    typedef typename Eigen::SparseMatrix<T,Options>::StorageIndex Index;
+
+    const Index *outer = A.outerIndexPtr();
+          Index *inner = A.innerIndexPtr();
+          T     *val   = A.valuePtr();
+
+    // outer vectors are short (a few tens of entries at most): insertion sort
+    PARALLEL_FOR(0, A.outerSize(), 1000, [&](uint i)
+    {
+        for(Index j=outer[i]+1; j<outer[i+1]; ++j)
+        {
+            Index idx = inner[j];
+            T     v   = val[j];
+            Index k   = j;
+            for(; k>outer[i] && inner[k-1]>idx; --k)
+            {
+                inner[k] = inner[k-1];
+                val[k]   = val[k-1];
+            }
+            inner[k] = idx;
+            val[k]   = v;
+        }
+    });
+}
+
+}
@@ -0,0 +1,91 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SPARSE_MATRIX_ASSEMBLY_H
+#define CINO_SPARSE_MATRIX_ASSEMBLY_H
+
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Utilities to assemble Eigen sparse matrices directly in compressed form,
+ * bypassing the list of triplets (and its sorting) when the sparsity pattern
+ * is known in advance. Assembly is done in two passes:
+ *
+ *   1) sparse_alloc takes the number of non zeros of each outer vector (column
+ *      for column major matrices, row for row major matrices), and allocates
+ *      the compressed storage;
+ *
+ *   2) the caller fills inner indices and values of each outer vector, which
+ *      starts at A.outerIndexPtr()[i]. Outer vectors are independent from each
+ *      other, hence this is typically done inside a PARALLEL_FOR. Inner indices
+ *      can be written in any order, and sorted afterwards with sparse_sort_inner.
+ *
+ * Example of usage (diagonal matrix, column major):
+ *
+ *   Eigen::SparseMatrix<double> D;
+ *   sparse_alloc(D, n, n, [](uint col){ return 1; });
+ *   PARALLEL_FOR(0, n, 1000, [&](uint col)
+ *   {
+ *       D.innerIndexPtr()[col] = col;
+ *       D.valuePtr()[col]      = diag[col];
+ *   });
+*/
+
+template<typename T, int Options, typename Func>
+CINO_INLINE
+void sparse_alloc(Eigen::SparseMatrix<T,Options> & A,
+                  const uint                       rows,
+                  const uint                       cols,
+                  const Func                     & outer_size); // uint outer_size(uint i)
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// sorts the inner indices of each outer vector (with the associated values)
+//
+template<typename T, int Options>
+CINO_INLINE
+void sparse_sort_inner(Eigen::SparseMatrix<T,Options> & A);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "sparse_matrix_assembly.cpp"
+#endif
+
+#endif // CINO_SPARSE_MATRIX_ASSEMBLY_H
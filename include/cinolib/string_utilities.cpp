@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/string_utilities.h>
+#include <clocale>
 
 namespace cinolib
 {
@@ -70,4 +71,12 @@ std::string get_file_name(const std::string & s, const bool with_extension)
     return ss.substr(0,pos);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void use_dot_as_decimal_separator()
+{
+    if(*localeconv()->decimal_point != '.') setlocale(LC_NUMERIC, "en_US.UTF-8");
+}
+
 }
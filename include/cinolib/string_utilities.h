@@ -63,6 +63,16 @@ std::string get_file_path(const std::string & s, const bool with_basename = fals
 CINO_INLINE
 std::string get_file_name(const std::string & s, const bool with_extension = true);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// makes sure "." is the decimal separator used to read/write numbers. The locale
+// is global, hence it is changed only if needed: readers and writers running on
+// different threads at the same time do not race on it (unless the locale must
+// actually be changed, in which case call this before spawning the threads)
+//
+CINO_INLINE
+void use_dot_as_decimal_separator();
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/subdivision_midpoint.h>
 #include <cinolib/sort_poly_vertices.h>
+#include <cinolib/geometry/point_utils.h>
 #include <map>
 
 namespace cinolib
@@ -65,7 +66,7 @@ void subdivision_midpoint(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
     face_verts.clear();
     poly_verts.clear();
 
-    std::vector<vec3d>             verts = m_in.vector_verts();
+    std::vector<vec3d>             verts = points_as_vec3d(m_in.vector_verts());
     std::vector<std::vector<uint>> faces;
     std::vector<std::vector<uint>> polys;
     std::vector<std::vector<bool>> polys_winding;
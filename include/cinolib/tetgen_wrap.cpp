@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/tetgen_wrap.h>
 #include <cinolib/vector_serialization.h>
+#include <cinolib/geometry/point_utils.h>
 
 #ifdef CINOLIB_USES_TETGEN
 #include <tetgen.h>
@@ -223,7 +224,7 @@ void tetgen_wrap(const AbstractPolygonMesh<M,V,E,F> & m_srf,
                  const std::string                  & flags,
                        Tetmesh<M,V,E,F,P>           & m)
 {
-    tetgen_wrap(m_srf.vector_verts(), m_srf.vector_polys(), {}, flags, m);
+    tetgen_wrap(points_as_vec3d(m_srf.vector_verts()), m_srf.vector_polys(), {}, flags, m);
 }
 
 }
@@ -0,0 +1,127 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/updatable_ldlt.h>
+#include <algorithm>
+#include <cassert>
+
+namespace cinolib
+{
+
+CINO_INLINE
+UpdatableLDLT::UpdatableLDLT(const UpdatableLDLT & f)
+    : Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>()
+{
+    // (m_isInitialized is made private by SimplicialCholeskyBase, but it is protected in SparseSolverBase)
+    typedef Eigen::SparseSolverBase<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>> SolverBase;
+    this->SolverBase::m_isInitialized = f.SolverBase::m_isInitialized;
+    m_info              = f.m_info;
+    m_factorizationIsOk = f.m_factorizationIsOk;
+    m_analysisIsOk      = f.m_analysisIsOk;
+    m_matrix            = f.m_matrix;
+    m_diag              = f.m_diag;
+    m_parent            = f.m_parent;
+    m_nonZerosPerCol    = f.m_nonZerosPerCol;
+    m_P                 = f.m_P;
+    m_Pinv              = f.m_Pinv;
+    m_shiftOffset       = f.m_shiftOffset;
+    m_shiftScale        = f.m_shiftScale;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool UpdatableLDLT::rank_update(const Eigen::SparseVector<double> & w, const double sigma)
+{
+    assert(m_factorizationIsOk && info()==Eigen::Success);
+    assert(w.size()==rows());
+
+    int n = int(rows());
+    if(work.size()!=n)
+    {
+        work = Eigen::VectorXd::Zero(n);
+        visited.assign(n, false);
+    }
+
+    // scatter w into the permuted ordering, and collect the union of the
+    // elimination tree paths from its non zeros to the root(s)
+    path.clear();
+    for(Eigen::SparseVector<double>::InnerIterator it(w); it; ++it)
+    {
+        int j = m_P.size()>0 ? m_P.indices()[it.index()] : int(it.index());
+        work[j] = it.value();
+        for(; j>=0 && !visited.at(j); j=m_parent[j])
+        {
+            visited.at(j) = true;
+            path.push_back(j);
+        }
+    }
+    std::sort(path.begin(), path.end());
+
+    // method C1 of Gill, Golub, Murray and Saunders, restricted to the path
+    const int    * Lp = m_matrix.outerIndexPtr();
+    const int    * Li = m_matrix.innerIndexPtr();
+          double * Lx = m_matrix.valuePtr();
+    double alpha = 1.0;
+    bool   ok    = true;
+    for(int j : path)
+    {
+        double wj = work[j];
+        work[j]   = 0.0;
+        visited.at(j) = false;
+        if(!ok || wj==0.0) continue;
+
+        double dj        = m_diag[j];
+        double alpha_new = alpha + sigma*wj*wj/dj;
+        if(alpha_new<=0.0 || dj==0.0)
+        {
+            ok = false; // the downdated matrix is not positive definite
+            continue;
+        }
+        double gamma = wj/(dj*alpha_new);
+        m_diag[j]    = dj*alpha_new/alpha;
+        alpha        = alpha_new;
+
+        for(int p=Lp[j]; p<Lp[j+1]; ++p)
+        {
+            int i = Li[p];
+            work[i] -= wj*Lx[p];
+            Lx[p]   += sigma*gamma*work[i];
+        }
+    }
+    return ok;
+}
+
+}
@@ -0,0 +1,92 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_UPDATABLE_LDLT_H
+#define CINO_UPDATABLE_LDLT_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Sparse LDLT factorization (Eigen::SimplicialLDLT) that supports rank one
+ * updates and downdates. If A = LDL^T, rank_update(w,sigma) modifies L and D
+ * so that they factorize A + sigma*w*w^T, with sigma = +1 (update) or -1
+ * (downdate). This is typical of reweighted least squares, where changing the
+ * weight of row a_i of the system matrix adds (w_new-w_old)*a_i*a_i^T to the
+ * normal equations, and of interactive tools that add or remove soft
+ * constraints. The method is the one described in:
+ *
+ *     T.A. Davis, W.W. Hager
+ *     Modifying a sparse Cholesky factorization
+ *     SIAM Journal on Matrix Analysis and Applications, 1999
+ *
+ * Only the columns along the paths of the elimination tree that start from the
+ * non zeros of w are visited, hence an update costs much less than factorizing
+ * again. The pattern of w*w^T must be contained in the pattern of the matrix
+ * that was factorized (e.g. w is a row of the matrix A, and A^T*A is factorized),
+ * because the pattern of L is not modified. Downdates fail (returning false) if
+ * the resulting matrix is not positive definite, in which case the factorization
+ * is no longer valid and must be recomputed. Differently from Eigen solvers,
+ * factorizations can be copied, e.g. to update a copy of a shared one.
+*/
+
+class UpdatableLDLT : public Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>
+{
+    public:
+
+        UpdatableLDLT() {}
+        explicit UpdatableLDLT(const Eigen::SparseMatrix<double> & A) { compute(A); }
+        UpdatableLDLT(const UpdatableLDLT & f); // (Eigen solvers are not copyable)
+
+        bool rank_update(const Eigen::SparseVector<double> & w, const double sigma = 1.0);
+
+    protected:
+
+        Eigen::VectorXd   work; // w, in the permuted ordering (zero outside of the current update)
+        std::vector<int>  path; // columns touched by the current update
+        std::vector<bool> visited;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "updatable_ldlt.cpp"
+#endif
+
+#endif // CINO_UPDATABLE_LDLT_H
@@ -34,32 +34,64 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vector_area_matrix.h>
+#include <cinolib/sparse_matrix_assembly.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
 
+/* Each boundary edge (v0,v1) contributes with four entries:
+ *
+ *   (v0+vn, v1   ) = -0.25
+ *   (v1,    v0+vn) = -0.25
+ *   (v0,    v1+vn) =  0.25
+ *   (v1+vn, v0   ) =  0.25
+ *
+ * hence columns vid and vid+vn both contain one entry for each boundary edge
+ * incident to vid, and can be filled independently from each other.
+*/
 template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> vector_area_matrix(const AbstractPolygonMesh<M,V,E,P> & m)
 {
-    typedef Eigen::Triplet<double> Entry;
-    std::vector<Entry> entries;
+    uint vn = m.num_verts();
 
-    uint vn      = m.num_verts();
-    auto b_edges = m.get_boundary_edges();
+    std::vector<uint> n_boundary_edges(vn,0);
+    PARALLEL_FOR(0, vn, 1000, [&](uint vid)
+    {
+        for(uint eid : m.adj_v2e(vid)) if(m.edge_is_boundary(eid)) ++n_boundary_edges[vid];
+    });
 
-    for(auto e : b_edges)
+    Eigen::SparseMatrix<double> A;
+    sparse_alloc(A, vn*2, vn*2, [&](uint col)
     {
-        uint v0 = e.first;
-        uint v1 = e.second;
-        entries.push_back(Entry(v0+vn, v1,    -0.25));
-        entries.push_back(Entry(v1,    v0+vn, -0.25));
-        entries.push_back(Entry(v0,    v1+vn,  0.25));
-        entries.push_back(Entry(v1+vn, v0,     0.25));
-    }
+        return n_boundary_edges[col%vn];
+    });
 
-    Eigen::SparseMatrix<double> A(vn*2, vn*2);
-    A.setFromTriplets(entries.begin(), entries.end());
+    PARALLEL_FOR(0, vn, 1000, [&](uint vid)
+    {
+        int    *idx_u = A.innerIndexPtr() + A.outerIndexPtr()[vid];    // column vid
+        double *val_u = A.valuePtr()      + A.outerIndexPtr()[vid];
+        int    *idx_v = A.innerIndexPtr() + A.outerIndexPtr()[vid+vn]; // column vid+vn
+        double *val_v = A.valuePtr()      + A.outerIndexPtr()[vid+vn];
+        for(uint eid : m.adj_v2e(vid))
+        {
+            if(!m.edge_is_boundary(eid)) continue;
+            uint v0 = m.edge_vert_id(eid,0);
+            uint v1 = m.edge_vert_id(eid,1);
+            if(vid==v1)
+            {
+                *idx_u++ = v0+vn; *val_u++ = -0.25;
+                *idx_v++ = v0;    *val_v++ =  0.25;
+            }
+            else
+            {
+                *idx_u++ = v1+vn; *val_u++ =  0.25;
+                *idx_v++ = v1;    *val_v++ = -0.25;
+            }
+        }
+    });
+    sparse_sort_inner(A);
 
     return A;
 }
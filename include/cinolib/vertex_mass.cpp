@@ -34,6 +34,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vertex_mass.h>
+#include <cinolib/sparse_matrix_assembly.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -42,26 +44,22 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m, const int n)
 {
-    typedef Eigen::Triplet<double> Entry;
-
     uint nv = m.num_verts();
-    std::vector<uint> base(n);
-    for(int i=0; i<n; ++i) base[i] = nv*i;
+    Eigen::SparseMatrix<double> MM;
+    sparse_alloc(MM, n*nv, n*nv, [](uint){ return 1; });
 
-    std::vector<Entry>  entries;
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+    PARALLEL_FOR(0, nv, 1000, [&](uint vid)
     {
         double mass = m.vert_mass(vid);
-        for(int i=0; i<n; ++i) entries.push_back(Entry(base[i] + vid, base[i] + vid, mass));
-    }
-
-    nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> MM(nv, nv);
-    MM.setFromTriplets(entries.begin(), entries.end());
+        for(int i=0; i<n; ++i)
+        {
+            uint col = nv*i + vid;
+            MM.innerIndexPtr()[col] = col;
+            MM.valuePtr()[col]      = mass;
+        }
+    });
 
     return MM;
 }
 
-
 }
-
@@ -0,0 +1,286 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/voxelize.h>
+#include <cinolib/predicates.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/geometry/point_utils.h>
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+namespace cinolib
+{
+
+CINO_INLINE
+OccupancyGrid::OccupancyGrid(const AABB & bbox, const uint nx, const uint ny, const uint nz)
+{
+    init(bbox, nx, ny, nz);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void OccupancyGrid::init(const AABB & bbox, const uint nx, const uint ny, const uint nz)
+{
+    bb     = bbox;
+    res[0] = nx;
+    res[1] = ny;
+    res[2] = nz;
+    wpr    = (nx+63)/64;
+    bits.assign(size_t(wpr)*ny*nz, 0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void OccupancyGrid::clear()
+{
+    std::fill(bits.begin(), bits.end(), 0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d OccupancyGrid::voxel_size() const
+{
+    return vec3d(bb.delta_x()/res[0], bb.delta_y()/res[1], bb.delta_z()/res[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d OccupancyGrid::voxel_center(const uint i, const uint j, const uint k) const
+{
+    vec3d d = voxel_size();
+    return bb.min + vec3d((i+0.5)*d[0], (j+0.5)*d[1], (k+0.5)*d[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool OccupancyGrid::is_inside(const uint i, const uint j, const uint k) const
+{
+    assert(i<res[0] && j<res[1] && k<res[2]);
+    return (row(j,k)[i/64] >> (i%64)) & 1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void OccupancyGrid::set(const uint i, const uint j, const uint k, const bool inside)
+{
+    assert(i<res[0] && j<res[1] && k<res[2]);
+    uint64_t mask = uint64_t(1) << (i%64);
+    if(inside) row(j,k)[i/64] |=  mask;
+    else       row(j,k)[i/64] &= ~mask;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void OccupancyGrid::set_range(const uint i_beg, const uint i_end, const uint j, const uint k)
+{
+    assert(i_beg<=i_end && i_end<=res[0]);
+    if(i_beg==i_end) return;
+    uint64_t * r = row(j,k);
+    uint wb = i_beg/64;
+    uint we = (i_end-1)/64;
+    uint64_t mb = ~uint64_t(0) << (i_beg%64);          // bits >= i_beg in the first word
+    uint64_t me = ~uint64_t(0) >> (63 - (i_end-1)%64); // bits <  i_end in the last word
+    if(wb==we)
+    {
+        r[wb] |= (mb & me);
+        return;
+    }
+    r[wb] |= mb;
+    for(uint w=wb+1; w<we; ++w) r[w] = ~uint64_t(0);
+    r[we] |= me;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint64_t OccupancyGrid::num_inside() const
+{
+    uint64_t count = 0;
+    for(uint64_t w : bits) count += std::bitset<64>(w).count();
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace
+{
+
+// sign of orient2d(a,b,q), where q is symbolically moved to q + (e,e^2), for an
+// infinitesimal e. The result is zero only if a and b coincide. Since the rule
+// is the same for all the edges, a point lying on an edge (or a vertex) shared
+// by multiple triangles is considered inside exactly one of them (if the
+// triangles form a surface that crosses the line through q)
+CINO_INLINE
+int orient2d_perturbed(const vec2d & a, const vec2d & b, const vec2d & q)
+{
+    double o = orient2d(a, b, q);
+    if(o>0) return  1;
+    if(o<0) return -1;
+    if(a[1]!=b[1]) return (a[1]>b[1]) ? 1 : -1;
+    if(a[0]!=b[0]) return (b[0]>a[0]) ? 1 : -1;
+    return 0;
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void voxelize(const Trimesh<M,V,E,P> & m,
+              const uint               max_res,
+                    OccupancyGrid    & grid)
+{
+    assert(max_res>0);
+
+    // cubic voxels, with a grid slightly larger than the mesh
+    AABB   bb   = m.bbox();
+    double size = bb.delta().max_entry()/max_res;
+    if(size==0) size = 1;
+    uint   res[3];
+    for(uint i=0; i<3; ++i)
+    {
+        res[i] = std::max(1u, static_cast<uint>(std::ceil(bb.delta()[i]/size)));
+    }
+    vec3d c = bb.center();
+    vec3d d = vec3d(res[0]*size, res[1]*size, res[2]*size)*0.5;
+    grid.init(AABB(c-d, c+d), res[0], res[1], res[2]);
+
+    auto tris = serialized_vids_from_polys(m.vector_polys());
+    voxelize(points_as_vec3d(m.vector_verts()), tris, grid);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void voxelize(const std::vector<vec3d> & verts,
+              const std::vector<uint>  & tris,
+                    OccupancyGrid      & grid)
+{
+    grid.clear();
+
+    const uint  nx = grid.size(0);
+    const uint  ny = grid.size(1);
+    const uint  nz = grid.size(2);
+    const vec3d o  = grid.bbox().min;
+    const vec3d d  = grid.voxel_size();
+    if(nx==0 || ny==0 || nz==0) return;
+
+    // rows that may cross a triangle (i.e. whose center lines may cross its bbox).
+    // The range is enlarged by one row per side: exact tests will discard them
+    auto row_range = [&](const double lo, const double hi, const uint axis, const uint n, uint & beg, uint & end)
+    {
+        double b = std::ceil ((lo-o[axis])/d[axis] - 0.5) - 1;
+        double e = std::floor((hi-o[axis])/d[axis] - 0.5) + 2;
+        beg = static_cast<uint>(std::max(0.0, std::min(b, double(n))));
+        end = static_cast<uint>(std::max(0.0, std::min(e, double(n))));
+    };
+
+    // bucket the triangles by row (compressed rows: the triangles
+    // of row r are tri_ids[row_beg[r]] ... tri_ids[row_beg[r+1]-1])
+    uint nt = tris.size()/3;
+    std::vector<uint> jr(2*nt), kr(2*nt);
+    std::vector<uint> row_beg(ny*nz+1, 0);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        const vec3d & a = verts.at(tris.at(3*tid  ));
+        const vec3d & b = verts.at(tris.at(3*tid+1));
+        const vec3d & c = verts.at(tris.at(3*tid+2));
+        row_range(std::min({a[1],b[1],c[1]}), std::max({a[1],b[1],c[1]}), 1, ny, jr[2*tid], jr[2*tid+1]);
+        row_range(std::min({a[2],b[2],c[2]}), std::max({a[2],b[2],c[2]}), 2, nz, kr[2*tid], kr[2*tid+1]);
+        for(uint k=kr[2*tid]; k<kr[2*tid+1]; ++k)
+        for(uint j=jr[2*tid]; j<jr[2*tid+1]; ++j) ++row_beg[k*ny+j+1];
+    }
+    for(uint r=0; r<ny*nz; ++r) row_beg[r+1] += row_beg[r];
+    std::vector<uint> tri_ids(row_beg.back());
+    std::vector<uint> fill(row_beg.begin(), row_beg.end()-1);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        for(uint k=kr[2*tid]; k<kr[2*tid+1]; ++k)
+        for(uint j=jr[2*tid]; j<jr[2*tid+1]; ++j) tri_ids[fill[k*ny+j]++] = tid;
+    }
+
+    // classify each row
+    PARALLEL_FOR(0, ny*nz, 64, [&](uint r)
+    {
+        if(row_beg[r]==row_beg[r+1]) return;
+        uint  j = r%ny;
+        uint  k = r/ny;
+        vec2d q(o[1]+(j+0.5)*d[1], o[2]+(k+0.5)*d[2]);
+
+        std::vector<double> x;
+        for(uint i=row_beg[r]; i<row_beg[r+1]; ++i)
+        {
+            uint tid = tri_ids[i];
+            const vec3d & a = verts.at(tris.at(3*tid  ));
+            const vec3d & b = verts.at(tris.at(3*tid+1));
+            const vec3d & c = verts.at(tris.at(3*tid+2));
+            vec2d a2(a[1],a[2]), b2(b[1],b[2]), c2(c[1],c[2]);
+
+            int s = orient2d_perturbed(a2, b2, q);
+            if(s==0 || orient2d_perturbed(b2, c2, q)!=s || orient2d_perturbed(c2, a2, q)!=s) continue;
+
+            // the line crosses the triangle: find where, with barycentric coordinates
+            double wa  = orient2d(b2, c2, q);
+            double wb  = orient2d(c2, a2, q);
+            double wc  = orient2d(a2, b2, q);
+            double sum = wa + wb + wc;
+            double xi  = (sum!=0) ? (wa*a[0] + wb*b[0] + wc*c[0])/sum : a[0];
+            x.push_back(std::max(std::min({a[0],b[0],c[0]}), std::min(xi, std::max({a[0],b[0],c[0]}))));
+        }
+        std::sort(x.begin(), x.end());
+
+        // voxels whose center is in between two consecutive crossings (even-odd rule)
+        for(uint i=0; i+1<x.size(); i+=2)
+        {
+            double b = std::ceil((x[i  ]-o[0])/d[0] - 0.5);
+            double e = std::ceil((x[i+1]-o[0])/d[0] - 0.5);
+            b = std::max(0.0, std::min(b, double(nx)));
+            e = std::max(0.0, std::min(e, double(nx)));
+            if(b<e) grid.set_range(static_cast<uint>(b), static_cast<uint>(e), j, k);
+        }
+    });
+}
+
+}
@@ -0,0 +1,130 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2022: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_VOXELIZE_H
+#define CINO_VOXELIZE_H
+
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/geometry/aabb.h>
+#include <cinolib/meshes/trimesh.h>
+#include <cstdint>
+
+namespace cinolib
+{
+
+/* Dense occupancy grid of nx*ny*nz voxels that tile a box. Each voxel is a single
+ * bit, and voxels are packed along X: voxel (i,j,k) is the (i%64)-th bit of the
+ * (i/64)-th word of row (j,k), and each row starts on a new word.
+*/
+
+class OccupancyGrid
+{
+    public:
+
+        explicit OccupancyGrid() {}
+
+        explicit OccupancyGrid(const AABB & bbox, const uint nx, const uint ny, const uint nz);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void init(const AABB & bbox, const uint nx, const uint ny, const uint nz);
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const AABB & bbox()                  const { return bb;        }
+              uint   size(const uint axis)   const { return res[axis]; }
+              vec3d  voxel_size()            const;
+              vec3d  voxel_center(const uint i, const uint j, const uint k) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool     is_inside (const uint i, const uint j, const uint k) const;
+        void     set       (const uint i, const uint j, const uint k, const bool inside);
+        void     set_range (const uint i_beg, const uint i_end, const uint j, const uint k); // marks voxels [i_beg,i_end) as inside
+        uint64_t num_inside() const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint             words_per_row()                    const { return wpr; }
+        const uint64_t * row(const uint j, const uint k)    const { return bits.data() + (size_t(k)*res[1] + j)*wpr; }
+              uint64_t * row(const uint j, const uint k)          { return bits.data() + (size_t(k)*res[1] + j)*wpr; }
+
+    protected:
+
+        AABB                  bb;
+        uint                  res[3] = { 0, 0, 0 };
+        uint                  wpr    = 0; // words per row
+        std::vector<uint64_t> bits;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Classifies the voxels of a grid as inside or outside of a closed triangle mesh. A voxel is
+ * inside if its center is inside the mesh, according to the even-odd rule. The classification
+ * works on whole rows of voxels at once, and rows are processed in parallel: for each row of
+ * voxels along X, the triangles are intersected with the line through the voxel centers, the
+ * crossings are sorted, and all the voxels between the first and second crossing, the third
+ * and fourth, and so on, are marked as inside. Triangles are bucketed by row beforehand, so
+ * each row only tests the triangles whose projection on the YZ plane may contain it.
+ *
+ * Lines that pass exactly through edges or vertices of the mesh are handled with a symbolic
+ * perturbation of the line, so that each crossing of the surface is counted exactly once.
+ * This makes the parity of the crossings robust, as long as the orient2d predicate is exact,
+ * that is, if the symbol CINOLIB_USES_SHEWCHUK_PREDICATES is defined (see predicates.h).
+ * The position of each crossing along the row is computed in floating point.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void voxelize(const Trimesh<M,V,E,P> & m,
+              const uint               max_res, // number of voxels along the longest side of the bbox
+                    OccupancyGrid    & grid);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the grid must be initialized beforehand (bbox and number of voxels per side)
+CINO_INLINE
+void voxelize(const std::vector<vec3d> & verts,
+              const std::vector<uint>  & tris,
+                    OccupancyGrid      & grid);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "voxelize.cpp"
+#endif
+
+#endif // CINO_VOXELIZE_H